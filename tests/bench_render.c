@@ -0,0 +1,407 @@
+/* SPDX-License-Identifier: Zlib */
+
+/* Headless benchmark of the renderer, the page cache, recoloring, searching
+ * and the layout code. Documents are generated for the synthetic plugin; the
+ * results are printed and written as JSON to the file given as argument so
+ * they can be compared across commits. */
+
+#include <girara/log.h>
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+#include <math.h>
+
+#include "adjustment.h"
+#include "document.h"
+#include "page.h"
+#include "plugin.h"
+#include "render.h"
+#include "zathura-version.h"
+
+#include "tests.h"
+
+#define BENCH_CONTENT_TYPE "application/x-zathura-synthetic"
+#define BENCH_VIEW_WIDTH 1400
+#define BENCH_VIEW_HEIGHT 900
+#define BENCH_PAGE_PADDING 2
+#define BENCH_CACHE_SIZE 16
+/* number of pages rendered to measure the render throughput */
+#define BENCH_RENDER_PAGES 64
+
+typedef struct bench_document_s {
+  const char* name;
+  unsigned int pages;
+  unsigned int lines;
+  unsigned int words_per_line;
+  unsigned int render_latency; /**< µs */
+} bench_document_t;
+
+static const bench_document_t bench_documents[] = {
+    {"short", 16, 40, 10, 0},
+    {"dense", 200, 80, 16, 0},
+    {"slow", 400, 40, 10, 2000},
+};
+
+static const char* bench_queries[] = {"lorem", "tempor", "ill", "zzz"};
+
+typedef struct bench_view_s bench_view_t;
+
+typedef struct bench_page_s {
+  bench_view_t* view;
+  ZathuraRenderRequest* request;
+  bool visible;
+  bool rendering;
+  bool rendered; /**< A surface of the page is available */
+} bench_page_t;
+
+/* State of a headless view of a document, i.e. what the page widgets keep. */
+struct bench_view_s {
+  zathura_document_t* document;
+  ZathuraRenderer* renderer;
+  bench_page_t* pages;
+  unsigned int pending; /**< Number of running render requests */
+  guint64 pixels;       /**< Number of rendered pixels */
+};
+
+static void cb_bench_completed(ZathuraRenderRequest* UNUSED(request), cairo_surface_t* surface, void* data) {
+  bench_page_t* page = data;
+  bench_view_t* view = page->view;
+
+  page->rendering = false;
+  page->rendered  = true;
+  view->pixels += (guint64)cairo_image_surface_get_width(surface) * cairo_image_surface_get_height(surface);
+  --view->pending;
+}
+
+static void cb_bench_cache_invalidated(ZathuraRenderRequest* UNUSED(request), void* data) {
+  bench_page_t* page = data;
+
+  /* like the page widget: keep the surface of visible pages */
+  if (page->visible == false) {
+    page->rendered = false;
+  }
+}
+
+static bench_view_t* bench_view_new(zathura_document_t* document) {
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+
+  bench_view_t* view = g_new0(bench_view_t, 1);
+  view->document     = document;
+  view->renderer     = zathura_renderer_new(BENCH_CACHE_SIZE);
+  view->pages        = g_new0(bench_page_t, number_of_pages);
+
+  for (unsigned int idx = 0; idx < number_of_pages; ++idx) {
+    bench_page_t* page = &view->pages[idx];
+    page->view         = view;
+    page->request      = zathura_render_request_new(view->renderer, zathura_document_get_page(document, idx));
+    g_signal_connect(page->request, "completed", G_CALLBACK(cb_bench_completed), page);
+    g_signal_connect(page->request, "cache-invalidated", G_CALLBACK(cb_bench_cache_invalidated), page);
+  }
+
+  return view;
+}
+
+static void bench_view_wait(bench_view_t* view) {
+  while (view->pending != 0) {
+    g_main_context_iteration(NULL, TRUE);
+  }
+}
+
+static void bench_view_free(bench_view_t* view) {
+  bench_view_wait(view);
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(view->document);
+  for (unsigned int idx = 0; idx < number_of_pages; ++idx) {
+    g_object_unref(view->pages[idx].request);
+  }
+  g_object_unref(view->renderer);
+  g_free(view->pages);
+  g_free(view);
+}
+
+static void bench_view_render(bench_view_t* view, unsigned int index) {
+  bench_page_t* page = &view->pages[index];
+  if (page->rendering == true) {
+    return;
+  }
+
+  page->rendering = true;
+  ++view->pending;
+  zathura_render_request(page->request, g_get_real_time());
+}
+
+static double bench_seconds(gint64 start) {
+  return MAX(g_get_monotonic_time() - start, 1) / (double)G_USEC_PER_SEC;
+}
+
+/* Render the first pages and report the throughput. */
+static void bench_render(JsonBuilder* builder, zathura_document_t* document, const char* name, const char* light,
+                         const char* dark) {
+  bench_view_t* view = bench_view_new(document);
+  if (light != NULL) {
+    zathura_renderer_set_recolor_colors_str(view->renderer, light, dark);
+    zathura_renderer_enable_recolor(view->renderer, true);
+  }
+
+  const unsigned int pages = MIN(zathura_document_get_number_of_pages(document), BENCH_RENDER_PAGES);
+  const gint64 start       = g_get_monotonic_time();
+  for (unsigned int idx = 0; idx < pages; ++idx) {
+    bench_view_render(view, idx);
+  }
+  bench_view_wait(view);
+  const double seconds = bench_seconds(start);
+
+  json_builder_set_member_name(builder, name);
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "renders_per_second");
+  json_builder_add_double_value(builder, pages / seconds);
+  json_builder_set_member_name(builder, "megapixels_per_second");
+  json_builder_add_double_value(builder, view->pixels / seconds / 1e6);
+  json_builder_end_object(builder);
+
+  g_print("  %-14s %8.1f renders/s %8.1f Mpx/s\n", name, pages / seconds, view->pixels / seconds / 1e6);
+  bench_view_free(view);
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+  const double lhs = *(const double*)a;
+  const double rhs = *(const double*)b;
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+/* Scroll down through the document and back up again, a quarter of the
+ * viewport at a time. A frame ends when all visible pages have been rendered. */
+static void bench_scroll(JsonBuilder* builder, zathura_document_t* document) {
+  bench_view_t* view                 = bench_view_new(document);
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+
+  unsigned int doc_height = 0;
+  unsigned int doc_width  = 0;
+  zathura_document_get_document_size(document, &doc_height, &doc_width);
+
+  /* positions are those of the center of the viewport */
+  const double step         = (BENCH_VIEW_HEIGHT / 4.0) / doc_height;
+  const double first        = MIN((BENCH_VIEW_HEIGHT / 2.0) / doc_height, 0.5);
+  const unsigned int frames = ceil((1.0 - 2 * first) / step) + 1;
+  g_autoptr(GArray) times   = g_array_new(FALSE, FALSE, sizeof(double));
+  unsigned int hits         = 0;
+  unsigned int misses       = 0;
+  double layout_time        = 0;
+
+  for (unsigned int frame = 0; frame < 2 * frames; ++frame) {
+    const unsigned int row = frame < frames ? frame : 2 * frames - 1 - frame;
+    const gint64 start     = g_get_monotonic_time();
+    zathura_document_set_position_y(document, MIN(first + row * step, 1.0 - first));
+
+    /* update the visible pages as update_visible_pages does */
+    for (unsigned int idx = 0; idx < number_of_pages; ++idx) {
+      bench_page_t* page     = &view->pages[idx];
+      const bool was_visible = page->visible;
+      page->visible          = page_is_visible(document, idx);
+      if (page->visible == was_visible) {
+        continue;
+      }
+
+      zathura_page_set_visibility(zathura_document_get_page(document, idx), page->visible);
+      if (page->visible == false) {
+        continue;
+      }
+
+      zathura_render_request_update_view_time(page->request);
+      zathura_renderer_page_cache_add(view->renderer, idx);
+      if (page->rendered == true) {
+        ++hits;
+      } else {
+        ++misses;
+        bench_view_render(view, idx);
+      }
+    }
+    layout_time += bench_seconds(start);
+
+    bench_view_wait(view);
+    const double frame_time = bench_seconds(start) * 1000;
+    g_array_append_val(times, frame_time);
+  }
+
+  g_array_sort(times, bench_compare_double);
+  double total = 0;
+  for (guint idx = 0; idx < times->len; ++idx) {
+    total += g_array_index(times, double, idx);
+  }
+  const double mean     = total / MAX(times->len, 1);
+  const double median   = g_array_index(times, double, times->len / 2);
+  const double p95      = g_array_index(times, double, (times->len * 95) / 100);
+  const double max      = g_array_index(times, double, times->len - 1);
+  const double hit_rate = hits + misses != 0 ? (double)hits / (hits + misses) : 0;
+
+  json_builder_set_member_name(builder, "scroll");
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "frames");
+  json_builder_add_int_value(builder, times->len);
+  json_builder_set_member_name(builder, "frame_time_mean_ms");
+  json_builder_add_double_value(builder, mean);
+  json_builder_set_member_name(builder, "frame_time_median_ms");
+  json_builder_add_double_value(builder, median);
+  json_builder_set_member_name(builder, "frame_time_p95_ms");
+  json_builder_add_double_value(builder, p95);
+  json_builder_set_member_name(builder, "frame_time_max_ms");
+  json_builder_add_double_value(builder, max);
+  json_builder_set_member_name(builder, "layout_time_ms");
+  json_builder_add_double_value(builder, layout_time * 1000);
+  json_builder_set_member_name(builder, "cache_hit_rate");
+  json_builder_add_double_value(builder, hit_rate);
+  json_builder_end_object(builder);
+
+  g_print("  %-14s %8u frames %8.2f ms mean %8.2f ms p95 %5.1f%% cache hits\n", "scroll", times->len, mean, p95,
+          hit_rate * 100);
+  bench_view_free(view);
+}
+
+/* Search every page for each query. */
+static void bench_search(JsonBuilder* builder, zathura_document_t* document) {
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+
+  json_builder_set_member_name(builder, "search");
+  json_builder_begin_array(builder);
+  for (size_t query = 0; query < G_N_ELEMENTS(bench_queries); ++query) {
+    unsigned int results = 0;
+    const gint64 start   = g_get_monotonic_time();
+    for (unsigned int idx = 0; idx < number_of_pages; ++idx) {
+      g_autoptr(girara_list_t) list =
+          zathura_page_search_text(zathura_document_get_page(document, idx), bench_queries[query], NULL);
+      results += list != NULL ? girara_list_size(list) : 0;
+    }
+    const double latency = bench_seconds(start) * 1000;
+
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "query");
+    json_builder_add_string_value(builder, bench_queries[query]);
+    json_builder_set_member_name(builder, "results");
+    json_builder_add_int_value(builder, results);
+    json_builder_set_member_name(builder, "latency_ms");
+    json_builder_add_double_value(builder, latency);
+    json_builder_end_object(builder);
+
+    g_print("  search %-7s %8u results %8.2f ms\n", bench_queries[query], results, latency);
+  }
+  json_builder_end_array(builder);
+}
+
+static char* bench_document_write(const char* directory, const bench_document_t* bench_document) {
+  g_autoptr(GKeyFile) key_file = g_key_file_new();
+  g_key_file_set_integer(key_file, "synthetic", "pages", bench_document->pages);
+  g_key_file_set_integer(key_file, "synthetic", "lines", bench_document->lines);
+  g_key_file_set_integer(key_file, "synthetic", "words-per-line", bench_document->words_per_line);
+  g_key_file_set_integer(key_file, "synthetic", "render-latency", bench_document->render_latency);
+
+  char* path = g_build_filename(directory, bench_document->name, NULL);
+  if (g_key_file_save_to_file(key_file, path, NULL) == FALSE) {
+    g_free(path);
+    return NULL;
+  }
+
+  return path;
+}
+
+static bool bench_document(JsonBuilder* builder, const zathura_plugin_t* plugin, const char* directory,
+                           const bench_document_t* bench_document) {
+  g_autofree char* path = bench_document_write(directory, bench_document);
+  if (path == NULL) {
+    girara_error("Failed to write document '%s'.", bench_document->name);
+    return false;
+  }
+
+  const gint64 start           = g_get_monotonic_time();
+  zathura_document_t* document = zathura_document_open_with_plugin(plugin, path, NULL, NULL, NULL);
+  const double open_time       = bench_seconds(start) * 1000;
+  g_unlink(path);
+  if (document == NULL) {
+    girara_error("Failed to open document '%s'.", bench_document->name);
+    return false;
+  }
+
+  zathura_document_set_viewport_width(document, BENCH_VIEW_WIDTH);
+  zathura_document_set_viewport_height(document, BENCH_VIEW_HEIGHT);
+  zathura_document_set_page_layout(document, BENCH_PAGE_PADDING, BENCH_PAGE_PADDING, 1, 1);
+  zathura_document_set_position_x(document, 0.5);
+
+  g_print("%s (%u pages)\n", bench_document->name, bench_document->pages);
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "name");
+  json_builder_add_string_value(builder, bench_document->name);
+  json_builder_set_member_name(builder, "pages");
+  json_builder_add_int_value(builder, bench_document->pages);
+  json_builder_set_member_name(builder, "open_time_ms");
+  json_builder_add_double_value(builder, open_time);
+
+  bench_render(builder, document, "render", NULL, NULL);
+  bench_render(builder, document, "recolor", "#FFFFFF", "#000000");
+  bench_render(builder, document, "recolor_hue", "#EBDBB2", "#282828");
+  bench_scroll(builder, document);
+  bench_search(builder, document);
+
+  json_builder_end_object(builder);
+  zathura_document_free(document);
+
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  setup_logger();
+  girara_set_log_level(GIRARA_ERROR);
+
+  const char* plugin_dir          = g_getenv("G_TEST_BUILDDIR");
+  g_autofree char* executable_dir = g_path_get_dirname(argv[0]);
+
+  g_autoptr(zathura_plugin_manager_t) plugin_manager = zathura_plugin_manager_new();
+  zathura_plugin_manager_set_dir(plugin_manager, plugin_dir != NULL ? plugin_dir : executable_dir);
+  zathura_plugin_manager_load(plugin_manager);
+
+  g_autofree char* content_type  = g_content_type_from_mime_type(BENCH_CONTENT_TYPE);
+  const zathura_plugin_t* plugin = zathura_plugin_manager_get_plugin(plugin_manager, content_type);
+  if (plugin == NULL) {
+    girara_error("The synthetic plugin is not available.");
+    return 1;
+  }
+
+  g_autofree char* directory = g_dir_make_tmp("zathura-bench-XXXXXX", NULL);
+  if (directory == NULL) {
+    girara_error("Failed to create a temporary directory.");
+    return 1;
+  }
+
+  g_autoptr(GDateTime) now       = g_date_time_new_now_utc();
+  g_autofree char* timestamp     = g_date_time_format_iso8601(now);
+  g_autoptr(JsonBuilder) builder = json_builder_new();
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "version");
+  json_builder_add_string_value(builder, ZATHURA_VERSION);
+  json_builder_set_member_name(builder, "timestamp");
+  json_builder_add_string_value(builder, timestamp);
+  json_builder_set_member_name(builder, "documents");
+  json_builder_begin_array(builder);
+
+  bool ret = true;
+  for (size_t idx = 0; idx < G_N_ELEMENTS(bench_documents) && ret == true; ++idx) {
+    ret = bench_document(builder, plugin, directory, &bench_documents[idx]);
+  }
+
+  json_builder_end_array(builder);
+  json_builder_end_object(builder);
+  g_rmdir(directory);
+
+  if (ret == true && argc > 1) {
+    g_autoptr(JsonNode) root           = json_builder_get_root(builder);
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    json_generator_set_pretty(generator, TRUE);
+    json_generator_set_root(generator, root);
+
+    g_autoptr(GError) error = NULL;
+    if (json_generator_to_file(generator, argv[1], &error) == FALSE) {
+      girara_error("Failed to write results to '%s': %s", argv[1], error->message);
+      return 1;
+    }
+    g_print("Results written to %s\n", argv[1]);
+  }
+
+  return ret == true ? 0 : 1;
+}
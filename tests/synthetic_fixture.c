@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <glib/gstdio.h>
+#include <unistd.h>
+
+#include "plugin.h"
+#include "synthetic_fixture.h"
+
+static zathura_plugin_manager_t* plugin_manager = NULL;
+
+void synthetic_fixture_init(void) {
+  plugin_manager = zathura_plugin_manager_new();
+  zathura_plugin_manager_set_dir(plugin_manager, g_getenv("G_TEST_BUILDDIR"));
+  zathura_plugin_manager_load(plugin_manager);
+}
+
+void synthetic_fixture_clear(void) {
+  zathura_plugin_manager_free(plugin_manager);
+  plugin_manager = NULL;
+}
+
+zathura_document_t* synthetic_fixture_open(const char* contents) {
+  g_autofree char* content_type  = g_content_type_from_mime_type("application/x-zathura-synthetic");
+  const zathura_plugin_t* plugin = zathura_plugin_manager_get_plugin(plugin_manager, content_type);
+  g_assert_nonnull(plugin);
+
+  g_autofree char* path = NULL;
+  const gint fd         = g_file_open_tmp("zathura-synthetic-XXXXXX", &path, NULL);
+  g_assert_cmpint(fd, !=, -1);
+  close(fd);
+  g_assert_true(g_file_set_contents(path, contents, -1, NULL));
+
+  zathura_document_t* document = zathura_document_open_with_plugin(plugin, path, NULL, NULL, NULL);
+  g_unlink(path);
+
+  return document;
+}
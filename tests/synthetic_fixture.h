@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_TESTS_SYNTHETIC_FIXTURE_H
+#define ZATHURA_TESTS_SYNTHETIC_FIXTURE_H
+
+#include "document.h"
+
+/**
+ * Loads the synthetic plugin from the build directory. Has to be called before
+ * any document is opened.
+ */
+void synthetic_fixture_init(void);
+
+/**
+ * Unloads the plugins loaded by synthetic_fixture_init.
+ */
+void synthetic_fixture_clear(void);
+
+/**
+ * Opens a document generated by the synthetic plugin.
+ *
+ * @param contents Key file describing the document
+ * @return The document or NULL if it could not be opened
+ */
+zathura_document_t* synthetic_fixture_open(const char* contents);
+
+#endif
@@ -0,0 +1,488 @@
+/* SPDX-License-Identifier: Zlib */
+
+/* Plugin rendering generated documents for tests and benchmarks. A synthetic
+ * document is a key file describing the document:
+ *
+ *   [synthetic]
+ *   pages=100
+ *   page-sizes=595x842;842x595;420x595
+ *   lines=40
+ *   words-per-line=10
+ *   links=4
+ *   images=2
+ *   annotations=3
+ *   outline=true
+ *   front-matter=4
+ *   render-latency=2000
+ *
+ * Every page shows lines of words picked deterministically from a fixed
+ * vocabulary, so that rendering, searching and the lists of links, images
+ * and annotations give the same results on every run. The size of every page
+ * is picked from page-sizes. links, images and annotations are counts per
+ * page; links point to other pages of the document. With outline, the index
+ * has a chapter for every ten pages and an entry for every page. The first
+ * front-matter pages are labelled with roman numbers and the following pages
+ * are numbered starting from 1.
+ * render-latency is the time in µs every page render takes in addition to
+ * drawing the page. */
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+
+#include "plugin-api.h"
+
+#define SYNTHETIC_GROUP "synthetic"
+/* width of a character in points */
+#define SYNTHETIC_CHAR_WIDTH 5.0
+#define SYNTHETIC_MARGIN 10.0
+#define SYNTHETIC_IMAGE_HEIGHT 60.0
+#define SYNTHETIC_PAGES_PER_CHAPTER 10
+
+static const char* synthetic_vocabulary[] = {
+    "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "sed", "tempor", "labore",
+    "dolore", "magna", "aliqua", "enim", "minim", "quis", "veniam", "nostrud", "ullamco", "laboris", "nisi",
+    "aliquip", "commodo", "duis", "aute", "irure", "velit", "esse", "cillum", "fugiat", "nulla",
+};
+
+typedef struct synthetic_size_s {
+  double width;
+  double height;
+} synthetic_size_t;
+
+typedef struct synthetic_document_s {
+  unsigned int pages;
+  GArray* sizes; /**< synthetic_size_t */
+  unsigned int lines;
+  unsigned int words_per_line;
+  unsigned int links;
+  unsigned int images;
+  unsigned int annotations;
+  bool outline;
+  unsigned int front_matter;
+  gulong render_latency;
+} synthetic_document_t;
+
+/* All generated content is derived from this hash of its position. */
+static guint32 synthetic_hash(guint32 a, guint32 b, guint32 c) {
+  guint32 hash = a * 2654435761u ^ b * 40503u ^ c * 2246822519u;
+  hash ^= hash >> 15;
+  hash *= 2246822519u;
+  hash ^= hash >> 13;
+
+  return hash;
+}
+
+static unsigned int synthetic_key_uint(GKeyFile* key_file, const char* key, unsigned int fallback) {
+  GError* error    = NULL;
+  const gint value = g_key_file_get_integer(key_file, SYNTHETIC_GROUP, key, &error);
+  if (error != NULL) {
+    g_error_free(error);
+    return fallback;
+  }
+
+  return MAX(value, 0);
+}
+
+static GArray* synthetic_key_sizes(GKeyFile* key_file) {
+  GArray* sizes      = g_array_new(FALSE, FALSE, sizeof(synthetic_size_t));
+  g_auto(GStrv) list = g_key_file_get_string_list(key_file, SYNTHETIC_GROUP, "page-sizes", NULL, NULL);
+  for (char** entry = list; entry != NULL && *entry != NULL; ++entry) {
+    synthetic_size_t size = {0};
+    if (sscanf(*entry, "%lfx%lf", &size.width, &size.height) == 2 && size.width > 0 && size.height > 0) {
+      g_array_append_val(sizes, size);
+    }
+  }
+
+  if (sizes->len == 0) {
+    const synthetic_size_t a4 = {595, 842};
+    g_array_append_val(sizes, a4);
+  }
+
+  return sizes;
+}
+
+static zathura_error_t synthetic_document_open(zathura_document_t* document) {
+  g_autoptr(GKeyFile) key_file = g_key_file_new();
+  if (g_key_file_load_from_file(key_file, zathura_document_get_path(document), G_KEY_FILE_NONE, NULL) == FALSE ||
+      g_key_file_has_group(key_file, SYNTHETIC_GROUP) == FALSE) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  synthetic_document_t* synthetic = g_new0(synthetic_document_t, 1);
+  synthetic->pages                = synthetic_key_uint(key_file, "pages", 1);
+  synthetic->sizes                = synthetic_key_sizes(key_file);
+  synthetic->lines                = synthetic_key_uint(key_file, "lines", 40);
+  synthetic->words_per_line       = synthetic_key_uint(key_file, "words-per-line", 10);
+  synthetic->links                = synthetic_key_uint(key_file, "links", 0);
+  synthetic->images               = synthetic_key_uint(key_file, "images", 0);
+  synthetic->annotations          = synthetic_key_uint(key_file, "annotations", 0);
+  synthetic->outline              = g_key_file_get_boolean(key_file, SYNTHETIC_GROUP, "outline", NULL);
+  synthetic->front_matter         = synthetic_key_uint(key_file, "front-matter", 0);
+  synthetic->render_latency       = synthetic_key_uint(key_file, "render-latency", 0);
+
+  zathura_document_set_number_of_pages(document, synthetic->pages);
+  zathura_document_set_data(document, synthetic);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t synthetic_document_free(zathura_document_t* UNUSED(document), void* data) {
+  synthetic_document_t* synthetic = data;
+  g_array_unref(synthetic->sizes);
+  g_free(synthetic);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_index_element_t* synthetic_index_element_new(const char* title, unsigned int page) {
+  const zathura_link_target_t target = {ZATHURA_LINK_DESTINATION_XYZ, NULL, page, -1, -1, -1, -1, 0};
+  const zathura_rectangle_t position = {0, 0, 0, 0};
+
+  zathura_index_element_t* element = zathura_index_element_new(title);
+  element->link                    = zathura_link_new(ZATHURA_LINK_GOTO_DEST, position, target);
+
+  return element;
+}
+
+static girara_tree_node_t* synthetic_document_index_generate(zathura_document_t* UNUSED(document), void* data,
+                                                             zathura_error_t* error) {
+  const synthetic_document_t* synthetic = data;
+  if (synthetic->outline == false) {
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_UNKNOWN;
+    }
+    return NULL;
+  }
+
+  girara_tree_node_t* root = girara_node_new(zathura_index_element_new("ROOT"));
+  girara_node_set_free_function(root, (girara_free_function_t)zathura_index_element_free);
+
+  girara_tree_node_t* chapter = NULL;
+  for (unsigned int page = 0; page < synthetic->pages; ++page) {
+    if (page % SYNTHETIC_PAGES_PER_CHAPTER == 0) {
+      g_autofree char* chapter_title = g_strdup_printf("Chapter %u", page / SYNTHETIC_PAGES_PER_CHAPTER + 1);
+      chapter                        = girara_node_append_data(root, synthetic_index_element_new(chapter_title, page));
+    }
+
+    g_autofree char* title = g_strdup_printf("Page %u", page + 1);
+    girara_node_append_data(chapter, synthetic_index_element_new(title, page));
+  }
+
+  return root;
+}
+
+static zathura_error_t synthetic_page_init(zathura_page_t* page) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  const unsigned int size_index         = synthetic_hash(zathura_page_get_index(page), 0, 0) % synthetic->sizes->len;
+  const synthetic_size_t size           = g_array_index(synthetic->sizes, synthetic_size_t, size_index);
+
+  zathura_page_set_width(page, size.width);
+  zathura_page_set_height(page, size.height);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t synthetic_page_get_label(zathura_page_t* page, void* UNUSED(data), char** label) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  const unsigned int index              = zathura_page_get_index(page);
+  if (synthetic->front_matter == 0) {
+    return ZATHURA_ERROR_OK;
+  }
+  if (index >= synthetic->front_matter) {
+    *label = g_strdup_printf("%u", index - synthetic->front_matter + 1);
+    return ZATHURA_ERROR_OK;
+  }
+
+  static const struct {
+    unsigned int value;
+    const char* numeral;
+  } numerals[] = {
+      {1000, "m"}, {900, "cm"}, {500, "d"}, {400, "cd"}, {100, "c"}, {90, "xc"}, {50, "l"},
+      {40, "xl"},  {10, "x"},   {9, "ix"},  {5, "v"},    {4, "iv"},  {1, "i"},
+  };
+
+  GString* roman     = g_string_new(NULL);
+  unsigned int value = index + 1;
+  for (size_t idx = 0; idx < G_N_ELEMENTS(numerals); ++idx) {
+    for (; value >= numerals[idx].value; value -= numerals[idx].value) {
+      g_string_append(roman, numerals[idx].numeral);
+    }
+  }
+  *label = g_string_free(roman, FALSE);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t synthetic_page_clear(zathura_page_t* UNUSED(page), void* UNUSED(data)) {
+  return ZATHURA_ERROR_OK;
+}
+
+/* Word at the given position; the same position always yields the same word. */
+static const char* synthetic_word(unsigned int page, unsigned int line, unsigned int word) {
+  return synthetic_vocabulary[synthetic_hash(page, line, word) % G_N_ELEMENTS(synthetic_vocabulary)];
+}
+
+static double synthetic_line_height(zathura_page_t* page) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  return (zathura_page_get_height(page) - 2 * SYNTHETIC_MARGIN) / MAX(synthetic->lines, 1);
+}
+
+/* Calls func for the bounding box of every word on the page. */
+static void synthetic_page_foreach_word(zathura_page_t* page,
+                                        void (*func)(const char* word, zathura_rectangle_t box, void* data),
+                                        void* data) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  const unsigned int index              = zathura_page_get_index(page);
+  const double line_height              = synthetic_line_height(page);
+
+  for (unsigned int line = 0; line < synthetic->lines; ++line) {
+    double x       = SYNTHETIC_MARGIN;
+    const double y = SYNTHETIC_MARGIN + line * line_height;
+    for (unsigned int idx = 0; idx < synthetic->words_per_line; ++idx) {
+      const char* word        = synthetic_word(index, line, idx);
+      const double width      = strlen(word) * SYNTHETIC_CHAR_WIDTH;
+      zathura_rectangle_t box = {x, y, x + width, y + 0.8 * line_height};
+      func(word, box, data);
+      x += width + SYNTHETIC_CHAR_WIDTH;
+    }
+  }
+}
+
+/* Bounding box of a word, laid out as in synthetic_page_foreach_word. */
+static zathura_rectangle_t synthetic_word_box(zathura_page_t* page, unsigned int line, unsigned int word) {
+  const unsigned int index = zathura_page_get_index(page);
+  const double line_height = synthetic_line_height(page);
+
+  double x = SYNTHETIC_MARGIN;
+  for (unsigned int idx = 0; idx < word; ++idx) {
+    x += (strlen(synthetic_word(index, line, idx)) + 1) * SYNTHETIC_CHAR_WIDTH;
+  }
+  const double y     = SYNTHETIC_MARGIN + line * line_height;
+  const double width = strlen(synthetic_word(index, line, word)) * SYNTHETIC_CHAR_WIDTH;
+
+  return (zathura_rectangle_t){x, y, x + width, y + 0.8 * line_height};
+}
+
+/* Bounding box of an image; images are placed side by side at the bottom of
+ * the page, on top of the text. */
+static zathura_rectangle_t synthetic_image_box(zathura_page_t* page, unsigned int image) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+
+  const double width  = (zathura_page_get_width(page) - 2 * SYNTHETIC_MARGIN) / MAX(synthetic->images, 1);
+  const double bottom = zathura_page_get_height(page) - SYNTHETIC_MARGIN;
+
+  return (zathura_rectangle_t){SYNTHETIC_MARGIN + image * width, bottom - SYNTHETIC_IMAGE_HEIGHT,
+                               SYNTHETIC_MARGIN + (image + 0.9) * width, bottom};
+}
+
+static void synthetic_draw_word(const char* UNUSED(word), zathura_rectangle_t box, void* data) {
+  cairo_rectangle(data, box.x1, box.y1, box.x2 - box.x1, box.y2 - box.y1);
+}
+
+static void synthetic_draw_image(cairo_t* cairo, zathura_rectangle_t box, unsigned int page, unsigned int image) {
+  const guint32 hash       = synthetic_hash(page, image, 1);
+  cairo_pattern_t* pattern = cairo_pattern_create_linear(box.x1, box.y1, box.x2, box.y2);
+  cairo_pattern_add_color_stop_rgb(pattern, 0, (hash & 0xff) / 255.0, ((hash >> 8) & 0xff) / 255.0, 0.5);
+  cairo_pattern_add_color_stop_rgb(pattern, 1, 0.5, ((hash >> 16) & 0xff) / 255.0, ((hash >> 24) & 0xff) / 255.0);
+
+  cairo_save(cairo);
+  cairo_set_source(cairo, pattern);
+  cairo_rectangle(cairo, box.x1, box.y1, box.x2 - box.x1, box.y2 - box.y1);
+  cairo_fill(cairo);
+  cairo_restore(cairo);
+  cairo_pattern_destroy(pattern);
+}
+
+static zathura_error_t synthetic_page_render_cairo(zathura_page_t* page, void* UNUSED(data), cairo_t* cairo,
+                                                   bool UNUSED(printing)) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+
+  cairo_save(cairo);
+  cairo_set_source_rgb(cairo, 0.2, 0.2, 0.2);
+  synthetic_page_foreach_word(page, synthetic_draw_word, cairo);
+  cairo_fill(cairo);
+  cairo_restore(cairo);
+
+  for (unsigned int image = 0; image < synthetic->images; ++image) {
+    synthetic_draw_image(cairo, synthetic_image_box(page, image), zathura_page_get_index(page), image);
+  }
+
+  if (synthetic->render_latency != 0) {
+    g_usleep(synthetic->render_latency);
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+typedef struct synthetic_search_s {
+  const char* text;
+  girara_list_t* results;
+} synthetic_search_t;
+
+static void synthetic_search_word(const char* word, zathura_rectangle_t box, void* data) {
+  synthetic_search_t* search = data;
+  const char* match          = strstr(word, search->text);
+  if (match == NULL) {
+    return;
+  }
+
+  zathura_rectangle_t* rectangle = g_new(zathura_rectangle_t, 1);
+  rectangle->x1                  = box.x1 + (match - word) * SYNTHETIC_CHAR_WIDTH;
+  rectangle->x2                  = rectangle->x1 + strlen(search->text) * SYNTHETIC_CHAR_WIDTH;
+  rectangle->y1                  = box.y1;
+  rectangle->y2                  = box.y2;
+  girara_list_append(search->results, rectangle);
+}
+
+static girara_list_t* synthetic_page_search_text(zathura_page_t* page, void* UNUSED(data), const char* text,
+                                                 zathura_error_t* error) {
+  if (text == NULL || *text == '\0') {
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_INVALID_ARGUMENTS;
+    }
+    return NULL;
+  }
+
+  synthetic_search_t search = {text, girara_list_new_with_free(g_free)};
+  synthetic_page_foreach_word(page, synthetic_search_word, &search);
+
+  return search.results;
+}
+
+typedef struct synthetic_text_s {
+  zathura_rectangle_t rectangle;
+  GString* text;
+  double line; /**< Top of the line of the last word */
+} synthetic_text_t;
+
+static void synthetic_text_word(const char* word, zathura_rectangle_t box, void* data) {
+  synthetic_text_t* text = data;
+  if (box.x2 < text->rectangle.x1 || box.x1 > text->rectangle.x2 || box.y2 < text->rectangle.y1 ||
+      box.y1 > text->rectangle.y2) {
+    return;
+  }
+
+  if (text->text->len != 0) {
+    g_string_append_c(text->text, box.y1 != text->line ? '\n' : ' ');
+  }
+  g_string_append(text->text, word);
+  text->line = box.y1;
+}
+
+static char* synthetic_page_get_text(zathura_page_t* page, void* UNUSED(data), zathura_rectangle_t rectangle,
+                                     zathura_error_t* UNUSED(error)) {
+  synthetic_text_t text = {rectangle, g_string_new(NULL), 0};
+  synthetic_page_foreach_word(page, synthetic_text_word, &text);
+
+  return g_string_free(text.text, FALSE);
+}
+
+static girara_list_t* synthetic_page_links_get(zathura_page_t* page, void* UNUSED(data), zathura_error_t* error) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  const unsigned int index              = zathura_page_get_index(page);
+  if (synthetic->links == 0 || synthetic->lines == 0 || synthetic->words_per_line == 0) {
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_UNKNOWN;
+    }
+    return NULL;
+  }
+
+  /* links are on the first word of evenly spaced lines */
+  girara_list_t* links = girara_list_new_with_free((girara_free_function_t)zathura_link_free);
+  for (unsigned int link = 0; link < synthetic->links; ++link) {
+    const unsigned int line            = (link * synthetic->lines) / synthetic->links;
+    const unsigned int target_page     = synthetic_hash(index, link, 2) % synthetic->pages;
+    const zathura_link_target_t target = {ZATHURA_LINK_DESTINATION_XYZ, NULL, target_page, -1, -1, -1, -1, 0};
+    girara_list_append(links, zathura_link_new(ZATHURA_LINK_GOTO_DEST, synthetic_word_box(page, line, 0), target));
+  }
+
+  return links;
+}
+
+static girara_list_t* synthetic_page_images_get(zathura_page_t* page, void* UNUSED(data), zathura_error_t* error) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  if (synthetic->images == 0) {
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_UNKNOWN;
+    }
+    return NULL;
+  }
+
+  girara_list_t* images = girara_list_new_with_free(g_free);
+  for (unsigned int image = 0; image < synthetic->images; ++image) {
+    zathura_image_t* zathura_image = g_new0(zathura_image_t, 1);
+    zathura_image->position        = synthetic_image_box(page, image);
+    zathura_image->data            = GUINT_TO_POINTER(image);
+    girara_list_append(images, zathura_image);
+  }
+
+  return images;
+}
+
+static cairo_surface_t* synthetic_page_image_get_cairo(zathura_page_t* page, void* UNUSED(data),
+                                                       zathura_image_t* image, zathura_error_t* error) {
+  const zathura_rectangle_t box = image->position;
+  cairo_surface_t* surface      = cairo_image_surface_create(CAIRO_FORMAT_RGB24, box.x2 - box.x1, box.y2 - box.y1);
+  if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(surface);
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+    return NULL;
+  }
+
+  cairo_t* cairo = cairo_create(surface);
+  cairo_translate(cairo, -box.x1, -box.y1);
+  synthetic_draw_image(cairo, box, zathura_page_get_index(page), GPOINTER_TO_UINT(image->data));
+  cairo_destroy(cairo);
+
+  return surface;
+}
+
+static girara_list_t* synthetic_page_get_annotations(zathura_page_t* page, void* UNUSED(data),
+                                                     zathura_error_t* error) {
+  const synthetic_document_t* synthetic = zathura_document_get_data(zathura_page_get_document(page));
+  const unsigned int index              = zathura_page_get_index(page);
+  if (synthetic->annotations == 0 || synthetic->lines == 0 || synthetic->words_per_line == 0) {
+    if (error != NULL) {
+      *error = ZATHURA_ERROR_UNKNOWN;
+    }
+    return NULL;
+  }
+
+  /* every annotation highlights a single word */
+  girara_list_t* annotations = girara_list_new_with_free((girara_free_function_t)zathura_highlight_free);
+  for (unsigned int annotation = 0; annotation < synthetic->annotations; ++annotation) {
+    const unsigned int line = synthetic_hash(index, annotation, 3) % synthetic->lines;
+    const unsigned int word = synthetic_hash(index, annotation, 4) % synthetic->words_per_line;
+
+    girara_list_t* rects           = girara_list_new_with_free(g_free);
+    zathura_rectangle_t* rectangle = g_new(zathura_rectangle_t, 1);
+    *rectangle                     = synthetic_word_box(page, line, word);
+    girara_list_append(rects, rectangle);
+
+    girara_list_append(annotations, zathura_highlight_new(index, rects, annotation % (ZATHURA_HIGHLIGHT_RED + 1),
+                                                          synthetic_word(index, line, word)));
+  }
+
+  return annotations;
+}
+
+ZATHURA_PLUGIN_REGISTER_WITH_FUNCTIONS("synthetic", 0, 2, 0,
+                                       ZATHURA_PLUGIN_FUNCTIONS({
+                                           .document_open           = synthetic_document_open,
+                                           .document_free           = synthetic_document_free,
+                                           .document_index_generate = synthetic_document_index_generate,
+                                           .page_init               = synthetic_page_init,
+                                           .page_clear              = synthetic_page_clear,
+                                           .page_get_label          = synthetic_page_get_label,
+                                           .page_search_text        = synthetic_page_search_text,
+                                           .page_links_get          = synthetic_page_links_get,
+                                           .page_images_get         = synthetic_page_images_get,
+                                           .page_image_get_cairo    = synthetic_page_image_get_cairo,
+                                           .page_get_text           = synthetic_page_get_text,
+                                           .page_render_cairo       = synthetic_page_render_cairo,
+                                           .page_get_annotations    = synthetic_page_get_annotations,
+                                       }),
+                                       ZATHURA_PLUGIN_MIMETYPES({"application/x-zathura-synthetic"}))
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/log.h>
+#include <glib/gstdio.h>
+
+#include "batch.h"
+#include "document.h"
+#include "synthetic_fixture.h"
+
+static JsonObject* batch_job(JsonNode* root, const char* name) {
+  JsonArray* jobs = json_object_get_array_member(json_node_get_object(root), "jobs");
+  for (guint idx = 0; idx < json_array_get_length(jobs); ++idx) {
+    JsonObject* job = json_array_get_object_element(jobs, idx);
+    if (g_strcmp0(json_object_get_string_member(job, "job"), name) == 0) {
+      return job;
+    }
+  }
+
+  return NULL;
+}
+
+static void test_parse_jobs(void) {
+  unsigned int jobs = 0;
+  g_assert_true(zathura_batch_parse_jobs("text, annotations", &jobs));
+  g_assert_cmpuint(jobs, ==, ZATHURA_BATCH_TEXT | ZATHURA_BATCH_ANNOTATIONS);
+  g_assert_false(zathura_batch_parse_jobs("render,unknown", &jobs));
+}
+
+static void test_run_jobs(void) {
+  zathura_document_t* document =
+      synthetic_fixture_open("[synthetic]\npages=5\npage-sizes=144x72\nlines=4\nwords-per-line=3\nannotations=2\n");
+  g_assert_nonnull(document);
+  g_autofree char* directory = g_dir_make_tmp("zathura-batch-XXXXXX", NULL);
+  g_assert_nonnull(directory);
+
+  const zathura_batch_options_t options = {
+      .jobs       = ZATHURA_BATCH_RENDER | ZATHURA_BATCH_TEXT | ZATHURA_BATCH_ANNOTATIONS,
+      .first_page = 0,
+      .last_page  = 4,
+      .threads    = 3,
+      .dpi        = 36,
+      .format     = ZATHURA_EXPORT_PNG,
+      .directory  = directory,
+  };
+  g_autoptr(JsonNode) root = zathura_batch_run(document, &options);
+  g_assert_nonnull(root);
+  g_assert_cmpint(json_object_get_int_member(json_node_get_object(root), "threads"), ==, 3);
+
+  static const char* names[] = {"render", "text", "annotations"};
+  for (size_t idx = 0; idx < G_N_ELEMENTS(names); ++idx) {
+    JsonObject* job = batch_job(root, names[idx]);
+    g_assert_nonnull(job);
+    g_assert_cmpint(json_object_get_int_member(job, "pages"), ==, 5);
+    g_assert_cmpint(json_object_get_int_member(job, "failed"), ==, 0);
+  }
+  g_assert_cmpint(json_object_get_int_member(batch_job(root, "text"), "characters"), >, 0);
+  g_assert_cmpint(json_object_get_int_member(batch_job(root, "annotations"), "highlights"), ==, 10);
+
+  /* annotations are written in page order */
+  g_autofree char* path        = g_build_filename(directory, "annotations.json", NULL);
+  g_autoptr(JsonParser) parser = json_parser_new();
+  g_assert_true(json_parser_load_from_file(parser, path, NULL));
+  JsonArray* annotations = json_node_get_array(json_parser_get_root(parser));
+  g_assert_cmpuint(json_array_get_length(annotations), ==, 10);
+  for (guint idx = 0; idx < 10; ++idx) {
+    JsonObject* annotation = json_array_get_object_element(annotations, idx);
+    g_assert_cmpint(json_object_get_int_member(annotation, "page"), ==, idx / 2 + 1);
+  }
+
+  GDir* dir = g_dir_open(directory, 0, NULL);
+  g_assert_nonnull(dir);
+  unsigned int files = 0;
+  const char* name   = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    g_autofree char* file = g_build_filename(directory, name, NULL);
+    g_unlink(file);
+    ++files;
+  }
+  g_dir_close(dir);
+  g_rmdir(directory);
+  /* an image and a text file per page, and the annotations */
+  g_assert_cmpuint(files, ==, 11);
+
+  zathura_document_free(document);
+}
+
+int main(int argc, char* argv[]) {
+  girara_set_log_level(GIRARA_ERROR);
+
+  synthetic_fixture_init();
+
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/batch/parse-jobs", test_parse_jobs);
+  g_test_add_func("/batch/run", test_run_jobs);
+  const int ret = g_test_run();
+
+  synthetic_fixture_clear();
+  return ret;
+}
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/log.h>
+#include <glib/gstdio.h>
+
+#include "document.h"
+#include "export.h"
+#include "synthetic_fixture.h"
+
+static void test_parse_range(void) {
+  unsigned int first = 0;
+  unsigned int last  = 0;
+  g_assert_true(zathura_export_parse_range("all", 10, &first, &last));
+  g_assert_cmpuint(first, ==, 0);
+  g_assert_cmpuint(last, ==, 9);
+  g_assert_true(zathura_export_parse_range("3-", 10, &first, &last));
+  g_assert_cmpuint(first, ==, 2);
+  g_assert_cmpuint(last, ==, 9);
+  g_assert_true(zathura_export_parse_range("-4", 10, &first, &last));
+  g_assert_cmpuint(first, ==, 0);
+  g_assert_cmpuint(last, ==, 3);
+  g_assert_true(zathura_export_parse_range("7", 10, &first, &last));
+  g_assert_cmpuint(first, ==, 6);
+  g_assert_cmpuint(last, ==, 6);
+  g_assert_false(zathura_export_parse_range("0", 10, &first, &last));
+  g_assert_false(zathura_export_parse_range("11", 10, &first, &last));
+  g_assert_false(zathura_export_parse_range("5-2", 10, &first, &last));
+  g_assert_false(zathura_export_parse_range("2-x", 10, &first, &last));
+}
+
+static void test_export_pages(void) {
+  zathura_document_t* document = synthetic_fixture_open("[synthetic]\npages=4\npage-sizes=144x72\n");
+  g_assert_nonnull(document);
+  g_autofree char* directory = g_dir_make_tmp("zathura-export-XXXXXX", NULL);
+  g_assert_nonnull(directory);
+
+  const zathura_export_options_t options = {
+      .first_page = 1,
+      .last_page  = 2,
+      .dpi        = 36,
+      .format     = ZATHURA_EXPORT_PNG,
+      .directory  = directory,
+  };
+  ZathuraRenderer* renderer = zathura_renderer_new(1);
+  zathura_export_t* export  = zathura_export_pages(document, renderer, &options, NULL, NULL);
+  g_assert_nonnull(export);
+  g_assert_cmpuint(zathura_export_wait(export), ==, 0);
+  zathura_export_free(export);
+  g_object_unref(renderer);
+
+  for (unsigned int page = 1; page <= 4; ++page) {
+    g_autofree char* name = g_strdup_printf("page-%u.png", page);
+    g_autofree char* path = g_build_filename(directory, name, NULL);
+    if (page == 1 || page == 4) {
+      g_assert_false(g_file_test(path, G_FILE_TEST_EXISTS));
+      continue;
+    }
+
+    cairo_surface_t* surface = cairo_image_surface_create_from_png(path);
+    g_assert_cmpint(cairo_surface_status(surface), ==, CAIRO_STATUS_SUCCESS);
+    g_assert_cmpint(cairo_image_surface_get_width(surface), ==, 72);
+    g_assert_cmpint(cairo_image_surface_get_height(surface), ==, 36);
+    cairo_surface_destroy(surface);
+    g_unlink(path);
+  }
+  g_rmdir(directory);
+
+  zathura_document_free(document);
+}
+
+int main(int argc, char* argv[]) {
+  girara_set_log_level(GIRARA_ERROR);
+
+  synthetic_fixture_init();
+
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/export/parse-range", test_parse_range);
+  g_test_add_func("/export/pages", test_export_pages);
+  const int ret = g_test_run();
+
+  synthetic_fixture_clear();
+  return ret;
+}
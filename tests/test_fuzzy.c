@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include "fuzzy.h"
+
+static void test_fuzzy_score(void) {
+  g_assert_cmpint(zathura_fuzzy_score("", "abc", false), ==, 0);
+  g_assert_cmpint(zathura_fuzzy_score("xyz", "abc", false), ==, -1);
+  g_assert_cmpint(zathura_fuzzy_score("abcd", "abc", false), ==, -1);
+  g_assert_cmpint(zathura_fuzzy_score("ac", "abc", false), >, 0);
+  g_assert_cmpint(zathura_fuzzy_score("ac", "abc", true), ==, -1);
+  g_assert_cmpint(zathura_fuzzy_score("BC", "abc", true), >, 0);
+  g_assert_cmpint(zathura_fuzzy_score("ABC", "xabcx", false), ==, zathura_fuzzy_score("abc", "xabcx", false));
+  g_assert_cmpint(zathura_fuzzy_score("über", "Übersicht.pdf", true), >, 0);
+  g_assert_cmpint(zathura_fuzzy_score("ÜBER", "übersicht.pdf", false), >, 0);
+}
+
+static void test_fuzzy_ranking(void) {
+  /* word boundaries */
+  g_assert_cmpint(zathura_fuzzy_score("fb", "foo_bar.pdf", false), >, zathura_fuzzy_score("fb", "xfxxbx.pdf", false));
+  /* camel case */
+  g_assert_cmpint(zathura_fuzzy_score("fb", "fooBar", false), >, zathura_fuzzy_score("fb", "fooxbar", false));
+  /* consecutive characters */
+  g_assert_cmpint(zathura_fuzzy_score("abc", "abcxx", false), >, zathura_fuzzy_score("abc", "axbxc", false));
+  /* shorter gaps */
+  g_assert_cmpint(zathura_fuzzy_score("ad", "axxd", false), >, zathura_fuzzy_score("ad", "axxxxxxd", false));
+  /* the shortest occurrence is scored */
+  g_assert_cmpint(zathura_fuzzy_score("ab", "a-----ab", false), ==, zathura_fuzzy_score("ab", "ab", false));
+}
+
+static void test_fuzzy_matcher(void) {
+  zathura_fuzzy_t* fuzzy = zathura_fuzzy_new();
+  g_assert_nonnull(fuzzy);
+  g_assert_true(zathura_fuzzy_query_is_empty(fuzzy));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "anything"), ==, 0);
+
+  zathura_fuzzy_set_query(fuzzy, "fo", false);
+  g_assert_false(zathura_fuzzy_query_is_empty(fuzzy));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "foo"), ==, zathura_fuzzy_score("fo", "foo", false));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "f_o"), ==, zathura_fuzzy_score("fo", "f_o", false));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "bar"), ==, -1);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, NULL), ==, -1);
+
+  /* narrowed query */
+  zathura_fuzzy_set_query(fuzzy, "foo", false);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "foo"), ==, zathura_fuzzy_score("foo", "foo", false));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "f_o"), ==, -1);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "bar"), ==, -1);
+
+  /* broader query */
+  zathura_fuzzy_set_query(fuzzy, "o", false);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "f_o"), >, 0);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "bar"), ==, -1);
+
+  /* exact mode */
+  zathura_fuzzy_set_query(fuzzy, "fo", true);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "foo"), >, 0);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "f_o"), ==, -1);
+
+  zathura_fuzzy_clear(fuzzy);
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "foo"), >, 0);
+
+  zathura_fuzzy_set_query(fuzzy, NULL, false);
+  g_assert_true(zathura_fuzzy_query_is_empty(fuzzy));
+  g_assert_cmpint(zathura_fuzzy_match(fuzzy, "bar"), ==, 0);
+
+  zathura_fuzzy_free(fuzzy);
+}
+
+int main(int argc, char* argv[]) {
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/fuzzy/score", test_fuzzy_score);
+  g_test_add_func("/fuzzy/ranking", test_fuzzy_ranking);
+  g_test_add_func("/fuzzy/matcher", test_fuzzy_matcher);
+  return g_test_run();
+}
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/log.h>
+
+#include "document.h"
+#include "index-model.h"
+#include "synthetic_fixture.h"
+
+static void test_find_page(void) {
+  zathura_document_t* document = synthetic_fixture_open("[synthetic]\npages=25\noutline=true\n");
+  g_assert_nonnull(document);
+
+  girara_tree_node_t* index = zathura_document_index_generate(document, NULL);
+  g_assert_nonnull(index);
+  ZathuraIndexModel* model = zathura_index_model_new(document, index);
+  GtkTreeModel* tree_model = GTK_TREE_MODEL(model);
+  g_assert_cmpint(gtk_tree_model_iter_n_children(tree_model, NULL), ==, 3);
+
+  GtkTreeIter iter;
+  g_assert_true(zathura_index_model_find_page(model, 13, &iter));
+  g_autoptr(GtkTreePath) path = gtk_tree_model_get_path(tree_model, &iter);
+  g_autofree char* path_str   = gtk_tree_path_to_string(path);
+  g_assert_cmpstr(path_str, ==, "1:3");
+
+  g_autofree char* title       = NULL;
+  g_autofree char* description = NULL;
+  gtk_tree_model_get(tree_model, &iter, ZATHURA_INDEX_MODEL_COLUMN_TITLE, &title,
+                     ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION, &description, -1);
+  g_assert_cmpstr(title, ==, "Page 14");
+  g_assert_cmpstr(description, ==, "Page 14");
+
+  GtkTreeIter parent;
+  g_assert_true(gtk_tree_model_iter_parent(tree_model, &parent, &iter));
+  g_assert_cmpint(gtk_tree_model_iter_n_children(tree_model, &parent), ==, 10);
+  g_assert_false(gtk_tree_model_iter_parent(tree_model, &iter, &parent));
+
+  g_object_unref(model);
+  zathura_document_free(document);
+}
+
+int main(int argc, char* argv[]) {
+  girara_set_log_level(GIRARA_ERROR);
+
+  synthetic_fixture_init();
+
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/index-model/find-page", test_find_page);
+  const int ret = g_test_run();
+
+  synthetic_fixture_clear();
+  return ret;
+}
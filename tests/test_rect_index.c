@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include "rect-index.h"
+
+static bool cb_collect(const zathura_rectangle_t* UNUSED(rectangle), zathura_rect_index_kind_t UNUSED(kind), void* data,
+                       void* user_data) {
+  GArray* hits = user_data;
+  const gint value = GPOINTER_TO_INT(data);
+  g_array_append_val(hits, value);
+  return true;
+}
+
+static bool cb_first(const zathura_rectangle_t* UNUSED(rectangle), zathura_rect_index_kind_t UNUSED(kind), void* data,
+                     void* user_data) {
+  *(gint*)user_data = GPOINTER_TO_INT(data);
+  return false;
+}
+
+static void test_rect_index_empty(void) {
+  zathura_rect_index_t* index = zathura_rect_index_new(100, 100, 0);
+  g_assert_nonnull(index);
+  g_assert_cmpuint(zathura_rect_index_size(index), ==, 0);
+
+  gint hit = 0;
+  g_assert_false(zathura_rect_index_query_point(index, 10, 10, ZATHURA_RECT_INDEX_ALL, cb_first, &hit));
+  g_assert_cmpint(hit, ==, 0);
+  zathura_rect_index_free(index);
+}
+
+static void test_rect_index_point(void) {
+  zathura_rect_index_t* index = zathura_rect_index_new(100, 100, 16);
+
+  const zathura_rectangle_t a = {.x1 = 10, .y1 = 10, .x2 = 20, .y2 = 20};
+  const zathura_rectangle_t b = {.x1 = 15, .y1 = 15, .x2 = 90, .y2 = 90};
+  const zathura_rectangle_t c = {.x1 = 60, .y1 = 60, .x2 = 70, .y2 = 70};
+  zathura_rect_index_insert(index, &a, ZATHURA_RECT_INDEX_LINK, GINT_TO_POINTER(1));
+  zathura_rect_index_insert(index, &b, ZATHURA_RECT_INDEX_HIGHLIGHT, GINT_TO_POINTER(2));
+  zathura_rect_index_insert(index, &c, ZATHURA_RECT_INDEX_LINK, GINT_TO_POINTER(3));
+  g_assert_cmpuint(zathura_rect_index_size(index), ==, 3);
+
+  GArray* hits = g_array_new(FALSE, FALSE, sizeof(gint));
+  zathura_rect_index_query_point(index, 17, 17, ZATHURA_RECT_INDEX_ALL, cb_collect, hits);
+  g_assert_cmpuint(hits->len, ==, 2);
+  g_assert_cmpint(g_array_index(hits, gint, 0), ==, 1);
+  g_assert_cmpint(g_array_index(hits, gint, 1), ==, 2);
+
+  g_array_set_size(hits, 0);
+  zathura_rect_index_query_point(index, 65, 65, ZATHURA_RECT_INDEX_LINK, cb_collect, hits);
+  g_assert_cmpuint(hits->len, ==, 1);
+  g_assert_cmpint(g_array_index(hits, gint, 0), ==, 3);
+
+  g_array_set_size(hits, 0);
+  zathura_rect_index_query_point(index, 5, 95, ZATHURA_RECT_INDEX_ALL, cb_collect, hits);
+  g_assert_cmpuint(hits->len, ==, 0);
+
+  g_array_free(hits, TRUE);
+  zathura_rect_index_free(index);
+}
+
+static void test_rect_index_area(void) {
+  zathura_rect_index_t* index = zathura_rect_index_new(100, 100, 64);
+
+  /* a large entry spanning many cells must be reported once */
+  const zathura_rectangle_t large = {.x1 = 0, .y1 = 0, .x2 = 100, .y2 = 100};
+  const zathura_rectangle_t small = {.x1 = 40, .y1 = 40, .x2 = 45, .y2 = 45};
+  /* entries outside of the page are clamped to the border cells */
+  const zathura_rectangle_t outside = {.x1 = 120, .y1 = -20, .x2 = 130, .y2 = -10};
+  zathura_rect_index_insert(index, &large, ZATHURA_RECT_INDEX_HIGHLIGHT, GINT_TO_POINTER(1));
+  zathura_rect_index_insert(index, &small, ZATHURA_RECT_INDEX_NOTE, GINT_TO_POINTER(2));
+  zathura_rect_index_insert(index, &outside, ZATHURA_RECT_INDEX_LINK, GINT_TO_POINTER(3));
+
+  GArray* hits = g_array_new(FALSE, FALSE, sizeof(gint));
+  const zathura_rectangle_t area = {.x1 = 50, .y1 = 50, .x2 = 30, .y2 = 30};
+  zathura_rect_index_query(index, &area, ZATHURA_RECT_INDEX_ALL, cb_collect, hits);
+  g_assert_cmpuint(hits->len, ==, 2);
+  g_assert_cmpint(g_array_index(hits, gint, 0), ==, 1);
+  g_assert_cmpint(g_array_index(hits, gint, 1), ==, 2);
+
+  g_array_set_size(hits, 0);
+  zathura_rect_index_query_point(index, 125, -15, ZATHURA_RECT_INDEX_LINK, cb_collect, hits);
+  g_assert_cmpuint(hits->len, ==, 1);
+  g_assert_cmpint(g_array_index(hits, gint, 0), ==, 3);
+
+  gint first = 0;
+  g_assert_true(zathura_rect_index_query(index, &area, ZATHURA_RECT_INDEX_ALL, cb_first, &first));
+  g_assert_cmpint(first, ==, 1);
+
+  g_array_free(hits, TRUE);
+  zathura_rect_index_free(index);
+}
+
+int main(int argc, char* argv[]) {
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/rect_index/empty", test_rect_index_empty);
+  g_test_add_func("/rect_index/point", test_rect_index_point);
+  g_test_add_func("/rect_index/area", test_rect_index_area);
+  return g_test_run();
+}
@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/log.h>
+#include <string.h>
+
+#include "document.h"
+#include "links.h"
+#include "page.h"
+#include "synthetic_fixture.h"
+
+static void test_pages(void) {
+  zathura_document_t* document = synthetic_fixture_open("[synthetic]\npages=50\npage-sizes=595x842;842x595;420x595\n");
+  g_assert_nonnull(document);
+  g_assert_cmpuint(zathura_document_get_number_of_pages(document), ==, 50);
+
+  bool landscape = false;
+  bool portrait  = false;
+  for (unsigned int idx = 0; idx < 50; ++idx) {
+    zathura_page_t* page = zathura_document_get_page(document, idx);
+    const double width   = zathura_page_get_width(page);
+    const double height  = zathura_page_get_height(page);
+    g_assert_true((width == 595 && height == 842) || (width == 842 && height == 595) ||
+                  (width == 420 && height == 595));
+    landscape |= width > height;
+    portrait |= width < height;
+  }
+  g_assert_true(landscape);
+  g_assert_true(portrait);
+
+  zathura_document_free(document);
+}
+
+static void test_deterministic(void) {
+  static const char contents[] = "[synthetic]\npages=3\nlines=20\nwords-per-line=8\n";
+  zathura_document_t* first    = synthetic_fixture_open(contents);
+  zathura_document_t* second   = synthetic_fixture_open(contents);
+  g_assert_nonnull(first);
+  g_assert_nonnull(second);
+
+  const zathura_rectangle_t all = {0, 0, 1000, 1000};
+  for (unsigned int idx = 0; idx < 3; ++idx) {
+    g_autofree char* first_text  = zathura_page_get_text(zathura_document_get_page(first, idx), all, NULL);
+    g_autofree char* second_text = zathura_page_get_text(zathura_document_get_page(second, idx), all, NULL);
+    g_assert_nonnull(first_text);
+    g_assert_cmpstr(first_text, ==, second_text);
+
+    g_autoptr(girara_list_t) results = zathura_page_search_text(zathura_document_get_page(first, idx), "lorem", NULL);
+    g_assert_nonnull(results);
+    const char* match = first_text;
+    size_t matches    = 0;
+    while ((match = strstr(match, "lorem")) != NULL) {
+      ++matches;
+      ++match;
+    }
+    g_assert_cmpuint(girara_list_size(results), ==, matches);
+  }
+
+  zathura_document_free(first);
+  zathura_document_free(second);
+}
+
+static void test_content(void) {
+  zathura_document_t* document =
+      synthetic_fixture_open("[synthetic]\npages=25\nlinks=4\nimages=3\nannotations=2\noutline=true\n");
+  g_assert_nonnull(document);
+
+  for (unsigned int idx = 0; idx < 25; ++idx) {
+    zathura_page_t* page = zathura_document_get_page(document, idx);
+
+    g_autoptr(girara_list_t) links = zathura_page_links_get(page, NULL);
+    g_assert_nonnull(links);
+    g_assert_cmpuint(girara_list_size(links), ==, 4);
+    for (size_t link = 0; link < girara_list_size(links); ++link) {
+      const zathura_link_target_t target = zathura_link_get_target(girara_list_nth(links, link));
+      g_assert_cmpuint(target.page_number, <, 25);
+    }
+
+    g_autoptr(girara_list_t) images = zathura_page_images_get(page, NULL);
+    g_assert_nonnull(images);
+    g_assert_cmpuint(girara_list_size(images), ==, 3);
+    cairo_surface_t* surface = zathura_page_image_get_cairo(page, girara_list_nth(images, 0), NULL);
+    g_assert_nonnull(surface);
+    cairo_surface_destroy(surface);
+
+    g_autoptr(girara_list_t) annotations = zathura_page_get_annotations(page, NULL);
+    g_assert_nonnull(annotations);
+    g_assert_cmpuint(girara_list_size(annotations), ==, 2);
+  }
+
+  girara_tree_node_t* index = zathura_document_index_generate(document, NULL);
+  g_assert_nonnull(index);
+  /* a chapter for every ten pages */
+  g_assert_cmpuint(girara_node_get_num_children(index), ==, 3);
+  girara_node_free(index);
+
+  zathura_document_free(document);
+}
+
+static void test_labels(void) {
+  zathura_document_t* document = synthetic_fixture_open("[synthetic]\npages=20\nfront-matter=6\n");
+  g_assert_nonnull(document);
+
+  g_assert_cmpstr(zathura_page_get_label(zathura_document_get_page(document, 3), NULL), ==, "iv");
+  g_assert_cmpstr(zathura_page_get_label(zathura_document_get_page(document, 6), NULL), ==, "1");
+
+  unsigned int index = 0;
+  g_assert_true(zathura_document_find_page_label(document, "iv", &index));
+  g_assert_cmpuint(index, ==, 3);
+  g_assert_true(zathura_document_find_page_label(document, "vi", &index));
+  g_assert_cmpuint(index, ==, 5);
+  g_assert_true(zathura_document_find_page_label(document, "14", &index));
+  g_assert_cmpuint(index, ==, 19);
+  g_assert_false(zathura_document_find_page_label(document, "15", &index));
+  g_assert_false(zathura_document_find_page_label(document, "vii", &index));
+
+  zathura_document_free(document);
+
+  document = synthetic_fixture_open("[synthetic]\npages=2\n");
+  g_assert_nonnull(document);
+  g_assert_false(zathura_document_find_page_label(document, "1", NULL));
+  zathura_document_free(document);
+}
+
+int main(int argc, char* argv[]) {
+  girara_set_log_level(GIRARA_ERROR);
+
+  synthetic_fixture_init();
+
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/synthetic/pages", test_pages);
+  g_test_add_func("/synthetic/deterministic", test_deterministic);
+  g_test_add_func("/synthetic/content", test_content);
+  g_test_add_func("/synthetic/labels", test_labels);
+  const int ret = g_test_run();
+
+  synthetic_fixture_clear();
+  return ret;
+}
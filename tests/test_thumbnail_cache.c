@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/log.h>
+#include <glib/gstdio.h>
+
+#include "document.h"
+#include "macros.h"
+#include "synthetic_fixture.h"
+#include "thumbnail-cache.h"
+
+static void thumbnails_updated(zathura_thumbnail_cache_t* UNUSED(cache), void* UNUSED(data)) {}
+
+static bool thumbnails_complete(zathura_thumbnail_cache_t* cache, unsigned int number_of_pages) {
+  for (unsigned int idx = 0; idx < number_of_pages; ++idx) {
+    cairo_surface_t* thumbnail = zathura_thumbnail_cache_get(cache, idx);
+    if (thumbnail == NULL) {
+      return false;
+    }
+    cairo_surface_destroy(thumbnail);
+  }
+
+  return true;
+}
+
+static void test_generate(void) {
+  zathura_document_t* document = synthetic_fixture_open("[synthetic]\npages=6\npage-sizes=595x842;842x595\n");
+  g_assert_nonnull(document);
+  g_autofree char* cache_dir = g_dir_make_tmp("zathura-thumbnails-XXXXXX", NULL);
+  g_assert_nonnull(cache_dir);
+
+  /* generate the thumbnails and write them when the cache is freed */
+  zathura_thumbnail_cache_t* cache = zathura_thumbnail_cache_new(document, NULL, cache_dir, thumbnails_updated, NULL);
+  g_assert_null(zathura_thumbnail_cache_get(cache, 0));
+  zathura_thumbnail_cache_start(cache);
+  while (thumbnails_complete(cache, 6) == false) {
+    g_main_context_iteration(NULL, TRUE);
+  }
+  zathura_thumbnail_cache_free(cache);
+
+  /* a new cache maps the file without generating anything */
+  cache = zathura_thumbnail_cache_new(document, NULL, cache_dir, NULL, NULL);
+  for (unsigned int idx = 0; idx < 6; ++idx) {
+    cairo_surface_t* thumbnail = zathura_thumbnail_cache_get(cache, idx);
+    g_assert_nonnull(thumbnail);
+
+    unsigned int width  = 0;
+    unsigned int height = 0;
+    zathura_thumbnail_size(zathura_document_get_page(document, idx), &width, &height);
+    g_assert_cmpuint(MAX(width, height), ==, ZATHURA_THUMBNAIL_SIZE);
+    g_assert_cmpint(cairo_image_surface_get_format(thumbnail), ==, CAIRO_FORMAT_RGB16_565);
+    g_assert_cmpint(cairo_image_surface_get_width(thumbnail), ==, width);
+    g_assert_cmpint(cairo_image_surface_get_height(thumbnail), ==, height);
+    cairo_surface_destroy(thumbnail);
+  }
+  zathura_thumbnail_cache_free(cache);
+
+  g_autofree char* thumbnail_dir = g_build_filename(cache_dir, "thumbnails", NULL);
+  GDir* dir                      = g_dir_open(thumbnail_dir, 0, NULL);
+  g_assert_nonnull(dir);
+  const char* name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    g_autofree char* path = g_build_filename(thumbnail_dir, name, NULL);
+    g_unlink(path);
+  }
+  g_dir_close(dir);
+  g_rmdir(thumbnail_dir);
+  g_rmdir(cache_dir);
+
+  zathura_document_free(document);
+}
+
+int main(int argc, char* argv[]) {
+  girara_set_log_level(GIRARA_ERROR);
+
+  synthetic_fixture_init();
+
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/thumbnail-cache/generate", test_generate);
+  const int ret = g_test_run();
+
+  synthetic_fixture_clear();
+  return ret;
+}
@@ -0,0 +1,336 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <girara/datastructures.h>
+#include <girara/log.h>
+#include <glib/gstdio.h>
+
+#include "batch.h"
+#include "document.h"
+#include "page.h"
+#include "render.h"
+
+#define BATCH_ANNOTATIONS_FILE "annotations.json"
+
+/**
+ * State of a running job
+ */
+typedef struct batch_s {
+  zathura_document_t* document;
+  const zathura_batch_options_t* options;
+  ZathuraRenderer* renderer; /**< Locked while the plugin is called */
+  int digits;                /**< Width of the page numbers in the file names */
+
+  GMutex lock;
+  unsigned int failed;     /**< Number of pages that failed */
+  guint64 characters;      /**< Number of extracted characters */
+  unsigned int highlights; /**< Number of exported highlights */
+  unsigned int notes;      /**< Number of exported notes */
+  JsonNode** annotations;  /**< Annotations of every page of the range */
+} batch_t;
+
+static const char* highlight_colors[] = {
+    [ZATHURA_HIGHLIGHT_YELLOW] = "yellow",
+    [ZATHURA_HIGHLIGHT_GREEN]  = "green",
+    [ZATHURA_HIGHLIGHT_BLUE]   = "blue",
+    [ZATHURA_HIGHLIGHT_RED]    = "red",
+};
+
+bool zathura_batch_parse_jobs(const char* jobs, unsigned int* mask) {
+  if (jobs == NULL || mask == NULL) {
+    return false;
+  }
+
+  *mask               = 0;
+  g_auto(GStrv) names = g_strsplit(jobs, ",", -1);
+  for (char** name = names; *name != NULL; ++name) {
+    g_strstrip(*name);
+    if (g_strcmp0(*name, "render") == 0) {
+      *mask |= ZATHURA_BATCH_RENDER;
+    } else if (g_strcmp0(*name, "text") == 0) {
+      *mask |= ZATHURA_BATCH_TEXT;
+    } else if (g_strcmp0(*name, "annotations") == 0) {
+      *mask |= ZATHURA_BATCH_ANNOTATIONS;
+    } else if (g_strcmp0(*name, "all") == 0) {
+      *mask |= ZATHURA_BATCH_RENDER | ZATHURA_BATCH_TEXT | ZATHURA_BATCH_ANNOTATIONS;
+    } else {
+      return false;
+    }
+  }
+
+  return *mask != 0;
+}
+
+static void batch_text(gpointer data, gpointer user_data) {
+  batch_t* batch             = user_data;
+  const unsigned int page_id = GPOINTER_TO_UINT(data) - 1;
+  zathura_page_t* page       = zathura_document_get_page(batch->document, page_id);
+
+  const zathura_rectangle_t rectangle = {
+      .x1 = 0,
+      .y1 = 0,
+      .x2 = zathura_page_get_width(page),
+      .y2 = zathura_page_get_height(page),
+  };
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  zathura_renderer_lock(batch->renderer);
+  g_autofree char* text = zathura_page_get_text(page, rectangle, &error);
+  zathura_renderer_unlock(batch->renderer);
+
+  bool ret = error == ZATHURA_ERROR_OK;
+  if (ret == true && batch->options->directory != NULL) {
+    g_autofree char* name = g_strdup_printf("page-%0*u.txt", batch->digits, page_id + 1);
+    g_autofree char* path = g_build_filename(batch->options->directory, name, NULL);
+    ret                   = g_file_set_contents(path, text != NULL ? text : "", -1, NULL) == TRUE;
+  }
+
+  g_mutex_lock(&batch->lock);
+  if (ret == true) {
+    batch->characters += text != NULL ? g_utf8_strlen(text, -1) : 0;
+  } else {
+    ++batch->failed;
+  }
+  g_mutex_unlock(&batch->lock);
+}
+
+static void batch_add_highlight(JsonBuilder* builder, zathura_highlight_t* highlight) {
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "page");
+  json_builder_add_int_value(builder, highlight->page + 1);
+  json_builder_set_member_name(builder, "type");
+  json_builder_add_string_value(builder, "highlight");
+  json_builder_set_member_name(builder, "color");
+  json_builder_add_string_value(builder, highlight->color < G_N_ELEMENTS(highlight_colors)
+                                             ? highlight_colors[highlight->color]
+                                             : highlight_colors[ZATHURA_HIGHLIGHT_YELLOW]);
+  json_builder_set_member_name(builder, "text");
+  json_builder_add_string_value(builder, highlight->text != NULL ? highlight->text : "");
+  json_builder_set_member_name(builder, "rects");
+  json_builder_begin_array(builder);
+  for (size_t idx = 0; highlight->rects != NULL && idx != girara_list_size(highlight->rects); ++idx) {
+    zathura_rectangle_t* rect = girara_list_nth(highlight->rects, idx);
+    json_builder_begin_array(builder);
+    json_builder_add_double_value(builder, rect->x1);
+    json_builder_add_double_value(builder, rect->y1);
+    json_builder_add_double_value(builder, rect->x2);
+    json_builder_add_double_value(builder, rect->y2);
+    json_builder_end_array(builder);
+  }
+  json_builder_end_array(builder);
+  json_builder_end_object(builder);
+}
+
+static void batch_add_note(JsonBuilder* builder, zathura_note_t* note) {
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "page");
+  json_builder_add_int_value(builder, note->page + 1);
+  json_builder_set_member_name(builder, "type");
+  json_builder_add_string_value(builder, "note");
+  json_builder_set_member_name(builder, "x");
+  json_builder_add_double_value(builder, note->x);
+  json_builder_set_member_name(builder, "y");
+  json_builder_add_double_value(builder, note->y);
+  json_builder_set_member_name(builder, "content");
+  json_builder_add_string_value(builder, note->content != NULL ? note->content : "");
+  json_builder_end_object(builder);
+}
+
+static void batch_annotations(gpointer data, gpointer user_data) {
+  batch_t* batch             = user_data;
+  const unsigned int page_id = GPOINTER_TO_UINT(data) - 1;
+  zathura_page_t* page       = zathura_document_get_page(batch->document, page_id);
+
+  zathura_error_t highlights_error = ZATHURA_ERROR_OK;
+  zathura_error_t notes_error      = ZATHURA_ERROR_OK;
+  zathura_renderer_lock(batch->renderer);
+  g_autoptr(girara_list_t) highlights = zathura_page_get_annotations(page, &highlights_error);
+  g_autoptr(girara_list_t) notes      = zathura_page_get_notes(page, &notes_error);
+  zathura_renderer_unlock(batch->renderer);
+
+  /* plugins without annotations are not an error */
+  const bool ret = (highlights_error == ZATHURA_ERROR_OK || highlights_error == ZATHURA_ERROR_NOT_IMPLEMENTED) &&
+                   (notes_error == ZATHURA_ERROR_OK || notes_error == ZATHURA_ERROR_NOT_IMPLEMENTED);
+
+  const size_t number_of_highlights = highlights != NULL ? girara_list_size(highlights) : 0;
+  const size_t number_of_notes      = notes != NULL ? girara_list_size(notes) : 0;
+  g_autoptr(JsonBuilder) builder    = json_builder_new();
+  json_builder_begin_array(builder);
+  for (size_t idx = 0; idx != number_of_highlights; ++idx) {
+    batch_add_highlight(builder, girara_list_nth(highlights, idx));
+  }
+  for (size_t idx = 0; idx != number_of_notes; ++idx) {
+    batch_add_note(builder, girara_list_nth(notes, idx));
+  }
+  json_builder_end_array(builder);
+
+  g_mutex_lock(&batch->lock);
+  batch->annotations[page_id - batch->options->first_page] = json_builder_get_root(builder);
+  batch->highlights += number_of_highlights;
+  batch->notes += number_of_notes;
+  if (ret == false) {
+    ++batch->failed;
+  }
+  g_mutex_unlock(&batch->lock);
+}
+
+/* Write the annotations of all pages in page order. */
+static bool batch_write_annotations(batch_t* batch, unsigned int total) {
+  if (batch->options->directory == NULL) {
+    return true;
+  }
+
+  JsonArray* array = json_array_new();
+  for (unsigned int idx = 0; idx < total; ++idx) {
+    if (batch->annotations[idx] == NULL) {
+      continue;
+    }
+
+    JsonArray* page = json_node_get_array(batch->annotations[idx]);
+    for (guint element = 0; element < json_array_get_length(page); ++element) {
+      json_array_add_element(array, json_array_dup_element(page, element));
+    }
+  }
+
+  g_autoptr(JsonNode) root = json_node_new(JSON_NODE_ARRAY);
+  json_node_take_array(root, array);
+
+  g_autoptr(JsonGenerator) generator = json_generator_new();
+  json_generator_set_pretty(generator, TRUE);
+  json_generator_set_root(generator, root);
+
+  g_autofree char* path   = g_build_filename(batch->options->directory, BATCH_ANNOTATIONS_FILE, NULL);
+  g_autoptr(GError) error = NULL;
+  if (json_generator_to_file(generator, path, &error) == FALSE) {
+    girara_error("Failed to write '%s': %s", path, error->message);
+    return false;
+  }
+
+  return true;
+}
+
+/* Process the pages of the range on the worker threads and wait for them. */
+static void batch_run_pages(batch_t* batch, GFunc func, unsigned int threads) {
+  GThreadPool* pool = g_thread_pool_new(func, batch, threads, FALSE, NULL);
+  for (unsigned int page_id = batch->options->first_page; page_id <= batch->options->last_page; ++page_id) {
+    g_thread_pool_push(pool, GUINT_TO_POINTER(page_id + 1), NULL);
+  }
+  g_thread_pool_free(pool, FALSE, TRUE);
+}
+
+static void batch_begin_job(JsonBuilder* builder, const char* name) {
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "job");
+  json_builder_add_string_value(builder, name);
+}
+
+static void batch_end_job(JsonBuilder* builder, unsigned int total, unsigned int failed, gint64 start) {
+  const double seconds = (g_get_monotonic_time() - start) / (double)G_USEC_PER_SEC;
+
+  json_builder_set_member_name(builder, "pages");
+  json_builder_add_int_value(builder, total - failed);
+  json_builder_set_member_name(builder, "failed");
+  json_builder_add_int_value(builder, failed);
+  json_builder_set_member_name(builder, "seconds");
+  json_builder_add_double_value(builder, seconds);
+  json_builder_set_member_name(builder, "pages_per_second");
+  json_builder_add_double_value(builder, seconds > 0 ? (total - failed) / seconds : 0);
+  json_builder_end_object(builder);
+}
+
+JsonNode* zathura_batch_run(zathura_document_t* document, const zathura_batch_options_t* options) {
+  g_return_val_if_fail(document != NULL && options != NULL, NULL);
+  g_return_val_if_fail(options->first_page <= options->last_page, NULL);
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+  g_return_val_if_fail(options->last_page < number_of_pages, NULL);
+
+  const unsigned int total   = options->last_page - options->first_page + 1;
+  const unsigned int threads = MIN(options->threads > 0 ? options->threads : g_get_num_processors(), total);
+  if (options->directory != NULL && g_mkdir_with_parents(options->directory, 0755) != 0) {
+    girara_error("Failed to create '%s': %s", options->directory, g_strerror(errno));
+    return NULL;
+  }
+
+  batch_t batch = {
+      .document = document,
+      .options  = options,
+      .renderer = zathura_renderer_new(1),
+      .digits   = snprintf(NULL, 0, "%u", number_of_pages),
+  };
+  g_mutex_init(&batch.lock);
+
+  g_autoptr(JsonBuilder) builder = json_builder_new();
+  json_builder_begin_object(builder);
+  json_builder_set_member_name(builder, "document");
+  json_builder_add_string_value(builder, zathura_document_get_path(document));
+  json_builder_set_member_name(builder, "number_of_pages");
+  json_builder_add_int_value(builder, number_of_pages);
+  json_builder_set_member_name(builder, "first_page");
+  json_builder_add_int_value(builder, options->first_page + 1);
+  json_builder_set_member_name(builder, "last_page");
+  json_builder_add_int_value(builder, options->last_page + 1);
+  json_builder_set_member_name(builder, "threads");
+  json_builder_add_int_value(builder, threads);
+  json_builder_set_member_name(builder, "jobs");
+  json_builder_begin_array(builder);
+
+  if ((options->jobs & ZATHURA_BATCH_RENDER) != 0) {
+    const zathura_export_options_t export_options = {
+        .first_page = options->first_page,
+        .last_page  = options->last_page,
+        .dpi        = options->dpi,
+        .format     = options->format,
+        .directory  = options->directory,
+        .threads    = threads,
+    };
+
+    batch_begin_job(builder, "render");
+    const gint64 start        = g_get_monotonic_time();
+    zathura_export_t* export  = zathura_export_pages(document, batch.renderer, &export_options, NULL, NULL);
+    const unsigned int failed = export != NULL ? zathura_export_wait(export) : total;
+    zathura_export_free(export);
+    batch_end_job(builder, total, failed, start);
+  }
+
+  if ((options->jobs & ZATHURA_BATCH_TEXT) != 0) {
+    batch_begin_job(builder, "text");
+    const gint64 start = g_get_monotonic_time();
+    batch.failed       = 0;
+    batch_run_pages(&batch, batch_text, threads);
+    json_builder_set_member_name(builder, "characters");
+    json_builder_add_int_value(builder, batch.characters);
+    batch_end_job(builder, total, batch.failed, start);
+  }
+
+  if ((options->jobs & ZATHURA_BATCH_ANNOTATIONS) != 0) {
+    batch_begin_job(builder, "annotations");
+    const gint64 start = g_get_monotonic_time();
+    batch.failed       = 0;
+    batch.annotations  = g_new0(JsonNode*, total);
+    batch_run_pages(&batch, batch_annotations, threads);
+    if (batch_write_annotations(&batch, total) == false) {
+      batch.failed = total;
+    }
+    for (unsigned int idx = 0; idx < total; ++idx) {
+      g_clear_pointer(&batch.annotations[idx], json_node_unref);
+    }
+    g_free(batch.annotations);
+
+    json_builder_set_member_name(builder, "highlights");
+    json_builder_add_int_value(builder, batch.highlights);
+    json_builder_set_member_name(builder, "notes");
+    json_builder_add_int_value(builder, batch.notes);
+    batch_end_job(builder, total, batch.failed, start);
+  }
+
+  json_builder_end_array(builder);
+  json_builder_end_object(builder);
+
+  g_mutex_clear(&batch.lock);
+  g_object_unref(batch.renderer);
+
+  return json_builder_get_root(builder);
+}
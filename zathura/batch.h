@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_BATCH_H
+#define ZATHURA_BATCH_H
+
+#include <stdbool.h>
+#include <json-glib/json-glib.h>
+
+#include "types.h"
+#include "export.h"
+
+/**
+ * Headless batch processing of a document, e.g. to produce page previews,
+ * extracted text and annotations in CI. Every job processes the pages of a
+ * range on a pool of worker threads and is timed, so a batch run doubles as a
+ * throughput benchmark. Calls into the plugin are serialized; writing the
+ * results runs in parallel.
+ */
+
+/**
+ * Jobs of a batch run
+ */
+typedef enum zathura_batch_job_e {
+  ZATHURA_BATCH_RENDER      = 1 << 0, /**< Render the pages to images */
+  ZATHURA_BATCH_TEXT        = 1 << 1, /**< Extract the text of the pages */
+  ZATHURA_BATCH_ANNOTATIONS = 1 << 2, /**< Export the annotations and notes of the pages */
+} zathura_batch_job_t;
+
+/**
+ * Options of a batch run
+ */
+typedef struct zathura_batch_options_s {
+  unsigned int jobs;              /**< Jobs to run, a combination of zathura_batch_job_t */
+  unsigned int first_page;        /**< First page of the range */
+  unsigned int last_page;         /**< Last page of the range */
+  unsigned int threads;           /**< Number of worker threads, 0 for the number of processors */
+  unsigned int dpi;               /**< Resolution of rendered pages */
+  zathura_export_format_t format; /**< Image format of rendered pages */
+  const char* directory;          /**< Directory the results are written to, NULL to discard them */
+} zathura_batch_options_t;
+
+/**
+ * Parse a comma-separated list of jobs: "render", "text", "annotations" or
+ * "all".
+ *
+ * @param jobs The list of jobs
+ * @param mask Set to the combination of the jobs
+ * @return true if all jobs are known
+ */
+bool zathura_batch_parse_jobs(const char* jobs, unsigned int* mask);
+
+/**
+ * Run the jobs on the document, one job after another. Rendered pages are
+ * written as page-N.png or page-N.jpg, text as page-N.txt and annotations to
+ * annotations.json.
+ *
+ * The result is an object with the document, the range and the number of
+ * threads, and "jobs", an array with an object per job holding the number of
+ * processed and failed pages, the elapsed seconds and the pages per second.
+ *
+ * @param document The document
+ * @param options The batch options
+ * @return the timings as JSON object
+ */
+JsonNode* zathura_batch_run(zathura_document_t* document, const zathura_batch_options_t* options);
+
+#endif
@@ -24,6 +24,9 @@
 #include "synctex.h"
 #include "dbus-interface.h"
 #include "database.h"
+#include "file-catalog.h"
+#include "fuzzy.h"
+#include "text-index.h"
 #include "types.h"
 
 gboolean cb_destroy(GtkWidget* UNUSED(widget), zathura_t* zathura) {
@@ -443,7 +446,7 @@ gboolean cb_highlights_key_press(GtkWidget* widget, GdkEventKey* event, void* da
               }
             );
           }
-          gtk_widget_queue_draw(page_widget);  // Trigger redraw with new color
+          zathura_page_widget_update_highlights(ZATHURA_PAGE(page_widget));  // Trigger redraw with new color
         }
       }
 
@@ -462,9 +465,30 @@ gboolean cb_highlights_key_press(GtkWidget* widget, GdkEventKey* event, void* da
   return FALSE;
 }
 
-void cb_highlights_search_changed(GtkEditable* UNUSED(editable), void* data) {
-  GtkTreeModelFilter* filter = GTK_TREE_MODEL_FILTER(data);
+/* Apply the query of a list panel search entry and order the visible rows by
+ * score. The sort model is unsorted while refiltering so that the rows are
+ * inserted cheaply and sorted once afterwards. */
+static void list_panel_refilter(GtkEntry* entry, GtkTreeModelFilter* filter) {
+  zathura_fuzzy_t* matcher = g_object_get_data(G_OBJECT(entry), "matcher");
+  GtkTreeSortable* sort    = g_object_get_data(G_OBJECT(entry), "sort");
+  if (matcher == NULL || sort == NULL) {
+    gtk_tree_model_filter_refilter(filter);
+    return;
+  }
+
+  const bool fuzzy_mode   = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(entry), "fuzzy_mode")) == TRUE;
+  const bool content_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(entry), "content_search_mode")) == TRUE;
+  zathura_fuzzy_set_query(matcher, content_mode == true ? NULL : gtk_entry_get_text(entry), fuzzy_mode == false);
+
+  gtk_tree_sortable_set_sort_column_id(sort, GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, GTK_SORT_ASCENDING);
   gtk_tree_model_filter_refilter(filter);
+  if (zathura_fuzzy_query_is_empty(matcher) == false) {
+    gtk_tree_sortable_set_sort_column_id(sort, GTK_TREE_SORTABLE_DEFAULT_SORT_COLUMN_ID, GTK_SORT_ASCENDING);
+  }
+}
+
+void cb_highlights_search_changed(GtkEditable* editable, void* data) {
+  list_panel_refilter(GTK_ENTRY(editable), GTK_TREE_MODEL_FILTER(data));
 }
 
 gboolean cb_highlights_search_key_press(GtkWidget* widget, GdkEventKey* event, void* data) {
@@ -500,7 +524,7 @@ gboolean cb_highlights_search_key_press(GtkWidget* widget, GdkEventKey* event, v
     }
 
     // Refilter to apply new mode
-    gtk_tree_model_filter_refilter(filter);
+    list_panel_refilter(entry, filter);
 
     return TRUE;  // Consume the event
   }
@@ -614,9 +638,8 @@ gboolean cb_notes_key_press(GtkWidget* widget, GdkEventKey* event, void* data) {
   return FALSE;
 }
 
-void cb_notes_search_changed(GtkEditable* UNUSED(editable), void* data) {
-  GtkTreeModelFilter* filter = GTK_TREE_MODEL_FILTER(data);
-  gtk_tree_model_filter_refilter(filter);
+void cb_notes_search_changed(GtkEditable* editable, void* data) {
+  list_panel_refilter(GTK_ENTRY(editable), GTK_TREE_MODEL_FILTER(data));
 }
 
 gboolean cb_notes_search_key_press(GtkWidget* widget, GdkEventKey* event, void* data) {
@@ -652,7 +675,7 @@ gboolean cb_notes_search_key_press(GtkWidget* widget, GdkEventKey* event, void*
     }
 
     // Refilter to apply new mode
-    gtk_tree_model_filter_refilter(filter);
+    list_panel_refilter(entry, filter);
 
     return TRUE;  // Consume the event
   }
@@ -669,6 +692,9 @@ typedef struct {
   int page_num;  /* Page to navigate to (1-indexed from rga, 0 means no specific page) */
 } file_picker_open_data_t;
 
+/* Maximal number of content search results */
+#define FILE_PICKER_CONTENT_RESULTS 200
+
 /* Structure for content search */
 typedef struct {
   zathura_t* zathura;
@@ -795,118 +821,299 @@ void file_picker_schedule_open_at_page(zathura_t* zathura, const char* file_path
   g_idle_add(file_picker_deferred_open, data);
 }
 
-/* Callback for rga subprocess completion */
-static void file_picker_rga_callback(GObject* source_object, GAsyncResult* res, gpointer user_data) {
-  GSubprocess* proc = G_SUBPROCESS(source_object);
-  file_picker_search_data_t* search_data = user_data;
-  zathura_t* zathura = search_data->zathura;
-  GError* error = NULL;
+/* Add a content search result to the file picker */
+static void file_picker_append_content_result(GtkListStore* store, const char* file_path, int page_num,
+                                              const char* content) {
+  /* Get filename from path */
+  const char* filename = strrchr(file_path, '/');
+  filename = filename ? filename + 1 : file_path;
 
-  char* stdout_buf = NULL;
-  char* stderr_buf = NULL;
+  /* Create display text: filename:page - context */
+  char display[512];
+  snprintf(display, sizeof(display), "%s:%d - %.60s%s",
+           filename, page_num, content,
+           strlen(content) > 60 ? "..." : "");
 
-  g_subprocess_communicate_utf8_finish(proc, res, &stdout_buf, &stderr_buf, &error);
+  GtkTreeIter iter;
+  gtk_list_store_append(store, &iter);
+  gtk_list_store_set(store, &iter,
+      0, file_path,    /* Full path */
+      1, display,      /* Display text */
+      2, page_num,     /* Page number */
+      3, content,      /* Context snippet */
+      -1);
+}
 
-  if (error != NULL) {
-    g_message("FILE_PICKER: rga error: %s", error->message);
-    g_error_free(error);
-    g_free(search_data->query);
-    g_free(search_data);
-    g_free(stdout_buf);
-    g_free(stderr_buf);
-    return;
-  }
+/* Receives the matches of a text index search */
+static void file_picker_text_index_results(GPtrArray* matches, bool UNUSED(finished), void* data) {
+  zathura_t* zathura = data;
 
   /* Check if file picker still exists and we're still in content mode */
-  if (zathura->ui.file_picker == NULL) {
-    g_free(search_data->query);
-    g_free(search_data);
-    g_free(stdout_buf);
-    g_free(stderr_buf);
+  if (zathura->ui.file_picker == NULL || zathura->ui.file_picker_search == NULL) {
     return;
   }
 
   GtkEntry* entry = GTK_ENTRY(zathura->ui.file_picker_search);
   gboolean content_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(entry), "content_search_mode"));
   if (!content_mode) {
-    g_free(search_data->query);
-    g_free(search_data);
-    g_free(stdout_buf);
-    g_free(stderr_buf);
     return;
   }
 
-  /* Clear and populate results */
   GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
-  gtk_list_store_clear(store);
+  const bool was_empty = gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store), NULL) == 0;
+  for (guint idx = 0; idx != matches->len; ++idx) {
+    const zathura_text_index_match_t* match = g_ptr_array_index(matches, idx);
+    file_picker_append_content_result(store, match->file, match->page + 1,
+                                      match->snippet != NULL ? match->snippet : "");
+  }
 
-  if (stdout_buf != NULL && stdout_buf[0] != '\0') {
-    /* Parse rga output: filepath:line_num:Page N: content
-     * The page number is embedded in the content as "Page N:" prefix */
-    char** lines = g_strsplit(stdout_buf, "\n", -1);
-    for (int i = 0; lines[i] != NULL && lines[i][0] != '\0'; i++) {
-      char* line = lines[i];
-
-      /* Find first colon (end of filepath) */
-      char* first_colon = strchr(line, ':');
-      if (first_colon == NULL) continue;
-
-      /* Find second colon (end of line number) */
-      char* second_colon = strchr(first_colon + 1, ':');
-      if (second_colon == NULL) continue;
-
-      /* Extract components */
-      *first_colon = '\0';
-      char* file_path = line;
-      char* content = second_colon + 1;
-
-      /* Extract page number from content "Page N: ..." */
-      int page_num = 1;  /* Default to page 1 */
-      if (strncmp(content, "Page ", 5) == 0) {
-        page_num = atoi(content + 5);
-        /* Skip past "Page N: " to get actual content */
-        char* content_start = strchr(content + 5, ':');
-        if (content_start != NULL) {
-          content = content_start + 1;
-          while (*content == ' ') content++;  /* Skip leading spaces */
-        }
-      }
+  /* Select first row once the first match arrived */
+  if (was_empty == true && matches->len != 0) {
+    GtkWidget* treeview = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "treeview");
+    GtkTreeModel* model = gtk_tree_view_get_model(GTK_TREE_VIEW(treeview));
+    GtkTreeIter first_iter;
+    if (gtk_tree_model_get_iter_first(model, &first_iter)) {
+      GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeview));
+      gtk_tree_selection_select_iter(selection, &first_iter);
+    }
+  }
+}
+
+static bool file_picker_in_content_mode(zathura_t* zathura) {
+  return zathura->ui.file_picker_search != NULL &&
+         GPOINTER_TO_INT(g_object_get_data(G_OBJECT(zathura->ui.file_picker_search), "content_search_mode")) == TRUE;
+}
+
+/* Show how much of the text index is up to date; searches only find those
+ * documents */
+static void file_picker_show_index_progress(zathura_t* zathura) {
+  if (zathura->ui.file_picker_search == NULL) {
+    return;
+  }
+
+  GtkEntry* entry = GTK_ENTRY(zathura->ui.file_picker_search);
+  if (file_picker_in_content_mode(zathura) == false) {
+    gtk_entry_set_progress_fraction(entry, 0);
+    return;
+  }
+
+  unsigned int checked = 0;
+  unsigned int total   = 0;
+  if (zathura->text_index != NULL && zathura_text_index_get_progress(zathura->text_index, &checked, &total) == true) {
+    g_autofree char* text =
+        g_strdup_printf("[Ctrl+T: filename] Search PDF content (indexing %u/%u)...", checked, total);
+    gtk_entry_set_placeholder_text(entry, text);
+    gtk_entry_set_progress_fraction(entry, (double)checked / total);
+  } else {
+    gtk_entry_set_placeholder_text(entry, "[Ctrl+T: filename] Search PDF content...");
+    gtk_entry_set_progress_fraction(entry, 0);
+  }
+}
+
+static void file_picker_text_index_progress(unsigned int UNUSED(checked), unsigned int UNUSED(total), void* data) {
+  file_picker_show_index_progress(data);
+}
+
+/* Bring the text index up to date with the documents of the file picker */
+static void file_picker_update_text_index(zathura_t* zathura) {
+  if (zathura->text_index == NULL) {
+    zathura->text_index = zathura_text_index_new(zathura->database, zathura->plugins.manager);
+    if (zathura->text_index == NULL) {
+      /* no index available; content search falls back to rga */
+      return;
+    }
+    zathura_text_index_set_progress_callback(zathura->text_index, file_picker_text_index_progress, zathura);
+  }
+
+  if (zathura->file_catalog != NULL) {
+    g_autoptr(GPtrArray) files = zathura_file_catalog_get_files(zathura->file_catalog);
+    zathura_text_index_update(zathura->text_index, files);
+  }
+  file_picker_show_index_progress(zathura);
+}
+
+/* State of a running rga search. Output is read line by line and the
+ * results are added to the store once per frame. */
+typedef struct {
+  zathura_t* zathura;
+  GSubprocess* process;
+  GDataInputStream* stream;
+  GCancellable* cancellable;
+  GtkListStore* store;   /* Store the results are added to */
+  GPtrArray* pending;    /* Results not yet added to the store */
+  guint flush_id;        /* Tick callback adding pending results, 0 if none */
+  unsigned int results;  /* Number of results read so far */
+} file_picker_rga_search_t;
+
+/* A parsed line of rga output */
+typedef struct {
+  char* file_path;
+  int page_num;
+  char* content;
+} file_picker_content_result_t;
+
+static void file_picker_content_result_free(void* data) {
+  file_picker_content_result_t* result = data;
+  g_free(result->file_path);
+  g_free(result->content);
+  g_free(result);
+}
+
+static void file_picker_rga_search_clear(void* data) {
+  file_picker_rga_search_t* search = data;
+  g_clear_object(&search->stream);
+  g_clear_object(&search->process);
+  g_clear_object(&search->cancellable);
+  g_clear_object(&search->store);
+  g_ptr_array_unref(search->pending);
+}
+
+static void file_picker_rga_search_release(void* data) {
+  g_rc_box_release_full(data, file_picker_rga_search_clear);
+}
+
+/* Check if the results of the search still belong into the file picker */
+static bool file_picker_rga_search_is_current(file_picker_rga_search_t* search) {
+  zathura_t* zathura = search->zathura;
+  if (g_cancellable_is_cancelled(search->cancellable) == TRUE || zathura->ui.file_picker == NULL) {
+    return false;
+  }
+
+  return g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store") == search->store;
+}
 
-      /* Get filename from path */
-      char* filename = strrchr(file_path, '/');
-      filename = filename ? filename + 1 : file_path;
-
-      /* Create display text: filename:page - context */
-      char display[512];
-      snprintf(display, sizeof(display), "%s:%d - %.60s%s",
-               filename, page_num, content,
-               strlen(content) > 60 ? "..." : "");
-
-      GtkTreeIter iter;
-      gtk_list_store_append(store, &iter);
-      gtk_list_store_set(store, &iter,
-          0, file_path,    /* Full path */
-          1, display,      /* Display text */
-          2, page_num,     /* Page number */
-          3, content,      /* Context snippet */
-          -1);
+/* Parse rga output: filepath:line_num:Page N: content
+ * The page number is embedded in the content as "Page N:" prefix */
+static file_picker_content_result_t* file_picker_parse_rga_line(char* line) {
+  /* Find first colon (end of filepath) */
+  char* first_colon = strchr(line, ':');
+  if (first_colon == NULL) {
+    return NULL;
+  }
+
+  /* Find second colon (end of line number) */
+  char* second_colon = strchr(first_colon + 1, ':');
+  if (second_colon == NULL) {
+    return NULL;
+  }
+
+  /* Extract components */
+  *first_colon = '\0';
+  char* content = second_colon + 1;
+
+  /* Extract page number from content "Page N: ..." */
+  int page_num = 1;  /* Default to page 1 */
+  if (strncmp(content, "Page ", 5) == 0) {
+    page_num = atoi(content + 5);
+    /* Skip past "Page N: " to get actual content */
+    char* content_start = strchr(content + 5, ':');
+    if (content_start != NULL) {
+      content = content_start + 1;
+      while (*content == ' ') content++;  /* Skip leading spaces */
     }
-    g_strfreev(lines);
   }
 
+  file_picker_content_result_t* result = g_new0(file_picker_content_result_t, 1);
+  result->file_path = g_strdup(line);
+  result->page_num = page_num;
+  result->content = g_strdup(content);
+  return result;
+}
+
+/* Tick callback: add the results read since the last frame */
+static gboolean file_picker_rga_flush(GtkWidget* UNUSED(widget), GdkFrameClock* UNUSED(frame_clock), gpointer data) {
+  file_picker_rga_search_t* search = data;
+  search->flush_id = 0;
+
+  if (file_picker_rga_search_is_current(search) == false) {
+    g_ptr_array_set_size(search->pending, 0);
+    return G_SOURCE_REMOVE;
+  }
+
+  const bool was_empty = gtk_tree_model_iter_n_children(GTK_TREE_MODEL(search->store), NULL) == 0;
+  for (guint idx = 0; idx != search->pending->len; ++idx) {
+    const file_picker_content_result_t* result = g_ptr_array_index(search->pending, idx);
+    file_picker_append_content_result(search->store, result->file_path, result->page_num, result->content);
+  }
+  g_ptr_array_set_size(search->pending, 0);
+
   /* Select first row */
-  GtkWidget* treeview = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "treeview");
-  GtkTreeModel* model = gtk_tree_view_get_model(GTK_TREE_VIEW(treeview));
-  GtkTreeIter first_iter;
-  if (gtk_tree_model_get_iter_first(model, &first_iter)) {
-    GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeview));
-    gtk_tree_selection_select_iter(selection, &first_iter);
+  if (was_empty == true) {
+    GtkWidget* treeview = g_object_get_data(G_OBJECT(search->zathura->ui.file_picker), "treeview");
+    GtkTreeModel* model = gtk_tree_view_get_model(GTK_TREE_VIEW(treeview));
+    GtkTreeIter first_iter;
+    if (gtk_tree_model_get_iter_first(model, &first_iter)) {
+      GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeview));
+      gtk_tree_selection_select_iter(selection, &first_iter);
+    }
   }
 
-  g_free(search_data->query);
-  g_free(search_data);
-  g_free(stdout_buf);
-  g_free(stderr_buf);
+  return G_SOURCE_REMOVE;
+}
+
+static void file_picker_rga_schedule_flush(file_picker_rga_search_t* search) {
+  if (search->flush_id != 0) {
+    return;
+  }
+
+  GtkWidget* treeview = g_object_get_data(G_OBJECT(search->zathura->ui.file_picker), "treeview");
+  search->flush_id = gtk_widget_add_tick_callback(treeview, file_picker_rga_flush, g_rc_box_acquire(search),
+                                                  file_picker_rga_search_release);
+}
+
+/* Callback for every line of rga output */
+static void file_picker_rga_read_line(GObject* source_object, GAsyncResult* res, gpointer user_data) {
+  file_picker_rga_search_t* search = user_data;
+  GError* error = NULL;
+
+  g_autofree char* line = g_data_input_stream_read_line_finish(G_DATA_INPUT_STREAM(source_object), res, NULL, &error);
+  if (error != NULL) {
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED) == FALSE) {
+      g_message("FILE_PICKER: rga error: %s", error->message);
+    }
+    g_error_free(error);
+  }
+
+  /* Stop at the end of the output, when the query changed or the picker is gone */
+  if (line == NULL || file_picker_rga_search_is_current(search) == false) {
+    g_subprocess_force_exit(search->process);
+    file_picker_rga_search_release(search);
+    return;
+  }
+
+  g_autofree char* valid_line = g_utf8_make_valid(line, -1);
+  file_picker_content_result_t* result = file_picker_parse_rga_line(valid_line);
+  if (result != NULL) {
+    g_ptr_array_add(search->pending, result);
+    search->results++;
+    file_picker_rga_schedule_flush(search);
+  }
+
+  /* Stop early once enough results were found */
+  if (search->results >= FILE_PICKER_CONTENT_RESULTS) {
+    g_subprocess_force_exit(search->process);
+    file_picker_rga_search_release(search);
+    return;
+  }
+
+  g_data_input_stream_read_line_async(search->stream, G_PRIORITY_DEFAULT, search->cancellable,
+                                      file_picker_rga_read_line, search);
+}
+
+/* Cancel the running content search */
+static void file_picker_cancel_content_search(zathura_t* zathura) {
+  if (zathura->text_index != NULL) {
+    zathura_text_index_cancel_search(zathura->text_index);
+  }
+
+  if (zathura->ui.file_picker_search != NULL) {
+    GObject* entry = G_OBJECT(zathura->ui.file_picker_search);
+    GCancellable* cancellable = g_object_get_data(entry, "content_search_cancellable");
+    if (cancellable != NULL) {
+      g_cancellable_cancel(cancellable);
+      g_object_set_data(entry, "content_search_cancellable", NULL);
+    }
+  }
 }
 
 /* Debounce timer callback for content search */
@@ -924,6 +1131,8 @@ static gboolean file_picker_content_search_timer_cb(gpointer user_data) {
   /* Clear timer ID */
   g_object_set_data(G_OBJECT(zathura->ui.file_picker_search), "content_search_timer", NULL);
 
+  file_picker_cancel_content_search(zathura);
+
   const char* query = search_data->query;
   if (query == NULL || query[0] == '\0') {
     /* Empty query - clear results */
@@ -936,6 +1145,17 @@ static gboolean file_picker_content_search_timer_cb(gpointer user_data) {
     return G_SOURCE_REMOVE;
   }
 
+  /* Search the text index if there is one */
+  if (zathura->text_index != NULL) {
+    GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
+    gtk_list_store_clear(store);
+    zathura_text_index_search(zathura->text_index, query, FILE_PICKER_CONTENT_RESULTS,
+                              file_picker_text_index_results, zathura);
+    g_free(search_data->query);
+    g_free(search_data);
+    return G_SOURCE_REMOVE;
+  }
+
   g_message("FILE_PICKER: Running rga search for '%s'", query);
 
   /* Build search paths */
@@ -947,7 +1167,7 @@ static gboolean file_picker_content_search_timer_cb(gpointer user_data) {
   /* Spawn rga subprocess */
   GError* error = NULL;
   GSubprocess* proc = g_subprocess_new(
-      G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_PIPE,
+      G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_SILENCE,
       &error,
       "rga", "--color=never", "--no-heading", "--line-number",
       "--max-count=50", "--type=pdf", query,
@@ -957,18 +1177,31 @@ static gboolean file_picker_content_search_timer_cb(gpointer user_data) {
   g_free(downloads);
   g_free(documents);
   g_free(projects);
+  g_free(search_data->query);
+  g_free(search_data);
 
   if (error != NULL) {
     g_message("FILE_PICKER: Failed to spawn rga: %s", error->message);
     g_error_free(error);
-    g_free(search_data->query);
-    g_free(search_data);
     return G_SOURCE_REMOVE;
   }
 
-  /* Run async and handle results in callback */
-  g_subprocess_communicate_utf8_async(proc, NULL, NULL, file_picker_rga_callback, search_data);
-  g_object_unref(proc);
+  /* Clear and populate results as the output arrives */
+  GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
+  gtk_list_store_clear(store);
+
+  file_picker_rga_search_t* search = g_rc_box_new0(file_picker_rga_search_t);
+  search->zathura = zathura;
+  search->process = proc;
+  search->stream = g_data_input_stream_new(g_subprocess_get_stdout_pipe(proc));
+  search->cancellable = g_cancellable_new();
+  search->store = g_object_ref(store);
+  search->pending = g_ptr_array_new_with_free_func(file_picker_content_result_free);
+
+  g_object_set_data_full(G_OBJECT(zathura->ui.file_picker_search), "content_search_cancellable",
+                         g_object_ref(search->cancellable), g_object_unref);
+  g_data_input_stream_read_line_async(search->stream, G_PRIORITY_DEFAULT, search->cancellable,
+                                      file_picker_rga_read_line, search);
 
   return G_SOURCE_REMOVE;
 }
@@ -997,6 +1230,123 @@ void file_picker_trigger_content_search(zathura_t* zathura, const char* query) {
   g_object_set_data(G_OBJECT(zathura->ui.file_picker_search), "content_search_timer", GUINT_TO_POINTER(timer_id));
 }
 
+/* Number of rows added to the file picker per main loop iteration */
+#define FILE_PICKER_FILL_BATCH 500
+
+typedef struct file_picker_fill_s {
+  zathura_t* zathura;
+  GtkListStore* store;
+  GPtrArray* files;
+  guint next;
+  guint generation; /**< Catalog generation of files */
+} file_picker_fill_t;
+
+static void file_picker_fill_free(void* data) {
+  file_picker_fill_t* fill = data;
+  if (g_object_get_data(G_OBJECT(fill->store), "fill") == fill) {
+    g_object_set_data(G_OBJECT(fill->store), "fill", NULL);
+  }
+  g_object_unref(fill->store);
+  g_ptr_array_unref(fill->files);
+  g_free(fill);
+}
+
+static void file_picker_store_append(GtkListStore* store, const char* path) {
+  g_autofree char* name = g_path_get_basename(path);
+  gtk_list_store_insert_with_values(store, NULL, -1,
+      0, path,  /* Full path */
+      1, name,  /* Display text (filename in file mode) */
+      2, 0,     /* Page number (0 for filename mode) */
+      3, "",    /* Context (empty for filename mode) */
+      -1);
+}
+
+static gboolean file_picker_fill_cb(void* data) {
+  file_picker_fill_t* fill = data;
+  zathura_t* zathura       = fill->zathura;
+
+  /* stop if the picker was closed or switched to content search */
+  GtkListStore* store =
+      zathura->ui.file_picker != NULL ? g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store") : NULL;
+  if (store != fill->store || file_picker_in_content_mode(zathura) == true) {
+    g_object_set_data(G_OBJECT(fill->store), "fill_source", NULL);
+    return G_SOURCE_REMOVE;
+  }
+
+  /* skip documents that were removed from the catalog since the list was taken */
+  zathura_file_catalog_t* catalog = zathura->file_catalog;
+  const bool changed = zathura_file_catalog_get_generation(catalog) != fill->generation;
+
+  const guint end = MIN(fill->next + FILE_PICKER_FILL_BATCH, fill->files->len);
+  for (; fill->next < end; ++fill->next) {
+    const char* path = g_ptr_array_index(fill->files, fill->next);
+    if (changed == false || zathura_file_catalog_contains(catalog, path) == true) {
+      file_picker_store_append(store, path);
+    }
+  }
+
+  if (fill->next < fill->files->len) {
+    return G_SOURCE_CONTINUE;
+  }
+
+  g_object_set_data(G_OBJECT(store), "fill_source", NULL);
+  return G_SOURCE_REMOVE;
+}
+
+static int compare_fill_path(const void* lhs, const void* rhs) {
+  return g_strcmp0(lhs, *(char* const*)rhs);
+}
+
+static bool file_picker_fill_pending(file_picker_fill_t* fill, const char* path) {
+  if (fill->next >= fill->files->len) {
+    return false;
+  }
+
+  char** remaining = (char**)fill->files->pdata + fill->next;
+  return bsearch(path, remaining, fill->files->len - fill->next, sizeof(char*), compare_fill_path) != NULL;
+}
+
+static void cb_file_picker_catalog_changed(zathura_file_catalog_t* UNUSED(catalog), girara_list_t* added,
+                                           girara_list_t* removed, void* data) {
+  zathura_t* zathura = data;
+  if (zathura->ui.file_picker == NULL || file_picker_in_content_mode(zathura) == true) {
+    return;
+  }
+
+  GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
+  if (store == NULL) {
+    return;
+  }
+
+  if (girara_list_size(removed) != 0) {
+    g_autoptr(GHashTable) paths = g_hash_table_new(g_str_hash, g_str_equal);
+    for (size_t idx = 0; idx != girara_list_size(removed); ++idx) {
+      g_hash_table_add(paths, girara_list_nth(removed, idx));
+    }
+
+    GtkTreeIter iter;
+    gboolean valid = gtk_tree_model_get_iter_first(GTK_TREE_MODEL(store), &iter);
+    while (valid == TRUE) {
+      g_autofree char* path = NULL;
+      gtk_tree_model_get(GTK_TREE_MODEL(store), &iter, 0, &path, -1);
+      if (g_hash_table_contains(paths, path) == TRUE) {
+        valid = gtk_list_store_remove(store, &iter);
+      } else {
+        valid = gtk_tree_model_iter_next(GTK_TREE_MODEL(store), &iter);
+      }
+    }
+  }
+
+  /* documents still waiting in a running fill are added by it */
+  file_picker_fill_t* fill = g_object_get_data(G_OBJECT(store), "fill");
+  for (size_t idx = 0; idx != girara_list_size(added); ++idx) {
+    const char* path = girara_list_nth(added, idx);
+    if (fill == NULL || file_picker_fill_pending(fill, path) == false) {
+      file_picker_store_append(store, path);
+    }
+  }
+}
+
 /* Refresh file list (when switching from content to filename mode) */
 void file_picker_refresh_file_list(zathura_t* zathura) {
   if (zathura->ui.file_picker == NULL) {
@@ -1008,24 +1358,60 @@ void file_picker_refresh_file_list(zathura_t* zathura) {
     return;
   }
 
+  /* stop filling the store from a previous refresh */
+  const guint fill_source = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(store), "fill_source"));
+  if (fill_source != 0) {
+    g_source_remove(fill_source);
+    g_object_set_data(G_OBJECT(store), "fill_source", NULL);
+  }
   gtk_list_store_clear(store);
 
-  /* Scan default directories */
-  const char* home = g_get_home_dir();
-  char* downloads = g_build_filename(home, "Downloads", NULL);
-  char* documents = g_build_filename(home, "Documents", NULL);
-  char* projects = g_build_filename(home, "projects", NULL);
+  /* forget the names of the previous list */
+  zathura_fuzzy_t* matcher = g_object_get_data(G_OBJECT(zathura->ui.file_picker_search), "matcher");
+  if (matcher != NULL) {
+    zathura_fuzzy_clear(matcher);
+  }
+
+  if (zathura->file_catalog == NULL) {
+    /* Index the default directories */
+    const char* home           = g_get_home_dir();
+    g_autofree char* downloads = g_build_filename(home, "Downloads", NULL);
+    g_autofree char* documents = g_build_filename(home, "Documents", NULL);
+    g_autofree char* projects  = g_build_filename(home, "projects", NULL);
+    const char* const roots[]  = {downloads, documents, projects, "/tmp", NULL};
+    zathura->file_catalog      = zathura_file_catalog_new(zathura->database, roots);
+    zathura_file_catalog_set_callback(zathura->file_catalog, cb_file_picker_catalog_changed, zathura);
+
+    /* page counts of documents opened before */
+    if (zathura->catalog_pages != NULL) {
+      GHashTableIter iter;
+      gpointer path  = NULL;
+      gpointer pages = NULL;
+      g_hash_table_iter_init(&iter, zathura->catalog_pages);
+      while (g_hash_table_iter_next(&iter, &path, &pages) == TRUE) {
+        zathura_file_catalog_set_pages(zathura->file_catalog, path, GPOINTER_TO_UINT(pages));
+      }
+      g_clear_pointer(&zathura->catalog_pages, g_hash_table_unref);
+    }
+  }
 
-  /* These functions are in shortcuts.c - we need forward declarations */
-  extern void file_picker_scan_directory(const char* path, GtkListStore* store, int depth);
-  file_picker_scan_directory(downloads, store, 0);
-  file_picker_scan_directory(documents, store, 0);
-  file_picker_scan_directory(projects, store, 0);
-  file_picker_scan_directory("/tmp", store, 0);
+  /* Show the known documents right away; the rows are added in batches to
+   * keep the UI responsive for large catalogs */
+  file_picker_fill_t* fill = g_new0(file_picker_fill_t, 1);
+  fill->zathura            = zathura;
+  fill->store              = g_object_ref(store);
+  fill->files              = zathura_file_catalog_get_files(zathura->file_catalog);
+  fill->generation         = zathura_file_catalog_get_generation(zathura->file_catalog);
+  if (file_picker_fill_cb(fill) == G_SOURCE_CONTINUE) {
+    const guint source = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, file_picker_fill_cb, fill, file_picker_fill_free);
+    g_object_set_data(G_OBJECT(store), "fill_source", GUINT_TO_POINTER(source));
+    g_object_set_data(G_OBJECT(store), "fill", fill);
+  } else {
+    file_picker_fill_free(fill);
+  }
 
-  g_free(downloads);
-  g_free(documents);
-  g_free(projects);
+  /* pick up documents that were added, changed or removed in the meantime */
+  zathura_file_catalog_update(zathura->file_catalog);
 
   /* Select first row */
   GtkWidget* treeview = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "treeview");
@@ -1039,7 +1425,7 @@ void file_picker_refresh_file_list(zathura_t* zathura) {
   /* Refilter with current search text */
   GtkTreeModelFilter* filter = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "filter");
   if (filter != NULL) {
-    gtk_tree_model_filter_refilter(filter);
+    list_panel_refilter(GTK_ENTRY(zathura->ui.file_picker_search), filter);
   }
 }
 
@@ -1127,8 +1513,7 @@ void cb_file_picker_search_changed(GtkEditable* editable, void* data) {
     }
   } else {
     /* In filename mode, refilter the existing list */
-    GtkTreeModelFilter* filter = GTK_TREE_MODEL_FILTER(data);
-    gtk_tree_model_filter_refilter(filter);
+    list_panel_refilter(entry, GTK_TREE_MODEL_FILTER(data));
   }
 }
 
@@ -1160,11 +1545,19 @@ gboolean cb_file_picker_search_key_press(GtkWidget* widget, GdkEventKey* event,
 
     if (content_mode) {
       gtk_entry_set_placeholder_text(entry, "[Ctrl+T: filename] Search PDF content...");
-      /* Clear file list - will be populated by rga results */
+      /* Index new and changed documents in the background; the progress is
+       * shown in the entry */
+      file_picker_update_text_index(zathura);
+      /* Clear file list - will be populated by the search results */
       GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
       if (store != NULL) {
         gtk_list_store_clear(store);
       }
+      /* Show the results unfiltered in the order they arrive */
+      GtkTreeModelFilter* filter = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "filter");
+      if (filter != NULL) {
+        list_panel_refilter(entry, filter);
+      }
       /* Trigger search if there's existing text */
       const char* text = gtk_entry_get_text(entry);
       if (text != NULL && text[0] != '\0') {
@@ -1177,6 +1570,8 @@ gboolean cb_file_picker_search_key_press(GtkWidget* widget, GdkEventKey* event,
       } else {
         gtk_entry_set_placeholder_text(entry, "Search files [Tab: fuzzy] [Ctrl+T: content]...");
       }
+      file_picker_cancel_content_search(zathura);
+      file_picker_show_index_progress(zathura);
       /* Refresh file list */
       file_picker_refresh_file_list(zathura);
     }
@@ -1203,7 +1598,7 @@ gboolean cb_file_picker_search_key_press(GtkWidget* widget, GdkEventKey* event,
     GtkTreeModelFilter* filter = g_object_get_data(
         G_OBJECT(zathura->ui.file_picker), "filter");
     if (filter != NULL) {
-      gtk_tree_model_filter_refilter(filter);
+      list_panel_refilter(entry, filter);
     }
     return TRUE;
   }
@@ -1479,15 +1874,25 @@ bool cb_unknown_command(girara_session_t* session, const char* input) {
   }
 
   /* check for number */
+  bool is_number    = true;
   const size_t size = strlen(input);
   for (size_t i = 0; i < size; i++) {
     if (g_ascii_isdigit(input[i]) == FALSE) {
-      return false;
+      is_number = false;
+      break;
     }
   }
 
+  /* otherwise check for a page label, e.g. roman numbers in the front matter */
+  unsigned int page_id = 0;
+  if (is_number == true) {
+    page_id = atoi(input) - 1;
+  } else if (zathura_document_find_page_label(zathura_get_document(zathura), input, &page_id) == false) {
+    return false;
+  }
+
   zathura_jumplist_add(zathura);
-  page_set(zathura, atoi(input) - 1);
+  page_set(zathura, page_id);
   zathura_jumplist_add(zathura);
 
   return true;
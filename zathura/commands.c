@@ -12,6 +12,8 @@
 #include "database.h"
 #include "dbus-interface.h"
 #include "document.h"
+#include "export.h"
+#include "girara-compat.h"
 #include "internal.h"
 #include "page-widget.h"
 #include "page.h"
@@ -641,6 +643,68 @@ bool cmd_annot_export(girara_session_t* session, girara_list_t* argument_list) {
   return true;
 }
 
+static void append_annotation_snippet(GString* string, const char* snippet) {
+  /* matched terms alternate with the surrounding text */
+  g_auto(GStrv) parts = g_strsplit_set(snippet, ZATHURA_ANNOTATION_MATCH_BEGIN ZATHURA_ANNOTATION_MATCH_END, -1);
+  for (size_t idx = 0; parts[idx] != NULL; ++idx) {
+    g_autofree char* escaped = g_markup_escape_text(parts[idx], -1);
+    if (idx % 2 == 1) {
+      g_string_append_printf(string, "<b>%s</b>", escaped);
+    } else {
+      g_string_append(string, escaped);
+    }
+  }
+}
+
+bool cmd_annot_search(girara_session_t* session, girara_list_t* argument_list) {
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(session->global.data != NULL, false);
+  zathura_t* zathura = session->global.data;
+
+  static const int max_results = 10;
+
+  if (girara_list_size(argument_list) == 0) {
+    girara_notify(session, GIRARA_ERROR, _("Invalid number of arguments given."));
+    return false;
+  }
+
+  g_autoptr(GString) query = g_string_new(NULL);
+  for (size_t idx = 0; idx != girara_list_size(argument_list); ++idx) {
+    if (idx > 0) {
+      g_string_append_c(query, ' ');
+    }
+    g_string_append(query, girara_list_nth(argument_list, idx));
+  }
+
+  g_autoptr(girara_list_t) results = zathura_db_search_annotations(zathura->database, query->str, max_results);
+  if (results == NULL) {
+    girara_notify(session, GIRARA_ERROR, _("Annotation search is not available."));
+    return false;
+  }
+
+  if (girara_list_size(results) == 0) {
+    girara_notify(session, GIRARA_INFO, _("No annotations found."));
+    return true;
+  }
+
+  g_autoptr(GString) string = g_string_new(NULL);
+  for (size_t idx = 0; idx != girara_list_size(results); ++idx) {
+    const zathura_annotation_match_t* match = girara_list_nth(results, idx);
+    g_autofree char* basename               = g_path_get_basename(match->file);
+    g_autofree char* escaped                = g_markup_escape_text(basename, -1);
+
+    g_string_append_printf(string, _("%s, page %u (%s): "), escaped, match->page + 1,
+                           match->kind == ZATHURA_ANNOTATION_NOTE ? _("note") : _("highlight"));
+    append_annotation_snippet(string, match->snippet != NULL ? match->snippet : "");
+    g_string_append_c(string, '\n');
+  }
+
+  g_string_set_size(string, string->len - 1);
+  girara_notify(session, GIRARA_INFO, "%s", string->str);
+
+  return true;
+}
+
 bool cmd_readwise_sync(girara_session_t* session, girara_list_t* GIRARA_UNUSED(argument_list)) {
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(session->global.data != NULL, false);
@@ -1061,6 +1125,83 @@ bool cmd_search(girara_session_t* session, const char* input, girara_argument_t*
   return true;
 }
 
+#ifndef WITH_SANDBOX
+static void cb_export_pages_progress(zathura_export_t* export, unsigned int exported, unsigned int failed,
+                                     unsigned int total, void* data) {
+  zathura_t* zathura        = data;
+  girara_session_t* session = zathura->ui.session;
+
+  if (exported + failed < total) {
+    g_autofree char* text = g_strdup_printf(_("Exporting pages: %u/%u ..."), exported + failed, total);
+    girara_statusbar_item_set_text(session, zathura->ui.statusbar.file, text);
+    return;
+  }
+
+  g_autofree char* file_path = get_formatted_filename(zathura, true);
+  girara_statusbar_item_set_text(session, zathura->ui.statusbar.file, file_path);
+
+  if (failed == 0) {
+    girara_notify(session, GIRARA_INFO, _("Exported %u pages."), exported);
+  } else {
+    girara_notify(session, GIRARA_ERROR, _("Couldn't export %u of %u pages."), failed, total);
+  }
+
+  zathura->export.pages = NULL;
+  zathura_export_free(export);
+}
+
+/* :export pages <directory> [range] */
+static bool export_pages(zathura_t* zathura, girara_list_t* argument_list) {
+  girara_session_t* session    = zathura->ui.session;
+  zathura_document_t* document = zathura_get_document(zathura);
+
+  const size_t number_of_arguments = girara_list_size(argument_list);
+  if (number_of_arguments != 2 && number_of_arguments != 3) {
+    girara_notify(session, GIRARA_ERROR, _("Invalid number of arguments given."));
+    return false;
+  }
+
+  if (zathura->export.pages != NULL) {
+    girara_notify(session, GIRARA_ERROR, _("Pages are already being exported."));
+    return false;
+  }
+
+  g_autofree char* directory = girara_fix_path(girara_list_nth(argument_list, 1));
+  if (directory == NULL) {
+    return false;
+  }
+
+  const char* range                = number_of_arguments == 3 ? girara_list_nth(argument_list, 2) : "all";
+  zathura_export_options_t options = {0};
+  if (zathura_export_parse_range(range, zathura_document_get_number_of_pages(document), &options.first_page,
+                                 &options.last_page) == false) {
+    girara_notify(session, GIRARA_ERROR, _("Invalid page range '%s'."), range);
+    return false;
+  }
+
+  int dpi                 = 0;
+  g_autofree char* format = NULL;
+  girara_setting_get(session, "export-dpi", &dpi);
+  girara_setting_get(session, "export-format", &format);
+  girara_setting_get(session, "export-recolor", &options.recolor);
+  if (dpi <= 0 || zathura_export_parse_format(format, &options.format) == false) {
+    girara_notify(session, GIRARA_ERROR, _("Invalid export-dpi or export-format."));
+    return false;
+  }
+  options.dpi       = dpi;
+  options.directory = directory;
+
+  zathura->export.pages =
+      zathura_export_pages(document, zathura->sync.render_thread, &options, cb_export_pages_progress, zathura);
+  if (zathura->export.pages == NULL) {
+    girara_notify(session, GIRARA_ERROR, _("Couldn't create '%s'."), directory);
+    return false;
+  }
+
+  return true;
+}
+#endif
+
 bool cmd_export(girara_session_t* session, girara_list_t* argument_list) {
   g_return_val_if_fail(session != NULL && argument_list != NULL, false);
   g_return_val_if_fail(session->global.data != NULL, false);
@@ -1076,6 +1217,10 @@ bool cmd_export(girara_session_t* session, girara_list_t* argument_list) {
     return false;
   }
 
+  if (girara_list_size(argument_list) > 0 && g_strcmp0(girara_list_nth(argument_list, 0), "pages") == 0) {
+    return export_pages(zathura, argument_list);
+  }
+
   if (girara_list_size(argument_list) != 2) {
     girara_notify(session, GIRARA_ERROR, _("Invalid number of arguments given."));
     return false;
@@ -114,6 +114,15 @@ bool cmd_annot_import(girara_session_t* session, girara_list_t* argument_list);
  */
 bool cmd_annot_export(girara_session_t* session, girara_list_t* argument_list);
 
+/**
+ * Search highlights and notes of all documents
+ *
+ * @param session The used girara session
+ * @param argument_list List of passed arguments
+ * @return true if no error occurred
+ */
+bool cmd_annot_search(girara_session_t* session, girara_list_t* argument_list);
+
 /**
  * Sync highlights to Readwise API
  *
@@ -13,10 +13,13 @@
 #include "utils.h"
 #include "page.h"
 #include "database.h"
+#include "dir-cache.h"
+#include "plugin.h"
 
 #include <girara/session.h>
 #include <girara/settings.h>
 #include <girara/completion.h>
+#include <girara/shortcuts.h>
 #include <girara/utils.h>
 
 #include "girara-compat.h"
@@ -31,6 +34,31 @@ static int compare_case_insensitive(const void* data1, const void* data2) {
   return g_utf8_collate(ustr1, ustr2);
 }
 
+static void cb_directory_listed(zathura_dir_cache_t* UNUSED(cache), const char* path, void* data) {
+  zathura_t* zathura        = data;
+  girara_session_t* session = zathura->ui.session;
+  GObject* entry            = G_OBJECT(session->gtk.inputbar_entry);
+
+  const char* completed = g_object_get_data(entry, "completion-directory");
+  if (g_strcmp0(completed, path) != 0) {
+    return;
+  }
+
+  const bool same_input =
+      g_strcmp0(g_object_get_data(entry, "completion-input"), gtk_entry_get_text(GTK_ENTRY(entry))) == 0;
+  if (same_input == false || gtk_widget_get_visible(GTK_WIDGET(session->gtk.inputbar)) == FALSE) {
+    g_object_set_data(entry, "completion-directory", NULL);
+    g_object_set_data(entry, "completion-input", NULL);
+    return;
+  }
+
+  /* complete again now that the listing is available or changed */
+  girara_argument_t arg = {.n = GIRARA_HIDE, .data = NULL};
+  girara_isc_completion(session, &arg, NULL, 0);
+  arg.n = GIRARA_NEXT;
+  girara_isc_completion(session, &arg, NULL, 0);
+}
+
 static girara_list_t* list_files(zathura_t* zathura, const char* current_path, const char* current_file,
                                  size_t current_file_length, bool is_dir, bool check_file_ext) {
   if (zathura == NULL || zathura->ui.session == NULL || current_path == NULL) {
@@ -39,28 +67,35 @@ static girara_list_t* list_files(zathura_t* zathura, const char* current_path, c
 
   girara_debug("checking files in %s", current_path);
 
-  /* read directory */
-  g_autoptr(GDir) dir = g_dir_open(current_path, 0, NULL);
-  if (dir == NULL) {
-    return NULL;
+  if (zathura->completion.directories == NULL) {
+    zathura->completion.directories = zathura_dir_cache_new();
+    zathura_dir_cache_set_callback(zathura->completion.directories, cb_directory_listed, zathura);
   }
 
   girara_list_t* res = girara_sorted_list_new_with_free(compare_case_insensitive, g_free);
 
+  /* read directory; if it has not been read yet or is rescanned, the
+   * completion is shown again once the listing is available or changed */
+  GObject* inputbar_entry = G_OBJECT(zathura->ui.session->gtk.inputbar_entry);
+  g_object_set_data_full(inputbar_entry, "completion-directory", g_canonicalize_filename(current_path, NULL), g_free);
+  g_object_set_data_full(inputbar_entry, "completion-input", g_strdup(gtk_entry_get_text(GTK_ENTRY(inputbar_entry))),
+                         g_free);
+  g_autoptr(GPtrArray) entries = zathura_dir_cache_get(zathura->completion.directories, current_path);
+  if (entries == NULL) {
+    return res;
+  }
+
   bool show_hidden = false;
   girara_setting_get(zathura->ui.session, "show-hidden", &show_hidden);
   bool show_directories = true;
   girara_setting_get(zathura->ui.session, "show-directories", &show_directories);
 
   /* read files */
-  const char* name = NULL;
-  while ((name = g_dir_read_name(dir)) != NULL) {
-    g_autofree char* e_name = g_filename_display_name(name);
-    if (e_name == NULL) {
-      goto error_free;
-    }
-
-    size_t e_length = strlen(e_name);
+  bool last_is_dir = false;
+  for (guint idx = 0; idx != entries->len; ++idx) {
+    const zathura_dir_entry_t* entry = g_ptr_array_index(entries, idx);
+    const char* e_name               = entry->name;
+    size_t e_length                  = strlen(e_name);
 
     if (show_hidden == false && e_name[0] == '.') {
       continue;
@@ -77,38 +112,60 @@ static girara_list_t* list_files(zathura_t* zathura, const char* current_path, c
 
     g_autofree char* full_path = g_strdup_printf("%s%s%s", current_path, tmp, e_name);
 
-    if (g_file_test(full_path, G_FILE_TEST_IS_DIR) == true) {
+    if (entry->is_dir == true) {
       if (show_directories == false) {
         girara_debug("ignoring %s (directory)", full_path);
         continue;
       }
       girara_debug("adding %s (directory)", full_path);
       girara_list_append(res, full_path);
-      full_path = NULL;
-    } else if (check_file_ext == false || file_valid_extension(zathura, full_path) == true) {
+      full_path   = NULL;
+      last_is_dir = true;
+    } else if (check_file_ext == false ||
+               (entry->content_type != NULL && zathura->plugins.manager != NULL &&
+                zathura_plugin_manager_get_plugin(zathura->plugins.manager, entry->content_type) != NULL)) {
       girara_debug("adding %s (file)", full_path);
       girara_list_append(res, full_path);
-      full_path = NULL;
+      full_path   = NULL;
+      last_is_dir = false;
     } else {
       girara_debug("ignoring %s (file)", full_path);
     }
   }
 
-  if (girara_list_size(res) == 1) {
+  if (girara_list_size(res) == 1 && last_is_dir == true) {
     char* path = girara_list_nth(res, 0);
-    if (g_file_test(path, G_FILE_TEST_IS_DIR) == true) {
-      girara_debug("changing to directory %s", path);
-      char* newpath = g_strdup_printf("%s/", path);
-      girara_list_clear(res);
-      girara_list_append(res, newpath);
-    }
+    girara_debug("changing to directory %s", path);
+    char* newpath = g_strdup_printf("%s/", path);
+    girara_list_clear(res);
+    girara_list_append(res, newpath);
   }
 
   return res;
+}
 
-error_free:
-  girara_list_free(res);
-  return NULL;
+/* Recent files starting with basepath. The history is read from the database
+ * once and kept until a document's file info is saved. */
+static girara_list_t* list_recent_files(zathura_t* zathura, int max, const char* basepath) {
+  if (zathura->completion.recent_files == NULL) {
+    zathura->completion.recent_files = zathura_db_get_recent_files(zathura->database, -1, NULL);
+    if (zathura->completion.recent_files == NULL) {
+      return NULL;
+    }
+  }
+
+  /* case-insensitive for ASCII like the LIKE pattern the database used */
+  const size_t basepath_length = strlen(basepath);
+  girara_list_t* res           = girara_list_new();
+  for (size_t idx = 0; idx != girara_list_size(zathura->completion.recent_files) && (int)girara_list_size(res) < max;
+       ++idx) {
+    char* file = girara_list_nth(zathura->completion.recent_files, idx);
+    if (g_ascii_strncasecmp(file, basepath, basepath_length) == 0) {
+      girara_list_append(res, file);
+    }
+  }
+
+  return res;
 }
 
 static void group_add_element(void* data, void* userdata) {
@@ -184,7 +241,7 @@ static girara_completion_t* list_files_for_cc(zathura_t* zathura, const char* in
   }
 
   if (show_recent > 0) {
-    g_autoptr(girara_list_t) recent_files = zathura_db_get_recent_files(zathura->database, show_recent, path);
+    g_autoptr(girara_list_t) recent_files = list_recent_files(zathura, show_recent, path);
     if (recent_files == NULL) {
       goto error_free;
     }
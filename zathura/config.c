@@ -10,6 +10,8 @@
 #include "marks.h"
 #include "utils.h"
 #include "types.h"
+#include "document.h"
+#include "page-widget.h"
 
 #include <girara/settings.h>
 #include <girara/session.h>
@@ -87,6 +89,14 @@ static void cb_color_change(girara_session_t* session, const char* name, girara_
     parse_color(&zathura->ui.colors.signature_error, string_value);
   }
 
+  /* the retained overlay layers were drawn with the old colors */
+  if (zathura->document != NULL && zathura->pages != NULL) {
+    const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+    for (unsigned int page_id = 0; page_id < number_of_pages; ++page_id) {
+      zathura_page_widget_update_highlights(ZATHURA_PAGE(zathura->pages[page_id]));
+    }
+  }
+
   render_all(zathura);
 }
 
@@ -249,6 +259,7 @@ void config_load_default(zathura_t* zathura) {
   zathura->modes.insert       = girara_mode_add(gsession, "insert");
   zathura->modes.presentation = girara_mode_add(gsession, "presentation");
   zathura->modes.highlights   = girara_mode_add(gsession, "highlights");
+  zathura->modes.overview     = girara_mode_add(gsession, "overview");
 
 #define NORMAL zathura->modes.normal
 #define INSERT zathura->modes.insert
@@ -256,9 +267,10 @@ void config_load_default(zathura_t* zathura) {
 #define FULLSCREEN zathura->modes.fullscreen
 #define PRESENTATION zathura->modes.presentation
 #define HIGHLIGHTS zathura->modes.highlights
+#define OVERVIEW zathura->modes.overview
 
   const girara_mode_t all_modes[] = {
-      NORMAL, INSERT, INDEX, FULLSCREEN, PRESENTATION, HIGHLIGHTS,
+      NORMAL, INSERT, INDEX, FULLSCREEN, PRESENTATION, HIGHLIGHTS, OVERVIEW,
   };
 
   /* Set default mode */
@@ -294,6 +306,15 @@ void config_load_default(zathura_t* zathura) {
   girara_setting_add(gsession, "page-cache-size",       &int_value,   INT,    true,  _("Maximum number of pages to keep in the cache"), NULL, NULL);
   int_value = ZATHURA_PAGE_THUMBNAIL_DEFAULT_SIZE;
   girara_setting_add(gsession, "page-thumbnail-size",   &int_value,   INT,    true,  _("Maximum size in pixels of thumbnails to keep in the cache"), NULL, NULL);
+  bool_value = true;
+  girara_setting_add(gsession, "thumbnail-cache",       &bool_value,  BOOLEAN, true, _("Store the thumbnails of the overview in the cache directory"), NULL, NULL);
+  bool_value = true;
+  girara_setting_add(gsession, "snapshot-cache",        &bool_value,  BOOLEAN, false, _("Show the visible pages of the last session while a document is rendered"), NULL, NULL);
+  int_value = 150;
+  girara_setting_add(gsession, "export-dpi",            &int_value,   INT,    false, _("Resolution of exported pages"), NULL, NULL);
+  girara_setting_add(gsession, "export-format",         "png",        STRING, false, _("Image format of exported pages"), NULL, NULL);
+  bool_value = false;
+  girara_setting_add(gsession, "export-recolor",        &bool_value,  BOOLEAN, false, _("Recolor exported pages"), NULL, NULL);
   int_value = 2000;
   girara_setting_add(gsession, "jumplist-size",         &int_value,   INT,    false, _("Number of positions to remember in the jumplist"), cb_jumplist_change, NULL);
 
@@ -499,6 +520,7 @@ void config_load_default(zathura_t* zathura) {
   girara_shortcut_add(gsession, 0, GDK_KEY_P, NULL, sc_snap_to_page, (mode), 0, NULL);                                 \
                                                                                                                        \
   girara_shortcut_add(gsession, 0, GDK_KEY_Tab, NULL, sc_toggle_index, (mode), 0, NULL);                               \
+  girara_shortcut_add(gsession, 0, GDK_KEY_ISO_Left_Tab, NULL, sc_toggle_overview, (mode), 0, NULL);                   \
   girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_n, NULL, girara_sc_toggle_statusbar, (mode), 0, NULL);       \
   girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_m, NULL, girara_sc_toggle_inputbar, (mode), 0, NULL);        \
   girara_shortcut_add(gsession, 0, GDK_KEY_d, NULL, sc_toggle_page_mode, (mode), 0, NULL);                             \
@@ -613,6 +635,36 @@ void config_load_default(zathura_t* zathura) {
   girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_bracketleft, NULL, sc_toggle_index,        INDEX,        0,                  NULL);
   girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_c,           NULL, sc_toggle_index,        INDEX,        0,                  NULL);
 
+  /* Overview mode */
+  girara_shortcut_add(gsession, 0,                GDK_KEY_ISO_Left_Tab, NULL, sc_toggle_overview,   OVERVIEW, 0,         NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_h,            NULL, sc_navigate_overview, OVERVIEW, LEFT,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_j,            NULL, sc_navigate_overview, OVERVIEW, DOWN,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_k,            NULL, sc_navigate_overview, OVERVIEW, UP,        NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_l,            NULL, sc_navigate_overview, OVERVIEW, RIGHT,     NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Left,         NULL, sc_navigate_overview, OVERVIEW, LEFT,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_KP_Left,      NULL, sc_navigate_overview, OVERVIEW, LEFT,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Down,         NULL, sc_navigate_overview, OVERVIEW, DOWN,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_KP_Down,      NULL, sc_navigate_overview, OVERVIEW, DOWN,      NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Up,           NULL, sc_navigate_overview, OVERVIEW, UP,        NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_KP_Up,        NULL, sc_navigate_overview, OVERVIEW, UP,        NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Right,        NULL, sc_navigate_overview, OVERVIEW, RIGHT,     NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_KP_Right,     NULL, sc_navigate_overview, OVERVIEW, RIGHT,     NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_d,            NULL, sc_navigate_overview, OVERVIEW, HALF_DOWN, NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_u,            NULL, sc_navigate_overview, OVERVIEW, HALF_UP,   NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_f,            NULL, sc_navigate_overview, OVERVIEW, FULL_DOWN, NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_b,            NULL, sc_navigate_overview, OVERVIEW, FULL_UP,   NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Page_Down,    NULL, sc_navigate_overview, OVERVIEW, FULL_DOWN, NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Page_Up,      NULL, sc_navigate_overview, OVERVIEW, FULL_UP,   NULL);
+  girara_shortcut_add(gsession, 0,                0,                    "gg", sc_navigate_overview, OVERVIEW, TOP,       NULL);
+  girara_shortcut_add(gsession, 0,                0,                    "G",  sc_navigate_overview, OVERVIEW, BOTTOM,    NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_space,        NULL, sc_navigate_overview, OVERVIEW, SELECT,    NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Return,       NULL, sc_navigate_overview, OVERVIEW, SELECT,    NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_KP_Enter,     NULL, sc_navigate_overview, OVERVIEW, SELECT,    NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_q,            NULL, sc_quit,              OVERVIEW, 0,         NULL);
+  girara_shortcut_add(gsession, 0,                GDK_KEY_Escape,       NULL, sc_toggle_overview,   OVERVIEW, 0,         NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_bracketleft,  NULL, sc_toggle_overview,   OVERVIEW, 0,         NULL);
+  girara_shortcut_add(gsession, GDK_CONTROL_MASK, GDK_KEY_c,            NULL, sc_toggle_overview,   OVERVIEW, 0,         NULL);
+
   /* Presentation mode */
   girara_shortcut_add(gsession, 0,              GDK_KEY_J,            NULL, sc_navigate,            PRESENTATION, NEXT,         NULL);
   girara_shortcut_add(gsession, 0,              GDK_KEY_Down,         NULL, sc_navigate,            PRESENTATION, NEXT,         NULL);
@@ -667,6 +719,7 @@ void config_load_default(zathura_t* zathura) {
   girara_inputbar_command_add(gsession, "files",      NULL,   cmd_files,           NULL,         _("Browse and search files"));
   girara_inputbar_command_add(gsession, "annotations_import", NULL, cmd_annot_import, NULL, _("Import all annotations from PDF (highlights and notes)"));
   girara_inputbar_command_add(gsession, "annotations_export", NULL, cmd_annot_export, NULL, _("Export all annotations to PDF (highlights and notes)"));
+  girara_inputbar_command_add(gsession, "annotsearch", NULL,  cmd_annot_search,    NULL,         _("Search highlights and notes of all documents"));
   girara_inputbar_command_add(gsession, "notes",    NULL,   cmd_notes,           NULL,         _("List all notes"));
   girara_inputbar_command_add(gsession, "readwise_sync", NULL, cmd_readwise_sync, NULL, _("Sync highlights to Readwise"));
   girara_inputbar_command_add(gsession, "close",      NULL,   cmd_close,           NULL,         _("Close current file"));
@@ -6,18 +6,44 @@
 #include <gio/gio.h>
 #include <girara/utils.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <magic.h>
 #include <stdio.h>
 
+/* number of files whose detected content types are remembered */
+#define CONTENT_TYPE_CACHE_SIZE 256
+
 struct zathura_content_type_context_s {
   magic_t magic;
+  GHashTable* cache; /**< path -> content_type_entry_t */
 };
 
+/* Content types detected for a file. The entry is only valid as long as the
+ * file is not replaced or modified. */
+typedef struct content_type_entry_s {
+  dev_t device;
+  ino_t inode;
+  goffset size;
+  gint64 mtime; /**< Modification time in nanoseconds */
+  bool magic_guessed; /**< magic holds the result of libmagic */
+  char* magic;
+  bool glib_guessed; /**< glib holds the result of GIO */
+  char* glib;
+} content_type_entry_t;
+
+static void content_type_entry_free(void* data) {
+  content_type_entry_t* entry = data;
+  g_free(entry->magic);
+  g_free(entry->glib);
+  g_free(entry);
+}
+
 zathura_content_type_context_t* zathura_content_type_new(void) {
   zathura_content_type_context_t* context = g_try_malloc0(sizeof(zathura_content_type_context_t));
   if (context == NULL) {
     return NULL;
   }
+  context->cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, content_type_entry_free);
 
   /* creat magic cookie */
   static const int flags = MAGIC_ERROR | MAGIC_MIME_TYPE | MAGIC_SYMLINK | MAGIC_NO_CHECK_APPTYPE | MAGIC_NO_CHECK_CDF |
@@ -40,10 +66,14 @@ zathura_content_type_context_t* zathura_content_type_new(void) {
 }
 
 void zathura_content_type_free(zathura_content_type_context_t* context) {
-  if (context != NULL && context->magic != NULL) {
-    magic_close(context->magic);
+  if (context == NULL) {
+    return;
   }
 
+  if (context->magic != NULL) {
+    magic_close(context->magic);
+  }
+  g_hash_table_unref(context->cache);
   g_free(context);
 }
 
@@ -112,10 +142,75 @@ static int compare_content_types(const void* lhs, const void* rhs) {
   return g_strcmp0(lhs, rhs);
 }
 
+static gint64 stat_mtime_ns(const GStatBuf* st) {
+  return (gint64)st->st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000) + st->st_mtim.tv_nsec;
+}
+
+/* Look up the cached content types of path. Returns NULL if the file cannot be
+ * accessed, in which case nothing is cached. */
+static content_type_entry_t* content_type_cache_lookup(zathura_content_type_context_t* context, const char* path) {
+  if (context == NULL) {
+    return NULL;
+  }
+
+  GStatBuf st;
+  if (g_stat(path, &st) != 0) {
+    return NULL;
+  }
+
+  content_type_entry_t* entry = g_hash_table_lookup(context->cache, path);
+  if (entry != NULL && entry->device == st.st_dev && entry->inode == st.st_ino && entry->size == st.st_size &&
+      entry->mtime == stat_mtime_ns(&st)) {
+    return entry;
+  }
+
+  if (entry == NULL && g_hash_table_size(context->cache) >= CONTENT_TYPE_CACHE_SIZE) {
+    g_hash_table_remove_all(context->cache);
+  }
+
+  entry         = g_new0(content_type_entry_t, 1);
+  entry->device = st.st_dev;
+  entry->inode  = st.st_ino;
+  entry->size   = st.st_size;
+  entry->mtime  = stat_mtime_ns(&st);
+  g_hash_table_replace(context->cache, g_strdup(path), entry);
+
+  return entry;
+}
+
+static char* cached_type_magic(zathura_content_type_context_t* context, content_type_entry_t* entry,
+                               const char* path) {
+  if (entry == NULL) {
+    return guess_type_magic(context, path);
+  }
+
+  if (entry->magic_guessed == false) {
+    entry->magic         = guess_type_magic(context, path);
+    entry->magic_guessed = true;
+  } else {
+    girara_debug("cached filetype of %s: %s", path, entry->magic);
+  }
+  return g_strdup(entry->magic);
+}
+
+static char* cached_type_glib(content_type_entry_t* entry, const char* path) {
+  if (entry == NULL) {
+    return guess_type_glib(path);
+  }
+
+  if (entry->glib_guessed == false) {
+    entry->glib         = guess_type_glib(path);
+    entry->glib_guessed = true;
+  }
+  return g_strdup(entry->glib);
+}
+
 char* zathura_content_type_guess(zathura_content_type_context_t* context, const char* path,
                                  const girara_list_t* supported_content_types) {
+  content_type_entry_t* entry = content_type_cache_lookup(context, path);
+
   /* try libmagic first */
-  char* content_type = guess_type_magic(context, path);
+  char* content_type = cached_type_magic(context, entry, path);
   if (content_type != NULL) {
     if (supported_content_types == NULL ||
         girara_list_find(supported_content_types, compare_content_types, content_type) != NULL) {
@@ -125,7 +220,7 @@ char* zathura_content_type_guess(zathura_content_type_context_t* context, const
     g_free(content_type);
   }
   /* else fallback to g_content_type_guess method */
-  content_type = guess_type_glib(path);
+  content_type = cached_type_glib(entry, path);
   if (content_type != NULL) {
     if (supported_content_types == NULL ||
         girara_list_find(supported_content_types, compare_content_types, content_type) != NULL) {
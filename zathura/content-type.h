@@ -23,7 +23,8 @@ void zathura_content_type_free(zathura_content_type_context_t* context);
 
 /**
  * "Guess" the content type of a file. Various methods are tried depending on
- * the available libraries.
+ * the available libraries. The detected types are cached by the context
+ * until the file's inode, size or modification time changes.
  *
  * @param path file name
  * @return content type of path, needs to freeed with g_free.
@@ -66,24 +66,71 @@ static bool remove_note(zathura_database_t* GIRARA_UNUSED(db), const char* GIRAR
   return true;
 }
 
+static zathura_highlight_t* get_highlight(zathura_database_t* GIRARA_UNUSED(db), const char* GIRARA_UNUSED(file),
+                                          const char* GIRARA_UNUSED(id)) {
+  return NULL;
+}
+
+static zathura_note_t* get_note(zathura_database_t* GIRARA_UNUSED(db), const char* GIRARA_UNUSED(file),
+                                const char* GIRARA_UNUSED(id)) {
+  return NULL;
+}
+
+static girara_list_t* search_annotations(zathura_database_t* GIRARA_UNUSED(db), const char* GIRARA_UNUSED(query),
+                                         int GIRARA_UNUSED(max)) {
+  return girara_list_new();
+}
+
+static girara_list_t* load_catalog(zathura_database_t* GIRARA_UNUSED(db)) {
+  return girara_list_new();
+}
+
+static bool update_catalog(zathura_database_t* GIRARA_UNUSED(db), girara_list_t* GIRARA_UNUSED(entries),
+                           girara_list_t* GIRARA_UNUSED(removed)) {
+  return true;
+}
+
+static girara_list_t* load_text_index(zathura_database_t* GIRARA_UNUSED(db)) {
+  return NULL;
+}
+
+static bool update_text_index(zathura_database_t* GIRARA_UNUSED(db),
+                              const zathura_catalog_entry_t* GIRARA_UNUSED(entry),
+                              girara_list_t* GIRARA_UNUSED(pages)) {
+  return false;
+}
+
+static bool search_text(zathura_database_t* GIRARA_UNUSED(db), const char* GIRARA_UNUSED(query), int GIRARA_UNUSED(max),
+                        zathura_text_match_func_t GIRARA_UNUSED(func), void* GIRARA_UNUSED(data)) {
+  return false;
+}
+
 static void db_interface_init(ZathuraDatabaseInterface* iface) {
   /* initialize interface */
-  iface->add_bookmark     = add_bookmark;
-  iface->remove_bookmark  = remove_bookmark;
-  iface->load_bookmarks   = load_list;
-  iface->load_jumplist    = load_list;
-  iface->save_jumplist    = save_list;
-  iface->set_fileinfo     = set_fileinfo;
-  iface->get_fileinfo     = get_fileinfo;
-  iface->get_recent_files = get_recent_files;
-  iface->load_quickmarks  = load_list;
-  iface->save_quickmarks  = save_list;
-  iface->add_highlight    = add_highlight;
-  iface->remove_highlight = remove_highlight;
-  iface->load_highlights  = load_list;
-  iface->add_note         = add_note;
-  iface->remove_note      = remove_note;
-  iface->load_notes       = load_list;
+  iface->add_bookmark       = add_bookmark;
+  iface->remove_bookmark    = remove_bookmark;
+  iface->load_bookmarks     = load_list;
+  iface->load_jumplist      = load_list;
+  iface->save_jumplist      = save_list;
+  iface->set_fileinfo       = set_fileinfo;
+  iface->get_fileinfo       = get_fileinfo;
+  iface->get_recent_files   = get_recent_files;
+  iface->load_quickmarks    = load_list;
+  iface->save_quickmarks    = save_list;
+  iface->add_highlight      = add_highlight;
+  iface->remove_highlight   = remove_highlight;
+  iface->load_highlights    = load_list;
+  iface->get_highlight      = get_highlight;
+  iface->add_note           = add_note;
+  iface->remove_note        = remove_note;
+  iface->load_notes         = load_list;
+  iface->get_note           = get_note;
+  iface->search_annotations = search_annotations;
+  iface->load_catalog       = load_catalog;
+  iface->update_catalog     = update_catalog;
+  iface->load_text_index    = load_text_index;
+  iface->update_text_index  = update_text_index;
+  iface->search_text        = search_text;
 }
 
 static void io_interface_init(GiraraInputHistoryIOInterface* iface) {
@@ -12,7 +12,7 @@
 #include "utils.h"
 
 /* version of the database layout */
-#define DATABASE_VERSION 6
+#define DATABASE_VERSION 7
 
 static char* sqlite3_column_text_dup(sqlite3_stmt* stmt, int col) {
   return g_strdup((const char*)sqlite3_column_text(stmt, col));
@@ -23,6 +23,11 @@ static void io_interface_init(GiraraInputHistoryIOInterface* iface);
 
 typedef struct zathura_sqldatabase_private_s {
   sqlite3* session;
+  sqlite3* worker;       /**< Connection used by the text index from other threads */
+  GMutex worker_lock;    /**< Lock for the worker connection */
+  char* path;            /**< Path of the database file */
+  bool annotation_index; /**< Full-text index of highlights and notes is available */
+  bool text_index;       /**< Full-text index of document text is available */
 } ZathuraSQLDatabasePrivate;
 
 G_DEFINE_TYPE_WITH_CODE(ZathuraSQLDatabase, zathura_sqldatabase, G_TYPE_OBJECT,
@@ -55,6 +60,11 @@ static void sqlite_finalize(GObject* object) {
     sqlite3_exec(priv->session, "VACUUM;", NULL, 0, NULL);
     sqlite3_close(priv->session);
   }
+  if (priv->worker != NULL) {
+    sqlite3_close(priv->worker);
+  }
+  g_mutex_clear(&priv->worker_lock);
+  g_free(priv->path);
 
   G_OBJECT_CLASS(zathura_sqldatabase_parent_class)->finalize(object);
 }
@@ -227,8 +237,15 @@ static void sqlite_db_check_layout(sqlite3* session, const int database_version,
                                        "created_at INTEGER,"
                                        "PRIMARY KEY(file, id));";
 
-  static const char* ALL_INIT[] = {SQL_BOOKMARK_INIT, SQL_JUMPLIST_INIT, SQL_FILEINFO_INIT, SQL_HISTORY_INIT,
-                                   QUICKMARKS_INIT, SQL_HIGHLIGHTS_INIT, SQL_NOTES_INIT};
+  /* create catalog table */
+  static const char SQL_CATALOG_INIT[] = "CREATE TABLE IF NOT EXISTS catalog ("
+                                         "path TEXT PRIMARY KEY,"
+                                         "size INTEGER,"
+                                         "mtime INTEGER,"
+                                         "pages INTEGER);";
+
+  static const char* ALL_INIT[] = {SQL_BOOKMARK_INIT, SQL_JUMPLIST_INIT,   SQL_FILEINFO_INIT, SQL_HISTORY_INIT,
+                                   QUICKMARKS_INIT,   SQL_HIGHLIGHTS_INIT, SQL_NOTES_INIT,    SQL_CATALOG_INIT};
 
   /* update fileinfo table (part 1) */
   static const char SQL_FILEINFO_ALTER[] = "ALTER TABLE fileinfo ADD COLUMN pages_per_row INTEGER;"
@@ -369,6 +386,99 @@ static void sqlite_db_check_layout(sqlite3* session, const int database_version,
   }
 }
 
+static bool sqlite_db_init_annotation_index(sqlite3* session) {
+  static const char SQL_ANNOTATION_INDEX_EXISTS[] =
+      "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'annotations_fts';";
+
+  /* The full-text index is kept separate from ALL_INIT since sqlite3 might be
+   * built without FTS5. Document ids live in annotation_keys since VACUUM may
+   * renumber the implicit rowids of the highlights and notes tables. The kind
+   * column holds zathura_annotation_kind_t values. */
+  static const char SQL_ANNOTATION_INDEX_INIT[] =
+      "BEGIN;"
+      "CREATE TABLE IF NOT EXISTS annotation_keys ("
+      "docid INTEGER PRIMARY KEY,"
+      "kind INTEGER,"
+      "file TEXT,"
+      "id TEXT,"
+      "UNIQUE(kind, file, id));"
+      "DELETE FROM annotation_keys;"
+      "CREATE VIRTUAL TABLE annotations_fts USING fts5(content, page UNINDEXED, prefix = '2 3');"
+      "INSERT INTO annotation_keys (kind, file, id) "
+      "SELECT 0, file, id FROM highlights WHERE text != '';"
+      "INSERT INTO annotations_fts (rowid, content, page) "
+      "SELECT k.docid, h.text, h.page FROM annotation_keys AS k JOIN highlights AS h "
+      "ON k.kind = 0 AND h.file = k.file AND h.id = k.id;"
+      "INSERT INTO annotation_keys (kind, file, id) "
+      "SELECT 1, file, id FROM notes WHERE content != '';"
+      "INSERT INTO annotations_fts (rowid, content, page) "
+      "SELECT k.docid, n.content, n.page FROM annotation_keys AS k JOIN notes AS n "
+      "ON k.kind = 1 AND n.file = k.file AND n.id = k.id;"
+      "COMMIT;";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_ANNOTATION_INDEX_EXISTS);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  const bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+  sqlite3_finalize(stmt);
+  if (exists == true) {
+    return true;
+  }
+
+  /* build the index from the existing highlights and notes */
+  char* errmsg = NULL;
+  if (sqlite3_exec(session, SQL_ANNOTATION_INDEX_INIT, NULL, 0, &errmsg) != SQLITE_OK) {
+    girara_warning("Failed to create annotation search index: %s", errmsg);
+    sqlite3_free(errmsg);
+    sqlite3_exec(session, "ROLLBACK;", NULL, 0, NULL);
+    return false;
+  }
+
+  return true;
+}
+
+static bool sqlite_db_init_text_index(sqlite3* session) {
+  static const char SQL_TEXT_INDEX_EXISTS[] = "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'text_fts';";
+
+  /* Like the annotation index, the text index requires FTS5. The rowid of a
+   * page is the docid of its document shifted by 20 bits plus the page
+   * number, so that all pages of a document form a contiguous range. */
+  static const char SQL_TEXT_INDEX_INIT[] =
+      "BEGIN;"
+      "CREATE TABLE IF NOT EXISTS text_files ("
+      "docid INTEGER PRIMARY KEY,"
+      "path TEXT UNIQUE,"
+      "size INTEGER,"
+      "mtime INTEGER,"
+      "pages INTEGER);"
+      "DELETE FROM text_files;"
+      "CREATE VIRTUAL TABLE text_fts USING fts5(content, tokenize = 'unicode61 remove_diacritics 2', prefix = '3');"
+      "COMMIT;";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_INDEX_EXISTS);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  const bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+  sqlite3_finalize(stmt);
+  if (exists == true) {
+    return true;
+  }
+
+  char* errmsg = NULL;
+  if (sqlite3_exec(session, SQL_TEXT_INDEX_INIT, NULL, 0, &errmsg) != SQLITE_OK) {
+    girara_warning("Failed to create document text index: %s", errmsg);
+    sqlite3_free(errmsg);
+    sqlite3_exec(session, "ROLLBACK;", NULL, 0, NULL);
+    return false;
+  }
+
+  return true;
+}
+
 static void sqlite_db_init(ZathuraSQLDatabase* db, const char* path) {
   ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(db);
 
@@ -381,6 +491,11 @@ static void sqlite_db_init(ZathuraSQLDatabase* db, const char* path) {
 
   /* Set busy timeout to 1s. */
   sqlite3_busy_timeout(session, 1000);
+  /* Readers do not wait for the text index being written on another
+   * connection. */
+  if (sqlite3_exec(session, "PRAGMA journal_mode = WAL;", NULL, 0, NULL) != SQLITE_OK) {
+    girara_debug("Failed to enable write-ahead logging.");
+  }
 
   const int database_version = sqlite_get_user_version(session);
   if (database_version == -1) {
@@ -395,7 +510,10 @@ static void sqlite_db_init(ZathuraSQLDatabase* db, const char* path) {
     sqlite_db_check_layout(session, database_version, !db_exists);
   }
 
-  priv->session = session;
+  priv->session          = session;
+  priv->path             = g_strdup(path);
+  priv->annotation_index = sqlite_db_init_annotation_index(session);
+  priv->text_index       = sqlite_db_init_text_index(session);
 }
 
 static void sqlite_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
@@ -996,6 +1114,136 @@ static char* rects_to_json(girara_list_t* rects) {
   return json_str;
 }
 
+static bool sqlite_annotation_index_remove(sqlite3* session, zathura_annotation_kind_t kind, const char* file,
+                                           const char* id) {
+  static const char SQL_ANNOTATION_KEY_SELECT[] =
+      "SELECT docid FROM annotation_keys WHERE kind = ? AND file = ? AND id = ?;";
+  static const char SQL_ANNOTATION_INDEX_REMOVE[] = "DELETE FROM annotations_fts WHERE rowid = ?;";
+  static const char SQL_ANNOTATION_KEY_REMOVE[]   = "DELETE FROM annotation_keys WHERE docid = ?;";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_ANNOTATION_KEY_SELECT);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int(stmt, 1, kind) != SQLITE_OK || sqlite3_bind_text(stmt, 2, file, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 3, id, -1, NULL) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  int res = sqlite3_step(stmt);
+  if (res != SQLITE_ROW) {
+    sqlite3_finalize(stmt);
+    return res == SQLITE_DONE;
+  }
+
+  const sqlite3_int64 docid = sqlite3_column_int64(stmt, 0);
+  sqlite3_finalize(stmt);
+
+  static const char* SQL_REMOVE[] = {SQL_ANNOTATION_INDEX_REMOVE, SQL_ANNOTATION_KEY_REMOVE};
+  for (size_t idx = 0; idx < LENGTH(SQL_REMOVE); ++idx) {
+    stmt = prepare_statement(session, SQL_REMOVE[idx]);
+    if (stmt == NULL) {
+      return false;
+    }
+
+    if (sqlite3_bind_int64(stmt, 1, docid) != SQLITE_OK) {
+      sqlite3_finalize(stmt);
+      girara_error("Failed to bind arguments.");
+      return false;
+    }
+
+    res = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    if (res != SQLITE_DONE) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool sqlite_annotation_index_add(sqlite3* session, zathura_annotation_kind_t kind, const char* file,
+                                        const char* id, unsigned int page, const char* content) {
+  static const char SQL_ANNOTATION_KEY_ADD[]   = "INSERT INTO annotation_keys (kind, file, id) VALUES (?, ?, ?);";
+  static const char SQL_ANNOTATION_INDEX_ADD[] = "INSERT INTO annotations_fts (rowid, content, page) VALUES (?, ?, ?);";
+
+  /* drop the previous version of the annotation */
+  if (sqlite_annotation_index_remove(session, kind, file, id) == false) {
+    return false;
+  }
+
+  if (content == NULL || *content == '\0') {
+    return true;
+  }
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_ANNOTATION_KEY_ADD);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int(stmt, 1, kind) != SQLITE_OK || sqlite3_bind_text(stmt, 2, file, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 3, id, -1, NULL) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  int res = sqlite3_step(stmt);
+  sqlite3_finalize(stmt);
+  if (res != SQLITE_DONE) {
+    return false;
+  }
+
+  const sqlite3_int64 docid = sqlite3_last_insert_rowid(session);
+
+  stmt = prepare_statement(session, SQL_ANNOTATION_INDEX_ADD);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int64(stmt, 1, docid) != SQLITE_OK || sqlite3_bind_text(stmt, 2, content, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_int(stmt, 3, page) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  res = sqlite3_step(stmt);
+  sqlite3_finalize(stmt);
+
+  return res == SQLITE_DONE;
+}
+
+/* Run stmt and update the annotation index in one transaction. If content is
+ * NULL, the annotation is removed from the index. */
+static bool sqlite_step_annotation(ZathuraSQLDatabasePrivate* priv, sqlite3_stmt* stmt, zathura_annotation_kind_t kind,
+                                   const char* file, const char* id, unsigned int page, const char* content) {
+  if (priv->annotation_index == false) {
+    return sqlite3_step(stmt) == SQLITE_DONE;
+  }
+
+  if (sqlite3_exec(priv->session, "BEGIN;", NULL, 0, NULL) != SQLITE_OK) {
+    return false;
+  }
+
+  bool status = sqlite3_step(stmt) == SQLITE_DONE;
+  if (status == true) {
+    status = content != NULL ? sqlite_annotation_index_add(priv->session, kind, file, id, page, content)
+                             : sqlite_annotation_index_remove(priv->session, kind, file, id);
+  }
+
+  if (status == false) {
+    sqlite3_exec(priv->session, "ROLLBACK;", NULL, 0, NULL);
+    return false;
+  }
+
+  sqlite3_exec(priv->session, "COMMIT;", NULL, 0, NULL);
+  return true;
+}
+
 static bool sqlite_add_highlight(zathura_database_t* db, const char* file, zathura_highlight_t* highlight) {
   g_return_val_if_fail(db != NULL && file != NULL && highlight != NULL, false);
 
@@ -1026,11 +1274,12 @@ static bool sqlite_add_highlight(zathura_database_t* db, const char* file, zathu
     return false;
   }
 
-  int res = sqlite3_step(stmt);
+  const bool res = sqlite_step_annotation(priv, stmt, ZATHURA_ANNOTATION_HIGHLIGHT, file, highlight->id,
+                                          highlight->page, highlight->text != NULL ? highlight->text : "");
   g_free(rects_json);
   sqlite3_finalize(stmt);
 
-  return (res == SQLITE_DONE) ? true : false;
+  return res;
 }
 
 static bool sqlite_remove_highlight(zathura_database_t* db, const char* file, const char* id) {
@@ -1053,10 +1302,10 @@ static bool sqlite_remove_highlight(zathura_database_t* db, const char* file, co
     return false;
   }
 
-  int res = sqlite3_step(stmt);
+  const bool res = sqlite_step_annotation(priv, stmt, ZATHURA_ANNOTATION_HIGHLIGHT, file, id, 0, NULL);
   sqlite3_finalize(stmt);
 
-  return (res == SQLITE_DONE) ? true : false;
+  return res;
 }
 
 static void highlight_free(void* p) {
@@ -1112,6 +1361,24 @@ static girara_list_t* json_to_rects(const char* json_str) {
   return rects;
 }
 
+/* Columns: id, page, rects_json, color, text, created_at */
+static zathura_highlight_t* highlight_from_row(sqlite3_stmt* stmt) {
+  zathura_highlight_t* highlight = g_try_malloc0(sizeof(zathura_highlight_t));
+  if (highlight == NULL) {
+    return NULL;
+  }
+
+  highlight->id          = sqlite3_column_text_dup(stmt, 0);
+  highlight->page        = sqlite3_column_int(stmt, 1);
+  const char* rects_json = (const char*)sqlite3_column_text(stmt, 2);
+  highlight->rects       = json_to_rects(rects_json);
+  highlight->color       = sqlite3_column_int(stmt, 3);
+  highlight->text        = sqlite3_column_text_dup(stmt, 4);
+  highlight->created_at  = (time_t)sqlite3_column_int64(stmt, 5);
+
+  return highlight;
+}
+
 static girara_list_t* sqlite_load_highlights(zathura_database_t* db, const char* file) {
   g_return_val_if_fail(db != NULL && file != NULL, NULL);
 
@@ -1139,25 +1406,46 @@ static girara_list_t* sqlite_load_highlights(zathura_database_t* db, const char*
   }
 
   while (sqlite3_step(stmt) == SQLITE_ROW) {
-    zathura_highlight_t* highlight = g_try_malloc0(sizeof(zathura_highlight_t));
-    if (highlight == NULL) {
-      continue;
+    zathura_highlight_t* highlight = highlight_from_row(stmt);
+    if (highlight != NULL) {
+      girara_list_append(result, highlight);
     }
+  }
+
+  sqlite3_finalize(stmt);
+
+  return result;
+}
+
+static zathura_highlight_t* sqlite_get_highlight(zathura_database_t* db, const char* file, const char* id) {
+  g_return_val_if_fail(db != NULL && file != NULL && id != NULL, NULL);
 
-    highlight->id         = sqlite3_column_text_dup(stmt, 0);
-    highlight->page       = sqlite3_column_int(stmt, 1);
-    const char* rects_json = (const char*)sqlite3_column_text(stmt, 2);
-    highlight->rects      = json_to_rects(rects_json);
-    highlight->color      = sqlite3_column_int(stmt, 3);
-    highlight->text       = sqlite3_column_text_dup(stmt, 4);
-    highlight->created_at = (time_t)sqlite3_column_int64(stmt, 5);
+  static const char SQL_HIGHLIGHT_GET[] =
+      "SELECT id, page, rects_json, color, text, created_at FROM highlights WHERE file = ? AND id = ?;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
 
-    girara_list_append(result, highlight);
+  sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_HIGHLIGHT_GET);
+  if (stmt == NULL) {
+    return NULL;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, file, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 2, id, -1, NULL) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return NULL;
+  }
+
+  zathura_highlight_t* highlight = NULL;
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    highlight = highlight_from_row(stmt);
   }
 
   sqlite3_finalize(stmt);
 
-  return result;
+  return highlight;
 }
 
 static bool sqlite_add_note(zathura_database_t* db, const char* file, zathura_note_t* note) {
@@ -1187,10 +1475,11 @@ static bool sqlite_add_note(zathura_database_t* db, const char* file, zathura_no
     return false;
   }
 
-  int res = sqlite3_step(stmt);
+  const bool res = sqlite_step_annotation(priv, stmt, ZATHURA_ANNOTATION_NOTE, file, note->id, note->page,
+                                          note->content != NULL ? note->content : "");
   sqlite3_finalize(stmt);
 
-  return (res == SQLITE_DONE) ? true : false;
+  return res;
 }
 
 static bool sqlite_remove_note(zathura_database_t* db, const char* file, const char* id) {
@@ -1213,10 +1502,10 @@ static bool sqlite_remove_note(zathura_database_t* db, const char* file, const c
     return false;
   }
 
-  int res = sqlite3_step(stmt);
+  const bool res = sqlite_step_annotation(priv, stmt, ZATHURA_ANNOTATION_NOTE, file, id, 0, NULL);
   sqlite3_finalize(stmt);
 
-  return (res == SQLITE_DONE) ? true : false;
+  return res;
 }
 
 static void note_free(void* p) {
@@ -1224,6 +1513,23 @@ static void note_free(void* p) {
   zathura_note_free(note);
 }
 
+/* Columns: id, page, x, y, content, created_at */
+static zathura_note_t* note_from_row(sqlite3_stmt* stmt) {
+  zathura_note_t* note = g_try_malloc0(sizeof(zathura_note_t));
+  if (note == NULL) {
+    return NULL;
+  }
+
+  note->id         = sqlite3_column_text_dup(stmt, 0);
+  note->page       = sqlite3_column_int(stmt, 1);
+  note->x          = sqlite3_column_double(stmt, 2);
+  note->y          = sqlite3_column_double(stmt, 3);
+  note->content    = sqlite3_column_text_dup(stmt, 4);
+  note->created_at = (time_t)sqlite3_column_int64(stmt, 5);
+
+  return note;
+}
+
 static girara_list_t* sqlite_load_notes(zathura_database_t* db, const char* file) {
   g_return_val_if_fail(db != NULL && file != NULL, NULL);
 
@@ -1251,19 +1557,292 @@ static girara_list_t* sqlite_load_notes(zathura_database_t* db, const char* file
   }
 
   while (sqlite3_step(stmt) == SQLITE_ROW) {
-    zathura_note_t* note = g_try_malloc0(sizeof(zathura_note_t));
-    if (note == NULL) {
+    zathura_note_t* note = note_from_row(stmt);
+    if (note != NULL) {
+      girara_list_append(result, note);
+    }
+  }
+
+  sqlite3_finalize(stmt);
+
+  return result;
+}
+
+static zathura_note_t* sqlite_get_note(zathura_database_t* db, const char* file, const char* id) {
+  g_return_val_if_fail(db != NULL && file != NULL && id != NULL, NULL);
+
+  static const char SQL_NOTE_GET[] = "SELECT id, page, x, y, content, created_at FROM notes WHERE file = ? AND id = ?;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_NOTE_GET);
+  if (stmt == NULL) {
+    return NULL;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, file, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 2, id, -1, NULL) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return NULL;
+  }
+
+  zathura_note_t* note = NULL;
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    note = note_from_row(stmt);
+  }
+
+  sqlite3_finalize(stmt);
+
+  return note;
+}
+
+static void annotation_match_free(void* p) {
+  zathura_annotation_match_t* match = p;
+  zathura_annotation_match_free(match);
+}
+
+/* Turn user input into a FTS5 query: every word is quoted to escape the FTS5
+ * syntax and matched as a prefix. */
+static char* fts_search_query(const char* input) {
+  g_auto(GStrv) words      = g_strsplit_set(input, " \t\n", -1);
+  g_autoptr(GString) query = g_string_new(NULL);
+
+  for (GStrv word = words; *word != NULL; ++word) {
+    if (**word == '\0') {
+      continue;
+    }
+
+    if (query->len > 0) {
+      g_string_append_c(query, ' ');
+    }
+    g_string_append_c(query, '"');
+    for (const char* c = *word; *c != '\0'; ++c) {
+      if (*c == '"') {
+        g_string_append_c(query, '"');
+      }
+      g_string_append_c(query, *c);
+    }
+    g_string_append(query, "\"*");
+  }
+
+  if (query->len == 0) {
+    return NULL;
+  }
+
+  return g_string_free(g_steal_pointer(&query), FALSE);
+}
+
+static girara_list_t* sqlite_search_annotations(zathura_database_t* db, const char* query, int max) {
+  g_return_val_if_fail(db != NULL && query != NULL, NULL);
+
+  static const char SQL_ANNOTATION_SEARCH[] =
+      "SELECT k.file, k.id, k.kind, f.page, snippet(annotations_fts, 0, ?, ?, '…', 16) "
+      "FROM annotations_fts AS f JOIN annotation_keys AS k ON k.docid = f.rowid "
+      "WHERE annotations_fts MATCH ? ORDER BY f.rank LIMIT ?;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  if (priv->annotation_index == false) {
+    return NULL;
+  }
+
+  g_autofree char* match = fts_search_query(query);
+  if (match == NULL) {
+    return girara_list_new_with_free(annotation_match_free);
+  }
+
+  sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_ANNOTATION_SEARCH);
+  if (stmt == NULL) {
+    return NULL;
+  }
+
+  if (max < 0) {
+    max = INT_MAX;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, ZATHURA_ANNOTATION_MATCH_BEGIN, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 2, ZATHURA_ANNOTATION_MATCH_END, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_text(stmt, 3, match, -1, NULL) != SQLITE_OK || sqlite3_bind_int(stmt, 4, max) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return NULL;
+  }
+
+  girara_list_t* result = girara_list_new_with_free(annotation_match_free);
+  if (result == NULL) {
+    sqlite3_finalize(stmt);
+    return NULL;
+  }
+
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    zathura_annotation_match_t* annotation_match = g_try_malloc0(sizeof(zathura_annotation_match_t));
+    if (annotation_match == NULL) {
+      continue;
+    }
+
+    annotation_match->file    = sqlite3_column_text_dup(stmt, 0);
+    annotation_match->id      = sqlite3_column_text_dup(stmt, 1);
+    annotation_match->kind    = sqlite3_column_int(stmt, 2);
+    annotation_match->page    = sqlite3_column_int(stmt, 3);
+    annotation_match->snippet = sqlite3_column_text_dup(stmt, 4);
+
+    girara_list_append(result, annotation_match);
+  }
+
+  sqlite3_finalize(stmt);
+
+  return result;
+}
+
+static void catalog_entry_free(void* p) {
+  zathura_catalog_entry_t* entry = p;
+  zathura_catalog_entry_free(entry);
+}
+
+static girara_list_t* sqlite_load_catalog(zathura_database_t* db) {
+  g_return_val_if_fail(db != NULL, NULL);
+
+  static const char SQL_CATALOG_SELECT[] = "SELECT path, size, mtime, pages FROM catalog;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_CATALOG_SELECT);
+  if (stmt == NULL) {
+    return NULL;
+  }
+
+  girara_list_t* result = girara_list_new_with_free(catalog_entry_free);
+  if (result == NULL) {
+    sqlite3_finalize(stmt);
+    return NULL;
+  }
+
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    zathura_catalog_entry_t* entry = g_try_malloc0(sizeof(zathura_catalog_entry_t));
+    if (entry == NULL) {
+      continue;
+    }
+
+    entry->path  = sqlite3_column_text_dup(stmt, 0);
+    entry->size  = sqlite3_column_int64(stmt, 1);
+    entry->mtime = sqlite3_column_int64(stmt, 2);
+    entry->pages = sqlite3_column_int(stmt, 3);
+
+    girara_list_append(result, entry);
+  }
+
+  sqlite3_finalize(stmt);
+
+  return result;
+}
+
+static bool sqlite_update_catalog(zathura_database_t* db, girara_list_t* entries, girara_list_t* removed) {
+  g_return_val_if_fail(db != NULL, false);
+
+  static const char SQL_CATALOG_ADD[]    = "REPLACE INTO catalog (path, size, mtime, pages) VALUES (?, ?, ?, ?);";
+  static const char SQL_CATALOG_REMOVE[] = "DELETE FROM catalog WHERE path = ?;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  if (sqlite3_exec(priv->session, "BEGIN;", NULL, 0, NULL) != SQLITE_OK) {
+    return false;
+  }
+
+  bool status = true;
+  if (entries != NULL && girara_list_size(entries) != 0) {
+    sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_CATALOG_ADD);
+    status             = stmt != NULL;
+
+    for (size_t idx = 0; idx != girara_list_size(entries) && status == true; ++idx) {
+      zathura_catalog_entry_t* entry = girara_list_nth(entries, idx);
+      if (sqlite3_bind_text(stmt, 1, entry->path, -1, NULL) != SQLITE_OK ||
+          sqlite3_bind_int64(stmt, 2, entry->size) != SQLITE_OK ||
+          sqlite3_bind_int64(stmt, 3, entry->mtime) != SQLITE_OK ||
+          sqlite3_bind_int(stmt, 4, entry->pages) != SQLITE_OK) {
+        girara_error("Failed to bind arguments.");
+        status = false;
+        break;
+      }
+
+      status = sqlite3_step(stmt) == SQLITE_DONE;
+      sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+  }
+
+  if (status == true && removed != NULL && girara_list_size(removed) != 0) {
+    sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_CATALOG_REMOVE);
+    status             = stmt != NULL;
+
+    for (size_t idx = 0; idx != girara_list_size(removed) && status == true; ++idx) {
+      const char* path = girara_list_nth(removed, idx);
+      if (sqlite3_bind_text(stmt, 1, path, -1, NULL) != SQLITE_OK) {
+        girara_error("Failed to bind arguments.");
+        status = false;
+        break;
+      }
+
+      status = sqlite3_step(stmt) == SQLITE_DONE;
+      sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+  }
+
+  if (status == false) {
+    sqlite3_exec(priv->session, "ROLLBACK;", NULL, 0, NULL);
+    return false;
+  }
+
+  sqlite3_exec(priv->session, "COMMIT;", NULL, 0, NULL);
+  return true;
+}
+
+/* number of bits of the text_fts rowid holding the page number */
+#define TEXT_INDEX_PAGE_BITS 20
+#define TEXT_INDEX_PAGE_MASK ((1 << TEXT_INDEX_PAGE_BITS) - 1)
+/* number of pages added to the text index per transaction */
+#define TEXT_INDEX_BATCH_PAGES 32
+
+static girara_list_t* sqlite_load_text_index(zathura_database_t* db) {
+  g_return_val_if_fail(db != NULL, NULL);
+
+  static const char SQL_TEXT_FILES_SELECT[] = "SELECT path, size, mtime, pages FROM text_files;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  if (priv->text_index == false) {
+    return NULL;
+  }
+
+  sqlite3_stmt* stmt = prepare_statement(priv->session, SQL_TEXT_FILES_SELECT);
+  if (stmt == NULL) {
+    return NULL;
+  }
+
+  girara_list_t* result = girara_list_new_with_free(catalog_entry_free);
+  if (result == NULL) {
+    sqlite3_finalize(stmt);
+    return NULL;
+  }
+
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    zathura_catalog_entry_t* entry = g_try_malloc0(sizeof(zathura_catalog_entry_t));
+    if (entry == NULL) {
       continue;
     }
 
-    note->id         = sqlite3_column_text_dup(stmt, 0);
-    note->page       = sqlite3_column_int(stmt, 1);
-    note->x          = sqlite3_column_double(stmt, 2);
-    note->y          = sqlite3_column_double(stmt, 3);
-    note->content    = sqlite3_column_text_dup(stmt, 4);
-    note->created_at = (time_t)sqlite3_column_int64(stmt, 5);
+    entry->path  = sqlite3_column_text_dup(stmt, 0);
+    entry->size  = sqlite3_column_int64(stmt, 1);
+    entry->mtime = sqlite3_column_int64(stmt, 2);
+    entry->pages = sqlite3_column_int(stmt, 3);
 
-    girara_list_append(result, note);
+    girara_list_append(result, entry);
   }
 
   sqlite3_finalize(stmt);
@@ -1271,24 +1850,336 @@ static girara_list_t* sqlite_load_notes(zathura_database_t* db, const char* file
   return result;
 }
 
+static bool sqlite_text_index_remove(sqlite3* session, const char* path) {
+  static const char SQL_TEXT_FILE_SELECT[] = "SELECT docid FROM text_files WHERE path = ?;";
+  static const char SQL_TEXT_REMOVE[]      = "DELETE FROM text_fts WHERE rowid BETWEEN ? AND ?;";
+  static const char SQL_TEXT_FILE_REMOVE[] = "DELETE FROM text_files WHERE docid = ?;";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_FILE_SELECT);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, path, -1, NULL) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  const int res             = sqlite3_step(stmt);
+  const sqlite3_int64 docid = res == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : -1;
+  sqlite3_finalize(stmt);
+  if (res != SQLITE_ROW) {
+    return res == SQLITE_DONE;
+  }
+
+  stmt = prepare_statement(session, SQL_TEXT_REMOVE);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int64(stmt, 1, docid << TEXT_INDEX_PAGE_BITS) != SQLITE_OK ||
+      sqlite3_bind_int64(stmt, 2, (docid << TEXT_INDEX_PAGE_BITS) | TEXT_INDEX_PAGE_MASK) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  bool status = sqlite3_step(stmt) == SQLITE_DONE;
+  sqlite3_finalize(stmt);
+  if (status == false) {
+    return false;
+  }
+
+  stmt = prepare_statement(session, SQL_TEXT_FILE_REMOVE);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int64(stmt, 1, docid) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  status = sqlite3_step(stmt) == SQLITE_DONE;
+  sqlite3_finalize(stmt);
+
+  return status;
+}
+
+/* Add a document whose pages are added afterwards. Its modification time is
+ * stored once all pages are added, so that an interrupted update is redone. */
+static bool sqlite_text_index_add_file(sqlite3* session, const zathura_catalog_entry_t* entry, size_t number_of_pages,
+                                       sqlite3_int64* docid) {
+  static const char SQL_TEXT_FILE_ADD[] = "INSERT INTO text_files (path, size, mtime, pages) VALUES (?, ?, -1, ?);";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_FILE_ADD);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, entry->path, -1, NULL) != SQLITE_OK ||
+      sqlite3_bind_int64(stmt, 2, entry->size) != SQLITE_OK || sqlite3_bind_int(stmt, 3, number_of_pages) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  const bool status = sqlite3_step(stmt) == SQLITE_DONE;
+  sqlite3_finalize(stmt);
+  *docid = sqlite3_last_insert_rowid(session);
+
+  return status;
+}
+
+static bool sqlite_text_index_add_pages(sqlite3* session, sqlite3_int64 docid, girara_list_t* pages, size_t first,
+                                        size_t last) {
+  static const char SQL_TEXT_ADD[] = "INSERT INTO text_fts (rowid, content) VALUES (?, ?);";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_ADD);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  bool status = true;
+  for (size_t page = first; page != last && status == true; ++page) {
+    const char* text = girara_list_nth(pages, page);
+    if (text == NULL || *text == '\0') {
+      continue;
+    }
+
+    if (sqlite3_bind_int64(stmt, 1, (docid << TEXT_INDEX_PAGE_BITS) | page) != SQLITE_OK ||
+        sqlite3_bind_text(stmt, 2, text, -1, NULL) != SQLITE_OK) {
+      girara_error("Failed to bind arguments.");
+      status = false;
+      break;
+    }
+
+    status = sqlite3_step(stmt) == SQLITE_DONE;
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+
+  return status;
+}
+
+static bool sqlite_text_index_set_mtime(sqlite3* session, sqlite3_int64 docid, gint64 mtime) {
+  static const char SQL_TEXT_FILE_MTIME[] = "UPDATE text_files SET mtime = ? WHERE docid = ?;";
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_FILE_MTIME);
+  if (stmt == NULL) {
+    return false;
+  }
+
+  if (sqlite3_bind_int64(stmt, 1, mtime) != SQLITE_OK || sqlite3_bind_int64(stmt, 2, docid) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  const bool status = sqlite3_step(stmt) == SQLITE_DONE;
+  sqlite3_finalize(stmt);
+
+  return status;
+}
+
+/* Returns the connection of the threads using the text index, opened on first
+ * use. Has to be called with the worker lock held. */
+static sqlite3* sqlite_worker_session(ZathuraSQLDatabasePrivate* priv) {
+  if (priv->worker != NULL) {
+    return priv->worker;
+  }
+
+  sqlite3* session = NULL;
+  if (sqlite3_open_v2(priv->path, &session, SQLITE_OPEN_READWRITE | SQLITE_OPEN_NOMUTEX, NULL) != SQLITE_OK) {
+    girara_error("Could not open database: %s\n", priv->path);
+    sqlite3_close(session);
+    return NULL;
+  }
+  /* waiting does not block the UI here */
+  sqlite3_busy_timeout(session, 10000);
+
+  priv->worker = session;
+  return session;
+}
+
+/* Run a function in a write transaction on the worker connection. */
+static bool sqlite_worker_transaction(ZathuraSQLDatabasePrivate* priv, bool (*func)(sqlite3*, void*), void* data) {
+  g_mutex_lock(&priv->worker_lock);
+  sqlite3* session = sqlite_worker_session(priv);
+  if (session == NULL || sqlite3_exec(session, "BEGIN IMMEDIATE;", NULL, 0, NULL) != SQLITE_OK) {
+    g_mutex_unlock(&priv->worker_lock);
+    return false;
+  }
+
+  bool status = func(session, data);
+  if (status == true) {
+    status = sqlite3_exec(session, "COMMIT;", NULL, 0, NULL) == SQLITE_OK;
+  }
+  if (status == false) {
+    sqlite3_exec(session, "ROLLBACK;", NULL, 0, NULL);
+  }
+  g_mutex_unlock(&priv->worker_lock);
+
+  return status;
+}
+
+typedef struct text_index_update_s {
+  const zathura_catalog_entry_t* entry;
+  girara_list_t* pages;
+  size_t number_of_pages;
+  sqlite3_int64 docid;
+  size_t first; /**< First page of the batch */
+  size_t last;  /**< Page after the batch */
+} text_index_update_t;
+
+static bool text_index_update_file(sqlite3* session, void* data) {
+  text_index_update_t* update = data;
+  if (sqlite_text_index_remove(session, update->entry->path) == false) {
+    return false;
+  }
+
+  return update->pages == NULL ||
+         sqlite_text_index_add_file(session, update->entry, update->number_of_pages, &update->docid) == true;
+}
+
+static bool text_index_update_pages(sqlite3* session, void* data) {
+  text_index_update_t* update = data;
+  return sqlite_text_index_add_pages(session, update->docid, update->pages, update->first, update->last);
+}
+
+static bool text_index_update_mtime(sqlite3* session, void* data) {
+  text_index_update_t* update = data;
+  return sqlite_text_index_set_mtime(session, update->docid, update->entry->mtime);
+}
+
+static bool sqlite_update_text_index(zathura_database_t* db, const zathura_catalog_entry_t* entry,
+                                     girara_list_t* pages) {
+  g_return_val_if_fail(db != NULL && entry != NULL, false);
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  if (priv->text_index == false) {
+    return false;
+  }
+
+  /* The index is updated on the worker connection since the main thread keeps
+   * using priv->session. The pages are committed in small batches, so that
+   * writes of the main thread do not wait for a whole document. */
+  text_index_update_t update = {
+      .entry           = entry,
+      .pages           = pages,
+      .number_of_pages = pages != NULL ? MIN(girara_list_size(pages), TEXT_INDEX_PAGE_MASK + 1) : 0,
+  };
+  if (sqlite_worker_transaction(priv, text_index_update_file, &update) == false) {
+    return false;
+  }
+  if (pages == NULL) {
+    return true;
+  }
+
+  for (update.first = 0; update.first < update.number_of_pages; update.first = update.last) {
+    update.last = MIN(update.first + TEXT_INDEX_BATCH_PAGES, update.number_of_pages);
+    if (sqlite_worker_transaction(priv, text_index_update_pages, &update) == false) {
+      return false;
+    }
+  }
+
+  return sqlite_worker_transaction(priv, text_index_update_mtime, &update);
+}
+
+static bool sqlite_search_text(zathura_database_t* db, const char* query, int max, zathura_text_match_func_t func,
+                               void* data) {
+  g_return_val_if_fail(db != NULL && query != NULL && func != NULL, false);
+
+  static const char SQL_TEXT_SEARCH[] =
+      "SELECT f.path, t.rowid & " G_STRINGIFY(TEXT_INDEX_PAGE_MASK) ", snippet(text_fts, 0, '', '', '…', 12) "
+      "FROM text_fts AS t JOIN text_files AS f ON f.docid = t.rowid >> " G_STRINGIFY(TEXT_INDEX_PAGE_BITS) " "
+      "WHERE text_fts MATCH ? ORDER BY t.rank LIMIT ?;";
+
+  ZathuraSQLDatabase* sqldb       = ZATHURA_SQLDATABASE(db);
+  ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(sqldb);
+
+  if (priv->text_index == false) {
+    return false;
+  }
+
+  g_autofree char* match = fts_search_query(query);
+  if (match == NULL) {
+    return true;
+  }
+
+  /* The search runs on the worker connection since it may be called from
+   * other threads while the main thread keeps using priv->session. */
+  g_mutex_lock(&priv->worker_lock);
+  sqlite3* session = sqlite_worker_session(priv);
+  if (session == NULL) {
+    g_mutex_unlock(&priv->worker_lock);
+    return false;
+  }
+
+  sqlite3_stmt* stmt = prepare_statement(session, SQL_TEXT_SEARCH);
+  if (stmt == NULL) {
+    g_mutex_unlock(&priv->worker_lock);
+    return false;
+  }
+
+  if (max < 0) {
+    max = INT_MAX;
+  }
+
+  if (sqlite3_bind_text(stmt, 1, match, -1, NULL) != SQLITE_OK || sqlite3_bind_int(stmt, 2, max) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    g_mutex_unlock(&priv->worker_lock);
+    girara_error("Failed to bind arguments.");
+    return false;
+  }
+
+  int res = SQLITE_DONE;
+  while ((res = sqlite3_step(stmt)) == SQLITE_ROW) {
+    const char* file    = (const char*)sqlite3_column_text(stmt, 0);
+    const int page      = sqlite3_column_int(stmt, 1);
+    const char* snippet = (const char*)sqlite3_column_text(stmt, 2);
+    if (func(file, page, snippet, data) == false) {
+      res = SQLITE_DONE;
+      break;
+    }
+  }
+
+  sqlite3_finalize(stmt);
+  g_mutex_unlock(&priv->worker_lock);
+
+  return res == SQLITE_DONE;
+}
+
 static void zathura_database_interface_init(ZathuraDatabaseInterface* iface) {
   /* initialize interface */
-  iface->add_bookmark     = sqlite_add_bookmark;
-  iface->remove_bookmark  = sqlite_remove_bookmark;
-  iface->load_bookmarks   = sqlite_load_bookmarks;
-  iface->load_jumplist    = sqlite_load_jumplist;
-  iface->save_jumplist    = sqlite_save_jumplist;
-  iface->set_fileinfo     = sqlite_set_fileinfo;
-  iface->get_fileinfo     = sqlite_get_fileinfo;
-  iface->get_recent_files = sqlite_get_recent_files;
-  iface->load_quickmarks  = sqlite_load_quickmarks;
-  iface->save_quickmarks  = sqlite_save_quickmarks;
-  iface->add_highlight    = sqlite_add_highlight;
-  iface->remove_highlight = sqlite_remove_highlight;
-  iface->load_highlights  = sqlite_load_highlights;
-  iface->add_note         = sqlite_add_note;
-  iface->remove_note      = sqlite_remove_note;
-  iface->load_notes       = sqlite_load_notes;
+  iface->add_bookmark       = sqlite_add_bookmark;
+  iface->remove_bookmark    = sqlite_remove_bookmark;
+  iface->load_bookmarks     = sqlite_load_bookmarks;
+  iface->load_jumplist      = sqlite_load_jumplist;
+  iface->save_jumplist      = sqlite_save_jumplist;
+  iface->set_fileinfo       = sqlite_set_fileinfo;
+  iface->get_fileinfo       = sqlite_get_fileinfo;
+  iface->get_recent_files   = sqlite_get_recent_files;
+  iface->load_quickmarks    = sqlite_load_quickmarks;
+  iface->save_quickmarks    = sqlite_save_quickmarks;
+  iface->add_highlight      = sqlite_add_highlight;
+  iface->remove_highlight   = sqlite_remove_highlight;
+  iface->load_highlights    = sqlite_load_highlights;
+  iface->get_highlight      = sqlite_get_highlight;
+  iface->add_note           = sqlite_add_note;
+  iface->remove_note        = sqlite_remove_note;
+  iface->load_notes         = sqlite_load_notes;
+  iface->get_note           = sqlite_get_note;
+  iface->search_annotations = sqlite_search_annotations;
+  iface->load_catalog       = sqlite_load_catalog;
+  iface->update_catalog     = sqlite_update_catalog;
+  iface->load_text_index    = sqlite_load_text_index;
+  iface->update_text_index  = sqlite_update_text_index;
+  iface->search_text        = sqlite_search_text;
 }
 
 static void io_interface_init(GiraraInputHistoryIOInterface* iface) {
@@ -1312,4 +2203,6 @@ static void zathura_sqldatabase_class_init(ZathuraSQLDatabaseClass* class) {
 static void zathura_sqldatabase_init(ZathuraSQLDatabase* db) {
   ZathuraSQLDatabasePrivate* priv = zathura_sqldatabase_get_instance_private(db);
   priv->session                   = NULL;
+  priv->worker                    = NULL;
+  g_mutex_init(&priv->worker_lock);
 }
@@ -4,7 +4,19 @@
 
 G_DEFINE_INTERFACE(ZathuraDatabase, zathura_database, G_TYPE_OBJECT)
 
-static void zathura_database_default_init(ZathuraDatabaseInterface* GIRARA_UNUSED(iface)) {}
+static void zathura_database_default_init(ZathuraDatabaseInterface* iface) {
+  g_signal_new("annotation-changed", G_TYPE_FROM_INTERFACE(iface), G_SIGNAL_RUN_LAST, 0, NULL, NULL,
+               g_cclosure_marshal_generic, G_TYPE_NONE, 4, G_TYPE_STRING, G_TYPE_UINT, G_TYPE_STRING, G_TYPE_BOOLEAN);
+}
+
+static bool annotation_changed(ZathuraDatabase* db, bool success, const char* file, zathura_annotation_kind_t kind,
+                               const char* id, bool removed) {
+  if (success == true) {
+    g_signal_emit_by_name(db, "annotation-changed", file, (guint)kind, id, (gboolean)removed);
+  }
+
+  return success;
+}
 
 bool zathura_db_add_bookmark(zathura_database_t* db, const char* file, zathura_bookmark_t* bookmark) {
   g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file != NULL && bookmark != NULL, false);
@@ -71,13 +83,15 @@ bool zathura_db_save_quickmarks(ZathuraDatabase* db, const char* file, girara_li
 bool zathura_db_add_highlight(ZathuraDatabase* db, const char* file, zathura_highlight_t* highlight) {
   g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && highlight, false);
 
-  return ZATHURA_DATABASE_GET_INTERFACE(db)->add_highlight(db, file, highlight);
+  const bool res = ZATHURA_DATABASE_GET_INTERFACE(db)->add_highlight(db, file, highlight);
+  return annotation_changed(db, res, file, ZATHURA_ANNOTATION_HIGHLIGHT, highlight->id, false);
 }
 
 bool zathura_db_remove_highlight(ZathuraDatabase* db, const char* file, const char* id) {
   g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && id, false);
 
-  return ZATHURA_DATABASE_GET_INTERFACE(db)->remove_highlight(db, file, id);
+  const bool res = ZATHURA_DATABASE_GET_INTERFACE(db)->remove_highlight(db, file, id);
+  return annotation_changed(db, res, file, ZATHURA_ANNOTATION_HIGHLIGHT, id, true);
 }
 
 girara_list_t* zathura_db_load_highlights(ZathuraDatabase* db, const char* file) {
@@ -86,16 +100,24 @@ girara_list_t* zathura_db_load_highlights(ZathuraDatabase* db, const char* file)
   return ZATHURA_DATABASE_GET_INTERFACE(db)->load_highlights(db, file);
 }
 
+zathura_highlight_t* zathura_db_get_highlight(ZathuraDatabase* db, const char* file, const char* id) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && id, NULL);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->get_highlight(db, file, id);
+}
+
 bool zathura_db_add_note(ZathuraDatabase* db, const char* file, zathura_note_t* note) {
   g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && note, false);
 
-  return ZATHURA_DATABASE_GET_INTERFACE(db)->add_note(db, file, note);
+  const bool res = ZATHURA_DATABASE_GET_INTERFACE(db)->add_note(db, file, note);
+  return annotation_changed(db, res, file, ZATHURA_ANNOTATION_NOTE, note->id, false);
 }
 
 bool zathura_db_remove_note(ZathuraDatabase* db, const char* file, const char* id) {
   g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && id, false);
 
-  return ZATHURA_DATABASE_GET_INTERFACE(db)->remove_note(db, file, id);
+  const bool res = ZATHURA_DATABASE_GET_INTERFACE(db)->remove_note(db, file, id);
+  return annotation_changed(db, res, file, ZATHURA_ANNOTATION_NOTE, id, true);
 }
 
 girara_list_t* zathura_db_load_notes(ZathuraDatabase* db, const char* file) {
@@ -103,3 +125,66 @@ girara_list_t* zathura_db_load_notes(ZathuraDatabase* db, const char* file) {
 
   return ZATHURA_DATABASE_GET_INTERFACE(db)->load_notes(db, file);
 }
+
+zathura_note_t* zathura_db_get_note(ZathuraDatabase* db, const char* file, const char* id) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && file && id, NULL);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->get_note(db, file, id);
+}
+
+girara_list_t* zathura_db_search_annotations(ZathuraDatabase* db, const char* query, int max) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && query, NULL);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->search_annotations(db, query, max);
+}
+
+girara_list_t* zathura_db_load_catalog(ZathuraDatabase* db) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db), NULL);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->load_catalog(db);
+}
+
+bool zathura_db_update_catalog(ZathuraDatabase* db, girara_list_t* entries, girara_list_t* removed) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db), false);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->update_catalog(db, entries, removed);
+}
+
+girara_list_t* zathura_db_load_text_index(ZathuraDatabase* db) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db), NULL);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->load_text_index(db);
+}
+
+bool zathura_db_update_text_index(ZathuraDatabase* db, const zathura_catalog_entry_t* entry, girara_list_t* pages) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && entry != NULL, false);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->update_text_index(db, entry, pages);
+}
+
+bool zathura_db_search_text(ZathuraDatabase* db, const char* query, int max, zathura_text_match_func_t func,
+                            void* data) {
+  g_return_val_if_fail(ZATHURA_IS_DATABASE(db) && query != NULL && func != NULL, false);
+
+  return ZATHURA_DATABASE_GET_INTERFACE(db)->search_text(db, query, max, func, data);
+}
+
+void zathura_catalog_entry_free(zathura_catalog_entry_t* entry) {
+  if (entry == NULL) {
+    return;
+  }
+
+  g_free(entry->path);
+  g_free(entry);
+}
+
+void zathura_annotation_match_free(zathura_annotation_match_t* match) {
+  if (match == NULL) {
+    return;
+  }
+
+  g_free(match->file);
+  g_free(match->id);
+  g_free(match->snippet);
+  g_free(match);
+}
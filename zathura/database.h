@@ -25,6 +25,41 @@ typedef struct zathura_fileinfo_s {
   bool page_right_to_left;
 } zathura_fileinfo_t;
 
+typedef struct zathura_catalog_entry_s {
+  char* path;
+  guint64 size;
+  gint64 mtime;
+  unsigned int pages; /**< Number of pages or 0 if not known yet */
+} zathura_catalog_entry_t;
+
+/* Markers enclosing the matched terms in zathura_annotation_match_t::snippet */
+#define ZATHURA_ANNOTATION_MATCH_BEGIN "\x02"
+#define ZATHURA_ANNOTATION_MATCH_END "\x03"
+
+typedef enum zathura_annotation_kind_e {
+  ZATHURA_ANNOTATION_HIGHLIGHT = 0,
+  ZATHURA_ANNOTATION_NOTE      = 1,
+} zathura_annotation_kind_t;
+
+typedef struct zathura_annotation_match_s {
+  char* file;
+  char* id;
+  zathura_annotation_kind_t kind;
+  unsigned int page;
+  char* snippet;
+} zathura_annotation_match_t;
+
+/**
+ * Called for every match of a document text search.
+ *
+ * @param file The path of the document
+ * @param page The page number (starting at 0)
+ * @param snippet The text around the match
+ * @param data User data
+ * @return true to continue the search, false to stop it
+ */
+typedef bool (*zathura_text_match_func_t)(const char* file, unsigned int page, const char* snippet, void* data);
+
 #define ZATHURA_TYPE_DATABASE (zathura_database_get_type())
 #define ZATHURA_DATABASE(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), ZATHURA_TYPE_DATABASE, ZathuraDatabase))
 #define ZATHURA_IS_DATABASE(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), ZATHURA_TYPE_DATABASE))
@@ -66,15 +101,39 @@ struct _ZathuraDatabaseInterface {
 
   girara_list_t* (*load_highlights)(ZathuraDatabase* db, const char* file);
 
+  zathura_highlight_t* (*get_highlight)(ZathuraDatabase* db, const char* file, const char* id);
+
   bool (*add_note)(ZathuraDatabase* db, const char* file, zathura_note_t* note);
 
   bool (*remove_note)(ZathuraDatabase* db, const char* file, const char* id);
 
   girara_list_t* (*load_notes)(ZathuraDatabase* db, const char* file);
+
+  zathura_note_t* (*get_note)(ZathuraDatabase* db, const char* file, const char* id);
+
+  girara_list_t* (*search_annotations)(ZathuraDatabase* db, const char* query, int max);
+
+  girara_list_t* (*load_catalog)(ZathuraDatabase* db);
+
+  bool (*update_catalog)(ZathuraDatabase* db, girara_list_t* entries, girara_list_t* removed);
+
+  girara_list_t* (*load_text_index)(ZathuraDatabase* db);
+
+  bool (*update_text_index)(ZathuraDatabase* db, const zathura_catalog_entry_t* entry, girara_list_t* pages);
+
+  bool (*search_text)(ZathuraDatabase* db, const char* query, int max, zathura_text_match_func_t func, void* data);
 };
 
 GType zathura_database_get_type(void) G_GNUC_CONST;
 
+/*
+ * Signals:
+ *
+ * annotation-changed (const char* file, zathura_annotation_kind_t kind, const char* id, gboolean removed)
+ *   Emitted after a highlight or note was successfully added, updated or
+ *   removed through the zathura_db_* functions.
+ */
+
 /**
  * Add or update bookmark in the database.
  *
@@ -206,6 +265,16 @@ bool zathura_db_remove_highlight(ZathuraDatabase* db, const char* file, const ch
  */
 girara_list_t* zathura_db_load_highlights(ZathuraDatabase* db, const char* file);
 
+/**
+ * Load a single highlight from the database.
+ *
+ * @param db The database instance
+ * @param file The file to which the highlight belongs.
+ * @param id The highlight id.
+ * @return The highlight or NULL if it does not exist.
+ */
+zathura_highlight_t* zathura_db_get_highlight(ZathuraDatabase* db, const char* file, const char* id);
+
 /**
  * Add a note to the database.
  *
@@ -235,4 +304,98 @@ bool zathura_db_remove_note(ZathuraDatabase* db, const char* file, const char* i
  */
 girara_list_t* zathura_db_load_notes(ZathuraDatabase* db, const char* file);
 
+/**
+ * Load a single note from the database.
+ *
+ * @param db The database instance
+ * @param file The file to which the note belongs.
+ * @param id The note id.
+ * @return The note or NULL if it does not exist.
+ */
+zathura_note_t* zathura_db_get_note(ZathuraDatabase* db, const char* file, const char* id);
+
+/**
+ * Search the text of highlights and the content of notes of all files. Every
+ * whitespace separated word of the query has to match the beginning of a
+ * word of the annotation.
+ *
+ * @param db The database instance
+ * @param query The search query
+ * @param max The maximum number of results. If max is less than zero, no
+ * limit is applied.
+ * @return List of zathura_annotation_match_t* ordered by relevance or NULL on
+ * failure.
+ */
+girara_list_t* zathura_db_search_annotations(ZathuraDatabase* db, const char* query, int max);
+
+/**
+ * Load the catalog of known documents.
+ *
+ * @param db The database instance
+ * @return List of zathura_catalog_entry_t* or NULL on failure.
+ */
+girara_list_t* zathura_db_load_catalog(ZathuraDatabase* db);
+
+/**
+ * Add, update and remove catalog entries in one step.
+ *
+ * @param db The database instance
+ * @param entries List of zathura_catalog_entry_t* to add or update
+ * @param removed List of paths to remove
+ * @return true on success, false otherwise.
+ */
+bool zathura_db_update_catalog(ZathuraDatabase* db, girara_list_t* entries, girara_list_t* removed);
+
+/**
+ * Load the documents whose text is part of the text index.
+ *
+ * @param db The database instance
+ * @return List of zathura_catalog_entry_t* or NULL if there is no text index.
+ */
+girara_list_t* zathura_db_load_text_index(ZathuraDatabase* db);
+
+/**
+ * Replace the indexed text of a document. Like zathura_db_search_text, this
+ * function may be called from any thread.
+ *
+ * @param db The database instance
+ * @param entry The document, its size and modification time
+ * @param pages List of char* holding the text of every page or NULL to remove
+ * the document from the index
+ * @return true on success, false otherwise.
+ */
+bool zathura_db_update_text_index(ZathuraDatabase* db, const zathura_catalog_entry_t* entry, girara_list_t* pages);
+
+/**
+ * Search the indexed text of all documents. Every whitespace separated word of
+ * the query has to match the beginning of a word on the page. Matches are
+ * reported ordered by relevance. Unlike the other functions, this function
+ * may be called from any thread.
+ *
+ * @param db The database instance
+ * @param query The search query
+ * @param max The maximum number of results. If max is less than zero, no
+ * limit is applied.
+ * @param func Function called for every match
+ * @param data User data passed to func
+ * @return true on success, false if the search failed or there is no text
+ * index.
+ */
+bool zathura_db_search_text(ZathuraDatabase* db, const char* query, int max, zathura_text_match_func_t func,
+                            void* data);
+
+/**
+ * Free a catalog entry.
+ *
+ * @param entry The entry
+ */
+void zathura_catalog_entry_free(zathura_catalog_entry_t* entry);
+
+/**
+ * Free a search result.
+ *
+ * @param match The search result
+ */
+void zathura_annotation_match_free(zathura_annotation_match_t* match);
+
 #endif // DATABASE_H
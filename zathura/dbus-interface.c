@@ -3,9 +3,11 @@
 #include "dbus-interface.h"
 #include "adjustment.h"
 #include "config.h"
+#include "database.h"
 #include "document.h"
 #include "links.h"
 #include "macros.h"
+#include "page-widget.h"
 #include "resources.h"
 #include "synctex.h"
 #include "utils.h"
@@ -40,13 +42,55 @@ typedef struct private_s {
   GDBusConnection* connection;
   guint owner_id;
   guint registration_id;
+  guint annotations_subscription_id;
   char* bus_name;
+  guint document_owner_id;
+  char* document_bus_name;
+  GPtrArray* annotation_changes; /**< Pending (susb) changes to announce */
+  guint annotation_changes_idle;
+
+  GHashTable* requests;      /**< Latest pending request of every sender */
+  GHashTable* busy;          /**< Senders with a running SyncTeX lookup */
+  guint requests_idle;       /**< Source dispatching the pending requests */
+  GThreadPool* lookups;      /**< Worker running the SyncTeX lookups */
+  GMutex lookups_lock;       /**< Lock for the finished lookups */
+  GPtrArray* finished;       /**< Finished lookups to show */
+  guint finished_idle;       /**< Source showing the finished lookups */
+  GCancellable* cancellable; /**< Cancelled when the object is finalized */
 } ZathuraDbusPrivate;
 
+/**
+ * Kinds of requests moving the view
+ */
+typedef enum dbus_request_kind_e {
+  DBUS_REQUEST_GOTO_PAGE,
+  DBUS_REQUEST_SYNCTEX_VIEW,
+} dbus_request_kind_t;
+
+/**
+ * Request moving the view, i.e. a GotoPage or SynctexView call. Editors send
+ * a forward search on every cursor movement, so only the latest request of a
+ * sender is handled; the calls it replaced are answered together with it.
+ */
+typedef struct dbus_request_s {
+  char* sender;                   /**< Unique name of the sender */
+  dbus_request_kind_t kind;       /**< Kind of the request */
+  unsigned int page;              /**< Page to go to, or the page found by the lookup */
+  char* input_file;               /**< Input file of the forward search */
+  unsigned int line;              /**< Line of the forward search */
+  unsigned int column;            /**< Column of the forward search */
+  GPtrArray* invocations;         /**< Calls answered with the result */
+  zathura_synctex_t* synctex;     /**< SyncTeX context of the lookup */
+  girara_list_t* rectangles;      /**< Rectangles found by the lookup */
+  girara_list_t* secondary_rects; /**< Rectangles on other pages found by the lookup */
+} dbus_request_t;
+
 G_DEFINE_TYPE_WITH_CODE(ZathuraDbus, zathura_dbus, G_TYPE_OBJECT, G_ADD_PRIVATE(ZathuraDbus))
 
 /* template for bus name */
 static const char DBUS_NAME_TEMPLATE[] = "org.pwmt.zathura.PID-%d";
+/* template for the bus name of an open document */
+static const char DBUS_DOCUMENT_NAME_TEMPLATE[] = "org.pwmt.zathura.Document-%s";
 /* object path */
 static const char DBUS_OBJPATH[] = "/org/pwmt/zathura";
 /* interface name */
@@ -54,6 +98,68 @@ static const char DBUS_INTERFACE[] = "org.pwmt.zathura";
 
 static const GDBusInterfaceVTable interface_vtable;
 
+static void dbus_request_free(dbus_request_t* request) {
+  if (request == NULL) {
+    return;
+  }
+
+  synctex_context_unref(request->synctex);
+  girara_list_free(request->rectangles);
+  girara_list_free(request->secondary_rects);
+  g_ptr_array_unref(request->invocations);
+  g_free(request->input_file);
+  g_free(request->sender);
+  g_free(request);
+}
+
+static void dbus_request_return(dbus_request_t* request, bool ret) {
+  for (guint idx = 0; idx != request->invocations->len; ++idx) {
+    g_dbus_method_invocation_return_value(g_ptr_array_index(request->invocations, idx), g_variant_new("(b)", ret));
+  }
+  g_ptr_array_set_size(request->invocations, 0);
+}
+
+static void dbus_request_cancel(dbus_request_t* request) {
+  for (guint idx = 0; idx != request->invocations->len; ++idx) {
+    g_dbus_method_invocation_return_error(g_ptr_array_index(request->invocations, idx), G_IO_ERROR,
+                                          G_IO_ERROR_CANCELLED, "zathura is shutting down.");
+  }
+  dbus_request_free(request);
+}
+
+static void dbus_requests_cancel(ZathuraDbus* dbus) {
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+
+  /* a running lookup stops waiting for the SyncTeX file, queued ones are
+   * skipped */
+  g_cancellable_cancel(priv->cancellable);
+  g_thread_pool_free(priv->lookups, FALSE, TRUE);
+
+  if (priv->requests_idle > 0) {
+    g_source_remove(priv->requests_idle);
+  }
+  if (priv->finished_idle > 0) {
+    g_source_remove(priv->finished_idle);
+  }
+
+  for (guint idx = 0; idx != priv->finished->len; ++idx) {
+    dbus_request_cancel(g_ptr_array_index(priv->finished, idx));
+  }
+  g_ptr_array_unref(priv->finished);
+
+  GHashTableIter iter;
+  void* request = NULL;
+  g_hash_table_iter_init(&iter, priv->requests);
+  while (g_hash_table_iter_next(&iter, NULL, &request) == TRUE) {
+    g_hash_table_iter_steal(&iter);
+    dbus_request_cancel(request);
+  }
+  g_hash_table_unref(priv->requests);
+  g_hash_table_unref(priv->busy);
+  g_mutex_clear(&priv->lookups_lock);
+  g_clear_object(&priv->cancellable);
+}
+
 static void finalize(GObject* object) {
   ZathuraDbus* dbus        = ZATHURA_DBUS(object);
   ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
@@ -62,15 +168,34 @@ static void finalize(GObject* object) {
     g_dbus_connection_unregister_object(priv->connection, priv->registration_id);
   }
 
+  if (priv->connection != NULL && priv->annotations_subscription_id > 0) {
+    g_dbus_connection_signal_unsubscribe(priv->connection, priv->annotations_subscription_id);
+  }
+
+  if (priv->zathura != NULL && priv->zathura->database != NULL) {
+    g_signal_handlers_disconnect_by_data(priv->zathura->database, dbus);
+  }
+
+  if (priv->annotation_changes_idle > 0) {
+    g_source_remove(priv->annotation_changes_idle);
+  }
+  g_ptr_array_unref(priv->annotation_changes);
+
+  dbus_requests_cancel(dbus);
+
   if (priv->owner_id > 0) {
     g_bus_unown_name(priv->owner_id);
   }
+  if (priv->document_owner_id > 0) {
+    g_bus_unown_name(priv->document_owner_id);
+  }
 
   if (priv->introspection_data != NULL) {
     g_dbus_node_info_unref(priv->introspection_data);
   }
 
   g_free(priv->bus_name);
+  g_free(priv->document_bus_name);
 
   G_OBJECT_CLASS(zathura_dbus_parent_class)->finalize(object);
 }
@@ -81,6 +206,27 @@ static void zathura_dbus_class_init(ZathuraDbusClass* class) {
   object_class->finalize     = finalize;
 }
 
+static gboolean show_finished_lookups(void* data);
+
+static void synctex_lookup_thread(gpointer data, gpointer user_data) {
+  dbus_request_t* request  = data;
+  ZathuraDbus* dbus        = user_data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+
+  if (g_cancellable_is_cancelled(priv->cancellable) == FALSE) {
+    request->rectangles = synctex_context_rectangles_from_position(
+        request->synctex, request->input_file, request->line, request->column, &request->page,
+        &request->secondary_rects, priv->cancellable);
+  }
+
+  g_mutex_lock(&priv->lookups_lock);
+  g_ptr_array_add(priv->finished, request);
+  if (priv->finished_idle == 0 && g_cancellable_is_cancelled(priv->cancellable) == FALSE) {
+    priv->finished_idle = g_idle_add(show_finished_lookups, dbus);
+  }
+  g_mutex_unlock(&priv->lookups_lock);
+}
+
 static void zathura_dbus_init(ZathuraDbus* dbus) {
   ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
   priv->zathura            = NULL;
@@ -89,6 +235,22 @@ static void zathura_dbus_init(ZathuraDbus* dbus) {
   priv->owner_id           = 0;
   priv->registration_id    = 0;
   priv->bus_name           = NULL;
+
+  priv->document_owner_id = 0;
+  priv->document_bus_name = NULL;
+
+  priv->annotations_subscription_id = 0;
+  priv->annotation_changes          = g_ptr_array_new_with_free_func((GDestroyNotify)g_variant_unref);
+  priv->annotation_changes_idle     = 0;
+
+  priv->requests      = g_hash_table_new(g_str_hash, g_str_equal);
+  priv->busy          = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  priv->requests_idle = 0;
+  priv->lookups       = g_thread_pool_new(synctex_lookup_thread, dbus, 1, FALSE, NULL);
+  priv->finished      = g_ptr_array_new();
+  priv->finished_idle = 0;
+  priv->cancellable   = g_cancellable_new();
+  g_mutex_init(&priv->lookups_lock);
 }
 
 static void gdbus_connection_closed(GDBusConnection* UNUSED(connection), gboolean UNUSED(remote_peer_vanished),
@@ -98,6 +260,10 @@ static void gdbus_connection_closed(GDBusConnection* UNUSED(connection), gboolea
   }
 }
 
+static void handle_annotations_changed(GDBusConnection* connection, const gchar* sender, const gchar* object_path,
+                                       const gchar* interface_name, const gchar* signal_name, GVariant* parameters,
+                                       void* data);
+
 static void bus_acquired(GDBusConnection* connection, const gchar* name, void* data) {
   girara_debug("Bus acquired at '%s'.", name);
 
@@ -115,6 +281,11 @@ static void bus_acquired(GDBusConnection* connection, const gchar* name, void* d
     return;
   }
 
+  /* listen for annotation changes of other instances */
+  priv->annotations_subscription_id =
+      g_dbus_connection_signal_subscribe(connection, NULL, DBUS_INTERFACE, "AnnotationsChanged", DBUS_OBJPATH, NULL,
+                                         G_DBUS_SIGNAL_FLAGS_NONE, handle_annotations_changed, dbus, NULL);
+
   priv->connection = connection;
 }
 
@@ -126,6 +297,63 @@ static void name_lost(GDBusConnection* UNUSED(connection), const gchar* name, vo
   girara_debug("Lost connection or failed to acquire '%s' on session bus.", name);
 }
 
+static gboolean emit_annotations_changed(void* data) {
+  ZathuraDbus* dbus        = data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+
+  priv->annotation_changes_idle = 0;
+  g_autoptr(GPtrArray) changes  = priv->annotation_changes;
+  priv->annotation_changes      = g_ptr_array_new_with_free_func((GDestroyNotify)g_variant_unref);
+
+  if (priv->connection == NULL) {
+    return G_SOURCE_REMOVE;
+  }
+
+  /* send one signal per file with all changes in the order they happened */
+  g_autoptr(GHashTable) files = g_hash_table_new(g_str_hash, g_str_equal);
+  for (guint idx = 0; idx != changes->len; ++idx) {
+    const char* file = NULL;
+    g_variant_get_child(g_ptr_array_index(changes, idx), 0, "&s", &file);
+    if (g_hash_table_add(files, (gpointer)file) == FALSE) {
+      continue;
+    }
+
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(usb)"));
+    for (guint other = idx; other != changes->len; ++other) {
+      const char* other_file = NULL;
+      guint kind             = 0;
+      const char* id         = NULL;
+      gboolean removed       = FALSE;
+      g_variant_get(g_ptr_array_index(changes, other), "(&su&sb)", &other_file, &kind, &id, &removed);
+      if (g_strcmp0(file, other_file) == 0) {
+        g_variant_builder_add(&builder, "(usb)", kind, id, removed);
+      }
+    }
+
+    g_autoptr(GError) error = NULL;
+    g_dbus_connection_emit_signal(priv->connection, NULL, DBUS_OBJPATH, DBUS_INTERFACE, "AnnotationsChanged",
+                                  g_variant_new("(sa(usb))", file, &builder), &error);
+    if (error != NULL) {
+      girara_debug("Failed to emit 'AnnotationsChanged' signal: %s", error->message);
+    }
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+static void cb_annotation_changed(ZathuraDatabase* UNUSED(database), const char* file, guint kind, const char* id,
+                                  gboolean removed, void* data) {
+  ZathuraDbus* dbus        = data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+
+  /* collect the changes of one main loop iteration, e.g. of an import */
+  g_ptr_array_add(priv->annotation_changes, g_variant_ref_sink(g_variant_new("(susb)", file, kind, id, removed)));
+  if (priv->annotation_changes_idle == 0) {
+    priv->annotation_changes_idle = g_idle_add(emit_annotations_changed, dbus);
+  }
+}
+
 ZathuraDbus* zathura_dbus_new(zathura_t* zathura) {
   g_autoptr(GObject) obj = g_object_new(ZATHURA_TYPE_DBUS, NULL);
   if (obj == NULL) {
@@ -155,11 +383,47 @@ ZathuraDbus* zathura_dbus_new(zathura_t* zathura) {
   priv->owner_id        = g_bus_own_name(G_BUS_TYPE_SESSION, well_known_name, G_BUS_NAME_OWNER_FLAGS_NONE, bus_acquired,
                                          name_acquired, name_lost, dbus, NULL);
 
+  if (zathura->database != NULL) {
+    g_signal_connect(zathura->database, "annotation-changed", G_CALLBACK(cb_annotation_changed), dbus);
+  }
+
   // dbus takes ownership of obj
   obj = NULL;
   return dbus;
 }
 
+/* Bus names consist of letters, digits, '_' and '-', so the path is hashed. */
+static char* document_bus_name(const char* filename) {
+  g_autofree char* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA256, filename, -1);
+  return g_strdup_printf(DBUS_DOCUMENT_NAME_TEMPLATE, hash);
+}
+
+void zathura_dbus_set_document(zathura_t* zathura, const char* filename) {
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(zathura->dbus);
+
+  /* keep the place in the queue of the name when the document is reloaded */
+  g_autofree char* name = filename != NULL ? document_bus_name(filename) : NULL;
+  if (name != NULL && g_strcmp0(name, priv->document_bus_name) == 0) {
+    return;
+  }
+
+  if (priv->document_owner_id > 0) {
+    g_bus_unown_name(priv->document_owner_id);
+    priv->document_owner_id = 0;
+  }
+  g_clear_pointer(&priv->document_bus_name, g_free);
+
+  if (filename == NULL) {
+    return;
+  }
+
+  /* if another instance has the document open, the name is queued and passed
+   * on once that instance closes it */
+  priv->document_bus_name = g_steal_pointer(&name);
+  priv->document_owner_id = g_bus_own_name(G_BUS_TYPE_SESSION, priv->document_bus_name, G_BUS_NAME_OWNER_FLAGS_NONE,
+                                           NULL, name_acquired, NULL, NULL, NULL);
+}
+
 const char* zathura_dbus_get_name(zathura_t* zathura) {
   ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(zathura->dbus);
 
@@ -191,6 +455,149 @@ void zathura_dbus_edit(zathura_t* zathura, unsigned int page, unsigned int x, un
 
 /* D-Bus handler */
 
+static void present_window(zathura_t* zathura) {
+  if (zathura->ui.session->gtk.embed != 0) {
+    return;
+  }
+
+  bool present_window = true;
+  girara_setting_get(zathura->ui.session, "dbus-raise-window", &present_window);
+  if (present_window == true) {
+    gtk_window_present(GTK_WINDOW(zathura->ui.session->gtk.window));
+  }
+}
+
+static void dbus_request_run(ZathuraDbus* dbus, dbus_request_t* request) {
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+  zathura_t* zathura       = priv->zathura;
+
+  if (zathura_has_document(zathura) == false) {
+    for (guint idx = 0; idx != request->invocations->len; ++idx) {
+      g_dbus_method_invocation_return_dbus_error(g_ptr_array_index(request->invocations, idx),
+                                                 "org.pwmt.zathura.NoOpenDocument", "No document has been opened.");
+    }
+    g_ptr_array_set_size(request->invocations, 0);
+    dbus_request_free(request);
+    return;
+  }
+
+  if (request->kind == DBUS_REQUEST_GOTO_PAGE) {
+    const bool ret = request->page < zathura_document_get_number_of_pages(zathura_get_document(zathura));
+    if (ret == true) {
+      page_set(zathura, request->page);
+      present_window(zathura);
+    }
+    dbus_request_return(request, ret);
+    dbus_request_free(request);
+    return;
+  }
+
+  /* the lookup may have to wait for the SyncTeX file to be parsed */
+  request->synctex = synctex_context_ref(zathura);
+  g_hash_table_add(priv->busy, g_strdup(request->sender));
+  g_thread_pool_push(priv->lookups, request, NULL);
+}
+
+static gboolean dispatch_requests(void* data) {
+  ZathuraDbus* dbus        = data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+
+  priv->requests_idle = 0;
+
+  GHashTableIter iter;
+  void* value = NULL;
+  g_hash_table_iter_init(&iter, priv->requests);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    dbus_request_t* request = value;
+    /* dispatched once the running lookup of the sender finished */
+    if (g_hash_table_contains(priv->busy, request->sender) == TRUE) {
+      continue;
+    }
+
+    g_hash_table_iter_steal(&iter);
+    dbus_request_run(dbus, request);
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Returns the pending request of the sender of the invocation, which answers
+ * the invocation once it is handled. */
+static dbus_request_t* dbus_request_get(ZathuraDbus* dbus, GDBusMethodInvocation* invocation) {
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+  /* there is no sender on peer-to-peer connections */
+  const char* sender = g_dbus_method_invocation_get_sender(invocation);
+  if (sender == NULL) {
+    sender = "";
+  }
+
+  dbus_request_t* request = g_hash_table_lookup(priv->requests, sender);
+  if (request == NULL) {
+    request              = g_new0(dbus_request_t, 1);
+    request->sender      = g_strdup(sender);
+    request->invocations = g_ptr_array_new();
+    g_hash_table_insert(priv->requests, request->sender, request);
+  } else {
+    girara_debug("Replacing pending request of '%s'.", sender);
+  }
+  g_ptr_array_add(request->invocations, invocation);
+
+  if (priv->requests_idle == 0) {
+    priv->requests_idle = g_idle_add(dispatch_requests, dbus);
+  }
+
+  return request;
+}
+
+static gboolean show_finished_lookups(void* data) {
+  ZathuraDbus* dbus        = data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+  zathura_t* zathura       = priv->zathura;
+
+  g_mutex_lock(&priv->lookups_lock);
+  priv->finished_idle           = 0;
+  g_autoptr(GPtrArray) finished = priv->finished;
+  priv->finished                = g_ptr_array_new();
+  g_mutex_unlock(&priv->lookups_lock);
+
+  for (guint idx = 0; idx != finished->len; ++idx) {
+    dbus_request_t* request = g_ptr_array_index(finished, idx);
+    g_hash_table_remove(priv->busy, request->sender);
+
+    /* an outdated position is not shown; the newer request answers the calls */
+    dbus_request_t* newer = g_hash_table_lookup(priv->requests, request->sender);
+    if (newer != NULL) {
+      for (guint other = 0; other != request->invocations->len; ++other) {
+        g_ptr_array_add(newer->invocations, g_ptr_array_index(request->invocations, other));
+      }
+      g_ptr_array_set_size(request->invocations, 0);
+      dbus_request_free(request);
+
+      if (priv->requests_idle == 0) {
+        priv->requests_idle = g_idle_add(dispatch_requests, dbus);
+      }
+      continue;
+    }
+
+    /* the document may have been closed or reloaded in the meantime */
+    zathura_synctex_t* current = synctex_context_ref(zathura);
+    bool ret                   = false;
+    if (request->rectangles != NULL && current == request->synctex) {
+      ret = synctex_show_rectangles(zathura, request->page, g_steal_pointer(&request->rectangles),
+                                    request->secondary_rects);
+      if (ret == true) {
+        present_window(zathura);
+      }
+    }
+    synctex_context_unref(current);
+
+    dbus_request_return(request, ret);
+    dbus_request_free(request);
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
 static void handle_open_document(zathura_t* zathura, GVariant* parameters, GDBusMethodInvocation* invocation) {
   g_autofree gchar* filename = NULL;
   g_autofree gchar* password = NULL;
@@ -217,15 +624,15 @@ static void handle_goto_page(zathura_t* zathura, GVariant* parameters, GDBusMeth
   guint page = 0;
   g_variant_get(parameters, "(u)", &page);
 
-  bool ret = true;
   if (page >= number_of_pages) {
-    ret = false;
-  } else {
-    page_set(zathura, page);
+    GVariant* result = g_variant_new("(b)", false);
+    g_dbus_method_invocation_return_value(invocation, result);
+    return;
   }
 
-  GVariant* result = g_variant_new("(b)", ret);
-  g_dbus_method_invocation_return_value(invocation, result);
+  dbus_request_t* request = dbus_request_get(g_dbus_method_invocation_get_user_data(invocation), invocation);
+  request->kind           = DBUS_REQUEST_GOTO_PAGE;
+  request->page           = page;
 }
 
 typedef struct {
@@ -342,43 +749,19 @@ static void handle_highlight_rects(zathura_t* zathura, GVariant* parameters, GDB
   g_dbus_method_invocation_return_value(invocation, result);
 }
 
-typedef struct {
-  zathura_t* zathura;
-  gchar* input_file;
-  unsigned int line;
-  unsigned int column;
-} view_data_t;
-
-static gboolean synctex_view_impl(gpointer ptr) {
-  view_data_t* data = ptr;
-
-  synctex_view(data->zathura, data->input_file, data->line, data->column);
-
-  g_free(data->input_file);
-  g_free(data);
-  return false;
-}
-
-static void synctex_view_idle(zathura_t* zathura, gchar* input_file, unsigned int line, unsigned int column) {
-  view_data_t* data = g_try_malloc0(sizeof(view_data_t));
-  data->zathura     = zathura;
-  data->input_file  = input_file;
-  data->line        = line;
-  data->column      = column;
-
-  gdk_threads_add_idle(synctex_view_impl, data);
-}
-
-static void handle_synctex_view(zathura_t* zathura, GVariant* parameters, GDBusMethodInvocation* invocation) {
+static void handle_synctex_view(zathura_t* UNUSED(zathura), GVariant* parameters, GDBusMethodInvocation* invocation) {
   gchar* input_file = NULL;
   guint line        = 0;
   guint column      = 0;
   g_variant_get(parameters, "(suu)", &input_file, &line, &column);
 
-  synctex_view_idle(zathura, input_file, line, column);
-
-  GVariant* result = g_variant_new("(b)", true);
-  g_dbus_method_invocation_return_value(invocation, result);
+  dbus_request_t* request = dbus_request_get(g_dbus_method_invocation_get_user_data(invocation), invocation);
+  g_free(request->input_file);
+  request->kind       = DBUS_REQUEST_SYNCTEX_VIEW;
+  request->page       = 0;
+  request->input_file = input_file;
+  request->line       = line;
+  request->column     = column;
 }
 
 static void handle_execute_command(zathura_t* zathura, GVariant* parameters, GDBusMethodInvocation* invocation) {
@@ -409,6 +792,81 @@ static void handle_source_config_from_dir(zathura_t* zathura, GVariant* paramete
   g_dbus_method_invocation_return_value(invocation, result);
 }
 
+static bool remove_annotation(zathura_t* zathura, zathura_annotation_kind_t kind, const char* id) {
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura_get_document(zathura));
+  for (unsigned int page = 0; page != number_of_pages; ++page) {
+    ZathuraPage* page_widget = ZATHURA_PAGE(zathura->pages[page]);
+    const bool removed       = kind == ZATHURA_ANNOTATION_NOTE ? zathura_page_widget_remove_note(page_widget, id)
+                                                               : zathura_page_widget_remove_highlight(page_widget, id);
+    if (removed == true) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void add_annotation(zathura_t* zathura, const char* file, zathura_annotation_kind_t kind, const char* id) {
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura_get_document(zathura));
+
+  if (kind == ZATHURA_ANNOTATION_NOTE) {
+    zathura_note_t* note = zathura_db_get_note(zathura->database, file, id);
+    if (note == NULL) {
+      return;
+    }
+    if (note->page >= number_of_pages) {
+      zathura_note_free(note);
+      return;
+    }
+    zathura_page_widget_add_note(ZATHURA_PAGE(zathura->pages[note->page]), note);
+  } else {
+    zathura_highlight_t* highlight = zathura_db_get_highlight(zathura->database, file, id);
+    if (highlight == NULL) {
+      return;
+    }
+    if (highlight->page >= number_of_pages) {
+      zathura_highlight_free(highlight);
+      return;
+    }
+    zathura_page_widget_add_highlight(ZATHURA_PAGE(zathura->pages[highlight->page]), highlight);
+  }
+}
+
+static void handle_annotations_changed(GDBusConnection* connection, const gchar* sender,
+                                       const gchar* UNUSED(object_path), const gchar* UNUSED(interface_name),
+                                       const gchar* UNUSED(signal_name), GVariant* parameters, void* data) {
+  ZathuraDbus* dbus        = data;
+  ZathuraDbusPrivate* priv = zathura_dbus_get_instance_private(dbus);
+  zathura_t* zathura       = priv->zathura;
+
+  /* our own changes are already displayed */
+  if (g_strcmp0(sender, g_dbus_connection_get_unique_name(connection)) == 0 ||
+      zathura_has_document(zathura) == false || zathura->database == NULL) {
+    return;
+  }
+
+  const char* file             = NULL;
+  g_autoptr(GVariantIter) iter = NULL;
+  g_variant_get(parameters, "(&sa(usb))", &file, &iter);
+
+  if (g_strcmp0(file, zathura_document_get_path(zathura_get_document(zathura))) != 0) {
+    return;
+  }
+
+  guint kind       = 0;
+  const char* id   = NULL;
+  gboolean removed = FALSE;
+  while (g_variant_iter_next(iter, "(u&sb)", &kind, &id, &removed)) {
+    girara_debug("Annotation %s %s by %s.", id, removed == TRUE ? "removed" : "changed", sender);
+
+    /* updated annotations are replaced */
+    remove_annotation(zathura, kind, id);
+    if (removed == FALSE) {
+      add_annotation(zathura, file, kind, id);
+    }
+  }
+}
+
 static void handle_method_call(GDBusConnection* UNUSED(connection), const gchar* UNUSED(sender),
                                const gchar* object_path, const gchar* interface_name, const gchar* method_name,
                                GVariant* parameters, GDBusMethodInvocation* invocation, void* data) {
@@ -425,9 +883,9 @@ static void handle_method_call(GDBusConnection* UNUSED(connection), const gchar*
   } handlers[] = {
       {"OpenDocument", handle_open_document, false, true},
       {"CloseDocument", handle_close_document, false, false},
-      {"GotoPage", handle_goto_page, true, true},
+      {"GotoPage", handle_goto_page, true, false},
       {"HighlightRects", handle_highlight_rects, true, true},
-      {"SynctexView", handle_synctex_view, true, true},
+      {"SynctexView", handle_synctex_view, true, false},
       {"ExecuteCommand", handle_execute_command, false, false},
       {"SourceConfig", handle_source_config, false, false},
       {"SourceConfigFromDirectory", handle_source_config_from_dir, false, false},
@@ -446,12 +904,8 @@ static void handle_method_call(GDBusConnection* UNUSED(connection), const gchar*
 
     (*handlers[idx].handler)(priv->zathura, parameters, invocation);
 
-    if (handlers[idx].present_window == true && priv->zathura->ui.session->gtk.embed == 0) {
-      bool present_window = true;
-      girara_setting_get(priv->zathura->ui.session, "dbus-raise-window", &present_window);
-      if (present_window == true) {
-        gtk_window_present(GTK_WINDOW(priv->zathura->ui.session->gtk.window));
-      }
+    if (handlers[idx].present_window == true) {
+      present_window(priv->zathura);
     }
 
     return;
@@ -546,6 +1000,24 @@ static const GDBusInterfaceVTable interface_vtable = {
 };
 
 static const unsigned int TIMEOUT = 3000;
+/* SynctexView is answered once the position is shown, which may have to wait
+ * for the SyncTeX file to be parsed */
+static const unsigned int SYNCTEX_VIEW_TIMEOUT = 30000;
+
+/* Whether the instance received the position, even if it did not answer in
+ * time. Another window must not be opened for a document that is open. */
+static bool synctex_view_received(const char* name, GVariant* ret, const GError* error) {
+  if (ret != NULL) {
+    return true;
+  }
+
+  if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT) == TRUE) {
+    girara_warning("'%s' did not answer SynctexView in time, assuming it shows the position.", name);
+    return true;
+  }
+
+  return false;
+}
 
 static bool call_synctex_view(GDBusConnection* connection, const char* filename, const char* name,
                               const char* input_file, unsigned int line, unsigned int column) {
@@ -570,14 +1042,35 @@ static bool call_synctex_view(GDBusConnection* connection, const char* filename,
 
   g_autoptr(GVariant) ret = g_dbus_connection_call_sync(
       connection, name, DBUS_OBJPATH, DBUS_INTERFACE, "SynctexView", g_variant_new("(suu)", input_file, line, column),
-      G_VARIANT_TYPE("(b)"), G_DBUS_CALL_FLAGS_NONE, TIMEOUT, NULL, &error);
-  if (ret == NULL) {
+      G_VARIANT_TYPE("(b)"), G_DBUS_CALL_FLAGS_NONE, SYNCTEX_VIEW_TIMEOUT, NULL, &error);
+  if (synctex_view_received(name, ret, error) == false) {
     girara_error("Failed to run SynctexView on '%s': %s", name, error->message);
     return false;
   }
   return true;
 }
 
+/* Forward the position to the instance owning the bus name of the document. */
+static bool call_synctex_view_document(GDBusConnection* connection, const char* filename, const char* input_file,
+                                      unsigned int line, unsigned int column) {
+  g_autofree char* name   = document_bus_name(filename);
+  g_autoptr(GError) error = NULL;
+  g_autoptr(GVariant) ret = g_dbus_connection_call_sync(
+      connection, name, DBUS_OBJPATH, DBUS_INTERFACE, "SynctexView", g_variant_new("(suu)", input_file, line, column),
+      G_VARIANT_TYPE("(b)"), G_DBUS_CALL_FLAGS_NO_AUTO_START, SYNCTEX_VIEW_TIMEOUT, NULL, &error);
+  if (synctex_view_received(name, ret, error) == false) {
+    if (g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_NAME_HAS_NO_OWNER) == TRUE ||
+        g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_SERVICE_UNKNOWN) == TRUE) {
+      girara_debug("No instance registered '%s'.", name);
+    } else {
+      girara_error("Failed to run SynctexView on '%s': %s", name, error->message);
+    }
+    return false;
+  }
+
+  return true;
+}
+
 static int iterate_instances_call_synctex_view(const char* filename, const char* input_file, unsigned int line,
                                                unsigned int column, pid_t hint) {
   if (filename == NULL) {
@@ -597,6 +1090,12 @@ static int iterate_instances_call_synctex_view(const char* filename, const char*
     return ret ? 1 : -1;
   }
 
+  /* instances own a bus name derived from the path of their document */
+  if (call_synctex_view_document(connection, filename, input_file, line, column) == true) {
+    return 1;
+  }
+
+  /* fall back to asking every instance, e.g. of older versions */
   g_autoptr(GVariant) vnames = g_dbus_connection_call_sync(
       connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames", NULL,
       G_VARIANT_TYPE("(as)"), G_DBUS_CALL_FLAGS_NONE, TIMEOUT, NULL, &error);
@@ -31,6 +31,17 @@ GType zathura_dbus_get_type(void) G_GNUC_CONST;
 ZathuraDbus* zathura_dbus_new(zathura_t* zathura);
 const char* zathura_dbus_get_name(zathura_t* zathura);
 
+/**
+ * Register the open document on the D-Bus connection. The instance owns a bus
+ * name derived from the path of the document, so that forward searches find
+ * it with a single call. Registering the same document again, e.g. after a
+ * reload, keeps the name.
+ *
+ * @param zathura Zathura session
+ * @param filename path of the open document, or NULL if it was closed
+ */
+void zathura_dbus_set_document(zathura_t* zathura, const char* filename);
+
 /**
  * Emit the 'Edit' signal on the D-Bus connection.
  *
@@ -0,0 +1,247 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <gio/gio.h>
+#include <girara/utils.h>
+
+#include "dir-cache.h"
+#include "content-type.h"
+#include "macros.h"
+
+/* number of directories kept in the cache */
+#define DIR_CACHE_MAX_DIRECTORIES 64
+/* time in µs after which a cached listing is checked for changes again */
+#define DIR_CACHE_CHECK_INTERVAL (2 * G_USEC_PER_SEC)
+
+typedef struct dir_cache_listing_s {
+  GPtrArray* entries; /**< zathura_dir_entry_t */
+  gint64 mtime;       /**< Modification time of the directory in µs */
+  gint64 checked;     /**< Monotonic time of the last check for changes */
+  gint64 used;        /**< Monotonic time of the last lookup */
+} dir_cache_listing_t;
+
+struct zathura_dir_cache_s {
+  GHashTable* listings;      /**< path -> dir_cache_listing_t */
+  GHashTable* scanning;      /**< Paths of the directories being scanned */
+  GCancellable* cancellable; /**< Cancelled when the cache is freed */
+  zathura_dir_cache_changed_t callback;
+  void* data;
+};
+
+typedef struct dir_cache_scan_s {
+  char* path;
+  gint64 mtime;       /**< Modification time of the cached listing, -1 if none */
+  gint64 new_mtime;   /**< Modification time of the directory when it was read */
+  GPtrArray* entries; /**< New listing, NULL if the directory did not change */
+} dir_cache_scan_t;
+
+static void dir_entry_free(void* data) {
+  zathura_dir_entry_t* entry = data;
+  g_free(entry->name);
+  g_free(entry->content_type);
+  g_free(entry);
+}
+
+static void dir_cache_listing_free(void* data) {
+  dir_cache_listing_t* listing = data;
+  g_ptr_array_unref(listing->entries);
+  g_free(listing);
+}
+
+zathura_dir_cache_t* zathura_dir_cache_new(void) {
+  zathura_dir_cache_t* cache = g_try_malloc0(sizeof(zathura_dir_cache_t));
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  cache->listings    = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, dir_cache_listing_free);
+  cache->scanning    = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  cache->cancellable = g_cancellable_new();
+
+  return cache;
+}
+
+void zathura_dir_cache_free(zathura_dir_cache_t* cache) {
+  if (cache == NULL) {
+    return;
+  }
+
+  g_cancellable_cancel(cache->cancellable);
+  g_object_unref(cache->cancellable);
+  g_hash_table_unref(cache->scanning);
+  g_hash_table_unref(cache->listings);
+  g_free(cache);
+}
+
+void zathura_dir_cache_set_callback(zathura_dir_cache_t* cache, zathura_dir_cache_changed_t callback, void* data) {
+  g_return_if_fail(cache != NULL);
+
+  cache->callback = callback;
+  cache->data     = data;
+}
+
+static gint64 dir_cache_mtime(GFile* directory, GCancellable* cancellable) {
+  g_autoptr(GFileInfo) info =
+      g_file_query_info(directory, G_FILE_ATTRIBUTE_TIME_MODIFIED "," G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC,
+                        G_FILE_QUERY_INFO_NONE, cancellable, NULL);
+  if (info == NULL) {
+    return -1;
+  }
+
+  return g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED) * G_USEC_PER_SEC +
+         g_file_info_get_attribute_uint32(info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+}
+
+static void dir_cache_scan_thread(GTask* task, gpointer UNUSED(source), gpointer data, GCancellable* cancellable) {
+  dir_cache_scan_t* scan     = data;
+  g_autoptr(GFile) directory = g_file_new_for_path(scan->path);
+
+  /* the modification time is taken before reading the directory, so changes
+   * made while reading are picked up by the next check */
+  scan->new_mtime = dir_cache_mtime(directory, cancellable);
+  if (scan->new_mtime != -1 && scan->new_mtime == scan->mtime) {
+    g_task_return_boolean(task, TRUE);
+    return;
+  }
+
+  GError* error = NULL;
+  g_autoptr(GFileEnumerator) enumerator =
+      g_file_enumerate_children(directory, G_FILE_ATTRIBUTE_STANDARD_NAME "," G_FILE_ATTRIBUTE_STANDARD_TYPE,
+                                G_FILE_QUERY_INFO_NONE, cancellable, &error);
+  if (enumerator == NULL) {
+    g_task_return_error(task, error);
+    return;
+  }
+
+  zathura_content_type_context_t* content_type_context = zathura_content_type_new();
+  GPtrArray* entries                                   = g_ptr_array_new_with_free_func(dir_entry_free);
+
+  GFileInfo* info = NULL;
+  while (g_file_enumerator_iterate(enumerator, &info, NULL, cancellable, NULL) == TRUE && info != NULL) {
+    const char* name           = g_file_info_get_name(info);
+    zathura_dir_entry_t* entry = g_new0(zathura_dir_entry_t, 1);
+    entry->name                = g_filename_display_name(name);
+    entry->is_dir              = g_file_info_get_file_type(info) == G_FILE_TYPE_DIRECTORY;
+    if (entry->is_dir == false) {
+      g_autofree char* path = g_build_filename(scan->path, name, NULL);
+      entry->content_type   = zathura_content_type_guess(content_type_context, path, NULL);
+    }
+    g_ptr_array_add(entries, entry);
+  }
+
+  zathura_content_type_free(content_type_context);
+  scan->entries = entries;
+
+  g_task_return_boolean(task, TRUE);
+}
+
+static void dir_cache_scan_free(void* data) {
+  dir_cache_scan_t* scan = data;
+  if (scan->entries != NULL) {
+    g_ptr_array_unref(scan->entries);
+  }
+  g_free(scan->path);
+  g_free(scan);
+}
+
+/* Drop the least recently used listing if the cache is full. */
+static void dir_cache_evict(zathura_dir_cache_t* cache) {
+  if (g_hash_table_size(cache->listings) < DIR_CACHE_MAX_DIRECTORIES) {
+    return;
+  }
+
+  const char* oldest_path = NULL;
+  gint64 oldest           = G_MAXINT64;
+  GHashTableIter iter;
+  gpointer path    = NULL;
+  gpointer listing = NULL;
+  g_hash_table_iter_init(&iter, cache->listings);
+  while (g_hash_table_iter_next(&iter, &path, &listing) == TRUE) {
+    if (((dir_cache_listing_t*)listing)->used < oldest) {
+      oldest      = ((dir_cache_listing_t*)listing)->used;
+      oldest_path = path;
+    }
+  }
+
+  g_hash_table_remove(cache->listings, oldest_path);
+}
+
+static void dir_cache_scan_done(GObject* UNUSED(source), GAsyncResult* result, gpointer data) {
+  g_autoptr(GError) error = NULL;
+  if (g_task_propagate_boolean(G_TASK(result), &error) == FALSE &&
+      g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED) == TRUE) {
+    /* the cache has been freed in the meantime */
+    return;
+  }
+
+  zathura_dir_cache_t* cache = data;
+  dir_cache_scan_t* scan     = g_task_get_task_data(G_TASK(result));
+  const gint64 now           = g_get_monotonic_time();
+  g_hash_table_remove(cache->scanning, scan->path);
+
+  if (error != NULL) {
+    girara_debug("Failed to read directory '%s': %s", scan->path, error->message);
+    g_hash_table_remove(cache->listings, scan->path);
+    return;
+  }
+
+  dir_cache_listing_t* listing = g_hash_table_lookup(cache->listings, scan->path);
+  if (scan->entries == NULL) {
+    /* unchanged */
+    if (listing != NULL) {
+      listing->checked = now;
+    }
+    return;
+  }
+
+  if (listing == NULL) {
+    dir_cache_evict(cache);
+    listing       = g_new0(dir_cache_listing_t, 1);
+    listing->used = now;
+    g_hash_table_insert(cache->listings, g_strdup(scan->path), listing);
+  } else {
+    g_ptr_array_unref(listing->entries);
+  }
+
+  listing->entries = g_steal_pointer(&scan->entries);
+  listing->mtime   = scan->new_mtime;
+  listing->checked = now;
+  girara_debug("Read %u entries of directory '%s'.", listing->entries->len, scan->path);
+
+  if (cache->callback != NULL) {
+    cache->callback(cache, scan->path, cache->data);
+  }
+}
+
+static void dir_cache_scan(zathura_dir_cache_t* cache, const char* path, gint64 mtime) {
+  if (g_hash_table_contains(cache->scanning, path) == TRUE) {
+    return;
+  }
+
+  g_hash_table_add(cache->scanning, g_strdup(path));
+
+  dir_cache_scan_t* scan = g_new0(dir_cache_scan_t, 1);
+  scan->path             = g_strdup(path);
+  scan->mtime            = mtime;
+
+  g_autoptr(GTask) task = g_task_new(NULL, cache->cancellable, dir_cache_scan_done, cache);
+  g_task_set_task_data(task, scan, dir_cache_scan_free);
+  g_task_run_in_thread(task, dir_cache_scan_thread);
+}
+
+GPtrArray* zathura_dir_cache_get(zathura_dir_cache_t* cache, const char* path) {
+  g_return_val_if_fail(cache != NULL && path != NULL, NULL);
+
+  g_autofree char* key         = g_canonicalize_filename(path, NULL);
+  const gint64 now             = g_get_monotonic_time();
+  dir_cache_listing_t* listing = g_hash_table_lookup(cache->listings, key);
+
+  if (listing == NULL || now - listing->checked >= DIR_CACHE_CHECK_INTERVAL) {
+    dir_cache_scan(cache, key, listing != NULL ? listing->mtime : -1);
+  }
+  if (listing == NULL) {
+    return NULL;
+  }
+
+  listing->used = now;
+  return g_ptr_array_ref(listing->entries);
+}
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_DIR_CACHE_H
+#define ZATHURA_DIR_CACHE_H
+
+#include <stdbool.h>
+#include <glib.h>
+
+/**
+ * Cache of directory listings. Listings are read in a background thread and
+ * kept together with the modification time of the directory; a cached
+ * listing is served immediately and re-read in the background once the
+ * directory changed. All functions have to be called from the main thread.
+ */
+typedef struct zathura_dir_cache_s zathura_dir_cache_t;
+
+/**
+ * An entry of a directory listing
+ */
+typedef struct zathura_dir_entry_s {
+  char* name;         /**< Name of the entry for display */
+  bool is_dir;        /**< The entry is a directory */
+  char* content_type; /**< Content type of a file, NULL for directories and unknown types */
+} zathura_dir_entry_t;
+
+/**
+ * Called after the listing of a directory was read or changed.
+ *
+ * @param cache The cache
+ * @param path The path of the directory
+ * @param data User data
+ */
+typedef void (*zathura_dir_cache_changed_t)(zathura_dir_cache_t* cache, const char* path, void* data);
+
+/**
+ * Create a new, empty cache.
+ *
+ * @return new cache
+ */
+zathura_dir_cache_t* zathura_dir_cache_new(void);
+
+/**
+ * Free the cache and stop running scans.
+ *
+ * @param cache The cache
+ */
+void zathura_dir_cache_free(zathura_dir_cache_t* cache);
+
+/**
+ * Set the function called after a listing was read or changed.
+ *
+ * @param cache The cache
+ * @param callback The callback
+ * @param data User data passed to callback
+ */
+void zathura_dir_cache_set_callback(zathura_dir_cache_t* cache, zathura_dir_cache_changed_t callback, void* data);
+
+/**
+ * Get the cached listing of a directory. If the directory is not cached yet
+ * or was not checked for changes recently, it is scanned in the background
+ * and the callback is invoked once the listing is available or changed.
+ *
+ * @param cache The cache
+ * @param path The path of the directory
+ * @return array of zathura_dir_entry_t*, free with g_ptr_array_unref, or NULL
+ * if the directory has not been read yet
+ */
+GPtrArray* zathura_dir_cache_get(zathura_dir_cache_t* cache, const char* path);
+
+#endif
@@ -55,6 +55,12 @@ struct zathura_document_s {
    */
   zathura_page_t** pages;
 
+  /**
+   * Page label -> index of the first page with that label; NULL if no page
+   * has a label. The keys are owned by the pages.
+   */
+  GHashTable* page_labels;
+
   /**
    * Used plugin
    */
@@ -127,6 +133,43 @@ zathura_document_t* zathura_document_open(zathura_t* zathura, const char* path,
     return NULL;
   }
 
+  zathura_document_t* document = zathura_document_open_with_plugin(plugin, real_path, uri, password, error);
+  if (document != NULL) {
+    hash_file_sha256(document->hash_sha256, document->file_path);
+  }
+
+  return document;
+}
+
+zathura_document_t* zathura_document_open_with_plugin(const zathura_plugin_t* plugin, const char* path,
+                                                      const char* uri, const char* password, zathura_error_t* error) {
+  if (plugin == NULL || path == NULL) {
+    zathura_check_set_error(error, ZATHURA_ERROR_INVALID_ARGUMENTS);
+    return NULL;
+  }
+
+  /* loads the plugin if it has not been used yet */
+  const zathura_plugin_functions_t* functions = zathura_plugin_get_functions(plugin);
+  if (functions == NULL) {
+    girara_error("Could not load plugin '%s'.", zathura_plugin_get_path(plugin));
+    zathura_check_set_error(error, ZATHURA_ERROR_UNKNOWN);
+    return NULL;
+  }
+
+  g_autoptr(GFile) file = g_file_new_for_path(path);
+  if (file == NULL) {
+    girara_error("Error while handling path '%s'.", path);
+    zathura_check_set_error(error, ZATHURA_ERROR_UNKNOWN);
+    return NULL;
+  }
+
+  g_autofree char* real_path = g_file_get_path(file);
+  if (real_path == NULL) {
+    girara_error("Error while handling path '%s'.", path);
+    zathura_check_set_error(error, ZATHURA_ERROR_UNKNOWN);
+    return NULL;
+  }
+
   zathura_document_t* document = g_try_malloc0(sizeof(zathura_document_t));
   if (document == NULL) {
     zathura_check_set_error(error, ZATHURA_ERROR_OUT_OF_MEMORY);
@@ -141,7 +184,6 @@ zathura_document_t* zathura_document_open(zathura_t* zathura, const char* path,
     g_autoptr(GFile) gf = g_file_new_for_uri(document->uri);
     document->basename  = g_file_get_basename(gf);
   }
-  hash_file_sha256(document->hash_sha256, document->file_path);
   document->password         = password;
   document->zoom             = 1.0;
   document->plugin           = plugin;
@@ -160,8 +202,6 @@ zathura_document_t* zathura_document_open(zathura_t* zathura, const char* path,
   real_path = NULL;
 
   /* open document */
-  const zathura_plugin_functions_t* functions = zathura_plugin_get_functions(plugin);
-
   zathura_error_t int_error = functions->document_open(document);
   if (int_error != ZATHURA_ERROR_OK) {
     zathura_check_set_error(error, int_error);
@@ -185,6 +225,17 @@ zathura_document_t* zathura_document_open(zathura_t* zathura, const char* path,
 
     document->pages[page_id] = page;
 
+    /* labels are requested from the plugin once when the page is created */
+    const char* label = zathura_page_get_label(page, NULL);
+    if (label != NULL) {
+      if (document->page_labels == NULL) {
+        document->page_labels = g_hash_table_new(g_str_hash, g_str_equal);
+      }
+      if (g_hash_table_contains(document->page_labels, label) == FALSE) {
+        g_hash_table_insert(document->page_labels, (gpointer)label, GUINT_TO_POINTER(page_id));
+      }
+    }
+
     /* cell_width and cell_height is the maximum of all the pages width and height */
     const double width = zathura_page_get_width(page);
     if (document->cell_width < width) {
@@ -213,6 +264,10 @@ zathura_error_t zathura_document_free(zathura_document_t* document) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  if (document->page_labels != NULL) {
+    g_hash_table_unref(document->page_labels);
+  }
+
   if (document->pages != NULL) {
     /* free pages */
     for (unsigned int page_id = 0; page_id < document->number_of_pages; page_id++) {
@@ -284,6 +339,22 @@ zathura_page_t* zathura_document_get_page(zathura_document_t* document, unsigned
   return document->pages[index];
 }
 
+bool zathura_document_find_page_label(zathura_document_t* document, const char* label, unsigned int* index) {
+  if (document == NULL || document->page_labels == NULL || label == NULL) {
+    return false;
+  }
+
+  gpointer value = NULL;
+  if (g_hash_table_lookup_extended(document->page_labels, label, NULL, &value) == FALSE) {
+    return false;
+  }
+
+  if (index != NULL) {
+    *index = GPOINTER_TO_UINT(value);
+  }
+  return true;
+}
+
 void* zathura_document_get_data(zathura_document_t* document) {
   if (document == NULL) {
     return NULL;
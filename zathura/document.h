@@ -22,6 +22,21 @@
 zathura_document_t* zathura_document_open(zathura_t* zathura, const char* path, const char* uri, const char* password,
                                           zathura_error_t* error);
 
+/**
+ * Open the document with the given plugin. Unlike \ref zathura_document_open,
+ * this function does not touch the zathura instance and may be called from
+ * any thread. The SHA256 hash of the file is not computed.
+ *
+ * @param plugin The plugin handling the document
+ * @param path Path to the document
+ * @param uri URI of the document or NULL
+ * @param password Password of the document or NULL
+ * @param error Optional error parameter
+ * @return The document object and NULL if an error occurs
+ */
+zathura_document_t* zathura_document_open_with_plugin(const zathura_plugin_t* plugin, const char* path,
+                                                      const char* uri, const char* password, zathura_error_t* error);
+
 /**
  * Free the document
  *
@@ -80,6 +95,17 @@ ZATHURA_PLUGIN_API const char* zathura_document_get_password(zathura_document_t*
  */
 ZATHURA_PLUGIN_API zathura_page_t* zathura_document_get_page(zathura_document_t* document, unsigned int index);
 
+/**
+ * Find the page with the given label. The lookup uses a table built when the
+ * document is opened and does not call the plugin.
+ *
+ * @param document The document
+ * @param label The page label
+ * @param index Set to the index of the first page with the label
+ * @return true if a page has the label, false otherwise
+ */
+bool zathura_document_find_page_label(zathura_document_t* document, const char* label, unsigned int* index);
+
 /**
  * Returns the number of pages
  *
@@ -0,0 +1,303 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <girara/log.h>
+#include <glib/gstdio.h>
+
+#include "export.h"
+#include "document.h"
+#include "page.h"
+
+/* upper bound of the worker threads; every worker keeps one page in memory */
+#define EXPORT_MAX_THREADS 4
+#define EXPORT_JPEG_QUALITY "90"
+
+struct zathura_export_s {
+  zathura_document_t* document;
+  ZathuraRenderer* renderer;
+  zathura_export_options_t options;
+  char* directory;
+  int digits; /**< Width of the page numbers in the file names */
+  zathura_export_progress_t callback;
+  void* data;
+
+  GThreadPool* pool;
+  gint cancelled;
+  GMutex lock;
+  unsigned int exported; /**< Number of written pages */
+  unsigned int failed;   /**< Number of pages that could not be exported */
+  guint idle;            /**< Source reporting the progress to the main loop */
+};
+
+static bool parse_page_number(const char* input, unsigned int number_of_pages, unsigned int* page) {
+  char* end                      = NULL;
+  const unsigned long long value = g_ascii_strtoull(input, &end, 10);
+  if (end == input || *end != '\0' || value == 0 || value > number_of_pages) {
+    return false;
+  }
+
+  *page = value - 1;
+  return true;
+}
+
+bool zathura_export_parse_range(const char* range, unsigned int number_of_pages, unsigned int* first_page,
+                                unsigned int* last_page) {
+  if (range == NULL || first_page == NULL || last_page == NULL || number_of_pages == 0) {
+    return false;
+  }
+
+  if (g_strcmp0(range, "all") == 0 || g_strcmp0(range, "-") == 0) {
+    *first_page = 0;
+    *last_page  = number_of_pages - 1;
+    return true;
+  }
+
+  const char* separator = strchr(range, '-');
+  if (separator == NULL) {
+    if (parse_page_number(range, number_of_pages, first_page) == false) {
+      return false;
+    }
+    *last_page = *first_page;
+    return true;
+  }
+
+  g_autofree char* first = g_strndup(range, separator - range);
+  const char* last       = separator + 1;
+  unsigned int from      = 0;
+  unsigned int to        = number_of_pages - 1;
+  if ((*first != '\0' && parse_page_number(first, number_of_pages, &from) == false) ||
+      (*last != '\0' && parse_page_number(last, number_of_pages, &to) == false) || from > to) {
+    return false;
+  }
+
+  *first_page = from;
+  *last_page  = to;
+  return true;
+}
+
+bool zathura_export_parse_format(const char* name, zathura_export_format_t* format) {
+  if (name == NULL || format == NULL) {
+    return false;
+  }
+
+  if (g_ascii_strcasecmp(name, "png") == 0) {
+    *format = ZATHURA_EXPORT_PNG;
+  } else if (g_ascii_strcasecmp(name, "jpeg") == 0 || g_ascii_strcasecmp(name, "jpg") == 0) {
+    *format = ZATHURA_EXPORT_JPEG;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+static cairo_surface_t* export_render(zathura_export_t* export, zathura_page_t* page) {
+  const double scale = export->options.dpi / 72.0;
+  const int width    = ceil(zathura_page_get_width(page) * scale);
+  const int height   = ceil(zathura_page_get_height(page) * scale);
+
+  cairo_surface_t* surface =
+      cairo_image_surface_create(export->options.recolor == true ? CAIRO_FORMAT_ARGB32 : CAIRO_FORMAT_RGB24, width,
+                                 height);
+  if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(surface);
+    return NULL;
+  }
+
+  cairo_t* cairo = cairo_create(surface);
+  if (cairo_status(cairo) != CAIRO_STATUS_SUCCESS) {
+    cairo_destroy(cairo);
+    cairo_surface_destroy(surface);
+    return NULL;
+  }
+
+  cairo_set_source_rgb(cairo, 1, 1, 1);
+  cairo_paint(cairo);
+  cairo_scale(cairo, scale, scale);
+
+  /* plugins are not required to be thread-safe */
+  zathura_renderer_lock(export->renderer);
+  const zathura_error_t error = zathura_page_render(page, cairo, false);
+  zathura_renderer_unlock(export->renderer);
+  cairo_destroy(cairo);
+
+  if (error != ZATHURA_ERROR_OK) {
+    cairo_surface_destroy(surface);
+    return NULL;
+  }
+
+  if (export->options.recolor == true) {
+    zathura_renderer_recolor_surface(export->renderer, page, surface, scale);
+  }
+
+  return surface;
+}
+
+static bool export_write(zathura_export_t* export, cairo_surface_t* surface, const char* path) {
+  if (export->options.format == ZATHURA_EXPORT_PNG) {
+    const cairo_status_t status = cairo_surface_write_to_png(surface, path);
+    if (status != CAIRO_STATUS_SUCCESS) {
+      girara_debug("Failed to write '%s': %s", path, cairo_status_to_string(status));
+      return false;
+    }
+
+    return true;
+  }
+
+  g_autoptr(GdkPixbuf) pixbuf = gdk_pixbuf_get_from_surface(surface, 0, 0, cairo_image_surface_get_width(surface),
+                                                            cairo_image_surface_get_height(surface));
+  if (pixbuf == NULL) {
+    return false;
+  }
+
+  g_autoptr(GError) error = NULL;
+  if (gdk_pixbuf_save(pixbuf, path, "jpeg", &error, "quality", EXPORT_JPEG_QUALITY, NULL) == FALSE) {
+    girara_debug("Failed to write '%s': %s", path, error->message);
+    return false;
+  }
+
+  return true;
+}
+
+static bool export_page(zathura_export_t* export, unsigned int page_id) {
+  zathura_page_t* page = zathura_document_get_page(export->document, page_id);
+  if (page == NULL) {
+    return false;
+  }
+
+  cairo_surface_t* surface = export_render(export, page);
+  if (surface == NULL) {
+    girara_debug("Failed to render page %u for export", page_id + 1);
+    return false;
+  }
+
+  if (export->directory == NULL) {
+    cairo_surface_destroy(surface);
+    return true;
+  }
+
+  g_autofree char* name =
+      g_strdup_printf("page-%0*u.%s", export->digits, page_id + 1,
+                      export->options.format == ZATHURA_EXPORT_PNG ? "png" : "jpg");
+  g_autofree char* path = g_build_filename(export->directory, name, NULL);
+  const bool ret        = export_write(export, surface, path);
+  cairo_surface_destroy(surface);
+
+  return ret;
+}
+
+static gboolean export_progress(gpointer data) {
+  zathura_export_t* export = data;
+
+  g_mutex_lock(&export->lock);
+  export->idle                = 0;
+  const unsigned int exported = export->exported;
+  const unsigned int failed   = export->failed;
+  g_mutex_unlock(&export->lock);
+
+  /* the callback may free the export */
+  export->callback(export, exported, failed, export->options.last_page - export->options.first_page + 1,
+                   export->data);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void export_thread(gpointer data, gpointer user_data) {
+  zathura_export_t* export   = user_data;
+  const unsigned int page_id = GPOINTER_TO_UINT(data) - 1;
+
+  bool ret = false;
+  if (g_atomic_int_get(&export->cancelled) == 0) {
+    ret = export_page(export, page_id);
+  }
+
+  g_mutex_lock(&export->lock);
+  if (ret == true) {
+    ++export->exported;
+  } else {
+    ++export->failed;
+  }
+  if (export->callback != NULL && export->idle == 0 && g_atomic_int_get(&export->cancelled) == 0) {
+    export->idle = g_idle_add(export_progress, export);
+  }
+  g_mutex_unlock(&export->lock);
+}
+
+zathura_export_t* zathura_export_pages(zathura_document_t* document, ZathuraRenderer* renderer,
+                                       const zathura_export_options_t* options, zathura_export_progress_t callback,
+                                       void* data) {
+  g_return_val_if_fail(document != NULL && renderer != NULL && options != NULL, NULL);
+  g_return_val_if_fail(options->first_page <= options->last_page && options->dpi > 0, NULL);
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+  g_return_val_if_fail(options->last_page < number_of_pages, NULL);
+
+  if (options->directory != NULL && g_mkdir_with_parents(options->directory, 0755) != 0) {
+    girara_debug("Failed to create '%s': %s", options->directory, g_strerror(errno));
+    return NULL;
+  }
+
+  zathura_export_t* export = g_new0(zathura_export_t, 1);
+  export->document         = document;
+  export->renderer         = g_object_ref(renderer);
+  export->options          = *options;
+  export->directory        = g_strdup(options->directory);
+  export->digits           = snprintf(NULL, 0, "%u", number_of_pages);
+  export->callback         = callback;
+  export->data             = data;
+  g_mutex_init(&export->lock);
+
+  export->options.directory = export->directory;
+
+  const unsigned int total   = options->last_page - options->first_page + 1;
+  const unsigned int threads =
+      MIN(options->threads > 0 ? options->threads : MIN(g_get_num_processors(), EXPORT_MAX_THREADS), total);
+  export->pool               = g_thread_pool_new(export_thread, export, threads, FALSE, NULL);
+  /* the queue only holds page numbers; pages are rendered when a worker takes them */
+  for (unsigned int page_id = options->first_page; page_id <= options->last_page; ++page_id) {
+    g_thread_pool_push(export->pool, GUINT_TO_POINTER(page_id + 1), NULL);
+  }
+
+  girara_debug("Exporting pages %u-%u at %u DPI with %u threads", options->first_page + 1, options->last_page + 1,
+               options->dpi, threads);
+  return export;
+}
+
+unsigned int zathura_export_wait(zathura_export_t* export) {
+  g_return_val_if_fail(export != NULL, 0);
+
+  if (export->pool != NULL) {
+    g_thread_pool_free(export->pool, FALSE, TRUE);
+    export->pool = NULL;
+  }
+
+  g_mutex_lock(&export->lock);
+  const unsigned int failed = export->failed;
+  g_mutex_unlock(&export->lock);
+
+  return failed;
+}
+
+void zathura_export_free(zathura_export_t* export) {
+  if (export == NULL) {
+    return;
+  }
+
+  g_atomic_int_set(&export->cancelled, 1);
+  if (export->pool != NULL) {
+    g_thread_pool_free(export->pool, TRUE, TRUE);
+  }
+  if (export->idle != 0) {
+    g_source_remove(export->idle);
+  }
+
+  g_clear_object(&export->renderer);
+  g_mutex_clear(&export->lock);
+  g_free(export->directory);
+  g_free(export);
+}
@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_EXPORT_H
+#define ZATHURA_EXPORT_H
+
+#include <stdbool.h>
+
+#include "types.h"
+#include "render.h"
+
+/**
+ * Export of rendered pages to image files. The pages of a range are rendered
+ * by a pool of worker threads; every worker renders, recolors, encodes and
+ * writes one page at a time, so at most one surface per worker is in memory.
+ * Rendering itself is serialized by the renderer lock, encoding runs in
+ * parallel.
+ */
+typedef struct zathura_export_s zathura_export_t;
+
+/**
+ * Image formats of exported pages
+ */
+typedef enum zathura_export_format_e {
+  ZATHURA_EXPORT_PNG,  /**< PNG */
+  ZATHURA_EXPORT_JPEG, /**< JPEG */
+} zathura_export_format_t;
+
+/**
+ * Options of an export
+ */
+typedef struct zathura_export_options_s {
+  unsigned int first_page;        /**< First page of the range */
+  unsigned int last_page;         /**< Last page of the range */
+  unsigned int dpi;               /**< Resolution of the images */
+  bool recolor;                   /**< Recolor the pages with the colors of the renderer */
+  zathura_export_format_t format; /**< Image format */
+  const char* directory;          /**< Directory the images are written to, NULL to only render the pages */
+  unsigned int threads;           /**< Number of worker threads, 0 for the default */
+} zathura_export_options_t;
+
+/**
+ * Callback of an export, invoked from the main loop after pages were written.
+ * It is invoked a last time once exported + failed equals total.
+ *
+ * @param export The export
+ * @param exported Number of written pages
+ * @param failed Number of pages that could not be rendered or written
+ * @param total Number of pages in the range
+ * @param data Custom data
+ */
+typedef void (*zathura_export_progress_t)(zathura_export_t* export, unsigned int exported, unsigned int failed,
+                                          unsigned int total, void* data);
+
+/**
+ * Parse a page range: "N", "N-M", "N-", "-M" or "all", with page numbers
+ * starting at 1.
+ *
+ * @param range The range
+ * @param number_of_pages Number of pages of the document
+ * @param first_page Set to the index of the first page
+ * @param last_page Set to the index of the last page
+ * @return true if the range is valid
+ */
+bool zathura_export_parse_range(const char* range, unsigned int number_of_pages, unsigned int* first_page,
+                                unsigned int* last_page);
+
+/**
+ * Parse the name of an image format, "png" or "jpeg".
+ *
+ * @param name The name of the format
+ * @param format Set to the format
+ * @return true if the format is known
+ */
+bool zathura_export_parse_format(const char* name, zathura_export_format_t* format);
+
+/**
+ * Start exporting pages. The images are named page-N.png or page-N.jpg in the
+ * directory, which is created if needed.
+ *
+ * @param document The document; it has to outlive the export
+ * @param renderer The renderer; locked while a page is rendered and providing
+ *   the recoloring colors
+ * @param options The export options
+ * @param callback Invoked when pages were written, can be NULL
+ * @param data Custom data passed to the callback
+ * @return the running export, or NULL if the directory cannot be created
+ */
+zathura_export_t* zathura_export_pages(zathura_document_t* document, ZathuraRenderer* renderer,
+                                       const zathura_export_options_t* options, zathura_export_progress_t callback,
+                                       void* data);
+
+/**
+ * Wait until all pages are written.
+ *
+ * @param export The export
+ * @return the number of pages that could not be exported
+ */
+unsigned int zathura_export_wait(zathura_export_t* export);
+
+/**
+ * Free the export. Pages that were not started yet are skipped. Has to be
+ * called before the document is freed.
+ *
+ * @param export The export
+ */
+void zathura_export_free(zathura_export_t* export);
+
+#endif
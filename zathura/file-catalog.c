@@ -0,0 +1,537 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <girara/datastructures.h>
+#include <girara/utils.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "file-catalog.h"
+#include "girara-compat.h"
+#include "macros.h"
+
+/* maximal depth of directories below the roots */
+#define CATALOG_MAX_DEPTH 5
+/* number of changed entries the scanner hands over to the main thread at once */
+#define CATALOG_BATCH_SIZE 512
+/* delay in ms before rescanning after a directory was created or removed */
+#define CATALOG_RESCAN_DELAY 1000
+/* maximal number of page counts kept for documents not in the catalog yet */
+#define CATALOG_MAX_PENDING_PAGES 256
+
+struct zathura_file_catalog_s {
+  ZathuraDatabase* database;
+  char** roots;
+  GHashTable* entries;       /**< path -> zathura_catalog_entry_t */
+  GHashTable* monitors;      /**< directory -> GFileMonitor */
+  GHashTable* pages;         /**< path -> page count of documents not in the catalog yet */
+  GCancellable* cancellable; /**< Cancelled when the catalog is freed */
+  guint generation;          /**< Incremented whenever documents are added or removed */
+  bool scanning;             /**< A scan is running */
+  bool rescan;               /**< Scan again once the running scan finished */
+  guint rescan_timeout;
+  zathura_file_catalog_changed_t callback;
+  void* data;
+};
+
+typedef struct catalog_scan_s {
+  zathura_file_catalog_t* catalog; /**< Only to be used on the main thread */
+  GCancellable* cancellable;
+  GMainContext* context;
+  char** roots;
+  GHashTable* known;      /**< path -> entry known before the scan, removed once seen */
+  GPtrArray* directories; /**< Scanned directories */
+  GPtrArray* changed;     /**< New and changed entries of the current batch */
+} catalog_scan_t;
+
+typedef struct catalog_batch_s {
+  zathura_file_catalog_t* catalog;
+  GCancellable* cancellable;
+  GPtrArray* changed;     /**< zathura_catalog_entry_t */
+  GPtrArray* removed;     /**< paths */
+  GPtrArray* directories; /**< Scanned directories if this is the last batch of a scan, otherwise NULL */
+} catalog_batch_t;
+
+static void catalog_entry_free(void* p) {
+  zathura_catalog_entry_t* entry = p;
+  zathura_catalog_entry_free(entry);
+}
+
+static zathura_catalog_entry_t* catalog_entry_new(const char* path, const GStatBuf* st) {
+  zathura_catalog_entry_t* entry = g_new0(zathura_catalog_entry_t, 1);
+  entry->path                    = g_strdup(path);
+  entry->size                    = st->st_size;
+  entry->mtime                   = st->st_mtime;
+  return entry;
+}
+
+static zathura_catalog_entry_t* catalog_entry_copy(const zathura_catalog_entry_t* entry) {
+  zathura_catalog_entry_t* copy = g_new0(zathura_catalog_entry_t, 1);
+  *copy                         = *entry;
+  copy->path                    = g_strdup(entry->path);
+  return copy;
+}
+
+static void catalog_monitor_free(void* p) {
+  GFileMonitor* monitor = p;
+  g_file_monitor_cancel(monitor);
+  g_object_unref(monitor);
+}
+
+bool zathura_file_catalog_is_supported(const char* name) {
+  const char* ext = strrchr(name, '.');
+  if (ext == NULL) {
+    return false;
+  }
+  ext++; /* Skip the dot */
+
+  /* Supported document extensions */
+  static const char* supported[] = {"pdf", "epub", "djvu", "ps", "cbz", "cbr", "xps", "oxps"};
+  for (size_t idx = 0; idx < LENGTH(supported); ++idx) {
+    if (g_ascii_strcasecmp(ext, supported[idx]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+zathura_file_catalog_t* zathura_file_catalog_new(ZathuraDatabase* database, const char* const* roots) {
+  zathura_file_catalog_t* catalog = g_try_malloc0(sizeof(zathura_file_catalog_t));
+  if (catalog == NULL) {
+    return NULL;
+  }
+
+  catalog->database    = database;
+  catalog->roots       = g_strdupv((char**)roots);
+  catalog->entries     = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, catalog_entry_free);
+  catalog->monitors    = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, catalog_monitor_free);
+  catalog->pages       = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  catalog->cancellable = g_cancellable_new();
+
+  if (database != NULL) {
+    g_autoptr(girara_list_t) entries = zathura_db_load_catalog(database);
+    for (size_t idx = 0; entries != NULL && idx != girara_list_size(entries); ++idx) {
+      zathura_catalog_entry_t* entry = catalog_entry_copy(girara_list_nth(entries, idx));
+      g_hash_table_replace(catalog->entries, entry->path, entry);
+    }
+    girara_debug("Loaded %u documents from the catalog.", g_hash_table_size(catalog->entries));
+  }
+
+  return catalog;
+}
+
+void zathura_file_catalog_free(zathura_file_catalog_t* catalog) {
+  if (catalog == NULL) {
+    return;
+  }
+
+  /* stops the scanner and drops batches that were not applied yet */
+  g_cancellable_cancel(catalog->cancellable);
+  g_object_unref(catalog->cancellable);
+
+  if (catalog->rescan_timeout > 0) {
+    g_source_remove(catalog->rescan_timeout);
+  }
+
+  g_hash_table_unref(catalog->monitors);
+  g_hash_table_unref(catalog->pages);
+  g_hash_table_unref(catalog->entries);
+  g_strfreev(catalog->roots);
+  g_free(catalog);
+}
+
+void zathura_file_catalog_set_callback(zathura_file_catalog_t* catalog, zathura_file_catalog_changed_t callback,
+                                       void* data) {
+  g_return_if_fail(catalog != NULL);
+
+  catalog->callback = callback;
+  catalog->data     = data;
+}
+
+/* Apply new, changed and removed entries. Takes ownership of the entries in
+ * changed. */
+static void catalog_apply(zathura_file_catalog_t* catalog, GPtrArray* changed, GPtrArray* removed) {
+  g_autoptr(girara_list_t) entries       = girara_list_new();
+  g_autoptr(girara_list_t) added         = girara_list_new();
+  g_autoptr(girara_list_t) removed_paths = girara_list_new_with_free(g_free);
+
+  for (guint idx = 0; idx != changed->len; ++idx) {
+    zathura_catalog_entry_t* entry     = g_ptr_array_index(changed, idx);
+    const zathura_catalog_entry_t* old = g_hash_table_lookup(catalog->entries, entry->path);
+    if (old != NULL && old->size == entry->size && old->mtime == entry->mtime) {
+      continue;
+    }
+
+    if (old == NULL) {
+      girara_list_append(added, entry->path);
+
+      /* the document was opened before the scan found it */
+      gpointer pages = NULL;
+      if (g_hash_table_lookup_extended(catalog->pages, entry->path, NULL, &pages) == TRUE) {
+        entry->pages = GPOINTER_TO_UINT(pages);
+        g_hash_table_remove(catalog->pages, entry->path);
+      }
+    }
+    girara_list_append(entries, entry);
+    g_hash_table_replace(catalog->entries, entry->path, entry);
+    g_ptr_array_index(changed, idx) = NULL;
+  }
+
+  for (guint idx = 0; idx != removed->len; ++idx) {
+    const char* path = g_ptr_array_index(removed, idx);
+    if (g_hash_table_contains(catalog->entries, path) == TRUE) {
+      girara_list_append(removed_paths, g_strdup(path));
+      g_hash_table_remove(catalog->entries, path);
+    }
+  }
+
+  if (girara_list_size(entries) == 0 && girara_list_size(removed_paths) == 0) {
+    return;
+  }
+
+  if (girara_list_size(added) != 0 || girara_list_size(removed_paths) != 0) {
+    ++catalog->generation;
+  }
+
+  if (catalog->database != NULL) {
+    zathura_db_update_catalog(catalog->database, entries, removed_paths);
+  }
+
+  if (catalog->callback != NULL && (girara_list_size(added) != 0 || girara_list_size(removed_paths) != 0)) {
+    catalog->callback(catalog, added, removed_paths, catalog->data);
+  }
+}
+
+static void catalog_batch_free(void* data) {
+  catalog_batch_t* batch = data;
+  g_object_unref(batch->cancellable);
+  g_ptr_array_unref(batch->changed);
+  g_ptr_array_unref(batch->removed);
+  if (batch->directories != NULL) {
+    g_ptr_array_unref(batch->directories);
+  }
+  g_free(batch);
+}
+
+static void catalog_scan_finish(zathura_file_catalog_t* catalog, GPtrArray* directories);
+
+static gboolean catalog_batch_apply(void* data) {
+  catalog_batch_t* batch = data;
+  if (g_cancellable_is_cancelled(batch->cancellable) == FALSE) {
+    catalog_apply(batch->catalog, batch->changed, batch->removed);
+    /* batches are applied in order, so the scan is complete after the last one */
+    if (batch->directories != NULL) {
+      catalog_scan_finish(batch->catalog, batch->directories);
+    }
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Hand the current batch over to the main thread. Runs on the scanner thread.
+ * The last batch of a scan passes the removed documents. */
+static void catalog_scan_flush(catalog_scan_t* scan, GPtrArray* removed) {
+  catalog_batch_t* batch = g_new0(catalog_batch_t, 1);
+  batch->catalog         = scan->catalog;
+  batch->cancellable     = g_object_ref(scan->cancellable);
+  batch->changed         = scan->changed;
+  batch->removed         = removed != NULL ? removed : g_ptr_array_new();
+  batch->directories     = removed != NULL ? g_ptr_array_ref(scan->directories) : NULL;
+  scan->changed          = g_ptr_array_new_with_free_func(catalog_entry_free);
+
+  g_main_context_invoke_full(scan->context, G_PRIORITY_DEFAULT_IDLE, catalog_batch_apply, batch, catalog_batch_free);
+}
+
+static void catalog_scan_directory(catalog_scan_t* scan, const char* path, int depth) {
+  if (depth > CATALOG_MAX_DEPTH || g_cancellable_is_cancelled(scan->cancellable) == TRUE) {
+    return;
+  }
+
+  g_autoptr(GDir) dir = g_dir_open(path, 0, NULL);
+  if (dir == NULL) {
+    return;
+  }
+  g_ptr_array_add(scan->directories, g_strdup(path));
+
+  const char* name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    /* Skip hidden files/dirs */
+    if (name[0] == '.') {
+      continue;
+    }
+
+    g_autofree char* full_path = g_build_filename(path, name, NULL);
+    GStatBuf st;
+    if (g_stat(full_path, &st) != 0) {
+      continue;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+      catalog_scan_directory(scan, full_path, depth + 1);
+    } else if (S_ISREG(st.st_mode) && zathura_file_catalog_is_supported(name) == true) {
+      const zathura_catalog_entry_t* known = g_hash_table_lookup(scan->known, full_path);
+      const bool unchanged = known != NULL && known->size == (guint64)st.st_size && known->mtime == st.st_mtime;
+      g_hash_table_remove(scan->known, full_path);
+      if (unchanged == true) {
+        continue;
+      }
+
+      g_ptr_array_add(scan->changed, catalog_entry_new(full_path, &st));
+      if (scan->changed->len >= CATALOG_BATCH_SIZE) {
+        catalog_scan_flush(scan, NULL);
+      }
+    }
+  }
+}
+
+static void catalog_scan_thread(GTask* task, gpointer UNUSED(source), gpointer data,
+                                GCancellable* UNUSED(cancellable)) {
+  catalog_scan_t* scan = data;
+
+  for (char** root = scan->roots; *root != NULL; ++root) {
+    catalog_scan_directory(scan, *root, 0);
+  }
+
+  if (g_task_return_error_if_cancelled(task) == TRUE) {
+    return;
+  }
+
+  /* documents that were not seen are gone */
+  GPtrArray* removed = g_ptr_array_new_with_free_func(g_free);
+  GHashTableIter iter;
+  gpointer path = NULL;
+  g_hash_table_iter_init(&iter, scan->known);
+  while (g_hash_table_iter_next(&iter, &path, NULL) == TRUE) {
+    g_ptr_array_add(removed, g_strdup(path));
+  }
+  catalog_scan_flush(scan, removed);
+
+  g_task_return_boolean(task, TRUE);
+}
+
+static void catalog_scan_free(void* data) {
+  catalog_scan_t* scan = data;
+  g_object_unref(scan->cancellable);
+  g_main_context_unref(scan->context);
+  g_strfreev(scan->roots);
+  g_hash_table_unref(scan->known);
+  g_ptr_array_unref(scan->directories);
+  g_ptr_array_unref(scan->changed);
+  g_free(scan);
+}
+
+static void cb_catalog_directory_changed(GFileMonitor* monitor, GFile* file, GFile* other_file,
+                                         GFileMonitorEvent event, void* data);
+
+static void catalog_watch_directories(zathura_file_catalog_t* catalog, GPtrArray* directories) {
+  g_autoptr(GHashTable) current = g_hash_table_new(g_str_hash, g_str_equal);
+
+  for (guint idx = 0; idx != directories->len; ++idx) {
+    const char* directory = g_ptr_array_index(directories, idx);
+    g_hash_table_add(current, (gpointer)directory);
+    if (g_hash_table_contains(catalog->monitors, directory) == TRUE) {
+      continue;
+    }
+
+    g_autoptr(GFile) file = g_file_new_for_path(directory);
+    GFileMonitor* monitor = g_file_monitor_directory(file, G_FILE_MONITOR_WATCH_MOVES, NULL, NULL);
+    if (monitor == NULL) {
+      continue;
+    }
+    g_signal_connect(monitor, "changed", G_CALLBACK(cb_catalog_directory_changed), catalog);
+    g_hash_table_insert(catalog->monitors, g_strdup(directory), monitor);
+  }
+
+  /* stop watching directories that are gone */
+  GHashTableIter iter;
+  gpointer directory = NULL;
+  g_hash_table_iter_init(&iter, catalog->monitors);
+  while (g_hash_table_iter_next(&iter, &directory, NULL) == TRUE) {
+    if (g_hash_table_contains(current, directory) == FALSE) {
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+}
+
+static void catalog_scan_finish(zathura_file_catalog_t* catalog, GPtrArray* directories) {
+  catalog->scanning = false;
+  catalog_watch_directories(catalog, directories);
+  girara_debug("Catalog scan finished: %u documents in %u directories.", g_hash_table_size(catalog->entries),
+               directories->len);
+
+  if (catalog->rescan == true) {
+    catalog->rescan = false;
+    zathura_file_catalog_update(catalog);
+  }
+}
+
+void zathura_file_catalog_update(zathura_file_catalog_t* catalog) {
+  g_return_if_fail(catalog != NULL);
+
+  if (catalog->scanning == true) {
+    catalog->rescan = true;
+    return;
+  }
+
+  catalog_scan_t* scan = g_new0(catalog_scan_t, 1);
+  scan->catalog        = catalog;
+  scan->cancellable    = g_object_ref(catalog->cancellable);
+  scan->context        = g_main_context_ref_thread_default();
+  scan->roots          = g_strdupv(catalog->roots);
+  scan->known          = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, catalog_entry_free);
+  scan->directories    = g_ptr_array_new_with_free_func(g_free);
+  scan->changed        = g_ptr_array_new_with_free_func(catalog_entry_free);
+
+  GHashTableIter iter;
+  gpointer entry = NULL;
+  g_hash_table_iter_init(&iter, catalog->entries);
+  while (g_hash_table_iter_next(&iter, NULL, &entry) == TRUE) {
+    zathura_catalog_entry_t* copy = catalog_entry_copy(entry);
+    g_hash_table_replace(scan->known, copy->path, copy);
+  }
+
+  catalog->scanning     = true;
+  /* the scan is finished by its last batch */
+  g_autoptr(GTask) task = g_task_new(NULL, scan->cancellable, NULL, NULL);
+  g_task_set_task_data(task, scan, catalog_scan_free);
+  g_task_run_in_thread(task, catalog_scan_thread);
+}
+
+static gboolean cb_catalog_rescan(void* data) {
+  zathura_file_catalog_t* catalog = data;
+  catalog->rescan_timeout         = 0;
+  zathura_file_catalog_update(catalog);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void catalog_refresh_path(zathura_file_catalog_t* catalog, GFile* file) {
+  if (file == NULL) {
+    return;
+  }
+
+  g_autofree char* path = g_file_get_path(file);
+  g_autofree char* name = path != NULL ? g_path_get_basename(path) : NULL;
+  if (name == NULL || name[0] == '.') {
+    return;
+  }
+
+  GStatBuf st;
+  const bool exists = g_stat(path, &st) == 0;
+  if ((exists == true && S_ISDIR(st.st_mode)) || g_hash_table_contains(catalog->monitors, path) == TRUE) {
+    /* new and removed directories are handled by a scan */
+    if (catalog->rescan_timeout == 0) {
+      catalog->rescan_timeout = g_timeout_add(CATALOG_RESCAN_DELAY, cb_catalog_rescan, catalog);
+    }
+    return;
+  }
+
+  if (zathura_file_catalog_is_supported(name) == false) {
+    return;
+  }
+
+  g_autoptr(GPtrArray) changed = g_ptr_array_new_with_free_func(catalog_entry_free);
+  g_autoptr(GPtrArray) removed = g_ptr_array_new();
+  if (exists == true && S_ISREG(st.st_mode)) {
+    g_ptr_array_add(changed, catalog_entry_new(path, &st));
+  } else {
+    g_ptr_array_add(removed, path);
+  }
+  catalog_apply(catalog, changed, removed);
+}
+
+static void cb_catalog_directory_changed(GFileMonitor* UNUSED(monitor), GFile* file, GFile* other_file,
+                                         GFileMonitorEvent event, void* data) {
+  zathura_file_catalog_t* catalog = data;
+
+  switch (event) {
+  case G_FILE_MONITOR_EVENT_RENAMED:
+    catalog_refresh_path(catalog, file);
+    catalog_refresh_path(catalog, other_file);
+    break;
+  case G_FILE_MONITOR_EVENT_CREATED:
+  case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
+  case G_FILE_MONITOR_EVENT_DELETED:
+  case G_FILE_MONITOR_EVENT_MOVED_IN:
+  case G_FILE_MONITOR_EVENT_MOVED_OUT:
+    catalog_refresh_path(catalog, file);
+    break;
+  default:
+    break;
+  }
+}
+
+static gint compare_path(gconstpointer lhs, gconstpointer rhs) {
+  return g_strcmp0(*(char* const*)lhs, *(char* const*)rhs);
+}
+
+GPtrArray* zathura_file_catalog_get_files(zathura_file_catalog_t* catalog) {
+  g_return_val_if_fail(catalog != NULL, NULL);
+
+  GPtrArray* files = g_ptr_array_new_full(g_hash_table_size(catalog->entries), g_free);
+
+  GHashTableIter iter;
+  gpointer path = NULL;
+  g_hash_table_iter_init(&iter, catalog->entries);
+  while (g_hash_table_iter_next(&iter, &path, NULL) == TRUE) {
+    g_ptr_array_add(files, g_strdup(path));
+  }
+  g_ptr_array_sort(files, compare_path);
+
+  return files;
+}
+
+/* Whether a scan may add the path, i.e. whether it is below one of the roots */
+static bool catalog_in_roots(zathura_file_catalog_t* catalog, const char* path) {
+  for (char** root = catalog->roots; *root != NULL; ++root) {
+    const size_t length = strlen(*root);
+    if (strncmp(path, *root, length) == 0 &&
+        (path[length] == G_DIR_SEPARATOR || (length > 0 && (*root)[length - 1] == G_DIR_SEPARATOR))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void zathura_file_catalog_set_pages(zathura_file_catalog_t* catalog, const char* path, unsigned int pages) {
+  g_return_if_fail(catalog != NULL && path != NULL);
+
+  zathura_catalog_entry_t* entry = g_hash_table_lookup(catalog->entries, path);
+  if (entry == NULL) {
+    /* recorded once a scan adds the document; documents outside of the roots
+     * are never added */
+    if (catalog_in_roots(catalog, path) == false) {
+      return;
+    }
+    if (g_hash_table_size(catalog->pages) >= CATALOG_MAX_PENDING_PAGES &&
+        g_hash_table_contains(catalog->pages, path) == FALSE) {
+      g_hash_table_remove_all(catalog->pages);
+    }
+    g_hash_table_replace(catalog->pages, g_strdup(path), GUINT_TO_POINTER(pages));
+    return;
+  }
+  if (entry->pages == pages) {
+    return;
+  }
+
+  entry->pages = pages;
+  if (catalog->database != NULL) {
+    g_autoptr(girara_list_t) entries = girara_list_new();
+    girara_list_append(entries, entry);
+    zathura_db_update_catalog(catalog->database, entries, NULL);
+  }
+}
+
+bool zathura_file_catalog_contains(zathura_file_catalog_t* catalog, const char* path) {
+  g_return_val_if_fail(catalog != NULL && path != NULL, false);
+
+  return g_hash_table_contains(catalog->entries, path) == TRUE;
+}
+
+guint zathura_file_catalog_get_generation(zathura_file_catalog_t* catalog) {
+  g_return_val_if_fail(catalog != NULL, 0);
+
+  return catalog->generation;
+}
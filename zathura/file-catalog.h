@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_FILE_CATALOG_H
+#define ZATHURA_FILE_CATALOG_H
+
+#include <stdbool.h>
+#include <glib.h>
+#include <girara/types.h>
+
+#include "database.h"
+
+/**
+ * Persistent catalog of the documents below a set of directories. The catalog
+ * is loaded from the database and kept up to date by a background scan and by
+ * directory monitors. All functions have to be called from the main thread.
+ */
+typedef struct zathura_file_catalog_s zathura_file_catalog_t;
+
+/**
+ * Called after documents were added to or removed from the catalog.
+ *
+ * @param catalog The catalog
+ * @param added Paths of the new documents
+ * @param removed Paths of the removed documents
+ * @param data User data
+ */
+typedef void (*zathura_file_catalog_changed_t)(zathura_file_catalog_t* catalog, girara_list_t* added,
+                                               girara_list_t* removed, void* data);
+
+/**
+ * Create a new catalog and load the known documents from the database.
+ *
+ * @param database The database, may be NULL
+ * @param roots NULL terminated list of directories to index
+ * @return new catalog
+ */
+zathura_file_catalog_t* zathura_file_catalog_new(ZathuraDatabase* database, const char* const* roots);
+
+/**
+ * Free the catalog and stop a running scan.
+ *
+ * @param catalog The catalog
+ */
+void zathura_file_catalog_free(zathura_file_catalog_t* catalog);
+
+/**
+ * Set the function called after the catalog changed.
+ *
+ * @param catalog The catalog
+ * @param callback The callback
+ * @param data User data passed to callback
+ */
+void zathura_file_catalog_set_callback(zathura_file_catalog_t* catalog, zathura_file_catalog_changed_t callback,
+                                       void* data);
+
+/**
+ * Start a background scan of the directories. Only files whose size or
+ * modification time changed are written to the database. If a scan is
+ * already running, another one is started after it finished.
+ *
+ * @param catalog The catalog
+ */
+void zathura_file_catalog_update(zathura_file_catalog_t* catalog);
+
+/**
+ * Get the paths of all known documents sorted by path.
+ *
+ * @param catalog The catalog
+ * @return array of paths, free with g_ptr_array_unref
+ */
+GPtrArray* zathura_file_catalog_get_files(zathura_file_catalog_t* catalog);
+
+/**
+ * Record the number of pages of a document in the catalog. For documents below
+ * the roots that are not part of the catalog yet, the number is kept until a
+ * scan adds them; documents outside of the roots are ignored.
+ *
+ * @param catalog The catalog
+ * @param path The path of the document
+ * @param pages The number of pages
+ */
+void zathura_file_catalog_set_pages(zathura_file_catalog_t* catalog, const char* path, unsigned int pages);
+
+/**
+ * Check if a document is part of the catalog.
+ *
+ * @param catalog The catalog
+ * @param path The path of the document
+ * @return true if the document is known
+ */
+bool zathura_file_catalog_contains(zathura_file_catalog_t* catalog, const char* path);
+
+/**
+ * Get the generation of the catalog, which changes whenever documents are
+ * added or removed. A list obtained with zathura_file_catalog_get_files is up
+ * to date as long as the generation stays the same.
+ *
+ * @param catalog The catalog
+ * @return the generation
+ */
+guint zathura_file_catalog_get_generation(zathura_file_catalog_t* catalog);
+
+/**
+ * Check if the file name has the extension of a supported document.
+ *
+ * @param name The file name
+ * @return true if the file is a supported document
+ */
+bool zathura_file_catalog_is_supported(const char* name);
+
+#endif
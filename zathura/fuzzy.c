@@ -0,0 +1,330 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <string.h>
+
+#include "fuzzy.h"
+
+/* Scoring follows fzf: every matched character scores, gaps are penalized and
+ * matches at word boundaries and in consecutive runs get a bonus. */
+#define SCORE_MATCH 16
+#define SCORE_GAP_START -3
+#define SCORE_GAP_EXTENSION -1
+#define BONUS_BOUNDARY 8
+#define BONUS_NON_WORD 8
+#define BONUS_CAMEL 7
+#define BONUS_CONSECUTIVE 4
+#define BONUS_FIRST_CHAR_MULTIPLIER 2
+
+typedef enum fuzzy_class_e {
+  CLASS_NON_WORD,
+  CLASS_DELIMITER,
+  CLASS_LOWER,
+  CLASS_UPPER,
+  CLASS_DIGIT,
+} fuzzy_class_t;
+
+typedef struct fuzzy_item_s {
+  char* lower;             /**< Lowercase text */
+  guint8* classes;         /**< fuzzy_class_t of every byte */
+  size_t length;           /**< Length in bytes */
+  int score;               /**< Score for the query of generation */
+  unsigned int generation; /**< Query generation the score belongs to, 0 if none */
+} fuzzy_item_t;
+
+struct zathura_fuzzy_s {
+  GHashTable* items; /**< text -> fuzzy_item_t */
+  char* query;       /**< Lowercase query */
+  size_t query_length;
+  bool exact;
+  unsigned int generation;    /**< Incremented whenever the query changes */
+  unsigned int narrowed_from; /**< Generation whose mismatches cannot match the query, 0 if none */
+};
+
+static fuzzy_class_t fuzzy_class(char c) {
+  if (c >= 'a' && c <= 'z') {
+    return CLASS_LOWER;
+  }
+  if (c >= 'A' && c <= 'Z') {
+    return CLASS_UPPER;
+  }
+  if (c >= '0' && c <= '9') {
+    return CLASS_DIGIT;
+  }
+  if ((guchar)c >= 0x80) {
+    /* bytes that are not valid UTF-8 are treated as letters */
+    return CLASS_LOWER;
+  }
+
+  switch (c) {
+  case ' ':
+  case '/':
+  case '\\':
+  case '_':
+  case '-':
+  case '.':
+  case ',':
+  case ':':
+  case ';':
+    return CLASS_DELIMITER;
+  default:
+    return CLASS_NON_WORD;
+  }
+}
+
+/* Lowercase text character by character so that "Über" matches "über".
+ * Bytes that are not valid UTF-8 are kept as they are. If classes is not
+ * NULL, it receives the fuzzy_class_t of every byte of the result. */
+static char* fuzzy_fold(const char* text, GByteArray* classes) {
+  const char* end = text + strlen(text);
+  GString* lower  = g_string_sized_new(end - text);
+
+  while (text < end) {
+    const gunichar c = (guchar)*text < 0x80 ? (gunichar)-1 : g_utf8_get_char_validated(text, end - text);
+    if (c == (gunichar)-1 || c == (gunichar)-2) {
+      g_string_append_c(lower, g_ascii_tolower(*text));
+      if (classes != NULL) {
+        const guint8 class = fuzzy_class(*text);
+        g_byte_array_append(classes, &class, 1);
+      }
+      ++text;
+      continue;
+    }
+
+    const gsize before = lower->len;
+    g_string_append_unichar(lower, g_unichar_tolower(c));
+    if (classes != NULL) {
+      const guint8 class = g_unichar_isupper(c) == TRUE ? CLASS_UPPER : CLASS_LOWER;
+      for (gsize idx = before; idx != lower->len; ++idx) {
+        g_byte_array_append(classes, &class, 1);
+      }
+    }
+    text = g_utf8_next_char(text);
+  }
+
+  return g_string_free(lower, FALSE);
+}
+
+static void fuzzy_item_init(fuzzy_item_t* item, const char* text) {
+  GByteArray* classes = g_byte_array_new();
+  item->lower         = fuzzy_fold(text, classes);
+  item->length        = classes->len;
+  item->classes       = g_byte_array_free(classes, FALSE);
+}
+
+static void fuzzy_item_clear(fuzzy_item_t* item) {
+  g_free(item->lower);
+  g_free(item->classes);
+}
+
+static void fuzzy_item_free(void* data) {
+  fuzzy_item_t* item = data;
+  fuzzy_item_clear(item);
+  g_free(item);
+}
+
+static int fuzzy_bonus(const fuzzy_item_t* item, size_t idx) {
+  const fuzzy_class_t prev  = idx == 0 ? CLASS_DELIMITER : item->classes[idx - 1];
+  const fuzzy_class_t class = item->classes[idx];
+
+  if (class == CLASS_NON_WORD || class == CLASS_DELIMITER) {
+    return BONUS_NON_WORD;
+  }
+  if (prev == CLASS_NON_WORD || prev == CLASS_DELIMITER) {
+    return BONUS_BOUNDARY;
+  }
+  if ((prev == CLASS_LOWER && class == CLASS_UPPER) || (prev != CLASS_DIGIT && class == CLASS_DIGIT)) {
+    return BONUS_CAMEL;
+  }
+  return 0;
+}
+
+/* Score the query characters matched in order within [start, end). */
+static int fuzzy_score_range(const fuzzy_item_t* item, const char* query, size_t query_length, size_t start,
+                             size_t end) {
+  int score          = 0;
+  int first_bonus    = 0;
+  size_t consecutive = 0;
+  bool in_gap        = false;
+  size_t query_idx   = 0;
+
+  for (size_t idx = start; idx < end; ++idx) {
+    if (query_idx < query_length && item->lower[idx] == query[query_idx]) {
+      int bonus = fuzzy_bonus(item, idx);
+      if (consecutive == 0) {
+        first_bonus = bonus;
+      } else {
+        /* a run keeps the bonus of the boundary it started at */
+        if (bonus >= BONUS_BOUNDARY && bonus > first_bonus) {
+          first_bonus = bonus;
+        }
+        bonus = MAX(MAX(bonus, first_bonus), BONUS_CONSECUTIVE);
+      }
+
+      score += SCORE_MATCH + (query_idx == 0 ? bonus * BONUS_FIRST_CHAR_MULTIPLIER : bonus);
+      in_gap = false;
+      ++consecutive;
+      ++query_idx;
+    } else {
+      score += in_gap == true ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+      in_gap      = true;
+      consecutive = 0;
+      first_bonus = 0;
+    }
+  }
+
+  return score;
+}
+
+static int fuzzy_item_score(const fuzzy_item_t* item, const char* query, size_t query_length, bool exact) {
+  if (query_length == 0) {
+    return 0;
+  }
+  if (query_length > item->length) {
+    return -1;
+  }
+
+  if (exact == true) {
+    const char* match = strstr(item->lower, query);
+    if (match == NULL) {
+      return -1;
+    }
+    const size_t start = match - item->lower;
+    return fuzzy_score_range(item, query, query_length, start, start + query_length);
+  }
+
+  /* find the end of the first occurrence ... */
+  size_t query_idx = 0;
+  size_t end       = 0;
+  for (size_t idx = 0; idx < item->length; ++idx) {
+    if (item->lower[idx] == query[query_idx] && ++query_idx == query_length) {
+      end = idx + 1;
+      break;
+    }
+  }
+  if (query_idx != query_length) {
+    return -1;
+  }
+
+  /* ... and walk back to the shortest match ending there */
+  size_t start = end;
+  while (start > 0) {
+    --start;
+    if (item->lower[start] == query[query_idx - 1] && --query_idx == 0) {
+      break;
+    }
+  }
+
+  return fuzzy_score_range(item, query, query_length, start, end);
+}
+
+int zathura_fuzzy_score(const char* query, const char* text, bool exact) {
+  g_return_val_if_fail(query != NULL && text != NULL, -1);
+
+  g_autofree char* lower_query = fuzzy_fold(query, NULL);
+  fuzzy_item_t item            = {0};
+  fuzzy_item_init(&item, text);
+  const int score = fuzzy_item_score(&item, lower_query, strlen(lower_query), exact);
+  fuzzy_item_clear(&item);
+
+  return score;
+}
+
+zathura_fuzzy_t* zathura_fuzzy_new(void) {
+  zathura_fuzzy_t* fuzzy = g_try_malloc0(sizeof(zathura_fuzzy_t));
+  if (fuzzy == NULL) {
+    return NULL;
+  }
+
+  fuzzy->items      = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, fuzzy_item_free);
+  fuzzy->query      = g_strdup("");
+  fuzzy->generation = 1;
+
+  return fuzzy;
+}
+
+void zathura_fuzzy_free(zathura_fuzzy_t* fuzzy) {
+  if (fuzzy == NULL) {
+    return;
+  }
+
+  g_hash_table_unref(fuzzy->items);
+  g_free(fuzzy->query);
+  g_free(fuzzy);
+}
+
+void zathura_fuzzy_clear(zathura_fuzzy_t* fuzzy) {
+  g_return_if_fail(fuzzy != NULL);
+
+  g_hash_table_remove_all(fuzzy->items);
+  fuzzy->narrowed_from = 0;
+}
+
+/* Check if every text matching query also matches previous. */
+static bool fuzzy_query_narrows(const char* previous, const char* query, bool exact) {
+  if (exact == true) {
+    return strstr(query, previous) != NULL;
+  }
+
+  /* previous has to be a subsequence of query */
+  for (; *previous != '\0' && *query != '\0'; ++query) {
+    if (*previous == *query) {
+      ++previous;
+    }
+  }
+  return *previous == '\0';
+}
+
+void zathura_fuzzy_set_query(zathura_fuzzy_t* fuzzy, const char* query, bool exact) {
+  g_return_if_fail(fuzzy != NULL);
+
+  g_autofree char* lower_query = fuzzy_fold(query != NULL ? query : "", NULL);
+  if (exact == fuzzy->exact && g_strcmp0(lower_query, fuzzy->query) == 0) {
+    return;
+  }
+
+  const bool narrows =
+      exact == fuzzy->exact && fuzzy->query_length != 0 && fuzzy_query_narrows(fuzzy->query, lower_query, exact);
+
+  fuzzy->narrowed_from = narrows == true ? fuzzy->generation : 0;
+  fuzzy->generation += 1;
+  fuzzy->exact        = exact;
+  fuzzy->query_length = strlen(lower_query);
+  g_free(fuzzy->query);
+  fuzzy->query = g_steal_pointer(&lower_query);
+}
+
+bool zathura_fuzzy_query_is_empty(zathura_fuzzy_t* fuzzy) {
+  g_return_val_if_fail(fuzzy != NULL, true);
+
+  return fuzzy->query_length == 0;
+}
+
+int zathura_fuzzy_match(zathura_fuzzy_t* fuzzy, const char* text) {
+  g_return_val_if_fail(fuzzy != NULL, -1);
+
+  if (fuzzy->query_length == 0) {
+    return 0;
+  }
+  if (text == NULL) {
+    return -1;
+  }
+
+  fuzzy_item_t* item = g_hash_table_lookup(fuzzy->items, text);
+  if (item == NULL) {
+    item = g_new0(fuzzy_item_t, 1);
+    fuzzy_item_init(item, text);
+    g_hash_table_insert(fuzzy->items, g_strdup(text), item);
+  } else if (item->generation == fuzzy->generation) {
+    return item->score;
+  }
+
+  if (fuzzy->narrowed_from != 0 && item->generation == fuzzy->narrowed_from && item->score < 0) {
+    /* did not match the broader query */
+    item->score = -1;
+  } else {
+    item->score = fuzzy_item_score(item, fuzzy->query, fuzzy->query_length, fuzzy->exact);
+  }
+  item->generation = fuzzy->generation;
+
+  return item->score;
+}
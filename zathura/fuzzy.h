@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_FUZZY_H
+#define ZATHURA_FUZZY_H
+
+#include <stdbool.h>
+#include <glib.h>
+
+/**
+ * Fuzzy matcher for list panels. Texts are scored against the current query;
+ * the lowercase form and the character classes of every text are computed
+ * once and kept together with the score of the current query. Matching is
+ * case insensitive.
+ */
+typedef struct zathura_fuzzy_s zathura_fuzzy_t;
+
+/**
+ * Score a text against a query without caching.
+ *
+ * @param query The query
+ * @param text The text
+ * @param exact true to match the query as a substring, false to match its
+ * characters in order
+ * @return Score of the match (higher is better) or -1 if the text does not
+ * match
+ */
+int zathura_fuzzy_score(const char* query, const char* text, bool exact);
+
+/**
+ * Create a new matcher with an empty query.
+ *
+ * @return new matcher
+ */
+zathura_fuzzy_t* zathura_fuzzy_new(void);
+
+/**
+ * Free the matcher.
+ *
+ * @param fuzzy The matcher
+ */
+void zathura_fuzzy_free(zathura_fuzzy_t* fuzzy);
+
+/**
+ * Drop the cached texts, e.g. after the list was repopulated.
+ *
+ * @param fuzzy The matcher
+ */
+void zathura_fuzzy_clear(zathura_fuzzy_t* fuzzy);
+
+/**
+ * Set the query. If the new query only narrows the previous one, texts that
+ * did not match the previous query are rejected without scoring them again.
+ *
+ * @param fuzzy The matcher
+ * @param query The query
+ * @param exact true to match the query as a substring, false to match its
+ * characters in order
+ */
+void zathura_fuzzy_set_query(zathura_fuzzy_t* fuzzy, const char* query, bool exact);
+
+/**
+ * Check if the query is empty.
+ *
+ * @param fuzzy The matcher
+ * @return true if every text matches
+ */
+bool zathura_fuzzy_query_is_empty(zathura_fuzzy_t* fuzzy);
+
+/**
+ * Score a text against the current query. The result is cached until the
+ * query changes.
+ *
+ * @param fuzzy The matcher
+ * @param text The text
+ * @return Score of the match (higher is better) or -1 if the text does not
+ * match
+ */
+int zathura_fuzzy_match(zathura_fuzzy_t* fuzzy, const char* text);
+
+#endif
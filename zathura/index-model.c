@@ -0,0 +1,381 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <girara/datastructures.h>
+
+#include "index-model.h"
+#include "document.h"
+#include "links.h"
+#include "macros.h"
+#include "page.h"
+
+typedef struct index_entry_s {
+  girara_tree_node_t* node;
+  unsigned int page; /**< Target page of the entry */
+} index_entry_t;
+
+typedef struct private_s {
+  zathura_document_t* document;
+  girara_tree_node_t* root;
+  gint stamp;
+  GHashTable* children;  /**< girara_tree_node_t -> GPtrArray of its children */
+  GHashTable* positions; /**< girara_tree_node_t -> position among its siblings */
+  GArray* entries;       /**< index_entry_t of the entries pointing at a page, in reading order */
+} ZathuraIndexModelPrivate;
+
+static void zathura_index_model_tree_model_init(GtkTreeModelIface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(ZathuraIndexModel, zathura_index_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, zathura_index_model_tree_model_init)
+                            G_ADD_PRIVATE(ZathuraIndexModel))
+
+static void zathura_index_model_finalize(GObject* object) {
+  ZathuraIndexModel* model       = ZATHURA_INDEX_MODEL(object);
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(model);
+
+  g_hash_table_unref(priv->children);
+  g_hash_table_unref(priv->positions);
+  g_array_unref(priv->entries);
+  if (priv->root != NULL) {
+    girara_node_free(priv->root);
+  }
+
+  G_OBJECT_CLASS(zathura_index_model_parent_class)->finalize(object);
+}
+
+static void zathura_index_model_class_init(ZathuraIndexModelClass* class) {
+  GObjectClass* object_class = G_OBJECT_CLASS(class);
+  object_class->finalize     = zathura_index_model_finalize;
+}
+
+static void zathura_index_model_init(ZathuraIndexModel* model) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(model);
+
+  priv->stamp     = g_random_int();
+  priv->children  = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)g_ptr_array_unref);
+  priv->positions = g_hash_table_new(g_direct_hash, g_direct_equal);
+  priv->entries   = g_array_new(FALSE, FALSE, sizeof(index_entry_t));
+}
+
+/* Record the children of node and their descendants in reading order. */
+static void index_model_add_children(ZathuraIndexModelPrivate* priv, girara_tree_node_t* node) {
+  girara_list_t* list = girara_node_get_children(node);
+  const size_t size   = girara_list_size(list);
+  if (size == 0) {
+    return;
+  }
+
+  GPtrArray* children = g_ptr_array_sized_new(size);
+  g_hash_table_insert(priv->children, node, children);
+
+  for (size_t idx = 0; idx != size; ++idx) {
+    girara_tree_node_t* child              = girara_list_nth(list, idx);
+    zathura_index_element_t* index_element = girara_node_get_data(child);
+
+    g_ptr_array_add(children, child);
+    g_hash_table_insert(priv->positions, child, GSIZE_TO_POINTER(idx));
+
+    /* the page number of other links, e.g. URIs, is meaningless */
+    if (zathura_link_get_type(index_element->link) == ZATHURA_LINK_GOTO_DEST) {
+      const index_entry_t entry = {child, zathura_link_get_target(index_element->link).page_number};
+      g_array_append_val(priv->entries, entry);
+    }
+
+    index_model_add_children(priv, child);
+  }
+}
+
+ZathuraIndexModel* zathura_index_model_new(zathura_document_t* document, girara_tree_node_t* index) {
+  g_return_val_if_fail(document != NULL && index != NULL, NULL);
+
+  ZathuraIndexModel* model       = g_object_new(ZATHURA_TYPE_INDEX_MODEL, NULL);
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(model);
+  priv->document                 = document;
+  priv->root                     = index;
+
+  index_model_add_children(priv, index);
+
+  return model;
+}
+
+static GPtrArray* index_model_get_children(ZathuraIndexModelPrivate* priv, girara_tree_node_t* node) {
+  return g_hash_table_lookup(priv->children, node);
+}
+
+static gboolean index_model_set_iter(ZathuraIndexModelPrivate* priv, GtkTreeIter* iter, girara_tree_node_t* parent,
+                                     guint position) {
+  GPtrArray* children = index_model_get_children(priv, parent);
+  if (children == NULL || position >= children->len) {
+    iter->stamp = 0;
+    return FALSE;
+  }
+
+  iter->stamp      = priv->stamp;
+  iter->user_data  = g_ptr_array_index(children, position);
+  iter->user_data2 = GUINT_TO_POINTER(position);
+  iter->user_data3 = parent;
+  return TRUE;
+}
+
+bool zathura_index_model_find_page(ZathuraIndexModel* model, unsigned int page, GtkTreeIter* iter) {
+  g_return_val_if_fail(ZATHURA_IS_INDEX_MODEL(model) && iter != NULL, false);
+
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(model);
+  if (priv->entries->len == 0) {
+    return index_model_set_iter(priv, iter, priv->root, 0);
+  }
+
+  /* outlines are not necessarily sorted by page, so walk them in reading
+   * order up to the first entry after the page */
+  girara_tree_node_t* node = g_array_index(priv->entries, index_entry_t, 0).node;
+  for (guint idx = 1; idx < priv->entries->len; ++idx) {
+    const index_entry_t* entry = &g_array_index(priv->entries, index_entry_t, idx);
+    if (entry->page > page) {
+      break;
+    }
+    node = entry->node;
+  }
+
+  const guint position = GPOINTER_TO_SIZE(g_hash_table_lookup(priv->positions, node));
+  return index_model_set_iter(priv, iter, girara_node_get_parent(node), position);
+}
+
+/* GtkTreeModel implementation */
+
+static GtkTreeModelFlags index_model_get_flags(GtkTreeModel* UNUSED(tree_model)) {
+  return GTK_TREE_MODEL_ITERS_PERSIST;
+}
+
+static gint index_model_get_n_columns(GtkTreeModel* UNUSED(tree_model)) {
+  return ZATHURA_INDEX_MODEL_N_COLUMNS;
+}
+
+static GType index_model_get_column_type(GtkTreeModel* UNUSED(tree_model), gint column) {
+  switch (column) {
+  case ZATHURA_INDEX_MODEL_COLUMN_TITLE:
+  case ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION:
+  case ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION2:
+    return G_TYPE_STRING;
+  case ZATHURA_INDEX_MODEL_COLUMN_ELEMENT:
+    return G_TYPE_POINTER;
+  default:
+    return G_TYPE_INVALID;
+  }
+}
+
+static gboolean index_model_get_iter(GtkTreeModel* tree_model, GtkTreeIter* iter, GtkTreePath* path) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+
+  gint depth          = 0;
+  const gint* indices = gtk_tree_path_get_indices_with_depth(path, &depth);
+  if (depth == 0) {
+    iter->stamp = 0;
+    return FALSE;
+  }
+
+  girara_tree_node_t* parent = priv->root;
+  for (gint level = 0; level < depth; ++level) {
+    if (index_model_set_iter(priv, iter, parent, indices[level]) == FALSE) {
+      return FALSE;
+    }
+    parent = iter->user_data;
+  }
+
+  return TRUE;
+}
+
+static GtkTreePath* index_model_get_path(GtkTreeModel* tree_model, GtkTreeIter* iter) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(iter->stamp == priv->stamp, NULL);
+
+  GtkTreePath* path = gtk_tree_path_new();
+  for (girara_tree_node_t* node = iter->user_data; node != priv->root; node = girara_node_get_parent(node)) {
+    gtk_tree_path_prepend_index(path, GPOINTER_TO_SIZE(g_hash_table_lookup(priv->positions, node)));
+  }
+
+  return path;
+}
+
+static void index_model_get_value(GtkTreeModel* tree_model, GtkTreeIter* iter, gint column, GValue* value) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_if_fail(iter->stamp == priv->stamp);
+
+  zathura_index_element_t* index_element = girara_node_get_data(iter->user_data);
+  g_value_init(value, index_model_get_column_type(tree_model, column));
+
+  if (column == ZATHURA_INDEX_MODEL_COLUMN_ELEMENT) {
+    g_value_set_pointer(value, index_element);
+    return;
+  }
+  if (column == ZATHURA_INDEX_MODEL_COLUMN_TITLE) {
+    g_value_take_string(value, g_markup_escape_text(index_element->title, -1));
+    return;
+  }
+
+  const zathura_link_target_t target = zathura_link_get_target(index_element->link);
+  if (zathura_link_get_type(index_element->link) != ZATHURA_LINK_GOTO_DEST) {
+    if (column == ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION) {
+      g_value_set_string(value, target.value);
+    }
+    return;
+  }
+
+  zathura_page_t* page = zathura_document_get_page(priv->document, target.page_number);
+  const char* label    = zathura_page_get_label(page, NULL);
+
+  if (column == ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION) {
+    if (label != NULL) {
+      g_value_take_string(value, g_strdup_printf("Page %s", label));
+    } else {
+      g_value_take_string(value, g_strdup_printf("Page %d", target.page_number + 1));
+    }
+  } else if (label != NULL) {
+    g_value_take_string(value, g_strdup_printf("(%d)", target.page_number + 1));
+  }
+}
+
+static gboolean index_model_iter_next(GtkTreeModel* tree_model, GtkTreeIter* iter) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(iter->stamp == priv->stamp, FALSE);
+
+  return index_model_set_iter(priv, iter, iter->user_data3, GPOINTER_TO_UINT(iter->user_data2) + 1);
+}
+
+static gboolean index_model_iter_previous(GtkTreeModel* tree_model, GtkTreeIter* iter) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(iter->stamp == priv->stamp, FALSE);
+
+  const guint position = GPOINTER_TO_UINT(iter->user_data2);
+  if (position == 0) {
+    iter->stamp = 0;
+    return FALSE;
+  }
+
+  return index_model_set_iter(priv, iter, iter->user_data3, position - 1);
+}
+
+static gboolean index_model_iter_nth_child(GtkTreeModel* tree_model, GtkTreeIter* iter, GtkTreeIter* parent,
+                                           gint n) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(parent == NULL || parent->stamp == priv->stamp, FALSE);
+
+  return index_model_set_iter(priv, iter, parent != NULL ? parent->user_data : priv->root, n);
+}
+
+static gboolean index_model_iter_children(GtkTreeModel* tree_model, GtkTreeIter* iter, GtkTreeIter* parent) {
+  return index_model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean index_model_iter_has_child(GtkTreeModel* tree_model, GtkTreeIter* iter) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(iter->stamp == priv->stamp, FALSE);
+
+  return index_model_get_children(priv, iter->user_data) != NULL;
+}
+
+static gint index_model_iter_n_children(GtkTreeModel* tree_model, GtkTreeIter* iter) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(iter == NULL || iter->stamp == priv->stamp, 0);
+
+  GPtrArray* children = index_model_get_children(priv, iter != NULL ? iter->user_data : priv->root);
+  return children != NULL ? (gint)children->len : 0;
+}
+
+static gboolean index_model_iter_parent(GtkTreeModel* tree_model, GtkTreeIter* iter, GtkTreeIter* child) {
+  ZathuraIndexModelPrivate* priv = zathura_index_model_get_instance_private(ZATHURA_INDEX_MODEL(tree_model));
+  g_return_val_if_fail(child->stamp == priv->stamp, FALSE);
+
+  girara_tree_node_t* parent = child->user_data3;
+  if (parent == priv->root) {
+    iter->stamp = 0;
+    return FALSE;
+  }
+
+  const guint position = GPOINTER_TO_SIZE(g_hash_table_lookup(priv->positions, parent));
+  return index_model_set_iter(priv, iter, girara_node_get_parent(parent), position);
+}
+
+static void zathura_index_model_tree_model_init(GtkTreeModelIface* iface) {
+  iface->get_flags       = index_model_get_flags;
+  iface->get_n_columns   = index_model_get_n_columns;
+  iface->get_column_type = index_model_get_column_type;
+  iface->get_iter        = index_model_get_iter;
+  iface->get_path        = index_model_get_path;
+  iface->get_value       = index_model_get_value;
+  iface->iter_next       = index_model_iter_next;
+  iface->iter_previous   = index_model_iter_previous;
+  iface->iter_children   = index_model_iter_children;
+  iface->iter_has_child  = index_model_iter_has_child;
+  iface->iter_n_children = index_model_iter_n_children;
+  iface->iter_nth_child  = index_model_iter_nth_child;
+  iface->iter_parent     = index_model_iter_parent;
+}
+
+/* Loader */
+
+struct zathura_index_model_loader_s {
+  zathura_document_t* document;
+  zathura_index_model_loaded_t callback;
+  void* data;
+  GThread* thread;
+  GMutex lock;
+  ZathuraIndexModel* model; /**< Result of the worker thread */
+  guint idle;               /**< Source delivering the result to the main loop */
+};
+
+static gboolean index_model_load_done(gpointer data) {
+  zathura_index_model_loader_t* loader = data;
+
+  g_mutex_lock(&loader->lock);
+  ZathuraIndexModel* model = g_steal_pointer(&loader->model);
+  loader->idle             = 0;
+  g_mutex_unlock(&loader->lock);
+
+  /* the callback may free the loader */
+  loader->callback(model, loader->data);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gpointer index_model_load_thread(gpointer data) {
+  zathura_index_model_loader_t* loader = data;
+
+  /* plugins are already called from the render thread and the main thread at
+   * the same time, so the index is generated without locking the renderer */
+  girara_tree_node_t* index = zathura_document_index_generate(loader->document, NULL);
+  ZathuraIndexModel* model  = index != NULL ? zathura_index_model_new(loader->document, index) : NULL;
+
+  g_mutex_lock(&loader->lock);
+  loader->model = model;
+  loader->idle  = g_idle_add(index_model_load_done, loader);
+  g_mutex_unlock(&loader->lock);
+
+  return NULL;
+}
+
+zathura_index_model_loader_t* zathura_index_model_load(zathura_document_t* document,
+                                                       zathura_index_model_loaded_t callback, void* data) {
+  g_return_val_if_fail(document != NULL && callback != NULL, NULL);
+
+  zathura_index_model_loader_t* loader = g_new0(zathura_index_model_loader_t, 1);
+  loader->document                     = document;
+  loader->callback                     = callback;
+  loader->data                         = data;
+  g_mutex_init(&loader->lock);
+  loader->thread = g_thread_new("index", index_model_load_thread, loader);
+
+  return loader;
+}
+
+void zathura_index_model_loader_free(zathura_index_model_loader_t* loader) {
+  if (loader == NULL) {
+    return;
+  }
+
+  g_thread_join(loader->thread);
+  if (loader->idle != 0) {
+    g_source_remove(loader->idle);
+  }
+  g_clear_object(&loader->model);
+  g_mutex_clear(&loader->lock);
+  g_free(loader);
+}
@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_INDEX_MODEL_H
+#define ZATHURA_INDEX_MODEL_H
+
+#include <stdbool.h>
+#include <gtk/gtk.h>
+#include <girara/types.h>
+
+#include "types.h"
+
+/**
+ * Tree model presenting the outline of a document. The model wraps the tree
+ * generated by the plugin: rows are not copied into a store, and the title
+ * markup and page descriptions of a row are only formatted when the view asks
+ * for them, i.e. for rows that are expanded and visible.
+ */
+
+typedef struct zathura_index_model_s ZathuraIndexModel;
+typedef struct zathura_index_model_class_s ZathuraIndexModelClass;
+
+struct zathura_index_model_s {
+  GObject parent;
+};
+
+struct zathura_index_model_class_s {
+  GObjectClass parent_class;
+};
+
+#define ZATHURA_TYPE_INDEX_MODEL (zathura_index_model_get_type())
+#define ZATHURA_INDEX_MODEL(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), ZATHURA_TYPE_INDEX_MODEL, ZathuraIndexModel))
+#define ZATHURA_INDEX_MODEL_CLASS(obj)                                                                                 \
+  (G_TYPE_CHECK_CLASS_CAST((obj), ZATHURA_TYPE_INDEX_MODEL, ZathuraIndexModelClass))
+#define ZATHURA_IS_INDEX_MODEL(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), ZATHURA_TYPE_INDEX_MODEL))
+#define ZATHURA_IS_INDEX_MODEL_CLASS(obj) (G_TYPE_CHECK_CLASS_TYPE((obj), ZATHURA_TYPE_INDEX_MODEL))
+
+/**
+ * Columns of the index model.
+ */
+enum {
+  ZATHURA_INDEX_MODEL_COLUMN_TITLE,        /**< Escaped title markup (string) */
+  ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION,  /**< Target of the entry, e.g. "Page iv" (string) */
+  ZATHURA_INDEX_MODEL_COLUMN_DESCRIPTION2, /**< Page number if the page has a label, e.g. "(4)" (string) */
+  ZATHURA_INDEX_MODEL_COLUMN_ELEMENT,      /**< The zathura_index_element_t (pointer) */
+  ZATHURA_INDEX_MODEL_N_COLUMNS
+};
+
+/**
+ * Returns the type of the index model.
+ * @return the type
+ */
+GType zathura_index_model_get_type(void) G_GNUC_CONST;
+
+/**
+ * Create an index model. Only the tree structure is walked, so this can be
+ * called from a worker thread.
+ *
+ * @param document The document; it has to outlive the model
+ * @param index The index generated by the plugin; the model takes ownership
+ * @return an index model
+ */
+ZathuraIndexModel* zathura_index_model_new(zathura_document_t* document, girara_tree_node_t* index);
+
+/**
+ * Find the entry of a page. Entries are walked in reading order, so this is
+ * the last entry pointing at or before the page that precedes the first entry
+ * pointing after it, or the first entry if there is no such entry. Entries
+ * that do not point at a page are skipped.
+ *
+ * @param model The index model
+ * @param page The page number
+ * @param iter Set to the entry
+ * @return false if the index is empty
+ */
+bool zathura_index_model_find_page(ZathuraIndexModel* model, unsigned int page, GtkTreeIter* iter);
+
+typedef struct zathura_index_model_loader_s zathura_index_model_loader_t;
+
+/**
+ * Callback of zathura_index_model_load.
+ *
+ * @param model The index model or NULL if the document has no index
+ * @param data Custom data
+ */
+typedef void (*zathura_index_model_loaded_t)(ZathuraIndexModel* model, void* data);
+
+/**
+ * Generate the index of a document in a worker thread. The callback is
+ * invoked from the main loop once the model is ready.
+ *
+ * @param document The document
+ * @param callback The callback; it takes ownership of the model
+ * @param data Custom data passed to the callback
+ * @return the loader
+ */
+zathura_index_model_loader_t* zathura_index_model_load(zathura_document_t* document,
+                                                       zathura_index_model_loaded_t callback, void* data);
+
+/**
+ * Free the loader. Waits for the worker thread if the index is still being
+ * generated; the callback is not invoked afterwards. Has to be called before
+ * the document is freed.
+ *
+ * @param loader The loader
+ */
+void zathura_index_model_loader_free(zathura_index_model_loader_t* loader);
+
+#endif
@@ -42,6 +42,9 @@ static zathura_t* init_zathura(const char* config_dir, const char* data_dir, con
     return NULL;
   }
 
+  /* plugins cannot be loaded on demand once the sandbox is active */
+  zathura_plugin_manager_load_modules(zathura->plugins.manager);
+
   girara_debug("Strict sandbox preventing write and network access.");
 #ifdef WITH_LANDLOCK
   landlock_drop_write();
@@ -16,8 +16,14 @@
 #include <string.h>
 
 #include "zathura.h"
+#include "batch.h"
+#include "content-type.h"
+#include "document.h"
+#include "export.h"
 #include "plugin.h"
+#include "render.h"
 #include "utils.h"
+#include "startup-trace.h"
 #ifdef WITH_SYNCTEX
 #include "dbus-interface.h"
 #include "synctex.h"
@@ -80,6 +86,153 @@ static int run_synctex_forward(const char* synctex_fwd, const char* filename, in
 }
 #endif
 
+/* Open a document without creating a window. The plugin manager has to
+ * outlive the document. */
+static zathura_document_t* open_document_headless(zathura_plugin_manager_t* plugin_manager, const char* filename,
+                                                  const char* password) {
+  g_autoptr(GFile) file      = g_file_new_for_commandline_arg(filename);
+  g_autofree char* real_path = g_file_get_path(file);
+  if (real_path == NULL) {
+    girara_error("Failed to determine path for '%s'", filename);
+    return NULL;
+  }
+
+  zathura_content_type_context_t* context = zathura_content_type_new();
+  g_autofree char* content_type =
+      zathura_content_type_guess(context, real_path, zathura_plugin_manager_get_content_types(plugin_manager));
+  zathura_content_type_free(context);
+
+  const zathura_plugin_t* plugin = zathura_plugin_manager_get_plugin(plugin_manager, content_type);
+  if (plugin == NULL) {
+    girara_error("Unknown file type: '%s'", content_type != NULL ? content_type : filename);
+    return NULL;
+  }
+
+  zathura_document_t* document = zathura_document_open_with_plugin(plugin, real_path, NULL, password, NULL);
+  if (document == NULL) {
+    girara_error("Failed to open '%s'.", filename);
+  }
+
+  return document;
+}
+
+/* Export pages without creating a window */
+static int run_export_pages(const char* filename, const char* password, const char* plugin_path, const char* range,
+                            const char* directory, int dpi, const char* format, bool recolor) {
+  zathura_export_options_t options = {
+      .recolor   = recolor,
+      .directory = directory != NULL ? directory : ".",
+  };
+  if (dpi <= 0 || zathura_export_parse_format(format != NULL ? format : "png", &options.format) == false) {
+    girara_error("Invalid argument for --export-dpi or --export-format.");
+    return -1;
+  }
+  options.dpi = dpi;
+
+  g_autoptr(zathura_plugin_manager_t) plugin_manager = zathura_plugin_manager_new();
+  zathura_plugin_manager_set_dir(plugin_manager, plugin_path);
+  zathura_plugin_manager_load(plugin_manager);
+
+  zathura_document_t* document = open_document_headless(plugin_manager, filename, password);
+  if (document == NULL) {
+    return -1;
+  }
+
+  if (zathura_export_parse_range(range, zathura_document_get_number_of_pages(document), &options.first_page,
+                                 &options.last_page) == false) {
+    girara_error("Invalid argument for --export-pages: %s", range);
+    zathura_document_free(document);
+    return -1;
+  }
+
+  /* the renderer serializes the plugin calls of the workers and provides the
+   * default recoloring colors; zathurarc is not read */
+  ZathuraRenderer* renderer = zathura_renderer_new(1);
+  zathura_export_t* export  = zathura_export_pages(document, renderer, &options, NULL, NULL);
+  int ret                   = -1;
+  if (export != NULL) {
+    const unsigned int total  = options.last_page - options.first_page + 1;
+    const unsigned int failed = zathura_export_wait(export);
+    zathura_export_free(export);
+    if (failed == 0) {
+      ret = 0;
+    } else {
+      girara_error("Failed to export %u of %u pages.", failed, total);
+    }
+  } else {
+    girara_error("Failed to create '%s'.", options.directory);
+  }
+
+  g_object_unref(renderer);
+  zathura_document_free(document);
+
+  return ret;
+}
+
+/* Run batch jobs without creating a window and print the timings as JSON */
+static int run_batch(const char* filename, const char* password, const char* plugin_path, const char* jobs,
+                     const char* range, const char* directory, int dpi, const char* format, int threads) {
+  zathura_batch_options_t options = {
+      .directory = directory,
+  };
+  if (zathura_batch_parse_jobs(jobs, &options.jobs) == false) {
+    girara_error("Invalid argument for --batch: %s", jobs);
+    return -1;
+  }
+  if (dpi <= 0 || threads < 0 ||
+      zathura_export_parse_format(format != NULL ? format : "png", &options.format) == false) {
+    girara_error("Invalid argument for --export-dpi, --export-format or --batch-threads.");
+    return -1;
+  }
+  options.dpi     = dpi;
+  options.threads = threads;
+
+  g_autoptr(zathura_plugin_manager_t) plugin_manager = zathura_plugin_manager_new();
+  zathura_plugin_manager_set_dir(plugin_manager, plugin_path);
+  zathura_plugin_manager_load(plugin_manager);
+
+  const gint64 start           = g_get_monotonic_time();
+  zathura_document_t* document = open_document_headless(plugin_manager, filename, password);
+  const gint64 open_time       = g_get_monotonic_time() - start;
+  if (document == NULL) {
+    return -1;
+  }
+
+  if (zathura_export_parse_range(range != NULL ? range : "all", zathura_document_get_number_of_pages(document),
+                                 &options.first_page, &options.last_page) == false) {
+    girara_error("Invalid argument for --export-pages: %s", range);
+    zathura_document_free(document);
+    return -1;
+  }
+
+  g_autoptr(JsonNode) root = zathura_batch_run(document, &options);
+  zathura_document_free(document);
+  if (root == NULL) {
+    return -1;
+  }
+
+  JsonObject* object = json_node_get_object(root);
+  json_object_set_string_member(object, "version", ZATHURA_VERSION);
+  json_object_set_double_member(object, "open_seconds", open_time / (double)G_USEC_PER_SEC);
+  json_object_set_double_member(object, "seconds", (g_get_monotonic_time() - start) / (double)G_USEC_PER_SEC);
+
+  g_autoptr(JsonGenerator) generator = json_generator_new();
+  json_generator_set_pretty(generator, TRUE);
+  json_generator_set_root(generator, root);
+  g_autofree char* output = json_generator_to_data(generator, NULL);
+  fprintf(stdout, "%s\n", output);
+
+  /* the timings are printed even if pages failed */
+  JsonArray* results = json_object_get_array_member(object, "jobs");
+  for (guint idx = 0; idx < json_array_get_length(results); ++idx) {
+    if (json_object_get_int_member(json_array_get_object_element(results, idx), "failed") > 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 static zathura_t* init_zathura(const char* config_dir, const char* data_dir, const char* cache_dir,
                                const char* plugin_path, char** argv, const char* synctex_editor, Window embed) {
   /* create zathura session */
@@ -124,6 +277,14 @@ GIRARA_VISIBLE int main(int argc, char* argv[]) {
   g_autofree gchar* mode           = NULL;
   g_autofree gchar* bookmark_name  = NULL;
   g_autofree gchar* search_string  = NULL;
+  g_autofree gchar* startup_trace  = NULL;
+  g_autofree gchar* export_pages   = NULL;
+  g_autofree gchar* export_dir     = NULL;
+  g_autofree gchar* export_format  = NULL;
+  g_autofree gchar* batch_jobs     = NULL;
+  gint batch_threads               = 0;
+  gint export_dpi                  = 150;
+  gboolean export_recolor          = false;
   gboolean forkback                = false;
   gboolean print_version           = false;
   gint page_number                 = ZATHURA_PAGE_NUMBER_UNSPECIFIED;
@@ -151,6 +312,18 @@ GIRARA_VISIBLE int main(int argc, char* argv[]) {
       {"bookmark", 'b', 0, G_OPTION_ARG_STRING, &bookmark_name, _("Bookmark to go to"), "bookmark"},
       {"find", 'f', 0, G_OPTION_ARG_STRING, &search_string, _("Search for the given phrase and display results"),
        "string"},
+      {"startup-trace", '\0', 0, G_OPTION_ARG_FILENAME, &startup_trace,
+       _("Write startup timings as Chrome trace events to file"), "path"},
+      {"export-pages", '\0', 0, G_OPTION_ARG_STRING, &export_pages, _("Render the given pages to images and exit"),
+       "range"},
+      {"export-dir", '\0', 0, G_OPTION_ARG_FILENAME, &export_dir, _("Directory of the exported images"), "path"},
+      {"export-dpi", '\0', 0, G_OPTION_ARG_INT, &export_dpi, _("Resolution of the exported images"), "dpi"},
+      {"export-format", '\0', 0, G_OPTION_ARG_STRING, &export_format, _("Format of the exported images (png, jpeg)"),
+       "format"},
+      {"export-recolor", '\0', 0, G_OPTION_ARG_NONE, &export_recolor, _("Recolor the exported images"), NULL},
+      {"batch", '\0', 0, G_OPTION_ARG_STRING, &batch_jobs,
+       _("Run jobs (render, text, annotations) without a window and print the timings as JSON"), "jobs"},
+      {"batch-threads", '\0', 0, G_OPTION_ARG_INT, &batch_threads, _("Number of threads of --batch"), "number"},
       {NULL, '\0', 0, 0, NULL, NULL, NULL},
   };
 
@@ -168,6 +341,10 @@ GIRARA_VISIBLE int main(int argc, char* argv[]) {
 
   zathura_set_log_level(loglevel);
 
+  if (startup_trace != NULL) {
+    zathura_startup_trace_init(startup_trace);
+  }
+
 #ifdef WITH_SYNCTEX
   /* handle synctex forward synchronization */
   if (synctex_fwd != NULL) {
@@ -211,6 +388,29 @@ GIRARA_VISIBLE int main(int argc, char* argv[]) {
   const int file_idx_base    = has_double_dash ? 2 : 1;
 
   int file_idx = argc > file_idx_base ? file_idx_base : 0;
+
+  /* run batch jobs without opening a window */
+  if (batch_jobs != NULL) {
+    if (argc != file_idx_base + 1) {
+      girara_error("--batch expects exactly one file");
+      return -1;
+    }
+
+    return run_batch(argv[file_idx], password, plugin_path, batch_jobs, export_pages, export_dir, export_dpi,
+                     export_format, batch_threads);
+  }
+
+  /* export pages without opening a window */
+  if (export_pages != NULL) {
+    if (argc != file_idx_base + 1) {
+      girara_error("--export-pages expects exactly one file");
+      return -1;
+    }
+
+    return run_export_pages(argv[file_idx], password, plugin_path, export_pages, export_dir, export_dpi, export_format,
+                            export_recolor);
+  }
+
   /* Fork instances for other files. */
   if (print_version == false && argc > file_idx_base + 1) {
     for (int idx = file_idx_base + 1; idx < argc; ++idx) {
@@ -259,11 +459,15 @@ GIRARA_VISIBLE int main(int argc, char* argv[]) {
   }
 
   /* Initialize GTK+ */
+  zathura_startup_trace_begin("gtk_init");
   gtk_init(&argc, &argv);
+  zathura_startup_trace_end("gtk_init");
 
   /* Create zathura session */
+  zathura_startup_trace_begin("zathura_init");
   g_autoptr(zathura_t) zathura =
       init_zathura(config_dir, data_dir, cache_dir, plugin_path, argv, synctex_editor, embed);
+  zathura_startup_trace_end("zathura_init");
   if (zathura == NULL) {
     girara_error("Could not initialize zathura.");
     return -1;
@@ -0,0 +1,233 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <math.h>
+
+#include "overview.h"
+#include "document.h"
+#include "jumplist.h"
+#include "page.h"
+#include "shortcuts.h"
+#include "thumbnail-cache.h"
+
+/* space around a thumbnail */
+#define OVERVIEW_PADDING 8
+/* height of the page label below a thumbnail */
+#define OVERVIEW_LABEL_HEIGHT 20
+#define OVERVIEW_CELL_WIDTH (ZATHURA_THUMBNAIL_SIZE + 2 * OVERVIEW_PADDING)
+#define OVERVIEW_CELL_HEIGHT (ZATHURA_THUMBNAIL_SIZE + 2 * OVERVIEW_PADDING + OVERVIEW_LABEL_HEIGHT)
+
+static unsigned int overview_columns(GtkWidget* grid) {
+  return MAX(1, gtk_widget_get_allocated_width(grid) / OVERVIEW_CELL_WIDTH);
+}
+
+/* left margin centering the grid */
+static int overview_margin(GtkWidget* grid, unsigned int columns) {
+  return MAX(0, (gtk_widget_get_allocated_width(grid) - (int)columns * OVERVIEW_CELL_WIDTH) / 2);
+}
+
+static void overview_scroll_to_selected(zathura_t* zathura) {
+  GtkAdjustment* adjustment  = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(zathura->ui.overview));
+  const unsigned int columns = overview_columns(zathura->overview.grid);
+  const double top           = (double)(zathura->overview.selected / columns) * OVERVIEW_CELL_HEIGHT;
+  const double value         = gtk_adjustment_get_value(adjustment);
+  const double page_size     = gtk_adjustment_get_page_size(adjustment);
+
+  if (top < value) {
+    gtk_adjustment_set_value(adjustment, top);
+  } else if (top + OVERVIEW_CELL_HEIGHT > value + page_size) {
+    gtk_adjustment_set_value(adjustment, top + OVERVIEW_CELL_HEIGHT - page_size);
+  }
+}
+
+static gboolean overview_scroll_to_selected_idle(gpointer data) {
+  zathura_t* zathura = data;
+  if (zathura->ui.overview != NULL && zathura->document != NULL) {
+    overview_scroll_to_selected(zathura);
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+static void overview_draw_cell(zathura_t* zathura, cairo_t* cairo, PangoLayout* layout, const GdkRGBA* foreground,
+                               unsigned int page_id, double x, double y) {
+  zathura_page_t* page = zathura_document_get_page(zathura->document, page_id);
+  unsigned int width   = 0;
+  unsigned int height  = 0;
+  zathura_thumbnail_size(page, &width, &height);
+
+  const double thumbnail_x = x + OVERVIEW_PADDING + floor((ZATHURA_THUMBNAIL_SIZE - width) / 2.0);
+  const double thumbnail_y = y + OVERVIEW_PADDING + floor((ZATHURA_THUMBNAIL_SIZE - height) / 2.0);
+
+  cairo_surface_t* thumbnail = zathura_thumbnail_cache_get(zathura->overview.thumbnails, page_id);
+  if (thumbnail != NULL) {
+    cairo_set_source_surface(cairo, thumbnail, thumbnail_x, thumbnail_y);
+    cairo_paint(cairo);
+    cairo_surface_destroy(thumbnail);
+  } else {
+    gdk_cairo_set_source_rgba(cairo, &zathura->ui.colors.render_loading_bg);
+    cairo_rectangle(cairo, thumbnail_x, thumbnail_y, width, height);
+    cairo_fill(cairo);
+  }
+
+  if (page_id == zathura->overview.selected) {
+    gdk_cairo_set_source_rgba(cairo, &zathura->ui.colors.highlight_color_active);
+    cairo_set_line_width(cairo, 3);
+    cairo_rectangle(cairo, thumbnail_x - 2.5, thumbnail_y - 2.5, width + 5, height + 5);
+    cairo_stroke(cairo);
+  }
+
+  const char* label       = zathura_page_get_label(page, NULL);
+  g_autofree char* number = label == NULL ? g_strdup_printf("%u", page_id + 1) : NULL;
+  pango_layout_set_text(layout, label != NULL ? label : number, -1);
+
+  int text_width  = 0;
+  int text_height = 0;
+  pango_layout_get_pixel_size(layout, &text_width, &text_height);
+  gdk_cairo_set_source_rgba(cairo, foreground);
+  cairo_move_to(cairo, x + floor((OVERVIEW_CELL_WIDTH - text_width) / 2.0),
+                y + OVERVIEW_PADDING + ZATHURA_THUMBNAIL_SIZE +
+                    floor((OVERVIEW_PADDING + OVERVIEW_LABEL_HEIGHT - text_height) / 2.0));
+  pango_cairo_show_layout(cairo, layout);
+}
+
+static gboolean cb_overview_draw(GtkWidget* grid, cairo_t* cairo, gpointer data) {
+  zathura_t* zathura = data;
+  if (zathura->document == NULL || zathura->overview.thumbnails == NULL) {
+    return FALSE;
+  }
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  const unsigned int columns         = overview_columns(grid);
+  const int margin                   = overview_margin(grid, columns);
+
+  /* only draw the rows intersecting the exposed area */
+  double clip_x1 = 0;
+  double clip_y1 = 0;
+  double clip_x2 = 0;
+  double clip_y2 = 0;
+  cairo_clip_extents(cairo, &clip_x1, &clip_y1, &clip_x2, &clip_y2);
+  const unsigned int first_row = MAX(0, clip_y1) / OVERVIEW_CELL_HEIGHT;
+  const unsigned int last_row  = ceil(MAX(0, clip_y2) / OVERVIEW_CELL_HEIGHT);
+
+  GtkStyleContext* context = gtk_widget_get_style_context(grid);
+  GdkRGBA foreground;
+  gtk_style_context_get_color(context, gtk_style_context_get_state(context), &foreground);
+
+  PangoLayout* layout = pango_cairo_create_layout(cairo);
+  for (unsigned int row = first_row; row < last_row; ++row) {
+    for (unsigned int column = 0; column < columns; ++column) {
+      const unsigned int page_id = row * columns + column;
+      if (page_id >= number_of_pages) {
+        break;
+      }
+
+      overview_draw_cell(zathura, cairo, layout, &foreground, page_id, margin + column * OVERVIEW_CELL_WIDTH,
+                         row * OVERVIEW_CELL_HEIGHT);
+    }
+  }
+  g_object_unref(layout);
+
+  /* let the worker continue with the first visible thumbnail */
+  GtkAdjustment* adjustment  = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(zathura->ui.overview));
+  const unsigned int visible = (unsigned int)(gtk_adjustment_get_value(adjustment) / OVERVIEW_CELL_HEIGHT) * columns;
+  if (visible < number_of_pages) {
+    zathura_thumbnail_cache_prioritize(zathura->overview.thumbnails, visible);
+  }
+
+  return FALSE;
+}
+
+static void cb_overview_size_allocate(GtkWidget* grid, GdkRectangle* allocation, gpointer data) {
+  zathura_t* zathura = data;
+  if (zathura->document == NULL) {
+    return;
+  }
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  const unsigned int columns         = MAX(1, allocation->width / OVERVIEW_CELL_WIDTH);
+  const int height                   = (number_of_pages + columns - 1) / columns * OVERVIEW_CELL_HEIGHT;
+
+  int requested = 0;
+  gtk_widget_get_size_request(grid, NULL, &requested);
+  if (requested != height) {
+    gtk_widget_set_size_request(grid, -1, height);
+    /* the selected page moves when the number of columns changes */
+    g_idle_add(overview_scroll_to_selected_idle, zathura);
+  }
+}
+
+static gboolean cb_overview_button_press(GtkWidget* grid, GdkEventButton* event, gpointer data) {
+  zathura_t* zathura = data;
+  if (zathura->document == NULL || event->type != GDK_BUTTON_PRESS || event->button != GDK_BUTTON_PRIMARY) {
+    return FALSE;
+  }
+
+  const unsigned int columns = overview_columns(grid);
+  const int margin           = overview_margin(grid, columns);
+  if (event->x < margin || event->y < 0) {
+    return FALSE;
+  }
+
+  const unsigned int column  = (event->x - margin) / OVERVIEW_CELL_WIDTH;
+  const unsigned int page_id = (unsigned int)(event->y / OVERVIEW_CELL_HEIGHT) * columns + column;
+  if (column >= columns || page_id >= zathura_document_get_number_of_pages(zathura->document)) {
+    return FALSE;
+  }
+
+  zathura->overview.selected = page_id;
+  zathura_overview_activate(zathura);
+
+  return TRUE;
+}
+
+GtkWidget* zathura_overview_new(zathura_t* zathura) {
+  g_return_val_if_fail(zathura != NULL, NULL);
+
+  GtkWidget* overview = gtk_scrolled_window_new(NULL, NULL);
+  gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(overview), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+
+  GtkWidget* grid = gtk_drawing_area_new();
+  gtk_style_context_add_class(gtk_widget_get_style_context(grid), "overview");
+  gtk_widget_add_events(grid, GDK_BUTTON_PRESS_MASK);
+  g_signal_connect(G_OBJECT(grid), "draw", G_CALLBACK(cb_overview_draw), zathura);
+  g_signal_connect(G_OBJECT(grid), "size-allocate", G_CALLBACK(cb_overview_size_allocate), zathura);
+  g_signal_connect(G_OBJECT(grid), "button-press-event", G_CALLBACK(cb_overview_button_press), zathura);
+
+  gtk_widget_set_visible(grid, true);
+  gtk_container_add(GTK_CONTAINER(overview), grid);
+  zathura->overview.grid = grid;
+
+  return overview;
+}
+
+void zathura_overview_select(zathura_t* zathura, unsigned int page) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL && zathura->overview.grid != NULL);
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  zathura->overview.selected         = MIN(page, number_of_pages - 1);
+
+  gtk_widget_queue_draw(zathura->overview.grid);
+  overview_scroll_to_selected(zathura);
+}
+
+void zathura_overview_activate(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL);
+
+  const unsigned int page = zathura->overview.selected;
+  sc_toggle_overview(zathura->ui.session, NULL, NULL, 0);
+  page_set(zathura, page);
+  zathura_jumplist_add(zathura);
+}
+
+unsigned int zathura_overview_get_columns(zathura_t* zathura) {
+  g_return_val_if_fail(zathura != NULL && zathura->overview.grid != NULL, 1);
+
+  return overview_columns(zathura->overview.grid);
+}
+
+unsigned int zathura_overview_get_visible_rows(zathura_t* zathura) {
+  g_return_val_if_fail(zathura != NULL && zathura->ui.overview != NULL, 1);
+
+  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(zathura->ui.overview));
+  return MAX(1, gtk_adjustment_get_page_size(adjustment) / OVERVIEW_CELL_HEIGHT);
+}
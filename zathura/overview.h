@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_OVERVIEW_H
+#define ZATHURA_OVERVIEW_H
+
+#include <gtk/gtk.h>
+
+#include "zathura.h"
+
+/**
+ * Create the overview of the current document: a grid of page thumbnails in a
+ * scrolled window. Only the cells in the visible part of the grid are drawn.
+ *
+ * @param zathura The zathura session
+ * @return the scrolled window containing the grid
+ */
+GtkWidget* zathura_overview_new(zathura_t* zathura);
+
+/**
+ * Select a page in the overview and scroll it into view.
+ *
+ * @param zathura The zathura session
+ * @param page The page number
+ */
+void zathura_overview_select(zathura_t* zathura, unsigned int page);
+
+/**
+ * Leave the overview and go to the selected page.
+ *
+ * @param zathura The zathura session
+ */
+void zathura_overview_activate(zathura_t* zathura);
+
+/**
+ * Get the number of thumbnails per row of the overview.
+ *
+ * @param zathura The zathura session
+ * @return the number of columns
+ */
+unsigned int zathura_overview_get_columns(zathura_t* zathura);
+
+/**
+ * Get the number of rows visible in the overview.
+ *
+ * @param zathura The zathura session
+ * @return the number of rows
+ */
+unsigned int zathura_overview_get_visible_rows(zathura_t* zathura);
+
+#endif
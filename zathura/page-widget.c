@@ -11,17 +11,27 @@
 #include "links.h"
 #include "page-widget.h"
 #include "page.h"
+#include "rect-index.h"
 #include "render.h"
 #include "utils.h"
 #include "shortcuts.h"
 #include "zathura.h"
 #include "database.h"
+#include "startup-trace.h"
+
+typedef struct overlay_layer_s {
+  cairo_surface_t* surface; /**< Retained layer, NULL if there is nothing to draw */
+  unsigned int width;       /**< Width of the layer */
+  unsigned int height;      /**< Height of the layer */
+  bool dirty;               /**< True if the layer needs to be rebuilt */
+} overlay_layer_t;
 
 typedef struct zathura_page_widget_private_s {
   zathura_page_t* page;                 /**< Page object */
   zathura_t* zathura;                   /**< Zathura object */
   cairo_surface_t* surface;             /**< Cairo surface */
   cairo_surface_t* thumbnail;           /**< Cairo surface */
+  bool placeholder;                     /**< The thumbnail is a snapshot of an earlier session */
   ZathuraRenderRequest* render_request; /* Request object */
   bool cached;                          /**< Cached state */
 
@@ -93,6 +103,17 @@ typedef struct zathura_page_widget_private_s {
     double pending_widget_x;        /**< Widget X for pending popup */
     double pending_widget_y;        /**< Widget Y for pending popup */
   } embedded_notes;
+
+  zathura_rect_index_t* index; /**< Spatial index over links, highlights, notes and images (built on demand) */
+
+  struct {
+    double scale;            /**< Scale the cached rectangles were computed for */
+    unsigned int rotation;   /**< Rotation the cached rectangles were computed for */
+    GHashTable* rectangles;  /**< Rectangles in widget coordinates keyed by their source */
+  } transform;
+
+  overlay_layer_t overlay;        /**< Retained layer with highlights and notes */
+  overlay_layer_t search_overlay; /**< Retained layer with search results */
 } ZathuraPagePrivate;
 
 G_DEFINE_TYPE_WITH_CODE(ZathuraPage, zathura_page_widget, GTK_TYPE_DRAWING_AREA, G_ADD_PRIVATE(ZathuraPage))
@@ -225,6 +246,7 @@ static void zathura_page_widget_init(ZathuraPage* widget) {
   priv->zathura            = NULL;
   priv->surface            = NULL;
   priv->thumbnail          = NULL;
+  priv->placeholder        = false;
   priv->render_request     = NULL;
   priv->cached             = false;
 
@@ -277,6 +299,15 @@ static void zathura_page_widget_init(ZathuraPage* widget) {
   priv->embedded_notes.selected_x = 0.0;
   priv->embedded_notes.selected_y = 0.0;
 
+  priv->index = NULL;
+
+  priv->transform.scale      = 0;
+  priv->transform.rotation   = 0;
+  priv->transform.rectangles = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+
+  priv->overlay        = (overlay_layer_t){.dirty = true};
+  priv->search_overlay = (overlay_layer_t){.dirty = true};
+
   const unsigned int event_mask =
       GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK | GDK_POINTER_MOTION_MASK | GDK_LEAVE_NOTIFY_MASK;
   gtk_widget_add_events(GTK_WIDGET(widget), event_mask);
@@ -353,9 +384,217 @@ static void zathura_page_widget_finalize(GObject* object) {
     girara_list_free(priv->embedded_notes.list);
   }
 
+  zathura_rect_index_free(priv->index);
+  g_hash_table_unref(priv->transform.rectangles);
+
+  if (priv->overlay.surface != NULL) {
+    cairo_surface_destroy(priv->overlay.surface);
+  }
+  if (priv->search_overlay.surface != NULL) {
+    cairo_surface_destroy(priv->search_overlay.surface);
+  }
+
   G_OBJECT_CLASS(zathura_page_widget_parent_class)->finalize(object);
 }
 
+static void invalidate_index(ZathuraPagePrivate* priv) {
+  zathura_rect_index_free(priv->index);
+  priv->index = NULL;
+  /* cached widget rectangles are keyed by the rectangles of the index */
+  g_hash_table_remove_all(priv->transform.rectangles);
+  priv->overlay.dirty = true;
+}
+
+static void index_insert_note(zathura_rect_index_t* index, zathura_note_t* note, zathura_rect_index_kind_t kind) {
+  /* same anchor rectangle as used for drawing the note icon */
+  const zathura_rectangle_t note_rect = {.x1 = note->x, .y1 = note->y, .x2 = note->x + 1, .y2 = note->y + 1};
+  zathura_rect_index_insert(index, &note_rect, kind, note);
+}
+
+static zathura_rect_index_t* get_index(ZathuraPagePrivate* priv) {
+  if (priv->index != NULL) {
+    return priv->index;
+  }
+
+  size_t size_hint = 0;
+  if (priv->links.list != NULL) {
+    size_hint += girara_list_size(priv->links.list);
+  }
+  if (priv->highlights.list != NULL) {
+    size_hint += girara_list_size(priv->highlights.list);
+  }
+  if (priv->notes.list != NULL) {
+    size_hint += girara_list_size(priv->notes.list);
+  }
+  if (priv->embedded_notes.list != NULL) {
+    size_hint += girara_list_size(priv->embedded_notes.list);
+  }
+  if (priv->images.list != NULL) {
+    size_hint += girara_list_size(priv->images.list);
+  }
+
+  priv->index = zathura_rect_index_new(zathura_page_get_width(priv->page), zathura_page_get_height(priv->page),
+                                       size_hint);
+  if (priv->index == NULL) {
+    return NULL;
+  }
+
+  if (priv->links.list != NULL) {
+    for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
+      zathura_link_t* link                = girara_list_nth(priv->links.list, idx);
+      const zathura_rectangle_t rectangle = zathura_link_get_position(link);
+      zathura_rect_index_insert(priv->index, &rectangle, ZATHURA_RECT_INDEX_LINK, link);
+    }
+  }
+  if (priv->highlights.list != NULL) {
+    for (size_t idx = 0; idx != girara_list_size(priv->highlights.list); ++idx) {
+      zathura_highlight_t* highlight = girara_list_nth(priv->highlights.list, idx);
+      if (highlight == NULL || highlight->rects == NULL) {
+        continue;
+      }
+      for (size_t r = 0; r != girara_list_size(highlight->rects); ++r) {
+        zathura_rectangle_t* rect = girara_list_nth(highlight->rects, r);
+        if (rect != NULL) {
+          zathura_rect_index_insert(priv->index, rect, ZATHURA_RECT_INDEX_HIGHLIGHT, highlight);
+        }
+      }
+    }
+  }
+  if (priv->notes.list != NULL) {
+    for (size_t idx = 0; idx != girara_list_size(priv->notes.list); ++idx) {
+      zathura_note_t* note = girara_list_nth(priv->notes.list, idx);
+      if (note != NULL) {
+        index_insert_note(priv->index, note, ZATHURA_RECT_INDEX_NOTE);
+      }
+    }
+  }
+  if (priv->embedded_notes.list != NULL) {
+    for (size_t idx = 0; idx != girara_list_size(priv->embedded_notes.list); ++idx) {
+      zathura_note_t* note = girara_list_nth(priv->embedded_notes.list, idx);
+      if (note != NULL) {
+        index_insert_note(priv->index, note, ZATHURA_RECT_INDEX_EMBEDDED_NOTE);
+      }
+    }
+  }
+  if (priv->images.list != NULL) {
+    for (size_t idx = 0; idx != girara_list_size(priv->images.list); ++idx) {
+      zathura_image_t* image = girara_list_nth(priv->images.list, idx);
+      zathura_rect_index_insert(priv->index, &image->position, ZATHURA_RECT_INDEX_IMAGE, image);
+    }
+  }
+
+  return priv->index;
+}
+
+static void retrieve_links(ZathuraPagePrivate* priv) {
+  if (priv->links.retrieved == TRUE) {
+    return;
+  }
+
+  priv->links.list      = zathura_page_links_get(priv->page, NULL);
+  priv->links.retrieved = TRUE;
+  priv->links.n         = (priv->links.list == NULL) ? 0 : girara_list_size(priv->links.list);
+  invalidate_index(priv);
+}
+
+/* Inverse of recalc_rectangle: maps a rectangle in widget coordinates back to
+ * unscaled, unrotated page coordinates. */
+static zathura_rectangle_t widget_to_page_rectangle(zathura_page_t* page, zathura_rectangle_t rectangle) {
+  zathura_document_t* document = zathura_page_get_document(page);
+  const double scale           = zathura_document_get_scale(document);
+  const double page_height     = zathura_page_get_height(page);
+  const double page_width      = zathura_page_get_width(page);
+
+  const double x1 = rectangle.x1 / scale;
+  const double x2 = rectangle.x2 / scale;
+  const double y1 = rectangle.y1 / scale;
+  const double y2 = rectangle.y2 / scale;
+
+  zathura_rectangle_t tmp;
+  switch (zathura_document_get_rotation(document)) {
+  case 90:
+    tmp.x1 = y1;
+    tmp.x2 = y2;
+    tmp.y1 = page_height - x2;
+    tmp.y2 = page_height - x1;
+    break;
+  case 180:
+    tmp.x1 = page_width - x2;
+    tmp.x2 = page_width - x1;
+    tmp.y1 = page_height - y2;
+    tmp.y2 = page_height - y1;
+    break;
+  case 270:
+    tmp.x1 = page_width - y2;
+    tmp.x2 = page_width - y1;
+    tmp.y1 = x1;
+    tmp.y2 = x2;
+    break;
+  default:
+    tmp.x1 = x1;
+    tmp.x2 = x2;
+    tmp.y1 = y1;
+    tmp.y2 = y2;
+  }
+
+  return tmp;
+}
+
+typedef struct hit_test_s {
+  zathura_page_t* page; /**< Page of the widget */
+  double x;             /**< X coordinate of the point in widget coordinates */
+  double y;             /**< Y coordinate of the point in widget coordinates */
+  bool last;            /**< Report the last instead of the first hit */
+  void* hit;            /**< Data of the entry that was hit */
+} hit_test_t;
+
+static bool cb_hit_test_rectangle(const zathura_rectangle_t* rectangle, zathura_rect_index_kind_t UNUSED(kind),
+                                  void* data, void* user_data) {
+  hit_test_t* test               = user_data;
+  const zathura_rectangle_t rect = recalc_rectangle(test->page, *rectangle);
+  if (rect.x1 <= test->x && rect.x2 >= test->x && rect.y1 <= test->y && rect.y2 >= test->y) {
+    test->hit = data;
+    return test->last;
+  }
+  return true;
+}
+
+static bool cb_hit_test_note_icon(const zathura_rectangle_t* rectangle, zathura_rect_index_kind_t UNUSED(kind),
+                                  void* data, void* user_data) {
+  hit_test_t* test               = user_data;
+  const zathura_rectangle_t rect = recalc_rectangle(test->page, *rectangle);
+  if (test->x >= rect.x1 && test->x <= rect.x1 + NOTE_ICON_SIZE && test->y >= rect.y1 &&
+      test->y <= rect.y1 + NOTE_ICON_SIZE) {
+    test->hit = data;
+    return false;
+  }
+  return true;
+}
+
+/* Returns the data of the first (or last) entry of the given kinds whose
+ * rectangle contains the point (x, y) given in widget coordinates. */
+static void* hit_test(ZathuraPagePrivate* priv, double x, double y, zathura_rect_index_kind_t kinds, bool last) {
+  zathura_rect_index_t* index = get_index(priv);
+  if (index == NULL) {
+    return NULL;
+  }
+
+  hit_test_t test = {.page = priv->page, .x = x, .y = y, .last = last, .hit = NULL};
+  if (kinds & (ZATHURA_RECT_INDEX_NOTE | ZATHURA_RECT_INDEX_EMBEDDED_NOTE)) {
+    /* note icons have a fixed size in widget coordinates and extend to the
+     * bottom right of their anchor */
+    const zathura_rectangle_t area = widget_to_page_rectangle(
+        priv->page, (zathura_rectangle_t){.x1 = x - NOTE_ICON_SIZE, .y1 = y - NOTE_ICON_SIZE, .x2 = x, .y2 = y});
+    zathura_rect_index_query(index, &area, kinds, cb_hit_test_note_icon, &test);
+  } else {
+    const zathura_rectangle_t area =
+        widget_to_page_rectangle(priv->page, (zathura_rectangle_t){.x1 = x, .y1 = y, .x2 = x, .y2 = y});
+    zathura_rect_index_query(index, &area, kinds, cb_hit_test_rectangle, &test);
+  }
+
+  return test.hit;
+}
+
 static void set_font_from_property(cairo_t* cairo, zathura_t* zathura, cairo_font_weight_t weight) {
   if (zathura == NULL) {
     return;
@@ -431,12 +670,46 @@ static cairo_text_extents_t get_text_extents(const char* string, zathura_t* zath
   return text;
 }
 
+/* A string as wide as the widest link hint of the page, i.e. as many digits as
+ * the largest hint number */
+static char* link_hint_template(ZathuraPagePrivate* priv) {
+  const int digits = snprintf(NULL, 0, "%u", (unsigned int)priv->links.offset + priv->links.n);
+  char* template   = g_malloc(digits + 1);
+  memset(template, '8', digits);
+  template[digits] = '\0';
+
+  return template;
+}
+
+/* Redraw the links of the page together with the area of their hints. */
+static void redraw_link_hints(ZathuraPage* pageview) {
+  ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(pageview);
+  if (priv->links.retrieved == FALSE || priv->links.list == NULL) {
+    return;
+  }
+
+  g_autofree char* template       = link_hint_template(priv);
+  const cairo_text_extents_t text = get_text_extents(template, priv->zathura, CAIRO_FONT_WEIGHT_BOLD);
+
+  for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
+    zathura_link_t* link = girara_list_nth(priv->links.list, idx);
+    if (link != NULL) {
+      /* redraw link area */
+      zathura_rectangle_t rectangle = recalc_rectangle(priv->page, zathura_link_get_position(link));
+      redraw_rect(pageview, &rectangle);
+
+      /* also redraw area for link hint */
+      rectangle.x2 = rectangle.x1 + text.width;
+      rectangle.y1 = rectangle.y2 - text.height;
+      redraw_rect(pageview, &rectangle);
+    }
+  }
+}
+
 static void zathura_page_widget_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
   ZathuraPage* pageview    = ZATHURA_PAGE(object);
   ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(pageview);
 
-  cairo_text_extents_t text;
-
   switch (prop_id) {
   case PROP_PAGE:
     priv->page = g_value_get_pointer(value);
@@ -447,40 +720,28 @@ static void zathura_page_widget_set_property(GObject* object, guint prop_id, con
   case PROP_DRAW_LINKS:
     priv->links.draw = g_value_get_boolean(value);
     /* get links */
-    if (priv->links.draw == TRUE && priv->links.retrieved == FALSE) {
-      priv->links.list      = zathura_page_links_get(priv->page, NULL);
-      priv->links.retrieved = TRUE;
-      priv->links.n         = (priv->links.list == NULL) ? 0 : girara_list_size(priv->links.list);
+    if (priv->links.draw == TRUE) {
+      retrieve_links(priv);
     }
 
-    if (priv->links.retrieved == TRUE && priv->links.list != NULL) {
-      /* get size of text that should be large enough for every link hint */
-      text = get_text_extents("888", priv->zathura, CAIRO_FONT_WEIGHT_BOLD);
-
-      for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
-        zathura_link_t* link = girara_list_nth(priv->links.list, idx);
-        if (link != NULL) {
-          /* redraw link area */
-          zathura_rectangle_t rectangle = recalc_rectangle(priv->page, zathura_link_get_position(link));
-          redraw_rect(pageview, &rectangle);
-
-          /* also redraw area for link hint */
-          rectangle.x2 = rectangle.x1 + text.width;
-          rectangle.y1 = rectangle.y2 - text.height;
-          redraw_rect(pageview, &rectangle);
-        }
-      }
-    }
+    redraw_link_hints(pageview);
     break;
   case PROP_LINKS_OFFSET:
     priv->links.offset = g_value_get_int(value);
+    /* the hints may have become wider */
+    if (priv->links.draw == TRUE) {
+      redraw_link_hints(pageview);
+    }
     break;
   case PROP_SEARCH_RESULTS:
     if (priv->search.list != NULL && priv->search.draw) {
       redraw_all_rects(pageview, priv->search.list);
       girara_list_free(priv->search.list);
     }
-    priv->search.list = g_value_get_pointer(value);
+    /* cached widget rectangles might be keyed by the old search results */
+    g_hash_table_remove_all(priv->transform.rectangles);
+    priv->search.list          = g_value_get_pointer(value);
+    priv->search_overlay.dirty = true;
     if (priv->search.list != NULL && priv->search.draw) {
       priv->links.draw = FALSE;
       redraw_all_rects(pageview, priv->search.list);
@@ -489,6 +750,7 @@ static void zathura_page_widget_set_property(GObject* object, guint prop_id, con
     break;
   case PROP_SEARCH_RESULTS_CURRENT: {
     g_return_if_fail(priv->search.list != NULL);
+    priv->search_overlay.dirty = true;
     if (priv->search.current >= 0 && priv->search.current < (signed)girara_list_size(priv->search.list)) {
       zathura_rectangle_t* rect     = girara_list_nth(priv->search.list, priv->search.current);
       zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
@@ -508,7 +770,8 @@ static void zathura_page_widget_set_property(GObject* object, guint prop_id, con
     break;
   }
   case PROP_DRAW_SEARCH_RESULTS:
-    priv->search.draw = g_value_get_boolean(value);
+    priv->search.draw          = g_value_get_boolean(value);
+    priv->search_overlay.dirty = true;
 
     /*
      * we do the following instead of only redrawing the rectangles of the
@@ -585,6 +848,276 @@ static zathura_device_factors_t get_safe_device_factors(cairo_surface_t* surface
   return factors;
 }
 
+static bool rectangle_intersects(const zathura_rectangle_t* lhs, const zathura_rectangle_t* rhs) {
+  return lhs->x1 <= rhs->x2 && rhs->x1 <= lhs->x2 && lhs->y1 <= rhs->y2 && rhs->y1 <= lhs->y2;
+}
+
+static void update_transform_cache(ZathuraPagePrivate* priv) {
+  zathura_document_t* document = zathura_page_get_document(priv->page);
+  const double scale           = zathura_document_get_scale(document);
+  const unsigned int rotation  = zathura_document_get_rotation(document);
+
+  if (scale != priv->transform.scale || rotation != priv->transform.rotation) {
+    g_hash_table_remove_all(priv->transform.rectangles);
+    priv->transform.scale    = scale;
+    priv->transform.rotation   = rotation;
+    priv->overlay.dirty        = true;
+    priv->search_overlay.dirty = true;
+  }
+}
+
+/* Returns the rectangle in widget coordinates. The result is cached per key
+ * until the zoom level or the rotation changes. */
+static zathura_rectangle_t get_widget_rectangle(ZathuraPagePrivate* priv, const void* key,
+                                                zathura_rectangle_t rectangle) {
+  const zathura_rectangle_t* cached = g_hash_table_lookup(priv->transform.rectangles, key);
+  if (cached != NULL) {
+    return *cached;
+  }
+
+  const zathura_rectangle_t result = recalc_rectangle(priv->page, rectangle);
+  g_hash_table_insert(priv->transform.rectangles, (gpointer)key, g_memdup2(&result, sizeof(result)));
+  return result;
+}
+
+static GdkRGBA get_highlight_color(zathura_t* zathura, zathura_highlight_color_t highlight_color) {
+  switch (highlight_color) {
+  case ZATHURA_HIGHLIGHT_YELLOW:
+    return (GdkRGBA){1.0, 0.95, 0.6, 0.4};
+  case ZATHURA_HIGHLIGHT_GREEN:
+    return (GdkRGBA){0.6, 1.0, 0.6, 0.4};
+  case ZATHURA_HIGHLIGHT_BLUE:
+    return (GdkRGBA){0.6, 0.8, 1.0, 0.4};
+  case ZATHURA_HIGHLIGHT_RED:
+    return (GdkRGBA){1.0, 0.6, 0.6, 0.4};
+  default:
+    return zathura->ui.colors.highlight_color;
+  }
+}
+
+typedef struct draw_overlay_s {
+  ZathuraPagePrivate* priv; /**< Private data of the widget */
+  cairo_t* cairo;           /**< Cairo context to draw on */
+} draw_overlay_t;
+
+static bool cb_draw_highlight(const zathura_rectangle_t* rect, zathura_rect_index_kind_t UNUSED(kind), void* data,
+                              void* user_data) {
+  draw_overlay_t* overlay        = user_data;
+  zathura_highlight_t* highlight = data;
+
+  const GdkRGBA color                 = get_highlight_color(overlay->priv->zathura, highlight->color);
+  const zathura_rectangle_t rectangle = get_widget_rectangle(overlay->priv, rect, *rect);
+  cairo_set_source_rgba(overlay->cairo, color.red, color.green, color.blue, color.alpha);
+  cairo_rectangle(overlay->cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
+  cairo_fill(overlay->cairo);
+
+  return true;
+}
+
+static bool cb_draw_highlight_border(const zathura_rectangle_t* rect, zathura_rect_index_kind_t UNUSED(kind),
+                                     void* data, void* user_data) {
+  draw_overlay_t* overlay        = user_data;
+  zathura_highlight_t* highlight = data;
+
+  if (highlight->id == NULL || g_strcmp0(highlight->id, overlay->priv->highlights.selected_id) != 0) {
+    return true;
+  }
+
+  const zathura_rectangle_t rectangle = get_widget_rectangle(overlay->priv, rect, *rect);
+  cairo_rectangle(overlay->cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
+  cairo_stroke(overlay->cairo);
+
+  return true;
+}
+
+static bool cb_draw_note_icon(const zathura_rectangle_t* rect, zathura_rect_index_kind_t kind, void* data,
+                              void* user_data) {
+  draw_overlay_t* overlay  = user_data;
+  ZathuraPagePrivate* priv = overlay->priv;
+  cairo_t* cairo           = overlay->cairo;
+  zathura_note_t* note     = data;
+
+  /* Transform note position */
+  const zathura_rectangle_t transformed = get_widget_rectangle(priv, rect, *rect);
+  const double icon_x                   = transformed.x1;
+  const double icon_y                   = transformed.y1;
+
+  bool selected = false;
+  if (kind == ZATHURA_RECT_INDEX_EMBEDDED_NOTE) {
+    /* Light blue fill and dark blue border for embedded notes */
+    cairo_set_source_rgba(cairo, 0.6, 0.8, 1.0, 0.9);
+    cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
+    cairo_fill(cairo);
+    cairo_set_source_rgba(cairo, 0.2, 0.4, 0.8, 0.9);
+
+    const double eps = 1.0;
+    selected = priv->embedded_notes.has_selection == TRUE && fabs(note->x - priv->embedded_notes.selected_x) < eps &&
+               fabs(note->y - priv->embedded_notes.selected_y) < eps;
+  } else {
+    /* Light yellow fill and dark border (small post-it style) */
+    cairo_set_source_rgba(cairo, 1.0, 0.95, 0.6, 0.9);
+    cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
+    cairo_fill(cairo);
+    cairo_set_source_rgba(cairo, 0.6, 0.5, 0.2, 0.9);
+
+    selected = priv->notes.selected_id != NULL && note->id != NULL && g_strcmp0(note->id, priv->notes.selected_id) == 0;
+  }
+  cairo_set_line_width(cairo, 1.0);
+  cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
+  cairo_stroke(cairo);
+
+  /* Draw red border if this note is selected */
+  if (selected == true) {
+    cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);
+    cairo_set_line_width(cairo, 2.0);
+    cairo_rectangle(cairo, icon_x - 1, icon_y - 1, NOTE_ICON_SIZE + 2, NOTE_ICON_SIZE + 2);
+    cairo_stroke(cairo);
+  }
+
+  return true;
+}
+
+/* Draws persistent highlights and note icons that intersect clip (in widget
+ * coordinates). */
+static void draw_overlays(ZathuraPagePrivate* priv, cairo_t* cairo, const zathura_rectangle_t* clip) {
+  /* Persistent highlights and notes are looked up in the spatial index */
+  zathura_rect_index_t* rect_index = get_index(priv);
+  draw_overlay_t overlay           = {.priv = priv, .cairo = cairo};
+
+  /* Draw persistent highlights (selection border is 2 pixels wide) */
+  if (priv->highlights.list != NULL) {
+    const zathura_rectangle_t area = widget_to_page_rectangle(
+        priv->page,
+        (zathura_rectangle_t){.x1 = clip->x1 - 1, .y1 = clip->y1 - 1, .x2 = clip->x2 + 1, .y2 = clip->y2 + 1});
+    zathura_rect_index_query(rect_index, &area, ZATHURA_RECT_INDEX_HIGHLIGHT, cb_draw_highlight, &overlay);
+
+    /* Draw red border if a highlight is selected */
+    if (priv->highlights.selected_id != NULL) {
+      cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);  /* Red border */
+      cairo_set_line_width(cairo, 2.0);
+      zathura_rect_index_query(rect_index, &area, ZATHURA_RECT_INDEX_HIGHLIGHT, cb_draw_highlight_border, &overlay);
+    }
+  }
+
+  /* Draw red border if an embedded annotation is selected */
+  if (priv->highlights.embedded_selected_rects != NULL) {
+    cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);  /* Red border */
+    cairo_set_line_width(cairo, 2.0);
+    for (size_t r = 0; r < girara_list_size(priv->highlights.embedded_selected_rects); r++) {
+      zathura_rectangle_t* rect = girara_list_nth(priv->highlights.embedded_selected_rects, r);
+      if (rect != NULL) {
+        zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
+        cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
+        cairo_stroke(cairo);
+      }
+    }
+  }
+
+  /* Draw sticky note icons; embedded PDF notes are drawn AFTER database
+   * notes so they appear on top. Icons (including the selection border)
+   * extend to the bottom right of their anchor. */
+  if (priv->notes.list != NULL || priv->embedded_notes.list != NULL) {
+    const zathura_rectangle_t area = widget_to_page_rectangle(
+        priv->page, (zathura_rectangle_t){.x1 = clip->x1 - NOTE_ICON_SIZE - 2,
+                                          .y1 = clip->y1 - NOTE_ICON_SIZE - 2,
+                                          .x2 = clip->x2 + 2,
+                                          .y2 = clip->y2 + 2});
+    zathura_rect_index_query(rect_index, &area, ZATHURA_RECT_INDEX_NOTE, cb_draw_note_icon, &overlay);
+    zathura_rect_index_query(rect_index, &area, ZATHURA_RECT_INDEX_EMBEDDED_NOTE, cb_draw_note_icon, &overlay);
+  }
+}
+
+static bool has_overlays(ZathuraPagePrivate* priv) {
+  return (priv->highlights.list != NULL && girara_list_size(priv->highlights.list) != 0) ||
+         priv->highlights.embedded_selected_rects != NULL ||
+         (priv->notes.list != NULL && girara_list_size(priv->notes.list) != 0) ||
+         (priv->embedded_notes.list != NULL && girara_list_size(priv->embedded_notes.list) != 0);
+}
+
+/* Draws search results that intersect clip (in widget coordinates). */
+static void draw_search_results(ZathuraPagePrivate* priv, cairo_t* cairo, const zathura_rectangle_t* clip) {
+  for (size_t idx = 0; idx != girara_list_size(priv->search.list); ++idx) {
+    zathura_rectangle_t* rect     = girara_list_nth(priv->search.list, idx);
+    zathura_rectangle_t rectangle = get_widget_rectangle(priv, rect, *rect);
+    if (rectangle_intersects(&rectangle, clip) == false) {
+      continue;
+    }
+
+    /* draw position */
+    if ((int)idx == priv->search.current) {
+      const GdkRGBA color = priv->zathura->ui.colors.highlight_color_active;
+      cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
+    } else {
+      const GdkRGBA color = priv->zathura->ui.colors.highlight_color;
+      cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
+    }
+    cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1), (rectangle.y2 - rectangle.y1));
+    cairo_fill(cairo);
+  }
+}
+
+static bool has_search_results(ZathuraPagePrivate* priv) {
+  return priv->search.list != NULL && priv->search.draw == TRUE && girara_list_size(priv->search.list) != 0;
+}
+
+static void clear_overlay_layer(overlay_layer_t* overlay) {
+  if (overlay->surface != NULL) {
+    cairo_surface_destroy(overlay->surface);
+    overlay->surface = NULL;
+  }
+  overlay->dirty = true;
+}
+
+/* Returns the retained layer, rebuilding it with draw if it is outdated.
+ * Returns NULL if has_content reports that there is nothing to draw. */
+static cairo_surface_t* get_overlay_layer(ZathuraPagePrivate* priv, overlay_layer_t* overlay, cairo_t* cairo,
+                                          unsigned int width, unsigned int height,
+                                          bool (*has_content)(ZathuraPagePrivate*),
+                                          void (*draw)(ZathuraPagePrivate*, cairo_t*, const zathura_rectangle_t*)) {
+  if (overlay->dirty == false && overlay->width == width && overlay->height == height) {
+    return overlay->surface;
+  }
+
+  if (has_content(priv) == false) {
+    clear_overlay_layer(overlay);
+    overlay->dirty = false;
+    return NULL;
+  }
+
+  if (overlay->surface == NULL || overlay->width != width || overlay->height != height) {
+    clear_overlay_layer(overlay);
+
+    /* width and height are taken as unscaled device units, the device scale
+     * of the target is inherited */
+    cairo_surface_t* surface =
+        cairo_surface_create_similar(cairo_get_target(cairo), CAIRO_CONTENT_COLOR_ALPHA, width, height);
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+      cairo_surface_destroy(surface);
+      return NULL;
+    }
+    overlay->surface = surface;
+    overlay->width   = width;
+    overlay->height  = height;
+  }
+
+  cairo_t* layer = cairo_create(overlay->surface);
+  if (cairo_status(layer) != CAIRO_STATUS_SUCCESS) {
+    cairo_destroy(layer);
+    return NULL;
+  }
+
+  cairo_set_operator(layer, CAIRO_OPERATOR_CLEAR);
+  cairo_paint(layer);
+  cairo_set_operator(layer, CAIRO_OPERATOR_OVER);
+
+  const zathura_rectangle_t area = {.x1 = 0, .y1 = 0, .x2 = width, .y2 = height};
+  draw(priv, layer, &area);
+  cairo_destroy(layer);
+
+  overlay->dirty = false;
+  return overlay->surface;
+}
+
 static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
   ZathuraPage* page        = ZATHURA_PAGE(widget);
   ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(page);
@@ -635,6 +1168,11 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
       cairo_set_source_surface(cairo, priv->surface, 0, 0);
       cairo_paint(cairo);
       cairo_restore(cairo);
+
+      if (zathura_startup_trace_enabled() == true) {
+        zathura_startup_trace_mark("first-paint");
+        zathura_startup_trace_finish();
+      }
     } else {
       const unsigned int height = cairo_image_surface_get_height(priv->thumbnail);
       const unsigned int width  = cairo_image_surface_get_width(priv->thumbnail);
@@ -663,31 +1201,52 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
       return FALSE;
     }
 
+    /* only overlays intersecting the clip region need to be drawn */
+    zathura_rectangle_t clip;
+    cairo_clip_extents(cairo, &clip.x1, &clip.y1, &clip.x2, &clip.y2);
+    update_transform_cache(priv);
+
     /* draw links */
     set_font_from_property(cairo, zathura, CAIRO_FONT_WEIGHT_BOLD);
 
     if (priv->links.draw == true && priv->links.n != 0) {
+      /* link hints are drawn at the bottom left corner and may exceed the link */
+      g_autofree char* template = link_hint_template(priv);
+      cairo_text_extents_t hint;
+      cairo_text_extents(cairo, template, &hint);
+
       unsigned int link_counter = 0;
       for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
         zathura_link_t* link = girara_list_nth(priv->links.list, idx);
-        if (link != NULL) {
-          zathura_rectangle_t rectangle = recalc_rectangle(priv->page, zathura_link_get_position(link));
+        if (link == NULL) {
+          continue;
+        }
+        ++link_counter;
+
+        zathura_rectangle_t rectangle = get_widget_rectangle(priv, link, zathura_link_get_position(link));
+        const zathura_rectangle_t extents = {
+            .x1 = rectangle.x1,
+            .y1 = MIN(rectangle.y1, rectangle.y2 - hint.height - 2),
+            .x2 = MAX(rectangle.x2, rectangle.x1 + hint.width + 6),
+            .y2 = rectangle.y2,
+        };
+        if (rectangle_intersects(&extents, &clip) == false) {
+          continue;
+        }
 
-          /* draw position */
-          const GdkRGBA color = zathura->ui.colors.highlight_color;
-          cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
-          cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1),
-                          (rectangle.y2 - rectangle.y1));
-          cairo_fill(cairo);
+        /* draw position */
+        const GdkRGBA color = zathura->ui.colors.highlight_color;
+        cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
+        cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1), (rectangle.y2 - rectangle.y1));
+        cairo_fill(cairo);
 
-          /* draw text */
-          const GdkRGBA color_fg = zathura->ui.colors.highlight_color_fg;
-          cairo_set_source_rgba(cairo, color_fg.red, color_fg.green, color_fg.blue, color_fg.alpha);
-          cairo_move_to(cairo, rectangle.x1 + 1, rectangle.y2 - 1);
-          char* link_number = g_strdup_printf("%i", priv->links.offset + ++link_counter);
-          cairo_show_text(cairo, link_number);
-          g_free(link_number);
-        }
+        /* draw text */
+        const GdkRGBA color_fg = zathura->ui.colors.highlight_color_fg;
+        cairo_set_source_rgba(cairo, color_fg.red, color_fg.green, color_fg.blue, color_fg.alpha);
+        cairo_move_to(cairo, rectangle.x1 + 1, rectangle.y2 - 1);
+        char* link_number = g_strdup_printf("%i", priv->links.offset + link_counter);
+        cairo_show_text(cairo, link_number);
+        g_free(link_number);
       }
     }
 
@@ -736,19 +1295,32 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
           text  = _("Signature is invalid.");
         }
 
-        /* draw position */
-        zathura_rectangle_t rectangle = recalc_rectangle(priv->page, signature->position);
-        cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
-        cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1),
-                        (rectangle.y2 - rectangle.y1));
-        cairo_fill(cairo);
-
-        /* draw text */
-        const GdkRGBA color_fg = zathura->ui.colors.highlight_color_fg;
-        cairo_set_source_rgba(cairo, color_fg.red, color_fg.green, color_fg.blue, color_fg.alpha);
+        zathura_rectangle_t rectangle = get_widget_rectangle(priv, signature, signature->position);
         pango_layout_set_text(layout, text, strlen(text));
-        cairo_move_to(cairo, rectangle.x1 + 1, rectangle.y1 + 1);
-        pango_cairo_show_layout(cairo, layout);
+
+        /* the text may exceed the signature area */
+        PangoRectangle text_extents;
+        pango_layout_get_pixel_extents(layout, NULL, &text_extents);
+        const zathura_rectangle_t extents = {
+            .x1 = rectangle.x1,
+            .y1 = rectangle.y1,
+            .x2 = MAX(rectangle.x2, rectangle.x1 + 1 + text_extents.x + text_extents.width),
+            .y2 = MAX(rectangle.y2, rectangle.y1 + 1 + text_extents.y + text_extents.height),
+        };
+
+        if (rectangle_intersects(&extents, &clip) == true) {
+          /* draw position */
+          cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
+          cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1),
+                          (rectangle.y2 - rectangle.y1));
+          cairo_fill(cairo);
+
+          /* draw text */
+          const GdkRGBA color_fg = zathura->ui.colors.highlight_color_fg;
+          cairo_set_source_rgba(cairo, color_fg.red, color_fg.green, color_fg.blue, color_fg.alpha);
+          cairo_move_to(cairo, rectangle.x1 + 1, rectangle.y1 + 1);
+          pango_cairo_show_layout(cairo, layout);
+        }
         if (free_text == true) {
           g_free(text);
         }
@@ -757,24 +1329,14 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
       g_object_unref(layout);
     }
 
-    /* draw search results */
-    if (priv->search.list != NULL && priv->search.draw == true) {
-      for (size_t idx = 0; idx != girara_list_size(priv->search.list); ++idx) {
-        zathura_rectangle_t* rect     = girara_list_nth(priv->search.list, idx);
-        zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
-
-        /* draw position */
-        if ((int)idx == priv->search.current) {
-          const GdkRGBA color = zathura->ui.colors.highlight_color_active;
-          cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
-        } else {
-          const GdkRGBA color = zathura->ui.colors.highlight_color;
-          cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
-        }
-        cairo_rectangle(cairo, rectangle.x1, rectangle.y1, (rectangle.x2 - rectangle.x1),
-                        (rectangle.y2 - rectangle.y1));
-        cairo_fill(cairo);
-      }
+    /* Search results have a retained layer of their own, so that they stay
+     * below the selection and the highlighter. It is rebuilt when the results,
+     * the current result or the colors change. */
+    cairo_surface_t* search_layer = get_overlay_layer(priv, &priv->search_overlay, cairo, page_width, page_height,
+                                                      has_search_results, draw_search_results);
+    if (search_layer != NULL) {
+      cairo_set_source_surface(cairo, search_layer, 0, 0);
+      cairo_paint(cairo);
     }
     if (priv->selection.list != NULL && priv->selection.draw == true) {
       const GdkRGBA color = priv->zathura->ui.colors.highlight_color;
@@ -782,6 +1344,9 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
       for (size_t idx = 0; idx != girara_list_size(priv->selection.list); ++idx) {
         zathura_rectangle_t* rect     = girara_list_nth(priv->selection.list, idx);
         zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
+        if (rectangle_intersects(&rectangle, &clip) == false) {
+          continue;
+        }
         cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
         cairo_fill(cairo);
       }
@@ -793,177 +1358,25 @@ static gboolean zathura_page_widget_draw(GtkWidget* widget, cairo_t* cairo) {
       cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
       cairo_fill(cairo);
     }
-    /* Draw persistent highlights */
-    if (priv->highlights.list != NULL) {
-      for (size_t idx = 0; idx != girara_list_size(priv->highlights.list); ++idx) {
-        zathura_highlight_t* highlight = girara_list_nth(priv->highlights.list, idx);
-        if (highlight == NULL) {
-          continue;
-        }
-        /* Set color based on highlight color */
-        GdkRGBA color;
-        switch (highlight->color) {
-        case ZATHURA_HIGHLIGHT_YELLOW:
-          color = (GdkRGBA){1.0, 0.95, 0.6, 0.4};
-          break;
-        case ZATHURA_HIGHLIGHT_GREEN:
-          color = (GdkRGBA){0.6, 1.0, 0.6, 0.4};
-          break;
-        case ZATHURA_HIGHLIGHT_BLUE:
-          color = (GdkRGBA){0.6, 0.8, 1.0, 0.4};
-          break;
-        case ZATHURA_HIGHLIGHT_RED:
-          color = (GdkRGBA){1.0, 0.6, 0.6, 0.4};
-          break;
-        default:
-          color = priv->zathura->ui.colors.highlight_color;
-          break;
-        }
-        cairo_set_source_rgba(cairo, color.red, color.green, color.blue, color.alpha);
-        /* Draw each rectangle in the highlight */
-        if (highlight->rects != NULL) {
-          for (size_t r = 0; r < girara_list_size(highlight->rects); r++) {
-            zathura_rectangle_t* rect = girara_list_nth(highlight->rects, r);
-            if (rect != NULL) {
-              zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
-              cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
-              cairo_fill(cairo);
-            }
-          }
-        }
-
-        /* Draw red border if this highlight is selected */
-        if (priv->highlights.selected_id != NULL && highlight->id != NULL &&
-            g_strcmp0(highlight->id, priv->highlights.selected_id) == 0) {
-          cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);  /* Red border */
-          cairo_set_line_width(cairo, 2.0);
-          if (highlight->rects != NULL) {
-            for (size_t r = 0; r < girara_list_size(highlight->rects); r++) {
-              zathura_rectangle_t* rect = girara_list_nth(highlight->rects, r);
-              if (rect != NULL) {
-                zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
-                cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
-                cairo_stroke(cairo);
-              }
-            }
-          }
-        }
-      }
-    }
-
-    /* Draw red border if an embedded annotation is selected */
-    if (priv->highlights.embedded_selected_rects != NULL) {
-      cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);  /* Red border */
-      cairo_set_line_width(cairo, 2.0);
-      for (size_t r = 0; r < girara_list_size(priv->highlights.embedded_selected_rects); r++) {
-        zathura_rectangle_t* rect = girara_list_nth(priv->highlights.embedded_selected_rects, r);
-        if (rect != NULL) {
-          zathura_rectangle_t rectangle = recalc_rectangle(priv->page, *rect);
-          cairo_rectangle(cairo, rectangle.x1, rectangle.y1, rectangle.x2 - rectangle.x1, rectangle.y2 - rectangle.y1);
-          cairo_stroke(cairo);
-        }
-      }
-    }
-
-    /* Draw sticky note icons */
-    if (priv->notes.list != NULL) {
-      for (size_t idx = 0; idx != girara_list_size(priv->notes.list); ++idx) {
-        zathura_note_t* note = girara_list_nth(priv->notes.list, idx);
-        if (note == NULL) {
-          continue;
-        }
-
-        /* Transform note position using recalc_rectangle */
-        zathura_rectangle_t note_rect = {
-          .x1 = note->x,
-          .y1 = note->y,
-          .x2 = note->x + 1,
-          .y2 = note->y + 1
-        };
-        zathura_rectangle_t transformed = recalc_rectangle(priv->page, note_rect);
-
-        /* Draw note icon (small post-it style) */
-        double icon_x = transformed.x1;
-        double icon_y = transformed.y1;
-
-        /* Light yellow fill */
-        cairo_set_source_rgba(cairo, 1.0, 0.95, 0.6, 0.9);
-        cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
-        cairo_fill(cairo);
-
-        /* Dark border */
-        cairo_set_source_rgba(cairo, 0.6, 0.5, 0.2, 0.9);
-        cairo_set_line_width(cairo, 1.0);
-        cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
-        cairo_stroke(cairo);
-
-        /* Draw red border if this note is selected */
-        if (priv->notes.selected_id != NULL && note->id != NULL &&
-            g_strcmp0(note->id, priv->notes.selected_id) == 0) {
-          /* Draw red border around selected note */
-          cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);
-          cairo_set_line_width(cairo, 2.0);
-          cairo_rectangle(cairo, icon_x - 1, icon_y - 1, NOTE_ICON_SIZE + 2, NOTE_ICON_SIZE + 2);
-          cairo_stroke(cairo);
-          /* Note: delete button removed - deletion now via popup */
-        }
-      }
-    }
 
     /* Fetch embedded PDF notes (only once per page) */
     if (priv->embedded_notes.retrieved == FALSE) {
       priv->embedded_notes.retrieved = TRUE;
       priv->embedded_notes.list = zathura_page_get_notes(priv->page, NULL);
+      invalidate_index(priv);
       girara_debug("Fetched %zu embedded notes from PDF",
                    priv->embedded_notes.list ? girara_list_size(priv->embedded_notes.list) : 0);
     }
 
-    /* Draw embedded PDF note icons (blue color) - drawn AFTER database notes so they appear on top */
-    if (priv->embedded_notes.list != NULL) {
-      for (size_t idx = 0; idx != girara_list_size(priv->embedded_notes.list); ++idx) {
-        zathura_note_t* note = girara_list_nth(priv->embedded_notes.list, idx);
-        if (note == NULL) {
-          continue;
-        }
-
-        /* Transform note position using recalc_rectangle */
-        zathura_rectangle_t note_rect = {
-          .x1 = note->x,
-          .y1 = note->y,
-          .x2 = note->x + 1,
-          .y2 = note->y + 1
-        };
-        zathura_rectangle_t transformed = recalc_rectangle(priv->page, note_rect);
-
-        /* Draw note icon (small post-it style - BLUE for embedded) */
-        double icon_x = transformed.x1;
-        double icon_y = transformed.y1;
-
-        /* Light blue fill for embedded notes */
-        cairo_set_source_rgba(cairo, 0.6, 0.8, 1.0, 0.9);
-        cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
-        cairo_fill(cairo);
-
-        /* Dark blue border */
-        cairo_set_source_rgba(cairo, 0.2, 0.4, 0.8, 0.9);
-        cairo_set_line_width(cairo, 1.0);
-        cairo_rectangle(cairo, icon_x, icon_y, NOTE_ICON_SIZE, NOTE_ICON_SIZE);
-        cairo_stroke(cairo);
-
-        /* Draw red border if this embedded note is selected */
-        if (priv->embedded_notes.has_selection) {
-          const double eps = 1.0;
-          if (fabs(note->x - priv->embedded_notes.selected_x) < eps &&
-              fabs(note->y - priv->embedded_notes.selected_y) < eps) {
-            /* Draw red border around selected note */
-            cairo_set_source_rgba(cairo, 1.0, 0.0, 0.0, 0.9);
-            cairo_set_line_width(cairo, 2.0);
-            cairo_rectangle(cairo, icon_x - 1, icon_y - 1, NOTE_ICON_SIZE + 2, NOTE_ICON_SIZE + 2);
-            cairo_stroke(cairo);
-            /* Note: delete button removed - deletion now via popup */
-          }
-        }
-      }
+    /* Persistent highlights and note icons are drawn from a retained layer
+     * that is only rebuilt when one of them changes. It is as large as the
+     * page surface, so a rendered page takes twice the memory while it has
+     * highlights or notes. */
+    cairo_surface_t* layer =
+        get_overlay_layer(priv, &priv->overlay, cairo, page_width, page_height, has_overlays, draw_overlays);
+    if (layer != NULL) {
+      cairo_set_source_surface(cairo, layer, 0, 0);
+      cairo_paint(cairo);
     }
   } else {
     girara_debug("rendering loading screen, flicker might be happening");
@@ -1010,6 +1423,13 @@ static void zathura_page_widget_redraw_canvas(ZathuraPage* pageview) {
   gtk_widget_queue_draw(widget);
 }
 
+static void zathura_page_widget_redraw_overlay(ZathuraPage* pageview) {
+  ZathuraPagePrivate* priv   = zathura_page_widget_get_instance_private(pageview);
+  priv->overlay.dirty        = true;
+  priv->search_overlay.dirty = true;
+  zathura_page_widget_redraw_canvas(pageview);
+}
+
 /* smaller than max to be replaced by actual renders */
 #define THUMBNAIL_INITIAL_ZOOM 0.5
 /* small enough to make bilinear downscaling fast */
@@ -1084,6 +1504,11 @@ void zathura_page_widget_update_surface(ZathuraPage* widget, cairo_surface_t* su
   if (thumbnail_size <= 0) {
     thumbnail_size = ZATHURA_PAGE_THUMBNAIL_DEFAULT_SIZE;
   }
+  /* a snapshot is only shown until the page is rendered */
+  if (surface != NULL && priv->placeholder == true) {
+    g_clear_pointer(&priv->thumbnail, cairo_surface_destroy);
+    priv->placeholder = false;
+  }
   bool new_render = (priv->surface == NULL && priv->thumbnail == NULL);
 
   if (priv->surface != NULL) {
@@ -1105,7 +1530,13 @@ void zathura_page_widget_update_surface(ZathuraPage* widget, cairo_surface_t* su
     }
   } else if (!keep_thumbnail && priv->thumbnail != NULL) {
     cairo_surface_destroy(priv->thumbnail);
-    priv->thumbnail = NULL;
+    priv->thumbnail   = NULL;
+    priv->placeholder = false;
+  }
+  /* the overlay layers are rebuilt with the page */
+  if (surface == NULL) {
+    clear_overlay_layer(&priv->overlay);
+    clear_overlay_layer(&priv->search_overlay);
   }
   /* force a redraw here */
   if (priv->surface != NULL) {
@@ -1173,20 +1604,12 @@ static void evaluate_link_at_mouse_position(ZathuraPage* page, int oldx, int old
   ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(page);
   /* simple single click */
   /* get links */
-  if (priv->links.retrieved == false) {
-    priv->links.list      = zathura_page_links_get(priv->page, NULL);
-    priv->links.retrieved = true;
-    priv->links.n         = (priv->links.list == NULL) ? 0 : girara_list_size(priv->links.list);
-  }
+  retrieve_links(priv);
 
   if (priv->links.list != NULL && priv->links.n > 0) {
-    for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
-      zathura_link_t* link           = girara_list_nth(priv->links.list, idx);
-      const zathura_rectangle_t rect = recalc_rectangle(priv->page, zathura_link_get_position(link));
-      if (rect.x1 <= oldx && rect.x2 >= oldx && rect.y1 <= oldy && rect.y2 >= oldy) {
-        zathura_link_evaluate(priv->zathura, link);
-        break;
-      }
+    zathura_link_t* link = hit_test(priv, oldx, oldy, ZATHURA_RECT_INDEX_LINK, false);
+    if (link != NULL) {
+      zathura_link_evaluate(priv->zathura, link);
     }
   }
 }
@@ -1302,96 +1725,47 @@ static gboolean cb_zathura_page_widget_button_press_event(GtkWidget* widget, Gdk
 
   /* Check if click is on an existing note icon */
   if (button->button == GDK_BUTTON_PRIMARY && button->type == GDK_BUTTON_PRESS) {
-    if (priv->notes.list != NULL) {
-      for (size_t idx = 0; idx != girara_list_size(priv->notes.list); ++idx) {
-        zathura_note_t* note = girara_list_nth(priv->notes.list, idx);
-        if (note == NULL) {
-          continue;
-        }
-
-        /* Transform note position to widget coordinates (same as draw code) */
-        zathura_rectangle_t note_rect = {
-          .x1 = note->x,
-          .y1 = note->y,
-          .x2 = note->x + 1,
-          .y2 = note->y + 1
-        };
-        zathura_rectangle_t transformed = recalc_rectangle(priv->page, note_rect);
-
-        /* Check if click is within NOTE_ICON_SIZE of the note position */
-        double icon_x = transformed.x1;
-        double icon_y = transformed.y1;
-
-        /* Note: delete button removed - deletion now via popup */
-        if (button->x >= icon_x && button->x <= icon_x + NOTE_ICON_SIZE &&
-            button->y >= icon_y && button->y <= icon_y + NOTE_ICON_SIZE) {
-          /* Hit! Select this note and mark for popup on button release */
-          g_free(priv->notes.selected_id);
-          priv->notes.selected_id = g_strdup(note->id);
-          zathura_page_widget_redraw_canvas(page);
-
-          /* Store pending popup - will open on button RELEASE to avoid GTK modal close */
-          priv->notes.pending_popup = note;
-          priv->notes.pending_widget_x = button->x;
-          priv->notes.pending_widget_y = button->y;
-          g_message("NOTE: pending popup set for native note at (%.1f, %.1f)", note->x, note->y);
-
-          return TRUE;  /* Event handled */
-        }
-      }
+    zathura_note_t* note = hit_test(priv, button->x, button->y, ZATHURA_RECT_INDEX_NOTE, false);
+    if (note != NULL) {
+      /* Hit! Select this note and mark for popup on button release */
+      g_free(priv->notes.selected_id);
+      priv->notes.selected_id = g_strdup(note->id);
+      zathura_page_widget_redraw_overlay(page);
+
+      /* Store pending popup - will open on button RELEASE to avoid GTK modal close */
+      priv->notes.pending_popup = note;
+      priv->notes.pending_widget_x = button->x;
+      priv->notes.pending_widget_y = button->y;
+      g_message("NOTE: pending popup set for native note at (%.1f, %.1f)", note->x, note->y);
+
+      return TRUE;  /* Event handled */
     }
 
     /* Check if click is on an embedded PDF note icon */
-    if (priv->embedded_notes.list != NULL) {
-      for (size_t idx = 0; idx != girara_list_size(priv->embedded_notes.list); ++idx) {
-        zathura_note_t* note = girara_list_nth(priv->embedded_notes.list, idx);
-        if (note == NULL) {
-          continue;
-        }
-
-        /* Transform note position to widget coordinates (same as draw code) */
-        zathura_rectangle_t note_rect = {
-          .x1 = note->x,
-          .y1 = note->y,
-          .x2 = note->x + 1,
-          .y2 = note->y + 1
-        };
-        zathura_rectangle_t transformed = recalc_rectangle(priv->page, note_rect);
-
-        /* Check if click is within NOTE_ICON_SIZE of the note position */
-        double icon_x = transformed.x1;
-        double icon_y = transformed.y1;
-
-        /* Note: delete button removed - deletion now via popup */
-        /* Check if click is on the note icon itself */
-        g_message("EMBEDDED_NOTE: icon click check - click (%.1f,%.1f) vs icon (%.1f-%.1f, %.1f-%.1f)",
-                  button->x, button->y, icon_x, icon_x+NOTE_ICON_SIZE, icon_y, icon_y+NOTE_ICON_SIZE);
-        if (button->x >= icon_x && button->x <= icon_x + NOTE_ICON_SIZE &&
-            button->y >= icon_y && button->y <= icon_y + NOTE_ICON_SIZE) {
-          /* Hit! Mark for popup on button release */
-          g_message("EMBEDDED_NOTE: ICON HIT! Marking pending popup for (%.1f, %.1f)", note->x, note->y);
-
-          /* Clear database note selection */
-          if (priv->notes.selected_id != NULL) {
-            g_free(priv->notes.selected_id);
-            priv->notes.selected_id = NULL;
-          }
-          priv->notes.pending_popup = NULL;  /* Clear any native note pending */
+    note = hit_test(priv, button->x, button->y, ZATHURA_RECT_INDEX_EMBEDDED_NOTE, false);
+    if (note != NULL) {
+      /* Hit! Mark for popup on button release */
+      g_message("EMBEDDED_NOTE: ICON HIT! Marking pending popup for (%.1f, %.1f)", note->x, note->y);
+
+      /* Clear database note selection */
+      if (priv->notes.selected_id != NULL) {
+        g_free(priv->notes.selected_id);
+        priv->notes.selected_id = NULL;
+      }
+      priv->notes.pending_popup = NULL;  /* Clear any native note pending */
 
-          /* Select this embedded note */
-          priv->embedded_notes.has_selection = TRUE;
-          priv->embedded_notes.selected_x = note->x;
-          priv->embedded_notes.selected_y = note->y;
-          zathura_page_widget_redraw_canvas(page);
+      /* Select this embedded note */
+      priv->embedded_notes.has_selection = TRUE;
+      priv->embedded_notes.selected_x = note->x;
+      priv->embedded_notes.selected_y = note->y;
+      zathura_page_widget_redraw_overlay(page);
 
-          /* Store pending popup - will open on button RELEASE to avoid GTK modal close */
-          priv->embedded_notes.pending_popup = note;
-          priv->embedded_notes.pending_widget_x = button->x;
-          priv->embedded_notes.pending_widget_y = button->y;
+      /* Store pending popup - will open on button RELEASE to avoid GTK modal close */
+      priv->embedded_notes.pending_popup = note;
+      priv->embedded_notes.pending_widget_x = button->x;
+      priv->embedded_notes.pending_widget_y = button->y;
 
-          return TRUE;  /* Event handled */
-        }
-      }
+      return TRUE;  /* Event handled */
     }
   }
 
@@ -1415,44 +1789,20 @@ static gboolean cb_zathura_page_widget_button_press_event(GtkWidget* widget, Gdk
 
       /* Check if click is on any highlight */
       bool found_highlight = false;
-      if (priv->highlights.list != NULL) {
-        for (size_t idx = 0; idx != girara_list_size(priv->highlights.list); ++idx) {
-          zathura_highlight_t* highlight = girara_list_nth(priv->highlights.list, idx);
-          if (highlight == NULL || highlight->rects == NULL) {
-            continue;
-          }
-
-          /* Check all rects in this highlight */
-          for (size_t r = 0; r < girara_list_size(highlight->rects); r++) {
-            zathura_rectangle_t* rect = girara_list_nth(highlight->rects, r);
-            if (rect == NULL) {
-              continue;
-            }
-
-            /* Convert to widget coords for comparison with button->x/y */
-            zathura_rectangle_t widget_rect = recalc_rectangle(priv->page, *rect);
-            if (widget_rect.x1 <= button->x && widget_rect.x2 >= button->x &&
-                widget_rect.y1 <= button->y && widget_rect.y2 >= button->y) {
-              /* Hit! Toggle selection */
-              if (priv->highlights.selected_id != NULL &&
-                  g_strcmp0(priv->highlights.selected_id, highlight->id) == 0) {
-                /* Already selected - deselect (toggle) */
-                g_free(priv->highlights.selected_id);
-                priv->highlights.selected_id = NULL;
-              } else {
-                /* Select this highlight */
-                g_free(priv->highlights.selected_id);
-                priv->highlights.selected_id = g_strdup(highlight->id);
-              }
-              found_highlight = true;
-              zathura_page_widget_redraw_canvas(page);
-              break;
-            }
-          }
-          if (found_highlight) {
-            break;
-          }
+      zathura_highlight_t* highlight = hit_test(priv, button->x, button->y, ZATHURA_RECT_INDEX_HIGHLIGHT, false);
+      if (highlight != NULL) {
+        /* Hit! Toggle selection */
+        if (priv->highlights.selected_id != NULL && g_strcmp0(priv->highlights.selected_id, highlight->id) == 0) {
+          /* Already selected - deselect (toggle) */
+          g_free(priv->highlights.selected_id);
+          priv->highlights.selected_id = NULL;
+        } else {
+          /* Select this highlight */
+          g_free(priv->highlights.selected_id);
+          priv->highlights.selected_id = g_strdup(highlight->id);
         }
+        found_highlight = true;
+        zathura_page_widget_redraw_overlay(page);
       }
 
       /* If no database highlight clicked, check embedded PDF annotations */
@@ -1490,7 +1840,7 @@ static gboolean cb_zathura_page_widget_button_press_event(GtkWidget* widget, Gdk
                   }
                 }
                 found_highlight = true;
-                zathura_page_widget_redraw_canvas(page);
+                zathura_page_widget_redraw_overlay(page);
                 break;
               }
             }
@@ -1514,7 +1864,7 @@ static gboolean cb_zathura_page_widget_button_press_event(GtkWidget* widget, Gdk
           need_redraw = true;
         }
         if (need_redraw) {
-          zathura_page_widget_redraw_canvas(page);
+          zathura_page_widget_redraw_overlay(page);
         }
       }
 
@@ -1679,22 +2029,10 @@ static gboolean cb_zathura_page_widget_motion_notify(GtkWidget* widget, GdkEvent
       }
     }
   } else {
-    if (priv->links.retrieved == false) {
-      priv->links.list      = zathura_page_links_get(priv->page, NULL);
-      priv->links.retrieved = true;
-      priv->links.n         = (priv->links.list == NULL) ? 0 : girara_list_size(priv->links.list);
-    }
+    retrieve_links(priv);
 
     if (priv->links.list != NULL && priv->links.n > 0) {
-      bool over_link = false;
-      for (size_t idx = 0; idx != girara_list_size(priv->links.list); ++idx) {
-        zathura_link_t* link     = girara_list_nth(priv->links.list, idx);
-        zathura_rectangle_t rect = recalc_rectangle(priv->page, zathura_link_get_position(link));
-        if (rect.x1 <= event->x && rect.x2 >= event->x && rect.y1 <= event->y && rect.y2 >= event->y) {
-          over_link = true;
-          break;
-        }
-      }
+      const bool over_link = hit_test(priv, event->x, event->y, ZATHURA_RECT_INDEX_LINK, false) != NULL;
 
       if (priv->mouse.over_link != over_link) {
         if (over_link == true) {
@@ -1736,6 +2074,7 @@ static void zathura_page_widget_popup_menu(GtkWidget* widget, GdkEventButton* ev
   if (priv->images.retrieved == false) {
     priv->images.list      = zathura_page_images_get(priv->page, NULL);
     priv->images.retrieved = true;
+    invalidate_index(priv);
   }
 
   if (priv->images.list == NULL) {
@@ -1743,14 +2082,7 @@ static void zathura_page_widget_popup_menu(GtkWidget* widget, GdkEventButton* ev
   }
 
   /* search for underlaying image */
-  zathura_image_t* image = NULL;
-  for (size_t idx = 0; idx != girara_list_size(priv->images.list); ++idx) {
-    zathura_image_t* image_it = girara_list_nth(priv->images.list, idx);
-    zathura_rectangle_t rect  = recalc_rectangle(priv->page, image_it->position);
-    if (rect.x1 <= event->x && rect.x2 >= event->x && rect.y1 <= event->y && rect.y2 >= event->y) {
-      image = image_it;
-    }
-  }
+  zathura_image_t* image = hit_test(priv, event->x, event->y, ZATHURA_RECT_INDEX_IMAGE, true);
 
   if (image == NULL) {
     return;
@@ -1855,6 +2187,24 @@ bool zathura_page_widget_have_surface(ZathuraPage* widget) {
   return priv->surface != NULL;
 }
 
+cairo_surface_t* zathura_page_widget_get_surface(ZathuraPage* widget) {
+  g_return_val_if_fail(ZATHURA_IS_PAGE(widget), NULL);
+  ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(widget);
+  return priv->surface;
+}
+
+void zathura_page_widget_set_placeholder(ZathuraPage* widget, cairo_surface_t* surface) {
+  g_return_if_fail(ZATHURA_IS_PAGE(widget) && surface != NULL);
+  ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(widget);
+  if (priv->surface != NULL || priv->thumbnail != NULL) {
+    return;
+  }
+
+  priv->thumbnail   = cairo_surface_reference(surface);
+  priv->placeholder = true;
+  gtk_widget_queue_draw(GTK_WIDGET(widget));
+}
+
 void zathura_page_widget_abort_render_request(ZathuraPage* widget) {
   g_return_if_fail(ZATHURA_IS_PAGE(widget));
   ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(widget);
@@ -1906,7 +2256,8 @@ void zathura_page_widget_set_highlights(ZathuraPage* widget, girara_list_t* high
   }
 
   priv->highlights.list = highlights;
-  zathura_page_widget_redraw_canvas(widget);
+  invalidate_index(priv);
+  zathura_page_widget_redraw_overlay(widget);
 }
 
 static void highlight_free_func(void* data) {
@@ -1928,7 +2279,8 @@ void zathura_page_widget_add_highlight(ZathuraPage* widget, zathura_highlight_t*
   }
 
   girara_list_append(priv->highlights.list, highlight);
-  zathura_page_widget_redraw_canvas(widget);
+  invalidate_index(priv);
+  zathura_page_widget_redraw_overlay(widget);
 }
 
 bool zathura_page_widget_remove_highlight(ZathuraPage* widget, const char* highlight_id) {
@@ -1944,7 +2296,8 @@ bool zathura_page_widget_remove_highlight(ZathuraPage* widget, const char* highl
     zathura_highlight_t* highlight = girara_list_nth(priv->highlights.list, idx);
     if (highlight != NULL && highlight->id != NULL && g_strcmp0(highlight->id, highlight_id) == 0) {
       girara_list_remove(priv->highlights.list, highlight);
-      zathura_page_widget_redraw_canvas(widget);
+      invalidate_index(priv);
+      zathura_page_widget_redraw_overlay(widget);
       return true;
     }
   }
@@ -1952,6 +2305,11 @@ bool zathura_page_widget_remove_highlight(ZathuraPage* widget, const char* highl
   return false;
 }
 
+void zathura_page_widget_update_highlights(ZathuraPage* widget) {
+  g_return_if_fail(ZATHURA_IS_PAGE(widget));
+  zathura_page_widget_redraw_overlay(widget);
+}
+
 girara_list_t* zathura_page_widget_get_highlights(ZathuraPage* widget) {
   g_return_val_if_fail(ZATHURA_IS_PAGE(widget), NULL);
   ZathuraPagePrivate* priv = zathura_page_widget_get_instance_private(widget);
@@ -1984,11 +2342,12 @@ void zathura_page_widget_clear_selected_highlight(ZathuraPage* widget) {
   if (priv->highlights.selected_id != NULL) {
     g_free(priv->highlights.selected_id);
     priv->highlights.selected_id = NULL;
-    zathura_page_widget_redraw_canvas(widget);
+    zathura_page_widget_redraw_overlay(widget);
   }
   if (priv->highlights.embedded_selected_rects != NULL) {
     girara_list_free(priv->highlights.embedded_selected_rects);
     priv->highlights.embedded_selected_rects = NULL;
+    priv->overlay.dirty                      = true;
   }
 }
 
@@ -2008,7 +2367,8 @@ void zathura_page_widget_set_notes(ZathuraPage* widget, girara_list_t* notes) {
   }
 
   priv->notes.list = notes;
-  zathura_page_widget_redraw_canvas(widget);
+  invalidate_index(priv);
+  zathura_page_widget_redraw_overlay(widget);
 }
 
 void zathura_page_widget_add_note(ZathuraPage* widget, zathura_note_t* note) {
@@ -2022,7 +2382,8 @@ void zathura_page_widget_add_note(ZathuraPage* widget, zathura_note_t* note) {
   }
 
   girara_list_append(priv->notes.list, note);
-  zathura_page_widget_redraw_canvas(widget);
+  invalidate_index(priv);
+  zathura_page_widget_redraw_overlay(widget);
 }
 
 bool zathura_page_widget_remove_note(ZathuraPage* widget, const char* note_id) {
@@ -2038,7 +2399,8 @@ bool zathura_page_widget_remove_note(ZathuraPage* widget, const char* note_id) {
     zathura_note_t* note = girara_list_nth(priv->notes.list, idx);
     if (note != NULL && note->id != NULL && g_strcmp0(note->id, note_id) == 0) {
       girara_list_remove(priv->notes.list, note);
-      zathura_page_widget_redraw_canvas(widget);
+      invalidate_index(priv);
+      zathura_page_widget_redraw_overlay(widget);
       return true;
     }
   }
@@ -2075,7 +2437,7 @@ void zathura_page_widget_clear_embedded_note_selection(ZathuraPage* widget) {
 
   if (priv->embedded_notes.has_selection) {
     priv->embedded_notes.has_selection = FALSE;
-    zathura_page_widget_redraw_canvas(widget);
+    zathura_page_widget_redraw_overlay(widget);
   }
 }
 
@@ -2095,9 +2457,10 @@ void zathura_page_widget_refresh_embedded_notes(ZathuraPage* widget) {
   priv->embedded_notes.list = zathura_page_get_notes(priv->page, NULL);
   priv->embedded_notes.retrieved = TRUE;
   priv->embedded_notes.has_selection = FALSE;
+  invalidate_index(priv);
 
   g_message("NOTE_POPUP: refreshed embedded notes cache (immediate re-fetch)");
 
   /* Trigger redraw to show updated notes */
-  zathura_page_widget_redraw_canvas(widget);
+  zathura_page_widget_redraw_overlay(widget);
 }
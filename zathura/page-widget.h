@@ -75,6 +75,21 @@ void zathura_page_widget_update_view_time(ZathuraPage* widget);
  * @returns true if the widget has a surface, false otherwise
  */
 bool zathura_page_widget_have_surface(ZathuraPage* widget);
+/**
+ * Get the rendered surface.
+ *
+ * @param widget the widget
+ * @returns the surface (owned by the widget) or NULL if the page is not rendered
+ */
+cairo_surface_t* zathura_page_widget_get_surface(ZathuraPage* widget);
+/**
+ * Show a surface of an earlier session until the page is rendered. Does
+ * nothing if the widget already has a surface or a thumbnail.
+ *
+ * @param widget the widget
+ * @param surface the surface; it is scaled to the size of the widget
+ */
+void zathura_page_widget_set_placeholder(ZathuraPage* widget, cairo_surface_t* surface);
 /**
  * Abort outstanding render requests
  *
@@ -131,6 +146,14 @@ void zathura_page_widget_add_highlight(ZathuraPage* widget, zathura_highlight_t*
  */
 bool zathura_page_widget_remove_highlight(ZathuraPage* widget, const char* highlight_id);
 
+/**
+ * Redraw the highlights of this page after they have been modified in place
+ * (e.g. their color changed)
+ *
+ * @param widget the widget
+ */
+void zathura_page_widget_update_highlights(ZathuraPage* widget);
+
 /**
  * Get highlights for this page
  *
@@ -2,8 +2,11 @@
 
 #include "plugin.h"
 
+#include <errno.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include <glib/gi18n.h>
+#include <glib/gstdio.h>
 
 #include <girara/datastructures.h>
 #include <girara/utils.h>
@@ -11,6 +14,20 @@
 #include <girara/session.h>
 #include <girara/settings.h>
 
+/* name of the plugin manifest in the cache directory */
+#define PLUGIN_MANIFEST "plugins"
+/* group of the manifest describing the plugin API it was written for */
+#define PLUGIN_MANIFEST_GROUP "zathura"
+
+/**
+ * State of the shared object of a plugin
+ */
+enum {
+  PLUGIN_NOT_LOADED = 0, /**< Described by the manifest, loaded on first use */
+  PLUGIN_LOADED,         /**< Loaded successfully */
+  PLUGIN_FAILED,         /**< Loading failed */
+};
+
 /**
  * Document plugin structure
  */
@@ -19,7 +36,9 @@ struct zathura_plugin_s {
   zathura_plugin_functions_t functions; /**< Document functions */
   GModule* handle;                      /**< DLL handle */
   char* path;                           /**< Path to the plugin */
-  const zathura_plugin_definition_t* definition;
+  char* name;                           /**< Name of the plugin */
+  zathura_plugin_version_t version;     /**< Version of the plugin */
+  gsize state;                          /**< State of the shared object */
 };
 
 /**
@@ -38,6 +57,9 @@ struct zathura_plugin_manager_s {
   girara_list_t* path;                /**< List of plugin paths */
   girara_list_t* type_plugin_mapping; /**< List of type -> plugin mappings */
   girara_list_t* content_types;       /**< List of all registered content types */
+  char* manifest_path;                /**< Path to the plugin manifest, NULL if not used */
+  GKeyFile* manifest;                 /**< Name, version and mime types of the plugins by path */
+  bool manifest_changed;              /**< The manifest needs to be written */
 };
 
 static void zathura_type_plugin_mapping_free(void* data) {
@@ -54,7 +76,10 @@ static void zathura_plugin_free(void* data) {
     zathura_plugin_t* plugin = data;
 
     g_free(plugin->path);
-    g_module_close(plugin->handle);
+    g_free(plugin->name);
+    if (plugin->handle != NULL) {
+      g_module_close(plugin->handle);
+    }
     girara_list_free(plugin->content_types);
     g_free(plugin);
   }
@@ -112,6 +137,13 @@ void zathura_plugin_manager_set_dir(zathura_plugin_manager_t* plugin_manager, co
   }
 }
 
+void zathura_plugin_manager_set_cache_dir(zathura_plugin_manager_t* plugin_manager, const char* dir) {
+  g_return_if_fail(plugin_manager != NULL);
+
+  g_free(plugin_manager->manifest_path);
+  plugin_manager->manifest_path = dir != NULL ? g_build_filename(dir, PLUGIN_MANIFEST, NULL) : NULL;
+}
+
 static bool check_suffix(const char* path) {
 #ifdef __APPLE__
   if (g_str_has_suffix(path, ".dylib") == TRUE) {
@@ -188,23 +220,13 @@ static bool register_plugin(zathura_plugin_manager_t* plugin_manager, zathura_pl
   return at_least_one;
 }
 
-static void load_plugin(zathura_plugin_manager_t* plugin_manager, const char* plugindir, const char* name) {
-  g_autofree char* path = g_build_filename(plugindir, name, NULL);
-  if (g_file_test(path, G_FILE_TEST_IS_REGULAR) == 0) {
-    girara_debug("'%s' is not a regular file. Skipping.", path);
-    return;
-  }
-
-  if (check_suffix(path) == false) {
-    girara_debug("'%s' is not a plugin file. Skipping.", path);
-    return;
-  }
-
-  /* load plugin */
+/* Load the shared object of a plugin, resolve the plugin definition and check
+ * that it is usable. */
+static GModule* plugin_open_module(const char* path, const zathura_plugin_definition_t** definition) {
   GModule* handle = g_module_open(path, G_MODULE_BIND_LOCAL);
   if (handle == NULL) {
     girara_error("Could not load plugin '%s' (%s).", path, g_module_error());
-    return;
+    return NULL;
   }
 
   /* resolve symbols and check API and ABI version*/
@@ -214,21 +236,21 @@ static void load_plugin(zathura_plugin_manager_t* plugin_manager, const char* pl
     girara_error("Could not find '%s' in plugin %s - is not a plugin or needs to be rebuilt.",
                  G_STRINGIFY(ZATHURA_PLUGIN_DEFINITION_SYMBOL), path);
     g_module_close(handle);
-    return;
+    return NULL;
   }
 
   /* check name */
   if (plugin_definition->name == NULL) {
     girara_error("Plugin has no name.");
     g_module_close(handle);
-    return;
+    return NULL;
   }
 
   /* check mime type */
   if (plugin_definition->mime_types == NULL || plugin_definition->mime_types_size == 0) {
     girara_error("Plugin does not handly any mime types.");
     g_module_close(handle);
-    return;
+    return NULL;
   }
 
   if (plugin_definition->functions.document_open == NULL || plugin_definition->functions.document_free == NULL ||
@@ -236,28 +258,129 @@ static void load_plugin(zathura_plugin_manager_t* plugin_manager, const char* pl
       plugin_definition->functions.page_render_cairo == NULL) {
     girara_error("Plugin is missing required functions.");
     g_module_close(handle);
-    return;
+    return NULL;
+  }
+
+  *definition = plugin_definition;
+  return handle;
+}
+
+/* Load the shared object of a plugin that was created from the manifest. Safe
+ * to call from multiple threads; the object is only loaded once. */
+static bool plugin_ensure_loaded(zathura_plugin_t* plugin) {
+  if (g_once_init_enter(&plugin->state) == TRUE) {
+    gsize state                                   = PLUGIN_FAILED;
+    const zathura_plugin_definition_t* definition = NULL;
+    GModule* handle                               = plugin_open_module(plugin->path, &definition);
+    if (handle != NULL) {
+      plugin->handle    = handle;
+      plugin->functions = definition->functions;
+      state             = PLUGIN_LOADED;
+      girara_debug("Loaded plugin '%s' on first use.", plugin->path);
+    }
+    g_once_init_leave(&plugin->state, state);
   }
 
+  return plugin->state == PLUGIN_LOADED;
+}
+
+static zathura_plugin_t* plugin_new(char* path, const char* name, zathura_plugin_version_t version,
+                                    const char* const* mime_types, size_t mime_types_size) {
   zathura_plugin_t* plugin = g_try_malloc0(sizeof(zathura_plugin_t));
   if (plugin == NULL) {
     girara_error("Failed to allocate memory for plugin.");
-    g_module_close(handle);
-    return;
+    g_free(path);
+    return NULL;
   }
 
-  plugin->definition    = plugin_definition;
-  plugin->functions     = plugin_definition->functions;
   plugin->content_types = girara_list_new_with_free(g_free);
-  plugin->handle        = handle;
   plugin->path          = path;
-
-  // plugin took ownership of path
-  path = NULL;
+  plugin->name          = g_strdup(name);
+  plugin->version       = version;
 
   // register mime types
-  for (size_t s = 0; s != plugin_definition->mime_types_size; ++s) {
-    plugin_add_mimetype(plugin, plugin_definition->mime_types[s]);
+  for (size_t s = 0; s != mime_types_size; ++s) {
+    plugin_add_mimetype(plugin, mime_types[s]);
+  }
+
+  return plugin;
+}
+
+/* Create a plugin from its manifest entry if the shared object did not change
+ * since the entry was written. */
+static zathura_plugin_t* plugin_from_manifest(zathura_plugin_manager_t* plugin_manager, const char* path,
+                                              const GStatBuf* st) {
+  GKeyFile* manifest = plugin_manager->manifest;
+  if (manifest == NULL || g_key_file_has_group(manifest, path) == FALSE) {
+    return NULL;
+  }
+
+  gsize version_length     = 0;
+  gsize mime_types_size    = 0;
+  g_autofree char* name    = g_key_file_get_string(manifest, path, "name", NULL);
+  g_autofree gint* version = g_key_file_get_integer_list(manifest, path, "version", &version_length, NULL);
+  g_auto(GStrv) mime_types = g_key_file_get_string_list(manifest, path, "mime-types", &mime_types_size, NULL);
+  const gint64 mtime       = g_key_file_get_int64(manifest, path, "mtime", NULL);
+  const gint64 size        = g_key_file_get_int64(manifest, path, "size", NULL);
+  if (name == NULL || version == NULL || version_length != 3 || mime_types == NULL || mime_types_size == 0 ||
+      mtime != st->st_mtime || size != st->st_size) {
+    return NULL;
+  }
+
+  const zathura_plugin_version_t plugin_version = {version[0], version[1], version[2]};
+  return plugin_new(g_strdup(path), name, plugin_version, (const char* const*)mime_types, mime_types_size);
+}
+
+static void plugin_manifest_add(zathura_plugin_manager_t* plugin_manager, const char* path, const GStatBuf* st,
+                                const zathura_plugin_definition_t* definition) {
+  if (plugin_manager->manifest == NULL) {
+    return;
+  }
+
+  GKeyFile* manifest   = plugin_manager->manifest;
+  const gint version[] = {definition->version.major, definition->version.minor, definition->version.rev};
+  g_key_file_set_string(manifest, path, "name", definition->name);
+  g_key_file_set_integer_list(manifest, path, "version", (gint*)version, G_N_ELEMENTS(version));
+  g_key_file_set_string_list(manifest, path, "mime-types", definition->mime_types, definition->mime_types_size);
+  g_key_file_set_int64(manifest, path, "mtime", st->st_mtime);
+  g_key_file_set_int64(manifest, path, "size", st->st_size);
+  plugin_manager->manifest_changed = true;
+}
+
+static void load_plugin(zathura_plugin_manager_t* plugin_manager, const char* plugindir, const char* name) {
+  g_autofree char* path = g_build_filename(plugindir, name, NULL);
+  GStatBuf st;
+  if (g_stat(path, &st) != 0 || S_ISREG(st.st_mode) == 0) {
+    girara_debug("'%s' is not a regular file. Skipping.", path);
+    return;
+  }
+
+  if (check_suffix(path) == false) {
+    girara_debug("'%s' is not a plugin file. Skipping.", path);
+    return;
+  }
+
+  /* the shared object is only loaded once a document needs it if the
+   * manifest knows the plugin */
+  zathura_plugin_t* plugin = plugin_from_manifest(plugin_manager, path, &st);
+  if (plugin == NULL) {
+    const zathura_plugin_definition_t* plugin_definition = NULL;
+    GModule* handle                                      = plugin_open_module(path, &plugin_definition);
+    if (handle == NULL) {
+      return;
+    }
+
+    plugin = plugin_new(g_strdup(path), plugin_definition->name, plugin_definition->version,
+                        plugin_definition->mime_types, plugin_definition->mime_types_size);
+    if (plugin == NULL) {
+      g_module_close(handle);
+      return;
+    }
+
+    plugin->handle    = handle;
+    plugin->functions = plugin_definition->functions;
+    plugin->state     = PLUGIN_LOADED;
+    plugin_manifest_add(plugin_manager, path, &st, plugin_definition);
   }
 
   bool ret = register_plugin(plugin_manager, plugin);
@@ -265,9 +388,10 @@ static void load_plugin(zathura_plugin_manager_t* plugin_manager, const char* pl
     girara_error("Could not register plugin '%s'.", plugin->path);
     zathura_plugin_free(plugin);
   } else {
-    girara_debug("Successfully loaded plugin from '%s'.", plugin->path);
-    girara_debug("plugin %s: version %u.%u.%u", plugin_definition->name, plugin_definition->version.major,
-                 plugin_definition->version.minor, plugin_definition->version.rev);
+    girara_debug("Successfully %s plugin from '%s'.", plugin->state == PLUGIN_LOADED ? "loaded" : "registered",
+                 plugin->path);
+    girara_debug("plugin %s: version %u.%u.%u", plugin->name, plugin->version.major, plugin->version.minor,
+                 plugin->version.rev);
   }
 }
 
@@ -287,16 +411,79 @@ static void load_dir(void* data, void* userdata) {
   }
 }
 
+static void plugin_manifest_read(zathura_plugin_manager_t* plugin_manager) {
+  plugin_manager->manifest = g_key_file_new();
+  if (g_key_file_load_from_file(plugin_manager->manifest, plugin_manager->manifest_path, G_KEY_FILE_NONE, NULL) ==
+      FALSE) {
+    return;
+  }
+
+  /* the entries are only valid for the plugin API they were written for */
+  g_autofree char* symbol = g_key_file_get_string(plugin_manager->manifest, PLUGIN_MANIFEST_GROUP, "symbol", NULL);
+  if (g_strcmp0(symbol, G_STRINGIFY(ZATHURA_PLUGIN_DEFINITION_SYMBOL)) != 0) {
+    girara_debug("Discarding plugin manifest written for '%s'.", symbol);
+    g_key_file_unref(plugin_manager->manifest);
+    plugin_manager->manifest = g_key_file_new();
+  }
+}
+
+static void plugin_manifest_write(zathura_plugin_manager_t* plugin_manager) {
+  GKeyFile* manifest = plugin_manager->manifest;
+
+  /* forget plugins that have been removed */
+  g_auto(GStrv) groups = g_key_file_get_groups(manifest, NULL);
+  for (char** group = groups; *group != NULL; ++group) {
+    if (g_strcmp0(*group, PLUGIN_MANIFEST_GROUP) != 0 && g_file_test(*group, G_FILE_TEST_EXISTS) == FALSE) {
+      g_key_file_remove_group(manifest, *group, NULL);
+      plugin_manager->manifest_changed = true;
+    }
+  }
+
+  if (plugin_manager->manifest_changed == false) {
+    return;
+  }
+
+  g_key_file_set_string(manifest, PLUGIN_MANIFEST_GROUP, "symbol", G_STRINGIFY(ZATHURA_PLUGIN_DEFINITION_SYMBOL));
+
+  g_autofree char* dir    = g_path_get_dirname(plugin_manager->manifest_path);
+  g_autoptr(GError) error = NULL;
+  if (g_mkdir_with_parents(dir, 0700) != 0 ||
+      g_key_file_save_to_file(manifest, plugin_manager->manifest_path, &error) == FALSE) {
+    girara_debug("Failed to write plugin manifest '%s': %s", plugin_manager->manifest_path,
+                 error != NULL ? error->message : g_strerror(errno));
+    return;
+  }
+
+  plugin_manager->manifest_changed = false;
+}
+
 bool zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager) {
   if (plugin_manager == NULL || plugin_manager->path == NULL) {
     return false;
   }
 
+  if (plugin_manager->manifest_path != NULL) {
+    plugin_manifest_read(plugin_manager);
+  }
+
   /* read all files in the plugin directory */
   girara_list_foreach(plugin_manager->path, load_dir, plugin_manager);
+
+  if (plugin_manager->manifest != NULL) {
+    plugin_manifest_write(plugin_manager);
+  }
+
   return girara_list_size(plugin_manager->plugins) > 0;
 }
 
+void zathura_plugin_manager_load_modules(zathura_plugin_manager_t* plugin_manager) {
+  g_return_if_fail(plugin_manager != NULL);
+
+  for (size_t idx = 0; idx != girara_list_size(plugin_manager->plugins); ++idx) {
+    plugin_ensure_loaded(girara_list_nth(plugin_manager->plugins, idx));
+  }
+}
+
 const zathura_plugin_t* zathura_plugin_manager_get_plugin(const zathura_plugin_manager_t* plugin_manager,
                                                           const char* type) {
   if (plugin_manager == NULL || plugin_manager->type_plugin_mapping == NULL || type == NULL) {
@@ -335,13 +522,17 @@ void zathura_plugin_manager_free(zathura_plugin_manager_t* plugin_manager) {
     girara_list_free(plugin_manager->type_plugin_mapping);
     girara_list_free(plugin_manager->path);
     girara_list_free(plugin_manager->plugins);
+    if (plugin_manager->manifest != NULL) {
+      g_key_file_unref(plugin_manager->manifest);
+    }
+    g_free(plugin_manager->manifest_path);
 
     g_free(plugin_manager);
   }
 }
 
 const zathura_plugin_functions_t* zathura_plugin_get_functions(const zathura_plugin_t* plugin) {
-  if (plugin != NULL) {
+  if (plugin != NULL && plugin_ensure_loaded((zathura_plugin_t*)plugin) == true) {
     return &plugin->functions;
   } else {
     return NULL;
@@ -349,8 +540,8 @@ const zathura_plugin_functions_t* zathura_plugin_get_functions(const zathura_plu
 }
 
 const char* zathura_plugin_get_name(const zathura_plugin_t* plugin) {
-  if (plugin != NULL && plugin->definition != NULL) {
-    return plugin->definition->name;
+  if (plugin != NULL) {
+    return plugin->name;
   } else {
     return NULL;
   }
@@ -365,8 +556,8 @@ const char* zathura_plugin_get_path(const zathura_plugin_t* plugin) {
 }
 
 zathura_plugin_version_t zathura_plugin_get_version(const zathura_plugin_t* plugin) {
-  if (plugin != NULL && plugin->definition != NULL) {
-    return plugin->definition->version;
+  if (plugin != NULL) {
+    return plugin->version;
   }
 
   zathura_plugin_version_t version = {0, 0, 0};
@@ -35,6 +35,17 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(zathura_plugin_manager_t, zathura_plugin_manager_f
  */
 void zathura_plugin_manager_set_dir(zathura_plugin_manager_t* plugin_manager, const char* dir);
 
+/**
+ * Set the directory of the plugin manifest. The manifest records name,
+ * version and mime types of every plugin together with the modification time
+ * of its shared object. Plugins described by the manifest are only loaded
+ * when their functions are needed for the first time.
+ *
+ * @param plugin_manager The plugin manager
+ * @param dir The cache directory or NULL to load all plugins immediately
+ */
+void zathura_plugin_manager_set_cache_dir(zathura_plugin_manager_t* plugin_manager, const char* dir);
+
 /**
  * Loads all plugins available in the previously given directories
  *
@@ -43,6 +54,14 @@ void zathura_plugin_manager_set_dir(zathura_plugin_manager_t* plugin_manager, co
  */
 bool zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager);
 
+/**
+ * Load the shared objects of all plugins that have not been loaded yet, e.g.
+ * before access to the file system is restricted.
+ *
+ * @param plugin_manager The plugin manager
+ */
+void zathura_plugin_manager_load_modules(zathura_plugin_manager_t* plugin_manager);
+
 /**
  * Returns the (if available) associated plugin
  *
@@ -70,10 +89,11 @@ girara_list_t* zathura_plugin_manager_get_plugins(const zathura_plugin_manager_t
 girara_list_t* zathura_plugin_manager_get_content_types(const zathura_plugin_manager_t* plugin_manager);
 
 /**
- * Returns the plugin functions
+ * Returns the plugin functions. The plugin's shared object is loaded if that
+ * has not happened yet.
  *
  * @param plugin The plugin
- * @return The plugin functions
+ * @return The plugin functions or NULL if the plugin could not be loaded
  */
 const zathura_plugin_functions_t* zathura_plugin_get_functions(const zathura_plugin_t* plugin);
 
@@ -9,83 +9,407 @@
 #include <girara/statusbar.h>
 #include <girara/session.h>
 #include <glib/gi18n.h>
+#include <math.h>
+
+/* key of the print job attached to the print operation */
+#define PRINT_JOB_KEY "zathura-print-job"
+/* number of pages rendered ahead of the page GTK asks for */
+#define PRINT_PREFETCH_PAGES 2
+/* memory of all image surfaces of a print job; an A4 page at 600 DPI alone
+ * takes 139 MB */
+#define PRINT_MAX_BYTES (256 * 1024 * 1024)
+/* resolution used for print contexts without a useful resolution */
+#define PRINT_DEFAULT_DPI 300
+#define PRINT_MIN_DPI 150
+#define PRINT_MAX_DPI 600
+
+/**
+ * A page rendered ahead by the worker thread.
+ */
+typedef struct print_page_s {
+  unsigned int page;        /**< Page number */
+  cairo_surface_t* surface; /**< The rendered page, NULL if rendering failed */
+  bool recorded;            /**< The surface is a recording surface */
+  bool done;                /**< The worker is done with the page */
+} print_page_t;
+
+/**
+ * State of a print operation. Pages are rendered by a worker thread, a few
+ * pages ahead of the page GTK asks for, so that the main loop keeps running
+ * while printing. They are recorded on recording surfaces if the plugin
+ * supports rendering to any surface, and rendered to image surfaces
+ * otherwise. If GTK asks for a page that is not rendered yet, drawing is
+ * deferred until the worker delivers it.
+ */
+struct zathura_print_job_s {
+  zathura_t* zathura;
+  zathura_document_t* document; /**< The printed document */
+  ZathuraRenderer* renderer;    /**< Renderer locked while a page is rendered */
+  gint image_fallback;          /**< Pages are rendered to image surfaces */
+  double scale;                 /**< Scale of the image surfaces */
+  unsigned int prefetch;        /**< Number of pages rendered ahead */
+  int last_page;                /**< The page printed last */
+  GThreadPool* pool;            /**< Worker rendering the following pages */
+  gint cancelled;               /**< Skip queued pages */
+
+  GMutex lock;
+  GHashTable* pages;            /**< Queued pages by page number */
+  GPtrArray* surfaces;          /**< Surfaces of printed pages, reused for the next pages */
+  int deferred;                 /**< Page whose drawing waits for the worker, or -1 */
+  GtkPrintOperation* operation; /**< Operation waiting for the deferred page */
+  GtkPrintContext* context;     /**< Context of the deferred page */
+};
+
+/* Scale of pages rendered to an image surface, from the resolution of the
+ * print context. Contexts of file printers report 72 DPI, which is too coarse
+ * for printing. */
+static double print_image_scale(GtkPrintContext* context) {
+  double dpi = MIN(gtk_print_context_get_dpi_x(context), gtk_print_context_get_dpi_y(context));
+  if (dpi < PRINT_MIN_DPI) {
+    dpi = PRINT_DEFAULT_DPI;
+  }
 
-static void cb_print_end(GtkPrintOperation* UNUSED(print_operation), GtkPrintContext* UNUSED(context),
-                         zathura_t* zathura) {
-  if (zathura_has_document(zathura) == false || zathura->ui.session == NULL) {
-    return;
+  return MIN(dpi, PRINT_MAX_DPI) / 72.0;
+}
+
+static double print_surface_bytes(zathura_page_t* page, double scale) {
+  return 4.0 * ceil(zathura_page_get_width(page) * scale) * ceil(zathura_page_get_height(page) * scale);
+}
+
+/* Choose the scale and the number of pages rendered ahead so that the surfaces
+ * of the job stay within PRINT_MAX_BYTES. With prefetched pages p, the job
+ * holds at most p + 1 surfaces in use and p + 1 kept for reuse. */
+static void print_job_setup(zathura_print_job_t* job, GtkPrintContext* context) {
+  job->scale = print_image_scale(context);
+
+  /* size of the largest page */
+  zathura_page_t* largest            = NULL;
+  double largest_area                = 0;
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(job->document);
+  for (unsigned int page_id = 0; page_id < number_of_pages; ++page_id) {
+    zathura_page_t* page = zathura_document_get_page(job->document, page_id);
+    const double area    = zathura_page_get_width(page) * zathura_page_get_height(page);
+    if (largest == NULL || area > largest_area) {
+      largest      = page;
+      largest_area = area;
+    }
   }
 
-  g_autofree char* file_path = get_formatted_filename(zathura, true);
-  girara_statusbar_item_set_text(zathura->ui.session, zathura->ui.statusbar.file, file_path);
+  const double bytes = largest != NULL ? print_surface_bytes(largest, job->scale) : 0;
+  if (2 * bytes > PRINT_MAX_BYTES) {
+    /* not even one page fits with prefetching, so reduce the resolution */
+    job->scale *= sqrt(PRINT_MAX_BYTES / (2 * bytes));
+    job->prefetch = 0;
+  } else {
+    job->prefetch = bytes > 0 ? MIN(PRINT_PREFETCH_PAGES, (unsigned int)(PRINT_MAX_BYTES / (2 * bytes)) - 1)
+                              : PRINT_PREFETCH_PAGES;
+  }
 }
 
-static bool draw_page_cairo(cairo_t* cairo, zathura_t* zathura, zathura_page_t* page) {
-  /* Try to render the page without a temporary surface. This only works with
-   * plugins that support rendering to any surface.  */
-  zathura_renderer_lock(zathura->sync.render_thread);
-  const int err = zathura_page_render(page, cairo, true);
-  zathura_renderer_unlock(zathura->sync.render_thread);
+static cairo_surface_t* print_job_get_surface(zathura_print_job_t* job, int width, int height) {
+  g_mutex_lock(&job->lock);
+  for (guint idx = 0; idx < job->surfaces->len; ++idx) {
+    cairo_surface_t* surface = g_ptr_array_index(job->surfaces, idx);
+    if (cairo_image_surface_get_width(surface) == width && cairo_image_surface_get_height(surface) == height) {
+      g_ptr_array_remove_index_fast(job->surfaces, idx);
+      g_mutex_unlock(&job->lock);
+      return surface;
+    }
+  }
+  g_mutex_unlock(&job->lock);
 
-  return err == ZATHURA_ERROR_OK;
+  return cairo_image_surface_create(CAIRO_FORMAT_RGB24, width, height);
 }
 
-static bool draw_page_image(cairo_t* cairo, GtkPrintContext* context, zathura_t* zathura, zathura_page_t* page) {
-  /* Try to render the page on a temporary image surface. */
-  const double width  = gtk_print_context_get_width(context);
-  const double height = gtk_print_context_get_height(context);
+/* Keep the surface of a printed page for the next pages; pages of a document
+ * usually share their size. */
+static void print_job_put_surface(zathura_print_job_t* job, cairo_surface_t* surface) {
+  g_mutex_lock(&job->lock);
+  if (job->surfaces->len >= job->prefetch + 1) {
+    g_ptr_array_remove_index(job->surfaces, 0);
+  }
+  g_ptr_array_add(job->surfaces, surface);
+  g_mutex_unlock(&job->lock);
+}
 
-  const double scale_height = 5;
-  const double scale_width  = 5;
+/* Render a page without a temporary image surface. This only works with
+ * plugins that support rendering to any surface. */
+static cairo_surface_t* print_job_record(zathura_print_job_t* job, zathura_page_t* page) {
+  cairo_surface_t* surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, NULL);
+  cairo_t* cairo           = cairo_create(surface);
+  if (cairo_status(cairo) != CAIRO_STATUS_SUCCESS) {
+    cairo_destroy(cairo);
+    cairo_surface_destroy(surface);
+    return NULL;
+  }
 
-  /* Render to a surface that is 5 times larger to workaround quality issues. */
-  const double page_height = zathura_page_get_height(page) * scale_height;
-  const double page_width  = zathura_page_get_width(page) * scale_width;
-  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, page_width, page_height);
-  if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
-    return false;
+  zathura_renderer_lock(job->renderer);
+  const int err = zathura_page_render(page, cairo, true);
+  zathura_renderer_unlock(job->renderer);
+  cairo_destroy(cairo);
+
+  if (err != ZATHURA_ERROR_OK) {
+    cairo_surface_destroy(surface);
+    return NULL;
   }
 
-  cairo_t* temp_cairo = cairo_create(surface);
-  if (cairo_status(temp_cairo) != CAIRO_STATUS_SUCCESS) {
+  return surface;
+}
+
+/* Render a page on an image surface. */
+static cairo_surface_t* print_job_render(zathura_print_job_t* job, zathura_page_t* page) {
+  const int width          = ceil(zathura_page_get_width(page) * job->scale);
+  const int height         = ceil(zathura_page_get_height(page) * job->scale);
+  cairo_surface_t* surface = print_job_get_surface(job, width, height);
+  if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
     cairo_surface_destroy(surface);
-    return false;
+    return NULL;
+  }
+
+  cairo_t* cairo = cairo_create(surface);
+  if (cairo_status(cairo) != CAIRO_STATUS_SUCCESS) {
+    cairo_destroy(cairo);
+    print_job_put_surface(job, surface);
+    return NULL;
   }
 
   /* Draw a white background. */
-  cairo_save(temp_cairo);
-  cairo_set_source_rgb(temp_cairo, 1, 1, 1);
-  cairo_rectangle(temp_cairo, 0, 0, page_width, page_height);
-  cairo_fill(temp_cairo);
-  cairo_restore(temp_cairo);
-
-  /* Render the page to the temporary surface */
-  zathura_renderer_lock(zathura->sync.render_thread);
-  const int err = zathura_page_render(page, temp_cairo, true);
-  zathura_renderer_unlock(zathura->sync.render_thread);
+  cairo_set_source_rgb(cairo, 1, 1, 1);
+  cairo_paint(cairo);
+  cairo_scale(cairo, job->scale, job->scale);
+
+  zathura_renderer_lock(job->renderer);
+  const int err = zathura_page_render(page, cairo, true);
+  zathura_renderer_unlock(job->renderer);
+  cairo_destroy(cairo);
+
   if (err != ZATHURA_ERROR_OK) {
-    cairo_destroy(temp_cairo);
-    cairo_surface_destroy(surface);
+    print_job_put_surface(job, surface);
+    return NULL;
+  }
+
+  cairo_surface_flush(surface);
+  return surface;
+}
+
+static gboolean print_job_draw_deferred(gpointer data);
+
+static void print_job_render_thread(gpointer data, gpointer user_data) {
+  print_page_t* print_page = data;
+  zathura_print_job_t* job = user_data;
+
+  cairo_surface_t* surface = NULL;
+  bool recorded            = false;
+  if (g_atomic_int_get(&job->cancelled) == 0) {
+    zathura_page_t* page = zathura_document_get_page(job->document, print_page->page);
+    /* once a page needed the fallback, all pages are printed that way */
+    if (g_atomic_int_get(&job->image_fallback) == 0) {
+      surface  = print_job_record(job, page);
+      recorded = surface != NULL;
+      if (surface == NULL) {
+        girara_debug("printing with image surfaces from page %u on", print_page->page);
+        g_atomic_int_set(&job->image_fallback, 1);
+      }
+    }
+    if (surface == NULL) {
+      surface = print_job_render(job, page);
+    }
+  }
+
+  g_mutex_lock(&job->lock);
+  print_page->surface  = surface;
+  print_page->recorded = recorded;
+  print_page->done     = true;
+  if (job->deferred == (int)print_page->page) {
+    g_idle_add(print_job_draw_deferred, job);
+  }
+  g_mutex_unlock(&job->lock);
+}
+
+/* Queue a page for the worker unless it is queued already. Has to be called
+ * with the lock held. */
+static print_page_t* print_job_queue(zathura_print_job_t* job, unsigned int page_number) {
+  print_page_t* print_page = g_hash_table_lookup(job->pages, GUINT_TO_POINTER(page_number));
+  if (print_page == NULL) {
+    print_page       = g_new0(print_page_t, 1);
+    print_page->page = page_number;
+    g_hash_table_insert(job->pages, GUINT_TO_POINTER(page_number), print_page);
+    g_thread_pool_push(job->pool, print_page, NULL);
+  }
+
+  return print_page;
+}
+
+/* Take the surface of a rendered page from the queue. Has to be called with
+ * the lock held. */
+static cairo_surface_t* print_job_take(zathura_print_job_t* job, unsigned int page_number, bool* recorded) {
+  print_page_t* print_page = g_hash_table_lookup(job->pages, GUINT_TO_POINTER(page_number));
+  if (print_page == NULL) {
+    return NULL;
+  }
+
+  cairo_surface_t* surface = g_steal_pointer(&print_page->surface);
+  *recorded                = print_page->recorded;
+  g_hash_table_remove(job->pages, GUINT_TO_POINTER(page_number));
+
+  return surface;
+}
+
+/* Queue the pages following the printed page. GTK asks for the pages in
+ * order, backwards if the pages are printed in reverse. */
+static void print_job_prefetch(zathura_print_job_t* job, unsigned int page_number) {
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(job->document);
+  const int direction                = (int)page_number < job->last_page ? -1 : 1;
+  job->last_page                     = page_number;
+
+  g_mutex_lock(&job->lock);
+  /* drop rendered pages that were not asked for; the printed page is still
+   * queued if its drawing is deferred */
+  GHashTableIter iter;
+  gpointer key   = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, job->pages);
+  while (g_hash_table_iter_next(&iter, &key, &value) == TRUE) {
+    print_page_t* print_page = value;
+    const int distance       = ((int)print_page->page - (int)page_number) * direction;
+    if (print_page->done == true && (int)print_page->page != job->deferred &&
+        (distance <= 0 || distance > (int)job->prefetch)) {
+      if (print_page->surface != NULL && print_page->recorded == false && job->surfaces->len < job->prefetch + 1) {
+        g_ptr_array_add(job->surfaces, g_steal_pointer(&print_page->surface));
+      }
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+
+  const unsigned int printed = g_hash_table_contains(job->pages, GUINT_TO_POINTER(page_number)) == TRUE ? 1 : 0;
+  for (int idx = 1; idx <= (int)job->prefetch; ++idx) {
+    const int next = (int)page_number + idx * direction;
+    if (next < 0 || next >= (int)number_of_pages || g_hash_table_size(job->pages) - printed >= job->prefetch) {
+      break;
+    }
+
+    print_job_queue(job, next);
+  }
+  g_mutex_unlock(&job->lock);
+}
+
+static void print_page_free(gpointer data) {
+  print_page_t* print_page = data;
+  if (print_page->surface != NULL) {
+    cairo_surface_destroy(print_page->surface);
+  }
+  g_free(print_page);
+}
+
+static zathura_print_job_t* print_job_new(zathura_t* zathura) {
+  zathura_print_job_t* job = g_new0(zathura_print_job_t, 1);
+  job->zathura             = zathura;
+  job->document            = zathura_get_document(zathura);
+  job->renderer            = g_object_ref(zathura->sync.render_thread);
+  job->last_page           = -1;
+  job->deferred            = -1;
+  job->pages               = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, print_page_free);
+  job->surfaces            = g_ptr_array_new_with_free_func((GDestroyNotify)cairo_surface_destroy);
+  g_mutex_init(&job->lock);
+
+  return job;
+}
+
+/* Wait for the worker; queued pages are skipped. */
+static void print_job_stop(zathura_print_job_t* job) {
+  g_atomic_int_set(&job->cancelled, 1);
+  if (job->pool != NULL) {
+    g_thread_pool_free(job->pool, FALSE, TRUE);
+    job->pool = NULL;
+  }
+}
+
+static void print_job_free(gpointer data) {
+  zathura_print_job_t* job = data;
+
+  print_job_stop(job);
+  if (job->zathura->print.job == job) {
+    job->zathura->print.job = NULL;
+  }
+
+  g_hash_table_unref(job->pages);
+  g_ptr_array_unref(job->surfaces);
+  g_clear_object(&job->operation);
+  g_clear_object(&job->context);
+  g_clear_object(&job->renderer);
+  g_mutex_clear(&job->lock);
+  g_free(job);
+}
+
+static bool draw_page(zathura_print_job_t* job, GtkPrintContext* context, cairo_surface_t* surface,
+                      bool recorded) {
+  if (surface == NULL) {
+    return false;
+  }
+
+  cairo_t* cairo = gtk_print_context_get_cairo_context(context);
+  if (cairo_status(cairo) != CAIRO_STATUS_SUCCESS) {
+    if (recorded == true) {
+      cairo_surface_destroy(surface);
+    } else {
+      print_job_put_surface(job, surface);
+    }
     return false;
   }
 
+  cairo_save(cairo);
+  if (recorded == true) {
+    /* Replay the recorded page. */
+    cairo_set_source_surface(cairo, surface, 0.0, 0.0);
+    cairo_paint(cairo);
+    cairo_restore(cairo);
+    cairo_surface_destroy(surface);
+    return true;
+  }
+
   /* Rescale the page and keep the aspect ratio */
-  const gdouble scale = MIN(width / page_width, height / page_height);
+  const double width  = gtk_print_context_get_width(context);
+  const double height = gtk_print_context_get_height(context);
+  const double scale  = MIN(width / cairo_image_surface_get_width(surface),
+                            height / cairo_image_surface_get_height(surface));
   cairo_scale(cairo, scale, scale);
 
   /* Blit temporary surface to original cairo object. */
   cairo_set_source_surface(cairo, surface, 0.0, 0.0);
   cairo_paint(cairo);
-  cairo_destroy(temp_cairo);
-  cairo_surface_destroy(surface);
+  cairo_restore(cairo);
+  print_job_put_surface(job, surface);
 
   return true;
 }
 
+/* Draw the deferred page once the worker delivered it. */
+static gboolean print_job_draw_deferred(gpointer data) {
+  zathura_print_job_t* job = data;
+
+  g_mutex_lock(&job->lock);
+  bool recorded                                = false;
+  cairo_surface_t* surface                     = print_job_take(job, job->deferred, &recorded);
+  g_autoptr(GtkPrintOperation) print_operation = g_steal_pointer(&job->operation);
+  g_autoptr(GtkPrintContext) context           = g_steal_pointer(&job->context);
+  job->deferred                                = -1;
+  g_mutex_unlock(&job->lock);
+
+  if (g_atomic_int_get(&job->cancelled) != 0 || draw_page(job, context, surface, recorded) == false) {
+    gtk_print_operation_cancel(print_operation);
+  }
+  gtk_print_operation_draw_page_finish(print_operation);
+
+  return G_SOURCE_REMOVE;
+}
+
 static void cb_print_draw_page(GtkPrintOperation* print_operation, GtkPrintContext* context, gint page_number,
                                zathura_t* zathura) {
+  zathura_print_job_t* job = g_object_get_data(G_OBJECT(print_operation), PRINT_JOB_KEY);
   if (context == NULL || zathura_has_document(zathura) == false || zathura->ui.session == NULL ||
-      zathura->ui.statusbar.file == NULL) {
+      zathura->ui.statusbar.file == NULL || job == NULL || job->document != zathura_get_document(zathura) ||
+      g_atomic_int_get(&job->cancelled) != 0 ||
+      zathura_document_get_page(zathura_get_document(zathura), page_number) == NULL) {
     gtk_print_operation_cancel(print_operation);
     return;
   }
@@ -93,26 +417,54 @@ static void cb_print_draw_page(GtkPrintOperation* print_operation, GtkPrintConte
   /* Update statusbar. */
   g_autofree char* tmp = g_strdup_printf(_("Printing page %d ..."), page_number);
   girara_statusbar_item_set_text(zathura->ui.session, zathura->ui.statusbar.file, tmp);
+  girara_debug("printing page %d ...", page_number);
 
-  /* Get the page and cairo handle.  */
-  zathura_page_t* page = zathura_document_get_page(zathura_get_document(zathura), page_number);
-  cairo_t* cairo       = gtk_print_context_get_cairo_context(context);
-  if (cairo_status(cairo) != CAIRO_STATUS_SUCCESS || page == NULL) {
-    gtk_print_operation_cancel(print_operation);
-    return;
+  if (job->pool == NULL) {
+    /* Render the following pages while GTK processes this one. Rendering is
+     * serialized by the renderer lock, so a single worker suffices. */
+    print_job_setup(job, context);
+    job->pool = g_thread_pool_new(print_job_render_thread, job, 1, FALSE, NULL);
+    girara_debug("printing at image scale %.2f if needed, %u pages ahead", job->scale, job->prefetch);
   }
 
-  girara_debug("printing page %d ...", page_number);
-  if (draw_page_cairo(cairo, zathura, page) == true) {
+  g_mutex_lock(&job->lock);
+  print_page_t* print_page = print_job_queue(job, page_number);
+  if (print_page->done == false) {
+    /* draw the page once the worker delivered it */
+    job->deferred  = page_number;
+    job->operation = g_object_ref(print_operation);
+    job->context   = g_object_ref(context);
+    g_mutex_unlock(&job->lock);
+
+    gtk_print_operation_set_defer_drawing(print_operation);
+    print_job_prefetch(job, page_number);
     return;
   }
 
-  girara_debug("printing page %d (fallback) ...", page_number);
-  if (draw_page_image(cairo, context, zathura, page) == false) {
+  bool recorded            = false;
+  cairo_surface_t* surface = print_job_take(job, page_number, &recorded);
+  g_mutex_unlock(&job->lock);
+
+  print_job_prefetch(job, page_number);
+  if (draw_page(job, context, surface, recorded) == false) {
     gtk_print_operation_cancel(print_operation);
   }
 }
 
+static void cb_print_end(GtkPrintOperation* print_operation, GtkPrintContext* UNUSED(context), zathura_t* zathura) {
+  zathura_print_job_t* job = g_object_get_data(G_OBJECT(print_operation), PRINT_JOB_KEY);
+  if (job != NULL) {
+    print_job_stop(job);
+  }
+
+  if (zathura_has_document(zathura) == false || zathura->ui.session == NULL) {
+    return;
+  }
+
+  g_autofree char* file_path = get_formatted_filename(zathura, true);
+  girara_statusbar_item_set_text(zathura->ui.session, zathura->ui.statusbar.file, file_path);
+}
+
 static void cb_print_request_page_setup(GtkPrintOperation* UNUSED(print_operation), GtkPrintContext* UNUSED(context),
                                         gint page_number, GtkPageSetup* setup, zathura_t* zathura) {
   if (zathura_has_document(zathura) == false) {
@@ -152,6 +504,11 @@ void print(zathura_t* zathura) {
   }
   gtk_print_operation_set_embed_page_setup(print_operation, TRUE);
 
+  /* the job is freed with the print operation */
+  zathura_print_job_t* job = print_job_new(zathura);
+  g_object_set_data_full(G_OBJECT(print_operation), PRINT_JOB_KEY, job, print_job_free);
+  zathura->print.job = job;
+
   /* print operation signals */
   g_signal_connect(print_operation, "draw-page", G_CALLBACK(cb_print_draw_page), zathura);
   g_signal_connect(print_operation, "end-print", G_CALLBACK(cb_print_end), zathura);
@@ -173,3 +530,11 @@ void print(zathura_t* zathura) {
     zathura->print.page_setup = g_object_ref(gtk_print_operation_get_default_page_setup(print_operation));
   }
 }
+
+void print_cancel(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL);
+
+  if (zathura->print.job != NULL) {
+    print_job_stop(zathura->print.job);
+  }
+}
@@ -12,4 +12,14 @@
  */
 void print(zathura_t* zathura);
 
+/**
+ * Stop rendering pages of a running print operation. The operation is
+ * cancelled when it asks for the next page or when the page it waits for is
+ * delivered. Has to be called before the
+ * document is closed.
+ *
+ * @param zathura
+ */
+void print_cancel(zathura_t* zathura);
+
 #endif // PRINT_H
@@ -0,0 +1,179 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <math.h>
+
+#include "rect-index.h"
+#include "macros.h"
+
+/* upper bound for the number of rows and columns of the grid */
+#define RECT_INDEX_MAX_CELLS 64
+
+typedef struct rect_index_entry_s {
+  zathura_rectangle_t rectangle;
+  zathura_rect_index_kind_t kind;
+  void* data;
+} rect_index_entry_t;
+
+struct zathura_rect_index_s {
+  double cell_width;  /**< Width of a cell */
+  double cell_height; /**< Height of a cell */
+  unsigned int cols;  /**< Number of columns */
+  unsigned int rows;  /**< Number of rows */
+  GArray** cells;     /**< Entry indices per cell, allocated on demand */
+  GArray* entries;    /**< Entries in insertion order */
+};
+
+zathura_rect_index_t* zathura_rect_index_new(double width, double height, size_t size_hint) {
+  zathura_rect_index_t* index = g_try_malloc0(sizeof(zathura_rect_index_t));
+  if (index == NULL) {
+    return NULL;
+  }
+
+  /* aim for about one entry per cell */
+  unsigned int side = ceil(sqrt((double)size_hint));
+  side              = MAX(1, MIN(side, RECT_INDEX_MAX_CELLS));
+
+  index->cols        = side;
+  index->rows        = side;
+  index->cell_width  = MAX(width, 1.0) / side;
+  index->cell_height = MAX(height, 1.0) / side;
+  index->cells       = g_new0(GArray*, index->cols * index->rows);
+  index->entries     = g_array_sized_new(FALSE, FALSE, sizeof(rect_index_entry_t), size_hint);
+
+  return index;
+}
+
+void zathura_rect_index_free(zathura_rect_index_t* index) {
+  if (index == NULL) {
+    return;
+  }
+
+  for (unsigned int idx = 0; idx < index->cols * index->rows; ++idx) {
+    if (index->cells[idx] != NULL) {
+      g_array_free(index->cells[idx], TRUE);
+    }
+  }
+  g_free(index->cells);
+  g_array_free(index->entries, TRUE);
+  g_free(index);
+}
+
+static unsigned int cell_coordinate(double value, double cell_size, unsigned int count) {
+  const double cell = floor(value / cell_size);
+  if (cell < 0) {
+    return 0;
+  }
+  if (cell >= count) {
+    return count - 1;
+  }
+  return cell;
+}
+
+static void cell_range(const zathura_rect_index_t* index, const zathura_rectangle_t* rectangle, unsigned int* col1,
+                       unsigned int* row1, unsigned int* col2, unsigned int* row2) {
+  *col1 = cell_coordinate(MIN(rectangle->x1, rectangle->x2), index->cell_width, index->cols);
+  *col2 = cell_coordinate(MAX(rectangle->x1, rectangle->x2), index->cell_width, index->cols);
+  *row1 = cell_coordinate(MIN(rectangle->y1, rectangle->y2), index->cell_height, index->rows);
+  *row2 = cell_coordinate(MAX(rectangle->y1, rectangle->y2), index->cell_height, index->rows);
+}
+
+void zathura_rect_index_insert(zathura_rect_index_t* index, const zathura_rectangle_t* rectangle,
+                               zathura_rect_index_kind_t kind, void* data) {
+  g_return_if_fail(index != NULL && rectangle != NULL);
+
+  const rect_index_entry_t entry = {
+      .rectangle =
+          {
+              .x1 = MIN(rectangle->x1, rectangle->x2),
+              .y1 = MIN(rectangle->y1, rectangle->y2),
+              .x2 = MAX(rectangle->x1, rectangle->x2),
+              .y2 = MAX(rectangle->y1, rectangle->y2),
+          },
+      .kind = kind,
+      .data = data,
+  };
+  const guint entry_index = index->entries->len;
+  g_array_append_val(index->entries, entry);
+
+  unsigned int col1, row1, col2, row2;
+  cell_range(index, &entry.rectangle, &col1, &row1, &col2, &row2);
+  for (unsigned int row = row1; row <= row2; ++row) {
+    for (unsigned int col = col1; col <= col2; ++col) {
+      GArray** cell = &index->cells[row * index->cols + col];
+      if (*cell == NULL) {
+        *cell = g_array_new(FALSE, FALSE, sizeof(guint));
+      }
+      g_array_append_val(*cell, entry_index);
+    }
+  }
+}
+
+size_t zathura_rect_index_size(const zathura_rect_index_t* index) {
+  return index != NULL ? index->entries->len : 0;
+}
+
+static bool rectangles_intersect(const zathura_rectangle_t* lhs, const zathura_rectangle_t* rhs) {
+  return lhs->x1 <= rhs->x2 && rhs->x1 <= lhs->x2 && lhs->y1 <= rhs->y2 && rhs->y1 <= lhs->y2;
+}
+
+static gint compare_entry_index(gconstpointer lhs, gconstpointer rhs) {
+  const guint l = *(const guint*)lhs;
+  const guint r = *(const guint*)rhs;
+  return (l > r) - (l < r);
+}
+
+bool zathura_rect_index_query(const zathura_rect_index_t* index, const zathura_rectangle_t* area, unsigned int kinds,
+                              zathura_rect_index_func_t func, void* user_data) {
+  g_return_val_if_fail(area != NULL && func != NULL, false);
+  if (index == NULL || index->entries->len == 0) {
+    return false;
+  }
+
+  const zathura_rectangle_t normalized = {
+      .x1 = MIN(area->x1, area->x2),
+      .y1 = MIN(area->y1, area->y2),
+      .x2 = MAX(area->x1, area->x2),
+      .y2 = MAX(area->y1, area->y2),
+  };
+
+  unsigned int col1, row1, col2, row2;
+  cell_range(index, &normalized, &col1, &row1, &col2, &row2);
+
+  /* entries spanning several cells are collected multiple times; sort the
+   * candidates to report them once and in insertion order */
+  g_autoptr(GArray) candidates = g_array_new(FALSE, FALSE, sizeof(guint));
+  for (unsigned int row = row1; row <= row2; ++row) {
+    for (unsigned int col = col1; col <= col2; ++col) {
+      const GArray* cell = index->cells[row * index->cols + col];
+      if (cell != NULL) {
+        g_array_append_vals(candidates, cell->data, cell->len);
+      }
+    }
+  }
+  if (row1 != row2 || col1 != col2) {
+    g_array_sort(candidates, compare_entry_index);
+  }
+
+  for (guint idx = 0; idx < candidates->len; ++idx) {
+    const guint entry_index = g_array_index(candidates, guint, idx);
+    if (idx > 0 && entry_index == g_array_index(candidates, guint, idx - 1)) {
+      continue;
+    }
+
+    rect_index_entry_t* entry = &g_array_index(index->entries, rect_index_entry_t, entry_index);
+    if ((entry->kind & kinds) == 0 || rectangles_intersect(&entry->rectangle, &normalized) == false) {
+      continue;
+    }
+    if (func(&entry->rectangle, entry->kind, entry->data, user_data) == false) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool zathura_rect_index_query_point(const zathura_rect_index_t* index, double x, double y, unsigned int kinds,
+                                    zathura_rect_index_func_t func, void* user_data) {
+  const zathura_rectangle_t area = {.x1 = x, .y1 = y, .x2 = x, .y2 = y};
+  return zathura_rect_index_query(index, &area, kinds, func, user_data);
+}
@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_RECT_INDEX_H
+#define ZATHURA_RECT_INDEX_H
+
+#include <stdbool.h>
+#include <glib.h>
+
+#include "types.h"
+
+/**
+ * Kinds of interactive rectangles stored in the index
+ */
+typedef enum zathura_rect_index_kind_e {
+  ZATHURA_RECT_INDEX_LINK          = 1 << 0, /**< Link area */
+  ZATHURA_RECT_INDEX_HIGHLIGHT     = 1 << 1, /**< Rectangle of a persistent highlight */
+  ZATHURA_RECT_INDEX_NOTE          = 1 << 2, /**< Sticky note anchor */
+  ZATHURA_RECT_INDEX_EMBEDDED_NOTE = 1 << 3, /**< Sticky note embedded in the document */
+  ZATHURA_RECT_INDEX_IMAGE         = 1 << 4, /**< Image area */
+  ZATHURA_RECT_INDEX_ALL           = 0xff    /**< All of the above */
+} zathura_rect_index_kind_t;
+
+/**
+ * Uniform grid over the rectangles of a page. All coordinates are in unscaled
+ * and unrotated page coordinates.
+ */
+typedef struct zathura_rect_index_s zathura_rect_index_t;
+
+/**
+ * Callback for index queries. Entries are reported in insertion order and
+ * every entry is reported at most once per query.
+ *
+ * @param rectangle The rectangle of the entry
+ * @param kind The kind of the entry
+ * @param data The user data of the entry
+ * @param user_data The user data of the query
+ * @return true to continue the query, false to stop it
+ */
+typedef bool (*zathura_rect_index_func_t)(const zathura_rectangle_t* rectangle, zathura_rect_index_kind_t kind,
+                                          void* data, void* user_data);
+
+/**
+ * Create a new index.
+ *
+ * @param width Width of the page
+ * @param height Height of the page
+ * @param size_hint Expected number of entries, used to size the grid
+ * @return new index
+ */
+zathura_rect_index_t* zathura_rect_index_new(double width, double height, size_t size_hint);
+
+/**
+ * Free the index.
+ *
+ * @param index The index
+ */
+void zathura_rect_index_free(zathura_rect_index_t* index);
+
+/**
+ * Insert a rectangle into the index. The index does not take ownership of
+ * data.
+ *
+ * @param index The index
+ * @param rectangle The rectangle
+ * @param kind The kind of the entry
+ * @param data User data of the entry
+ */
+void zathura_rect_index_insert(zathura_rect_index_t* index, const zathura_rectangle_t* rectangle,
+                               zathura_rect_index_kind_t kind, void* data);
+
+/**
+ * Number of entries in the index.
+ *
+ * @param index The index
+ * @return number of entries
+ */
+size_t zathura_rect_index_size(const zathura_rect_index_t* index);
+
+/**
+ * Call func for every entry of one of the given kinds whose rectangle
+ * intersects area.
+ *
+ * @param index The index
+ * @param area The area to query
+ * @param kinds Bit mask of \ref zathura_rect_index_kind_t values
+ * @param func The callback
+ * @param user_data User data passed to func
+ * @return true if func stopped the query, false otherwise
+ */
+bool zathura_rect_index_query(const zathura_rect_index_t* index, const zathura_rectangle_t* area, unsigned int kinds,
+                              zathura_rect_index_func_t func, void* user_data);
+
+/**
+ * Call func for every entry of one of the given kinds whose rectangle
+ * contains the point (x, y).
+ *
+ * @param index The index
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @param kinds Bit mask of \ref zathura_rect_index_kind_t values
+ * @param func The callback
+ * @param user_data User data passed to func
+ * @return true if func stopped the query, false otherwise
+ */
+bool zathura_rect_index_query_point(const zathura_rect_index_t* index, double x, double y, unsigned int kinds,
+                                    zathura_rect_index_func_t func, void* user_data);
+
+#endif
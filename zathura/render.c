@@ -15,6 +15,7 @@
 #include "page.h"
 #include "page-widget.h"
 #include "utils.h"
+#include "startup-trace.h"
 
 /* private data for ZathuraRenderer */
 typedef struct private_s {
@@ -694,8 +695,12 @@ static void recolor_fast(ZathuraRendererPrivate* priv, unsigned int page_width,
   }
 }
 
+/* Images are located with the rotation and scale of the document, like in the
+ * page widgets, unless image_scale is given: then the surface is unrotated
+ * and image positions are scaled by it. */
 static void recolor(ZathuraRendererPrivate* priv, zathura_page_t* page, unsigned int page_width,
-                    unsigned int page_height, cairo_surface_t* surface, zathura_device_factors_t device_factors) {
+                    unsigned int page_height, cairo_surface_t* surface, zathura_device_factors_t device_factors,
+                    double image_scale) {
   /* uses a representation of a rgb color as follows:
      - a lightness scalar (between 0,1), which is a weighted average of r, g, b,
      - a hue vector, which indicates a radian direction from the grey axis,
@@ -743,12 +748,19 @@ static void recolor(ZathuraRendererPrivate* priv, zathura_page_t* page, unsigned
         if (rect == NULL) {
           break;
         }
-        *rect = recalc_rectangle(page, image_it->position);
-        /* Scale rectangle coordinates by device factors to match surface pixel coordinates */
-        rect->x1 *= device_factors.x;
-        rect->x2 *= device_factors.x;
-        rect->y1 *= device_factors.y;
-        rect->y2 *= device_factors.y;
+        if (image_scale > 0) {
+          rect->x1 = image_it->position.x1 * image_scale;
+          rect->x2 = image_it->position.x2 * image_scale;
+          rect->y1 = image_it->position.y1 * image_scale;
+          rect->y2 = image_it->position.y2 * image_scale;
+        } else {
+          *rect = recalc_rectangle(page, image_it->position);
+          /* Scale rectangle coordinates by device factors to match surface pixel coordinates */
+          rect->x1 *= device_factors.x;
+          rect->x2 *= device_factors.x;
+          rect->y1 *= device_factors.y;
+          rect->y2 *= device_factors.y;
+        }
         girara_list_append(rectangles, rect);
       }
     }
@@ -763,6 +775,16 @@ static void recolor(ZathuraRendererPrivate* priv, zathura_page_t* page, unsigned
   cairo_surface_mark_dirty(surface);
 }
 
+void zathura_renderer_recolor_surface(ZathuraRenderer* renderer, zathura_page_t* page, cairo_surface_t* surface,
+                                      double scale) {
+  g_return_if_fail(ZATHURA_IS_RENDERER(renderer) && page != NULL && surface != NULL && scale > 0);
+  ZathuraRendererPrivate* priv = zathura_renderer_get_instance_private(renderer);
+
+  const zathura_device_factors_t factors = {.x = 1, .y = 1};
+  recolor(priv, page, cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface), surface,
+          factors, scale);
+}
+
 static bool invoke_completed_signal(render_job_t* job, cairo_surface_t* surface) {
   emit_completed_signal_t* ecs = g_try_malloc0(sizeof(emit_completed_signal_t));
   if (ecs == NULL) {
@@ -864,7 +886,7 @@ static bool render(render_job_t* job, ZathuraRenderRequest* request, ZathuraRend
 
   /* recolor */
   if (request_priv->render_plain == false && priv->recolor.enabled == true) {
-    recolor(priv, page, page_width, page_height, surface, device_factors);
+    recolor(priv, page, page_width, page_height, surface, device_factors, 0);
   }
 
   if (!invoke_completed_signal(job, surface)) {
@@ -893,7 +915,10 @@ static void render_job(void* data, void* user_data) {
 
   ZathuraRenderRequestPrivate* request_priv = zathura_render_request_get_instance_private(request);
   girara_debug("Rendering page %d ...", zathura_page_get_index(request_priv->page) + 1);
-  if (render(job, request, renderer) != true) {
+  zathura_startup_trace_begin("render_job");
+  const bool rendered = render(job, request, renderer);
+  zathura_startup_trace_end("render_job");
+  if (rendered != true) {
     girara_error("Rendering failed (page %d)\n", zathura_page_get_index(request_priv->page) + 1);
     remove_job_and_free(job);
   }
@@ -107,6 +107,17 @@ void zathura_renderer_set_recolor_colors_str(ZathuraRenderer* renderer, const ch
  * @param dark dark color
  */
 void zathura_renderer_get_recolor_colors(ZathuraRenderer* renderer, GdkRGBA* light, GdkRGBA* dark);
+/**
+ * Recolor a surface rendered outside of the render thread, e.g. for exporting
+ * pages, with the recoloring settings of the renderer.
+ * @param renderer a renderer object
+ * @param page the page rendered to the surface
+ * @param surface an unrotated ARGB32 image surface
+ * @param scale pixels per point of the surface, used to locate images for
+ *   reverse video
+ */
+void zathura_renderer_recolor_surface(ZathuraRenderer* renderer, zathura_page_t* page, cairo_surface_t* surface,
+                                      double scale);
 /**
  * Stop rendering.
  * @param renderer a render object
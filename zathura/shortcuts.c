@@ -23,7 +23,11 @@
 #include "adjustment.h"
 #include "database.h"
 #include "document-widget.h"
+#include "fuzzy.h"
+#include "index-model.h"
 #include "note-popup.h"
+#include "overview.h"
+#include "thumbnail-cache.h"
 #include <math.h>
 #include <dirent.h>
 #include <sys/stat.h>
@@ -1211,13 +1215,22 @@ bool sc_toggle_index(girara_session_t* session, girara_argument_t* UNUSED(argume
     return false;
   }
 
-  girara_tree_node_t* document_index = NULL;
-  GtkWidget* treeview                = NULL;
-  GtkTreeModel* model                = NULL;
-  GtkCellRenderer* renderer          = NULL;
-  GtkCellRenderer* renderer2         = NULL;
+  GtkWidget* treeview        = NULL;
+  GtkCellRenderer* renderer  = NULL;
+  GtkCellRenderer* renderer2 = NULL;
 
   if (zathura->ui.index == NULL) {
+    /* the index is generated in the background when it is shown for the first time */
+    if (zathura->index.model == NULL) {
+      if (zathura->index.loaded == false) {
+        document_load_index(zathura);
+        girara_notify(session, GIRARA_INFO, _("Loading index..."));
+      } else {
+        girara_notify(session, GIRARA_WARNING, _("This document does not contain any index"));
+      }
+      return false;
+    }
+
     /* create new index widget */
     zathura->ui.index = gtk_scrolled_window_new(NULL, NULL);
 
@@ -1227,27 +1240,13 @@ bool sc_toggle_index(girara_session_t* session, girara_argument_t* UNUSED(argume
 
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(zathura->ui.index), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
 
-    /* create index */
-    document_index = zathura_document_index_generate(zathura->document, NULL);
-    if (document_index == NULL) {
-      girara_notify(session, GIRARA_WARNING, _("This document does not contain any index"));
-      goto error_free;
-    }
-
-    model = GTK_TREE_MODEL(gtk_tree_store_new(4, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_POINTER));
-    if (model == NULL) {
-      goto error_free;
-    }
-
-    treeview = gtk_tree_view_new_with_model(model);
+    treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(zathura->index.model));
     if (treeview == NULL) {
       goto error_free;
     }
 
     gtk_style_context_add_class(gtk_widget_get_style_context(treeview), "indexmode");
 
-    g_object_unref(model);
-
     renderer = gtk_cell_renderer_text_new();
     if (renderer == NULL) {
       goto error_free;
@@ -1258,9 +1257,6 @@ bool sc_toggle_index(girara_session_t* session, girara_argument_t* UNUSED(argume
       goto error_free;
     }
 
-    document_index_build(session, model, NULL, document_index);
-    girara_node_free(document_index);
-
     /* setup widget */
     gtk_tree_view_insert_column_with_attributes(GTK_TREE_VIEW(treeview), 0, "Title", renderer, "markup", 0, NULL);
     gtk_tree_view_insert_column_with_attributes(GTK_TREE_VIEW(treeview), 1, "Target", renderer2, "text", 1, NULL);
@@ -1311,68 +1307,168 @@ error_free:
     zathura->ui.index = NULL;
   }
 
-  if (document_index != NULL) {
-    girara_node_free(document_index);
+error_ret:
+
+  return false;
+}
+
+bool sc_navigate_overview(girara_session_t* session, girara_argument_t* argument, girara_event_t* UNUSED(event),
+                          unsigned int t) {
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(session->global.data != NULL, false);
+  zathura_t* zathura = session->global.data;
+  g_return_val_if_fail(argument != NULL, false);
+
+  if (zathura->document == NULL || zathura->ui.overview == NULL) {
+    return false;
   }
 
-error_ret:
+  const int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  const int columns         = zathura_overview_get_columns(zathura);
+  const int rows            = zathura_overview_get_visible_rows(zathura);
+  const int count           = t == 0 ? 1 : t;
+  int selected              = zathura->overview.selected;
+
+  switch (argument->n) {
+  case LEFT:
+    selected -= count;
+    break;
+  case RIGHT:
+    selected += count;
+    break;
+  case UP:
+    selected -= count * columns;
+    break;
+  case DOWN:
+    selected += count * columns;
+    break;
+  case HALF_UP:
+    selected -= count * columns * MAX(1, rows / 2);
+    break;
+  case HALF_DOWN:
+    selected += count * columns * MAX(1, rows / 2);
+    break;
+  case FULL_UP:
+    selected -= count * columns * rows;
+    break;
+  case FULL_DOWN:
+    selected += count * columns * rows;
+    break;
+  case TOP:
+    selected = 0;
+    break;
+  case BOTTOM:
+    selected = number_of_pages - 1;
+    break;
+  case SELECT:
+    zathura_overview_activate(zathura);
+    return false;
+  default:
+    return false;
+  }
+
+  zathura_overview_select(zathura, CLAMP(selected, 0, number_of_pages - 1));
 
   return false;
 }
 
-// Fuzzy match function - fzf style
-static gboolean fuzzy_match(const char* pattern, const char* text) {
-  if (pattern == NULL || *pattern == '\0') return TRUE;
-  if (text == NULL) return FALSE;
+bool sc_toggle_overview(girara_session_t* session, girara_argument_t* UNUSED(argument),
+                        girara_event_t* UNUSED(event), unsigned int UNUSED(t)) {
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(session->global.data != NULL, false);
+  zathura_t* zathura = session->global.data;
+  if (zathura->document == NULL) {
+    return false;
+  }
+
+  if (zathura->ui.overview == NULL) {
+    zathura->ui.overview = zathura_overview_new(zathura);
+  }
+
+  if (girara_mode_get(session) == zathura->modes.overview) {
+    girara_set_view(session, zathura->ui.view);
+    girara_mode_set(session, zathura->modes.normal);
+
+    /* refresh view */
+    refresh_view(zathura);
+  } else {
+    /* save current position to the jumplist */
+    zathura_jumplist_add(zathura);
 
-  const char* p = pattern;
-  const char* t = text;
-  while (*p && *t) {
-    if (g_ascii_tolower(*p) == g_ascii_tolower(*t)) {
-      p++;
+    /* zathura goes to the first page when toggling the view if this isn't done */
+    if (zathura_document_get_adjust_mode(zathura->document) == ZATHURA_ADJUST_INPUTBAR) {
+      zathura_document_set_adjust_mode(zathura->document, ZATHURA_ADJUST_NONE);
     }
-    t++;
+
+    /* thumbnails are only generated once they are needed */
+    zathura_thumbnail_cache_start(zathura->overview.thumbnails);
+
+    girara_set_view(session, zathura->ui.overview);
+    zathura_overview_select(zathura, zathura_document_get_current_page_number(zathura->document));
+    girara_mode_set(session, zathura->modes.overview);
   }
-  return (*p == '\0');
-}
 
-// Substring match function - case insensitive
-static gboolean substring_match(const char* pattern, const char* text) {
-  if (pattern == NULL || *pattern == '\0') return TRUE;
-  if (text == NULL) return FALSE;
-
-  gchar* lower_text = g_utf8_strdown(text, -1);
-  gchar* lower_pattern = g_utf8_strdown(pattern, -1);
-  gboolean match = (g_strstr_len(lower_text, -1, lower_pattern) != NULL);
-  g_free(lower_text);
-  g_free(lower_pattern);
-  return match;
+  return false;
 }
 
-// Filter function for tree model
-static gboolean highlights_filter_func(GtkTreeModel* model, GtkTreeIter* iter, gpointer data) {
-  GtkEntry* entry = GTK_ENTRY(data);
-  const gchar* search_text = gtk_entry_get_text(entry);
-
-  if (search_text == NULL || *search_text == '\0') {
+/* Show the rows of a list panel whose text matches the query of its search
+ * entry; the scores are cached by the matcher attached to the entry */
+static gboolean list_panel_filter_func(GtkTreeModel* model, GtkTreeIter* iter, gpointer data) {
+  GObject* entry           = G_OBJECT(data);
+  zathura_fuzzy_t* matcher = g_object_get_data(entry, "matcher");
+  if (zathura_fuzzy_query_is_empty(matcher) == true) {
     return TRUE;
   }
 
-  gchar* text = NULL;
-  gtk_tree_model_get(model, iter, 2, &text, -1);  // Column 2 is text
+  const int column      = GPOINTER_TO_INT(g_object_get_data(entry, "match_column"));
+  g_autofree char* text = NULL;
+  gtk_tree_model_get(model, iter, column, &text, -1);
+
+  return zathura_fuzzy_match(matcher, text) >= 0 ? TRUE : FALSE;
+}
 
-  // Get fuzzy mode flag from the search entry
-  gboolean fuzzy_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(entry), "fuzzy_mode"));
+/* Order the rows of a list panel by score; rows with equal scores keep the
+ * order of the store */
+static gint list_panel_sort_func(GtkTreeModel* model, GtkTreeIter* a, GtkTreeIter* b, gpointer data) {
+  GObject* entry           = G_OBJECT(data);
+  zathura_fuzzy_t* matcher = g_object_get_data(entry, "matcher");
+  const int column         = GPOINTER_TO_INT(g_object_get_data(entry, "match_column"));
 
-  gboolean visible;
-  if (fuzzy_mode) {
-    visible = fuzzy_match(search_text, text);
-  } else {
-    visible = substring_match(search_text, text);
+  g_autofree char* text_a = NULL;
+  g_autofree char* text_b = NULL;
+  gtk_tree_model_get(model, a, column, &text_a, -1);
+  gtk_tree_model_get(model, b, column, &text_b, -1);
+
+  const int score_a = zathura_fuzzy_match(matcher, text_a);
+  const int score_b = zathura_fuzzy_match(matcher, text_b);
+  if (score_a != score_b) {
+    return score_a > score_b ? -1 : 1;
   }
 
-  g_free(text);
-  return visible;
+  g_autoptr(GtkTreePath) path_a = gtk_tree_model_get_path(model, a);
+  g_autoptr(GtkTreePath) path_b = gtk_tree_model_get_path(model, b);
+  return gtk_tree_path_compare(path_a, path_b);
+}
+
+/* Create the model shown by a list panel: the rows of store are filtered by
+ * matching the text in column against the query of search_entry and sorted
+ * by score. The filter model is available with gtk_tree_model_sort_get_model. */
+static GtkTreeModel* list_panel_model_new(GtkListStore* store, GtkWidget* search_entry, int column) {
+  g_object_set_data_full(G_OBJECT(search_entry), "matcher", zathura_fuzzy_new(),
+                         (GDestroyNotify)zathura_fuzzy_free);
+  g_object_set_data(G_OBJECT(search_entry), "match_column", GINT_TO_POINTER(column));
+
+  GtkTreeModel* filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), NULL);
+  gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filter), list_panel_filter_func, search_entry, NULL);
+
+  /* sorted only while a query is set, see list_panel_refilter */
+  GtkTreeModel* sort = gtk_tree_model_sort_new_with_model(filter);
+  gtk_tree_sortable_set_default_sort_func(GTK_TREE_SORTABLE(sort), list_panel_sort_func, search_entry, NULL);
+  gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(sort), GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID,
+                                       GTK_SORT_ASCENDING);
+  g_object_set_data(G_OBJECT(search_entry), "sort", sort);
+
+  return sort;
 }
 
 bool sc_toggle_highlights(girara_session_t* session, girara_argument_t* UNUSED(argument),
@@ -1425,13 +1521,12 @@ bool sc_toggle_highlights(girara_session_t* session, girara_argument_t* UNUSED(a
     GtkListStore* store = gtk_list_store_new(4,
         G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_POINTER);
 
-    // Create filter model
-    GtkTreeModel* filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), NULL);
-    gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filter),
-        highlights_filter_func, search_entry, NULL);
+    // Create filter and sort model (column 2 is text)
+    GtkTreeModel* model  = list_panel_model_new(store, search_entry, 2);
+    GtkTreeModel* filter = gtk_tree_model_sort_get_model(GTK_TREE_MODEL_SORT(model));
 
     // Create tree view
-    GtkWidget* treeview = gtk_tree_view_new_with_model(filter);
+    GtkWidget* treeview = gtk_tree_view_new_with_model(model);
     gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(treeview), TRUE);
 
     // Color column
@@ -2322,7 +2417,7 @@ bool sc_cycle_highlight_color(girara_session_t* session, girara_argument_t* UNUS
     }
 
     /* Trigger redraw */
-    gtk_widget_queue_draw(page_widget);
+    zathura_page_widget_update_highlights(ZATHURA_PAGE(page_widget));
 
     /* Show notification */
     const char* color_names[] = {"yellow", "green", "blue", "red"};
@@ -2384,116 +2479,6 @@ error:
   return false;
 }
 
-/* File picker helper: Check if file extension is supported */
-static bool file_picker_is_supported_extension(const char* filename) {
-  const char* ext = strrchr(filename, '.');
-  if (ext == NULL) {
-    return false;
-  }
-  ext++; /* Skip the dot */
-
-  /* Supported document extensions */
-  const char* supported[] = {"pdf", "epub", "djvu", "ps", "cbz", "cbr", "xps", "oxps", NULL};
-  for (int i = 0; supported[i] != NULL; i++) {
-    if (g_ascii_strcasecmp(ext, supported[i]) == 0) {
-      return true;
-    }
-  }
-  return false;
-}
-
-/* File picker helper: Recursively scan directory for documents */
-/* Exported for use by callbacks.c */
-void file_picker_scan_directory(const char* dir_path, GtkListStore* store, int depth) {
-  if (depth > 5) { /* Limit recursion depth */
-    return;
-  }
-
-  GDir* dir = g_dir_open(dir_path, 0, NULL);
-  if (dir == NULL) {
-    return;
-  }
-
-  const char* name;
-  while ((name = g_dir_read_name(dir)) != NULL) {
-    /* Skip hidden files/dirs */
-    if (name[0] == '.') {
-      continue;
-    }
-
-    char* full_path = g_build_filename(dir_path, name, NULL);
-    struct stat st;
-    if (stat(full_path, &st) == 0) {
-      if (S_ISDIR(st.st_mode)) {
-        /* Recurse into subdirectory */
-        file_picker_scan_directory(full_path, store, depth + 1);
-      } else if (S_ISREG(st.st_mode) && file_picker_is_supported_extension(name)) {
-        /* Add file to store with all 4 columns */
-        GtkTreeIter iter;
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-            0, full_path,  /* Full path */
-            1, name,       /* Display text (filename in file mode) */
-            2, 0,          /* Page number (0 for filename mode) */
-            3, "",         /* Context (empty for filename mode) */
-            -1);
-      }
-    }
-    g_free(full_path);
-  }
-  g_dir_close(dir);
-}
-
-/* File picker filter function for fuzzy matching */
-static gboolean file_picker_filter_func(GtkTreeModel* model, GtkTreeIter* iter, gpointer data) {
-  GtkEntry* search_entry = GTK_ENTRY(data);
-
-  /* In content search mode, show all rows (rga already filtered results) */
-  gboolean content_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(search_entry), "content_search_mode"));
-  if (content_mode) {
-    return TRUE;
-  }
-
-  const char* search_text = gtk_entry_get_text(search_entry);
-
-  if (search_text == NULL || search_text[0] == '\0') {
-    return TRUE; /* Show all when no search */
-  }
-
-  char* filename = NULL;
-  gtk_tree_model_get(model, iter, 1, &filename, -1);
-  if (filename == NULL) {
-    return FALSE;
-  }
-
-  /* Check for fuzzy mode */
-  gboolean fuzzy_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(search_entry), "fuzzy_mode"));
-
-  gboolean match = FALSE;
-  if (fuzzy_mode) {
-    /* Fuzzy match: all search chars must appear in order */
-    const char* fp = filename;
-    const char* sp = search_text;
-    while (*sp != '\0' && *fp != '\0') {
-      if (g_ascii_tolower(*fp) == g_ascii_tolower(*sp)) {
-        sp++;
-      }
-      fp++;
-    }
-    match = (*sp == '\0');
-  } else {
-    /* Substring match */
-    char* lower_filename = g_ascii_strdown(filename, -1);
-    char* lower_search = g_ascii_strdown(search_text, -1);
-    match = (strstr(lower_filename, lower_search) != NULL);
-    g_free(lower_filename);
-    g_free(lower_search);
-  }
-
-  g_free(filename);
-  return match;
-}
-
 /* Helper for deferred focus grab - returns FALSE to run only once */
 static gboolean file_picker_grab_focus_cb(gpointer data) {
   GtkWidget* widget = GTK_WIDGET(data);
@@ -2554,13 +2539,13 @@ bool sc_toggle_file_picker(girara_session_t* session, girara_argument_t* UNUSED(
      */
     GtkListStore* store = gtk_list_store_new(4, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_INT, G_TYPE_STRING);
 
-    /* Create filter model */
-    GtkTreeModel* filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), NULL);
-    gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filter),
-        file_picker_filter_func, search_entry, NULL);
+    /* Create filter and sort model on the display text; content search
+     * results are shown unfiltered in the order they arrive */
+    GtkTreeModel* model  = list_panel_model_new(store, search_entry, 1);
+    GtkTreeModel* filter = gtk_tree_model_sort_get_model(GTK_TREE_MODEL_SORT(model));
 
     /* Create tree view */
-    GtkWidget* treeview = gtk_tree_view_new_with_model(filter);
+    GtkWidget* treeview = gtk_tree_view_new_with_model(model);
     gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(treeview), FALSE);
 
     /* Single column showing display text (column 1) */
@@ -2625,23 +2610,7 @@ refresh_and_show:
   ;
 
   /* Populate/refresh the file list */
-  GtkListStore* store = g_object_get_data(G_OBJECT(zathura->ui.file_picker), "store");
-  gtk_list_store_clear(store);
-
-  /* Scan default directories */
-  const char* home = g_get_home_dir();
-  char* downloads = g_build_filename(home, "Downloads", NULL);
-  char* documents = g_build_filename(home, "Documents", NULL);
-  char* projects = g_build_filename(home, "projects", NULL);
-
-  file_picker_scan_directory(downloads, store, 0);
-  file_picker_scan_directory(documents, store, 0);
-  file_picker_scan_directory(projects, store, 0);
-  file_picker_scan_directory("/tmp", store, 0);
-
-  g_free(downloads);
-  g_free(documents);
-  g_free(projects);
+  file_picker_refresh_file_list(zathura);
 
   /* Show panel */
   gtk_widget_show_all(zathura->ui.file_picker);
@@ -2920,32 +2889,6 @@ static void notes_list_free(gpointer data) {
   }
 }
 
-// Filter function for notes tree model
-static gboolean notes_filter_func(GtkTreeModel* model, GtkTreeIter* iter, gpointer data) {
-  GtkEntry* entry = GTK_ENTRY(data);
-  const gchar* search_text = gtk_entry_get_text(entry);
-
-  if (search_text == NULL || *search_text == '\0') {
-    return TRUE;
-  }
-
-  gchar* text = NULL;
-  gtk_tree_model_get(model, iter, 1, &text, -1);  // Column 1 is content
-
-  // Get fuzzy mode flag from the search entry
-  gboolean fuzzy_mode = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(entry), "fuzzy_mode"));
-
-  gboolean visible;
-  if (fuzzy_mode) {
-    visible = fuzzy_match(search_text, text);
-  } else {
-    visible = substring_match(search_text, text);
-  }
-
-  g_free(text);
-  return visible;
-}
-
 bool sc_toggle_notes(girara_session_t* session, girara_argument_t* UNUSED(argument),
                      girara_event_t* UNUSED(event), unsigned int UNUSED(t)) {
   g_return_val_if_fail(session != NULL, false);
@@ -2996,13 +2939,12 @@ bool sc_toggle_notes(girara_session_t* session, girara_argument_t* UNUSED(argume
     GtkListStore* store = gtk_list_store_new(3,
         G_TYPE_STRING, G_TYPE_STRING, G_TYPE_POINTER);
 
-    // Create filter model
-    GtkTreeModel* filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), NULL);
-    gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filter),
-        notes_filter_func, search_entry, NULL);
+    // Create filter and sort model (column 1 is content)
+    GtkTreeModel* model  = list_panel_model_new(store, search_entry, 1);
+    GtkTreeModel* filter = gtk_tree_model_sort_get_model(GTK_TREE_MODEL_SORT(model));
 
     // Create tree view
-    GtkWidget* treeview = gtk_tree_view_new_with_model(filter);
+    GtkWidget* treeview = gtk_tree_view_new_with_model(model);
     gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(treeview), TRUE);
 
     // Page column
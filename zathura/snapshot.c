@@ -0,0 +1,414 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <errno.h>
+#include <string.h>
+
+#include <gio/gio.h>
+#include <girara/log.h>
+#include <girara/settings.h>
+#include <glib/gstdio.h>
+
+#include "snapshot.h"
+#include "document.h"
+#include "macros.h"
+#include "page.h"
+#include "page-widget.h"
+#include "utils.h"
+
+/* directory of the snapshots in the cache directory */
+#define SNAPSHOT_DIR "snapshots"
+/* identifies the file format; bumped whenever the layout changes */
+#define SNAPSHOT_MAGIC "ZSNAP001"
+/* snapshots are removed once the directory grows beyond this size ... */
+#define SNAPSHOT_MAX_SIZE (64 * 1024 * 1024)
+/* ... or if the document was not closed for this many seconds */
+#define SNAPSHOT_MAX_AGE (30 * 24 * 60 * 60)
+
+/**
+ * Header of a snapshot. It is followed by the key and the pages, each an entry
+ * followed by the compressed pixel data. All values are stored in host byte
+ * order.
+ */
+typedef struct snapshot_header_s {
+  char magic[8];           /**< SNAPSHOT_MAGIC */
+  guint32 key_length;      /**< Length of the key */
+  guint32 number_of_pages; /**< Number of pages */
+} snapshot_header_t;
+
+/**
+ * Entry of a page in a snapshot.
+ */
+typedef struct snapshot_page_s {
+  guint32 page;    /**< Page number */
+  guint32 format;  /**< Format of the surface */
+  guint32 width;   /**< Width of the surface in pixels */
+  guint32 height;  /**< Height of the surface in pixels */
+  guint32 stride;  /**< Stride of the surface */
+  guint32 size;    /**< Size of the compressed pixel data */
+  double device_x; /**< Horizontal device scale of the surface */
+  double device_y; /**< Vertical device scale of the surface */
+} snapshot_page_t;
+
+/* The settings the surfaces were rendered with; a snapshot rendered with other
+ * settings is not shown. */
+static char* snapshot_key(zathura_t* zathura) {
+  zathura_document_t* document          = zathura->document;
+  const zathura_device_factors_t device = zathura_document_get_device_factors(document);
+
+  bool recolor                   = false;
+  bool recolor_keephue           = false;
+  bool recolor_reverse_video     = false;
+  bool recolor_adjust_lightness  = false;
+  g_autofree char* recolor_light = NULL;
+  g_autofree char* recolor_dark  = NULL;
+  girara_setting_get(zathura->ui.session, "recolor", &recolor);
+  girara_setting_get(zathura->ui.session, "recolor-keephue", &recolor_keephue);
+  girara_setting_get(zathura->ui.session, "recolor-reverse-video", &recolor_reverse_video);
+  girara_setting_get(zathura->ui.session, "recolor-adjust-lightness", &recolor_adjust_lightness);
+  girara_setting_get(zathura->ui.session, "recolor-lightcolor", &recolor_light);
+  girara_setting_get(zathura->ui.session, "recolor-darkcolor", &recolor_dark);
+
+  if (recolor == false) {
+    return g_strdup_printf("zoom=%.6f rotation=%u scale=%.3fx%.3f", zathura_document_get_zoom(document),
+                           zathura_document_get_rotation(document), device.x, device.y);
+  }
+
+  return g_strdup_printf("zoom=%.6f rotation=%u scale=%.3fx%.3f recolor=%d%d%d light=%s dark=%s",
+                         zathura_document_get_zoom(document), zathura_document_get_rotation(document), device.x,
+                         device.y, recolor_keephue, recolor_reverse_video, recolor_adjust_lightness, recolor_light,
+                         recolor_dark);
+}
+
+static char* snapshot_path(zathura_t* zathura) {
+  bool snapshot_cache = true;
+  girara_setting_get(zathura->ui.session, "snapshot-cache", &snapshot_cache);
+  if (snapshot_cache == false || zathura->config.cache_dir == NULL) {
+    return NULL;
+  }
+
+  g_autofree char* name = document_cache_name(zathura->document);
+  return g_build_filename(zathura->config.cache_dir, SNAPSHOT_DIR, name, NULL);
+}
+
+/* Append the compressed data to the array. Speed matters more than size here,
+ * so the lowest compression level is used. */
+static bool snapshot_compress(GByteArray* output, const guint8* data, gsize length) {
+  g_autoptr(GZlibCompressor) compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_RAW, 1);
+  const guint start                     = output->len;
+  /* rendered pages are mostly background, so they shrink considerably */
+  const gsize chunk = MAX(length / 8, 4096);
+
+  gsize used              = 0;
+  GConverterResult result = G_CONVERTER_CONVERTED;
+  while (result != G_CONVERTER_FINISHED) {
+    if (start + used == output->len) {
+      g_byte_array_set_size(output, output->len + chunk);
+    }
+
+    gsize read              = 0;
+    gsize written           = 0;
+    g_autoptr(GError) error = NULL;
+    result = g_converter_convert(G_CONVERTER(compressor), data, length, output->data + start + used,
+                                 output->len - start - used, G_CONVERTER_INPUT_AT_END, &read, &written, &error);
+    if (result == G_CONVERTER_ERROR) {
+      if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_NO_SPACE) == TRUE) {
+        g_byte_array_set_size(output, output->len + chunk);
+        continue;
+      }
+
+      g_byte_array_set_size(output, start);
+      return false;
+    }
+
+    data += read;
+    length -= read;
+    used += written;
+  }
+
+  g_byte_array_set_size(output, start + used);
+  return true;
+}
+
+static bool snapshot_decompress(const guint8* data, gsize length, guint8* output, gsize output_length) {
+  g_autoptr(GZlibDecompressor) decompressor = g_zlib_decompressor_new(G_ZLIB_COMPRESSOR_FORMAT_RAW);
+
+  gsize used              = 0;
+  GConverterResult result = G_CONVERTER_CONVERTED;
+  while (result != G_CONVERTER_FINISHED) {
+    gsize read    = 0;
+    gsize written = 0;
+    result = g_converter_convert(G_CONVERTER(decompressor), data, length, output + used, output_length - used,
+                                 G_CONVERTER_INPUT_AT_END, &read, &written, NULL);
+    if (result == G_CONVERTER_ERROR) {
+      return false;
+    }
+
+    data += read;
+    length -= read;
+    used += written;
+  }
+
+  return used == output_length;
+}
+
+/**
+ * A rendered page of a snapshot.
+ */
+typedef struct snapshot_surface_s {
+  unsigned int page;
+  cairo_surface_t* surface;
+} snapshot_surface_t;
+
+static void snapshot_surface_free(void* data) {
+  snapshot_surface_t* surface = data;
+  cairo_surface_destroy(surface->surface);
+  g_free(surface);
+}
+
+/**
+ * Snapshot to be written or read by a worker thread. It does not refer to the
+ * document.
+ */
+typedef struct snapshot_job_s {
+  char* path;
+  char* key;
+  unsigned int number_of_pages; /**< Number of pages of the document */
+  GPtrArray* surfaces;          /**< snapshot_surface_t */
+} snapshot_job_t;
+
+static void snapshot_job_free(void* data) {
+  snapshot_job_t* job = data;
+  g_free(job->path);
+  g_free(job->key);
+  g_ptr_array_unref(job->surfaces);
+  g_free(job);
+}
+
+static snapshot_job_t* snapshot_job_new(zathura_t* zathura) {
+  char* path = snapshot_path(zathura);
+  if (path == NULL) {
+    return NULL;
+  }
+
+  snapshot_job_t* job  = g_new0(snapshot_job_t, 1);
+  job->path            = path;
+  job->key             = snapshot_key(zathura);
+  job->number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  job->surfaces        = g_ptr_array_new_with_free_func(snapshot_surface_free);
+
+  return job;
+}
+
+static void snapshot_save_thread(GTask* UNUSED(task), gpointer UNUSED(source), gpointer data,
+                                 GCancellable* UNUSED(cancellable)) {
+  snapshot_job_t* job = data;
+
+  snapshot_header_t header = {
+      .key_length      = strlen(job->key),
+      .number_of_pages = 0,
+  };
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+
+  GByteArray* bytes = g_byte_array_new();
+  g_byte_array_append(bytes, (const guint8*)&header, sizeof(header));
+  g_byte_array_append(bytes, (const guint8*)job->key, header.key_length);
+
+  for (guint idx = 0; idx < job->surfaces->len; ++idx) {
+    const snapshot_surface_t* page = g_ptr_array_index(job->surfaces, idx);
+    cairo_surface_t* surface       = page->surface;
+
+    snapshot_page_t entry = {
+        .page   = page->page,
+        .format = cairo_image_surface_get_format(surface),
+        .width  = cairo_image_surface_get_width(surface),
+        .height = cairo_image_surface_get_height(surface),
+        .stride = cairo_image_surface_get_stride(surface),
+    };
+    cairo_surface_get_device_scale(surface, &entry.device_x, &entry.device_y);
+
+    const guint offset = bytes->len;
+    g_byte_array_append(bytes, (const guint8*)&entry, sizeof(entry));
+    if (snapshot_compress(bytes, cairo_image_surface_get_data(surface), (gsize)entry.stride * entry.height) ==
+        false) {
+      g_byte_array_set_size(bytes, offset);
+      continue;
+    }
+
+    entry.size = bytes->len - offset - sizeof(entry);
+    memcpy(bytes->data + offset, &entry, sizeof(entry));
+    ++header.number_of_pages;
+  }
+  memcpy(bytes->data, &header, sizeof(header));
+
+  if (header.number_of_pages == 0) {
+    /* an outdated snapshot must not be shown */
+    g_unlink(job->path);
+    g_byte_array_unref(bytes);
+    return;
+  }
+
+  g_autofree char* dir    = g_path_get_dirname(job->path);
+  g_autoptr(GError) error = NULL;
+  if (g_mkdir_with_parents(dir, 0700) != 0 ||
+      g_file_set_contents(job->path, (const char*)bytes->data, bytes->len, &error) == FALSE) {
+    girara_debug("Failed to write snapshot '%s': %s", job->path, error != NULL ? error->message : g_strerror(errno));
+  }
+  g_byte_array_unref(bytes);
+
+  cache_dir_trim(dir, SNAPSHOT_MAX_SIZE, SNAPSHOT_MAX_AGE);
+}
+
+void zathura_snapshot_save(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL && zathura->pages != NULL);
+
+  snapshot_job_t* job = snapshot_job_new(zathura);
+  if (job == NULL) {
+    return;
+  }
+
+  /* rendered surfaces are not modified anymore, so the worker thread only
+   * needs a reference */
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(zathura->document);
+  for (unsigned int page_id = 0; page_id < number_of_pages; ++page_id) {
+    zathura_page_t* page = zathura_document_get_page(zathura->document, page_id);
+    if (zathura_page_get_visibility(page) == false) {
+      continue;
+    }
+
+    cairo_surface_t* surface = zathura_page_widget_get_surface(ZATHURA_PAGE(zathura->pages[page_id]));
+    if (surface == NULL || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE) {
+      continue;
+    }
+    cairo_surface_flush(surface);
+
+    snapshot_surface_t* snapshot = g_new0(snapshot_surface_t, 1);
+    snapshot->page               = page_id;
+    snapshot->surface            = cairo_surface_reference(surface);
+    g_ptr_array_add(job->surfaces, snapshot);
+  }
+
+  g_autoptr(GTask) task = g_task_new(NULL, NULL, NULL, NULL);
+  g_task_set_task_data(task, job, snapshot_job_free);
+  g_task_run_in_thread(task, snapshot_save_thread);
+}
+
+static void snapshot_load_thread(GTask* task, gpointer UNUSED(source), gpointer data, GCancellable* cancellable) {
+  snapshot_job_t* job = data;
+
+  GMappedFile* file = g_mapped_file_new(job->path, FALSE, NULL);
+  if (file == NULL) {
+    g_task_return_boolean(task, FALSE);
+    return;
+  }
+
+  const guint8* contents = (const guint8*)g_mapped_file_get_contents(file);
+  const gsize length     = g_mapped_file_get_length(file);
+
+  snapshot_header_t header;
+  if (length < sizeof(header)) {
+    g_mapped_file_unref(file);
+    g_task_return_boolean(task, FALSE);
+    return;
+  }
+  memcpy(&header, contents, sizeof(header));
+  if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.key_length != strlen(job->key) ||
+      length - sizeof(header) < header.key_length ||
+      memcmp(contents + sizeof(header), job->key, header.key_length) != 0) {
+    girara_debug("Ignoring snapshot '%s' rendered with other settings", job->path);
+    g_mapped_file_unref(file);
+    g_task_return_boolean(task, FALSE);
+    return;
+  }
+
+  gsize offset = sizeof(header) + header.key_length;
+  for (guint32 idx = 0; idx < header.number_of_pages && g_cancellable_is_cancelled(cancellable) == FALSE; ++idx) {
+    snapshot_page_t entry;
+    if (length - offset < sizeof(entry)) {
+      break;
+    }
+    memcpy(&entry, contents + offset, sizeof(entry));
+    offset += sizeof(entry);
+    if (length - offset < entry.size) {
+      break;
+    }
+
+    const guint8* data = contents + offset;
+    offset += entry.size;
+    if (entry.page >= job->number_of_pages ||
+        (entry.format != CAIRO_FORMAT_ARGB32 && entry.format != CAIRO_FORMAT_RGB24) || entry.width == 0 ||
+        entry.height == 0 || entry.width > G_MAXINT16 || entry.height > G_MAXINT16 ||
+        entry.stride != (guint32)cairo_format_stride_for_width(entry.format, entry.width)) {
+      continue;
+    }
+
+    cairo_surface_t* surface = cairo_image_surface_create(entry.format, entry.width, entry.height);
+    if (cairo_surface_status(surface) == CAIRO_STATUS_SUCCESS &&
+        (guint32)cairo_image_surface_get_stride(surface) == entry.stride) {
+      cairo_surface_flush(surface);
+      if (snapshot_decompress(data, entry.size, cairo_image_surface_get_data(surface),
+                              (gsize)entry.stride * entry.height) == true) {
+        cairo_surface_mark_dirty(surface);
+        cairo_surface_set_device_scale(surface, entry.device_x, entry.device_y);
+
+        snapshot_surface_t* snapshot = g_new0(snapshot_surface_t, 1);
+        snapshot->page               = entry.page;
+        snapshot->surface            = cairo_surface_reference(surface);
+        g_ptr_array_add(job->surfaces, snapshot);
+      }
+    }
+    cairo_surface_destroy(surface);
+  }
+  g_mapped_file_unref(file);
+
+  g_task_return_boolean(task, TRUE);
+}
+
+static void snapshot_load_done(GObject* UNUSED(source), GAsyncResult* result, gpointer data) {
+  /* fails if the document has been closed in the meantime */
+  g_autoptr(GError) error = NULL;
+  const bool loaded       = g_task_propagate_boolean(G_TASK(result), &error) == TRUE;
+  if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED) == TRUE) {
+    return;
+  }
+
+  zathura_t* zathura = data;
+  g_clear_object(&zathura->snapshot.load);
+  if (loaded == false) {
+    return;
+  }
+
+  /* pages that were rendered in the meantime ignore the snapshot */
+  snapshot_job_t* job = g_task_get_task_data(G_TASK(result));
+  for (guint idx = 0; idx < job->surfaces->len; ++idx) {
+    const snapshot_surface_t* snapshot = g_ptr_array_index(job->surfaces, idx);
+    zathura_page_widget_set_placeholder(ZATHURA_PAGE(zathura->pages[snapshot->page]), snapshot->surface);
+  }
+
+  girara_debug("Showing snapshot of %u pages", job->surfaces->len);
+}
+
+void zathura_snapshot_load(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL && zathura->pages != NULL);
+
+  zathura_snapshot_cancel(zathura);
+
+  snapshot_job_t* job = snapshot_job_new(zathura);
+  if (job == NULL) {
+    return;
+  }
+
+  zathura->snapshot.load = g_cancellable_new();
+
+  g_autoptr(GTask) task = g_task_new(NULL, zathura->snapshot.load, snapshot_load_done, zathura);
+  g_task_set_task_data(task, job, snapshot_job_free);
+  g_task_run_in_thread(task, snapshot_load_thread);
+}
+
+void zathura_snapshot_cancel(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL);
+
+  if (zathura->snapshot.load != NULL) {
+    g_cancellable_cancel(zathura->snapshot.load);
+    g_clear_object(&zathura->snapshot.load);
+  }
+}
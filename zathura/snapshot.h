@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_SNAPSHOT_H
+#define ZATHURA_SNAPSHOT_H
+
+#include <stdbool.h>
+
+#include "zathura.h"
+
+/**
+ * Snapshots of the first screen of a document. When a document is closed, the
+ * rendered surfaces of the visible pages are compressed and stored in the
+ * cache directory by a worker thread, named after the SHA-256 of the document.
+ * When the document is opened again with the same zoom, rotation and recolor
+ * settings, the surfaces are decoded by a worker thread and shown until the
+ * pages are rendered. The least recently written snapshots are removed once
+ * the directory grows too large.
+ */
+
+/**
+ * Store the rendered surfaces of the visible pages of the current document.
+ * Has to be called before the page widgets are freed.
+ *
+ * @param zathura The zathura session
+ */
+void zathura_snapshot_save(zathura_t* zathura);
+
+/**
+ * Decode the stored surfaces of the current document in the background and
+ * show them in the page widgets until the pages are rendered. Has to be called
+ * after the zoom, rotation and recolor settings of the document are restored.
+ *
+ * @param zathura The zathura session
+ */
+void zathura_snapshot_load(zathura_t* zathura);
+
+/**
+ * Stop decoding the snapshot of the current document. Has to be called before
+ * the page widgets are freed.
+ *
+ * @param zathura The zathura session
+ */
+void zathura_snapshot_cancel(zathura_t* zathura);
+
+#endif
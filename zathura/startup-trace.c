@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <glib.h>
+#include <girara/log.h>
+#include <unistd.h>
+
+#include "startup-trace.h"
+
+static struct {
+  gint enabled;
+  GMutex lock;
+  char* path;
+  gint64 start;        /**< Monotonic time of zathura_startup_trace_init */
+  GString* events;     /**< Recorded events as comma separated JSON objects */
+  GHashTable* threads; /**< GThread -> thread id used in the trace */
+} startup_trace;
+
+void zathura_startup_trace_init(const char* path) {
+  g_return_if_fail(path != NULL);
+
+  g_mutex_lock(&startup_trace.lock);
+  if (startup_trace.events == NULL) {
+    startup_trace.path    = g_strdup(path);
+    startup_trace.start   = g_get_monotonic_time();
+    startup_trace.events  = g_string_new(NULL);
+    startup_trace.threads = g_hash_table_new(g_direct_hash, g_direct_equal);
+    g_atomic_int_set(&startup_trace.enabled, TRUE);
+  }
+  g_mutex_unlock(&startup_trace.lock);
+}
+
+bool zathura_startup_trace_enabled(void) {
+  return g_atomic_int_get(&startup_trace.enabled) == TRUE;
+}
+
+static void startup_trace_add(const char* name, const char* phase) {
+  if (zathura_startup_trace_enabled() == false) {
+    return;
+  }
+
+  const gint64 now = g_get_monotonic_time();
+
+  g_mutex_lock(&startup_trace.lock);
+  if (startup_trace.events != NULL) {
+    /* number threads in order of appearance, the main thread comes first */
+    GThread* self = g_thread_self();
+    guint tid     = GPOINTER_TO_UINT(g_hash_table_lookup(startup_trace.threads, self));
+    if (tid == 0) {
+      tid = g_hash_table_size(startup_trace.threads) + 1;
+      g_hash_table_insert(startup_trace.threads, self, GUINT_TO_POINTER(tid));
+    }
+
+    g_autofree char* escaped = g_strescape(name, NULL);
+    g_string_append_printf(startup_trace.events,
+                           "%s\n{\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"%s\",\"ts\":%" G_GINT64_FORMAT
+                           ",\"pid\":%d,\"tid\":%u%s}",
+                           startup_trace.events->len != 0 ? "," : "", escaped, phase, now - startup_trace.start,
+                           (int)getpid(), tid, g_strcmp0(phase, "i") == 0 ? ",\"s\":\"p\"" : "");
+  }
+  g_mutex_unlock(&startup_trace.lock);
+}
+
+void zathura_startup_trace_begin(const char* name) {
+  startup_trace_add(name, "B");
+}
+
+void zathura_startup_trace_end(const char* name) {
+  startup_trace_add(name, "E");
+}
+
+void zathura_startup_trace_mark(const char* name) {
+  startup_trace_add(name, "i");
+}
+
+void zathura_startup_trace_finish(void) {
+  if (zathura_startup_trace_enabled() == false) {
+    return;
+  }
+
+  g_mutex_lock(&startup_trace.lock);
+  g_atomic_int_set(&startup_trace.enabled, FALSE);
+  GString* events = g_steal_pointer(&startup_trace.events);
+  char* path      = g_steal_pointer(&startup_trace.path);
+  g_clear_pointer(&startup_trace.threads, g_hash_table_unref);
+  g_mutex_unlock(&startup_trace.lock);
+
+  if (events == NULL) {
+    return;
+  }
+
+  g_autofree char* contents = g_strdup_printf("{\"traceEvents\":[%s\n]}\n", events->str);
+  GError* error             = NULL;
+  if (g_file_set_contents(path, contents, -1, &error) == FALSE) {
+    girara_error("Failed to write startup trace to '%s': %s", path, error->message);
+    g_error_free(error);
+  } else {
+    girara_debug("Wrote startup trace to '%s'.", path);
+  }
+
+  g_string_free(events, TRUE);
+  g_free(path);
+}
@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_STARTUP_TRACE_H
+#define ZATHURA_STARTUP_TRACE_H
+
+#include <stdbool.h>
+
+/**
+ * Startup tracer. When enabled, the start and end of every startup phase is
+ * recorded with a monotonic timestamp and the events are written as a Chrome
+ * trace-event JSON file once the first page has been painted. The functions
+ * may be called from any thread and do nothing if tracing is not enabled.
+ */
+
+/**
+ * Enable tracing. Timestamps are relative to the time of this call.
+ *
+ * @param path The file the trace is written to
+ */
+void zathura_startup_trace_init(const char* path);
+
+/**
+ * Check if tracing is enabled.
+ *
+ * @return true if events are recorded
+ */
+bool zathura_startup_trace_enabled(void);
+
+/**
+ * Record the start of a phase.
+ *
+ * @param name The name of the phase
+ */
+void zathura_startup_trace_begin(const char* name);
+
+/**
+ * Record the end of a phase.
+ *
+ * @param name The name of the phase
+ */
+void zathura_startup_trace_end(const char* name);
+
+/**
+ * Record a point in time, e.g. the first paint.
+ *
+ * @param name The name of the event
+ */
+void zathura_startup_trace_mark(const char* name);
+
+/**
+ * Write the recorded events and disable tracing.
+ */
+void zathura_startup_trace_finish(void);
+
+#endif
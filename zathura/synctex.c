@@ -1,6 +1,9 @@
 /* SPDX-License-Identifier: Zlib */
 
 #include <glib.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <string.h>
 #include <girara/utils.h>
 #include <girara/settings.h>
 
@@ -18,19 +21,103 @@
 #include "adjustment.h"
 
 #ifdef WITH_SYNCTEX
-// Create scanner from given PDF file name.
-// Returns zathura->synctex.scanner. (May be NULL on error.)
-static synctex_scanner_p synctex_make_scanner(zathura_t* zathura, const char* pdf_filename) {
-  if (zathura->synctex.scanner) {
-    return zathura->synctex.scanner;
+/* number of recent lookups kept per document */
+#define SYNCTEX_CACHE_SIZE 16
+/* time in milliseconds between the last change of the SyncTeX file and
+ * parsing it again */
+#define SYNCTEX_RELOAD_DELAY 200
+
+/**
+ * Result of a lookup. Backward searches fill in the input file, line and
+ * column, forward searches the page and the rectangles. Lookups without a
+ * result are cached as well.
+ */
+typedef struct synctex_result_s {
+  char* key;                      /**< Query the result belongs to */
+  bool found;                     /**< Whether a backward search found a position */
+  char* input_file;               /**< Input file */
+  unsigned int line;              /**< Line in the input file */
+  unsigned int column;            /**< Column in the input file */
+  unsigned int page;              /**< Page of the rectangles */
+  girara_list_t* rectangles;      /**< Rectangles on the page */
+  girara_list_t* secondary_rects; /**< Rectangles on other pages */
+} synctex_result_t;
+
+struct zathura_synctex_s {
+  gint refs;                 /**< Reference count */
+  char* filename;            /**< Path of the document */
+  GMutex lock;               /**< Lock for the scanner and the cache */
+  GCond loaded;              /**< Signaled once the loader is done */
+  bool loading;              /**< Whether the loader is still parsing */
+  synctex_scanner_p scanner; /**< The parsed SyncTeX file, or NULL */
+  GStatBuf info;             /**< State of the SyncTeX file when it was parsed */
+  GQueue cache;              /**< Recent results, most recent first */
+
+  GFileMonitor* monitors[2]; /**< Watch the .synctex.gz and .synctex files; main thread only */
+  guint reload;              /**< Source starting the loader after a change; main thread only */
+};
+
+static void synctex_result_free(void* data) {
+  synctex_result_t* result = data;
+  if (result == NULL) {
+    return;
+  }
+
+  g_free(result->key);
+  g_free(result->input_file);
+  girara_list_free(result->rectangles);
+  girara_list_free(result->secondary_rects);
+  g_free(result);
+}
+
+static girara_list_t* synctex_copy_list(girara_list_t* list, size_t size) {
+  if (list == NULL) {
+    return NULL;
+  }
+
+  girara_list_t* copy = girara_list_new_with_free(g_free);
+  for (size_t idx = 0; idx != girara_list_size(list); ++idx) {
+    girara_list_append(copy, g_memdup2(girara_list_nth(list, idx), size));
   }
 
-  synctex_scanner_p scanner = synctex_scanner_new_with_output_file(pdf_filename, NULL, 1);
+  return copy;
+}
+
+static synctex_result_t* synctex_cache_lookup(zathura_synctex_t* synctex, const char* key) {
+  for (GList* link = synctex->cache.head; link != NULL; link = link->next) {
+    synctex_result_t* result = link->data;
+    if (g_strcmp0(result->key, key) == 0) {
+      g_queue_unlink(&synctex->cache, link);
+      g_queue_push_head_link(&synctex->cache, link);
+      return result;
+    }
+  }
+
+  return NULL;
+}
+
+static void synctex_cache_insert(zathura_synctex_t* synctex, synctex_result_t* result) {
+  g_queue_push_head(&synctex->cache, result);
+  while (g_queue_get_length(&synctex->cache) > SYNCTEX_CACHE_SIZE) {
+    synctex_result_free(g_queue_pop_tail(&synctex->cache));
+  }
+}
+
+// Create and parse scanner from given PDF file name. The state of the SyncTeX
+// file is recorded before parsing, so that a file rewritten in the meantime is
+// parsed again on the next lookup.
+static synctex_scanner_p synctex_load_scanner(const char* pdf_filename, GStatBuf* info) {
+  synctex_scanner_p scanner = synctex_scanner_new_with_output_file(pdf_filename, NULL, 0);
   if (scanner == NULL) {
     girara_debug("Failed to create synctex scanner.");
     return NULL;
   }
 
+  const char* path = synctex_scanner_get_synctex(scanner);
+  if (path == NULL || g_stat(path, info) != 0) {
+    memset(info, 0, sizeof(*info));
+  }
+
   synctex_scanner_p temp = synctex_scanner_parse(scanner);
   if (temp == NULL) {
     girara_debug("Failed to parse synctex file.");
@@ -38,39 +125,303 @@ static synctex_scanner_p synctex_make_scanner(zathura_t* zathura, const char* pd
     return NULL;
   }
 
-  zathura->synctex.scanner = scanner;
   return scanner;
 }
 
+/* Parse the SyncTeX file in the background and replace the scanner. The
+ * thread holds a reference, so the context can be released while it runs. */
+static gpointer synctex_loader(gpointer data) {
+  zathura_synctex_t* synctex = data;
+
+  GStatBuf info;
+  synctex_scanner_p scanner = synctex_load_scanner(synctex->filename, &info);
+
+  g_mutex_lock(&synctex->lock);
+  if (synctex->scanner != NULL) {
+    synctex_scanner_free(synctex->scanner);
+  }
+  g_queue_clear_full(&synctex->cache, synctex_result_free);
+  synctex->scanner = scanner;
+  synctex->info    = info;
+  synctex->loading = false;
+  g_cond_broadcast(&synctex->loaded);
+  g_mutex_unlock(&synctex->lock);
+
+  synctex_context_unref(synctex);
+  return NULL;
+}
+
+/* Whether the parsed SyncTeX file is still current. Has to be called with the
+ * lock held. */
+static bool synctex_scanner_is_current(zathura_synctex_t* synctex) {
+  if (synctex->scanner == NULL) {
+    return false;
+  }
+
+  GStatBuf info;
+  const char* path = synctex_scanner_get_synctex(synctex->scanner);
+  return path != NULL && g_stat(path, &info) == 0 && info.st_ino == synctex->info.st_ino &&
+         info.st_size == synctex->info.st_size && info.st_mtim.tv_sec == synctex->info.st_mtim.tv_sec &&
+         info.st_mtim.tv_nsec == synctex->info.st_mtim.tv_nsec;
+}
+
+/* Has to be called with the lock held. */
+static void synctex_start_loader(zathura_synctex_t* synctex) {
+  synctex->loading = true;
+  g_atomic_int_inc(&synctex->refs);
+  g_thread_unref(g_thread_new("synctex-loader", synctex_loader, synctex));
+}
+
+static gboolean synctex_reload(gpointer data) {
+  zathura_synctex_t* synctex = data;
+
+  g_mutex_lock(&synctex->lock);
+  if (synctex->loading == true) {
+    /* try again once the running parse is done */
+    g_mutex_unlock(&synctex->lock);
+    return G_SOURCE_CONTINUE;
+  }
+
+  /* a lookup may already have parsed the new file */
+  if (synctex_scanner_is_current(synctex) == false) {
+    girara_debug("SyncTeX file of '%s' changed, parsing it again.", synctex->filename);
+    synctex_start_loader(synctex);
+  }
+  g_mutex_unlock(&synctex->lock);
+
+  synctex->reload = 0;
+  return G_SOURCE_REMOVE;
+}
+
+static void cb_synctex_file_changed(GFileMonitor* UNUSED(monitor), GFile* UNUSED(file), GFile* UNUSED(other_file),
+                                    GFileMonitorEvent event, gpointer data) {
+  if (event != G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT && event != G_FILE_MONITOR_EVENT_CREATED) {
+    return;
+  }
+
+  /* wait until the file has been written completely */
+  zathura_synctex_t* synctex = data;
+  if (synctex->reload != 0) {
+    g_source_remove(synctex->reload);
+  }
+  synctex->reload = g_timeout_add(SYNCTEX_RELOAD_DELAY, synctex_reload, synctex);
+}
+
+/* Watch the SyncTeX files next to the document, so that a rebuild is parsed
+ * in the background before the next lookup. */
+static void synctex_watch(zathura_synctex_t* synctex) {
+  static const char* const extensions[] = {".synctex.gz", ".synctex"};
+
+  const char* extension = strrchr(synctex->filename, '.');
+  const char* separator = strrchr(synctex->filename, G_DIR_SEPARATOR);
+  const size_t length =
+      extension != NULL && (separator == NULL || extension > separator) ? (size_t)(extension - synctex->filename)
+                                                                        : strlen(synctex->filename);
+
+  for (size_t idx = 0; idx != G_N_ELEMENTS(extensions); ++idx) {
+    g_autofree char* path = g_strdup_printf("%.*s%s", (int)length, synctex->filename, extensions[idx]);
+    g_autoptr(GFile) file = g_file_new_for_path(path);
+    synctex->monitors[idx] = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+    if (synctex->monitors[idx] != NULL) {
+      g_signal_connect(synctex->monitors[idx], "changed", G_CALLBACK(cb_synctex_file_changed), synctex);
+    }
+  }
+}
+
+static zathura_synctex_t* synctex_new(const char* filename) {
+  zathura_synctex_t* synctex = g_new0(zathura_synctex_t, 1);
+  synctex->refs              = 1;
+  synctex->filename          = g_strdup(filename);
+  g_mutex_init(&synctex->lock);
+  g_cond_init(&synctex->loaded);
+  g_queue_init(&synctex->cache);
+
+  return synctex;
+}
+
+// Waits for the loader unless the wait is cancelled. Has to be called with the
+// lock held.
+static bool synctex_wait_loader(zathura_synctex_t* synctex, GCancellable* cancellable) {
+  while (synctex->loading == true) {
+    if (g_cancellable_is_cancelled(cancellable) == TRUE) {
+      return false;
+    }
+    g_cond_wait(&synctex->loaded, &synctex->lock);
+  }
+
+  return true;
+}
+
+static void synctex_cancel_wait(GCancellable* UNUSED(cancellable), gpointer data) {
+  zathura_synctex_t* synctex = data;
+
+  g_mutex_lock(&synctex->lock);
+  g_cond_broadcast(&synctex->loaded);
+  g_mutex_unlock(&synctex->lock);
+}
+
+// Returns the scanner of the document, or of the given PDF file if it is not
+// NULL. Waits for the loader and, if the SyncTeX file changed since it was
+// parsed and the monitor has not caught up yet, runs the loader again. The
+// lock is released while waiting. Has to be called with the lock held. (May be
+// NULL on error or if the wait was cancelled.)
+static synctex_scanner_p synctex_get_scanner(zathura_synctex_t* synctex, const char* pdf_filename,
+                                             GCancellable* cancellable) {
+  if (synctex_wait_loader(synctex, cancellable) == false) {
+    return NULL;
+  }
+
+  if (pdf_filename != NULL && g_strcmp0(synctex->filename, pdf_filename) != 0) {
+    g_free(synctex->filename);
+    synctex->filename = g_strdup(pdf_filename);
+  } else if (synctex_scanner_is_current(synctex) == true) {
+    return synctex->scanner;
+  }
+
+  synctex_start_loader(synctex);
+  if (synctex_wait_loader(synctex, cancellable) == false) {
+    return NULL;
+  }
+
+  return synctex->scanner;
+}
+
+static zathura_synctex_t* synctex_get_context(zathura_t* zathura, const char* filename) {
+  if (zathura->synctex == NULL) {
+    zathura->synctex = synctex_new(filename);
+  }
+
+  return zathura->synctex;
+}
+
+zathura_synctex_t* synctex_context_ref(zathura_t* zathura) {
+  g_return_val_if_fail(zathura != NULL, NULL);
+
+  zathura_document_t* document = zathura_get_document(zathura);
+  if (document == NULL || zathura_document_get_path(document) == NULL) {
+    return NULL;
+  }
+
+  zathura_synctex_t* synctex = synctex_get_context(zathura, zathura_document_get_path(document));
+  g_atomic_int_inc(&synctex->refs);
+  return synctex;
+}
+
+void synctex_context_unref(zathura_synctex_t* synctex) {
+  if (synctex == NULL || g_atomic_int_dec_and_test(&synctex->refs) == FALSE) {
+    return;
+  }
+
+  if (synctex->scanner != NULL) {
+    synctex_scanner_free(synctex->scanner);
+  }
+  g_queue_clear_full(&synctex->cache, synctex_result_free);
+  g_cond_clear(&synctex->loaded);
+  g_mutex_clear(&synctex->lock);
+  g_free(synctex->filename);
+  g_free(synctex);
+}
+
+void synctex_preload(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL);
+
+  const char* filename = zathura_document_get_path(zathura->document);
+  if (filename == NULL) {
+    return;
+  }
+
+  synctex_free(zathura);
+  zathura->synctex = synctex_new(filename);
+
+  bool synctex = true;
+  girara_setting_get(zathura->ui.session, "synctex", &synctex);
+  if (synctex == false) {
+    return;
+  }
+
+  g_mutex_lock(&zathura->synctex->lock);
+  synctex_start_loader(zathura->synctex);
+  g_mutex_unlock(&zathura->synctex->lock);
+
+  synctex_watch(zathura->synctex);
+}
+
+void synctex_free(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL);
+
+  zathura_synctex_t* synctex = zathura->synctex;
+  if (synctex == NULL) {
+    return;
+  }
+
+  for (size_t idx = 0; idx != G_N_ELEMENTS(synctex->monitors); ++idx) {
+    if (synctex->monitors[idx] != NULL) {
+      g_signal_handlers_disconnect_by_data(synctex->monitors[idx], synctex);
+      g_file_monitor_cancel(synctex->monitors[idx]);
+      g_clear_object(&synctex->monitors[idx]);
+    }
+  }
+  if (synctex->reload != 0) {
+    g_source_remove(synctex->reload);
+    synctex->reload = 0;
+  }
+
+  /* the loader and lookups running on other threads keep their reference */
+  zathura->synctex = NULL;
+  synctex_context_unref(synctex);
+}
+
+static void synctex_edit_query_result(synctex_scanner_p scanner, unsigned int page, int x, int y,
+                                      synctex_result_t* result) {
+  if (synctex_edit_query(scanner, page + 1u, x, y) > 0) {
+    /* Assume that a backward search returns at most one result. */
+    synctex_node_p node = synctex_scanner_next_result(scanner);
+    if (node != NULL) {
+      result->input_file = g_strdup(synctex_scanner_get_name(scanner, synctex_node_tag(node)));
+      result->line       = synctex_node_line(node);
+      result->column     = synctex_node_column(node);
+      result->found      = true;
+    }
+  }
+}
+
 bool synctex_get_input_line_column(zathura_t* zathura, const char* filename, unsigned int page, int x, int y,
                                    char** input_file, unsigned int* line, unsigned int* column) {
   if (filename == NULL) {
     return false;
   }
 
-  synctex_scanner_p scanner = synctex_make_scanner(zathura, filename);
+  zathura_synctex_t* synctex = synctex_get_context(zathura, filename);
+
+  g_mutex_lock(&synctex->lock);
+  synctex_scanner_p scanner = synctex_get_scanner(synctex, filename, NULL);
   if (!scanner) {
+    g_mutex_unlock(&synctex->lock);
     return false;
   }
 
-  bool ret = false;
-  if (synctex_edit_query(scanner, page + 1u, x, y) > 0) {
-    /* Assume that a backward search returns at most one result. */
-    synctex_node_p node = synctex_scanner_next_result(scanner);
-    if (node != NULL) {
-      if (input_file != NULL) {
-        *input_file = g_strdup(synctex_scanner_get_name(scanner, synctex_node_tag(node)));
-      }
-      if (line != NULL) {
-        *line = synctex_node_line(node);
-      }
-      if (column != NULL) {
-        *column = synctex_node_column(node);
-      }
+  g_autofree char* key     = g_strdup_printf("edit:%u:%d:%d", page, x, y);
+  synctex_result_t* result = synctex_cache_lookup(synctex, key);
+  if (result == NULL) {
+    result      = g_new0(synctex_result_t, 1);
+    result->key = g_steal_pointer(&key);
+    synctex_edit_query_result(scanner, page, x, y, result);
+    synctex_cache_insert(synctex, result);
+  }
 
-      ret = true;
+  const bool ret = result->found;
+  if (ret == true) {
+    if (input_file != NULL) {
+      *input_file = g_strdup(result->input_file);
+    }
+    if (line != NULL) {
+      *line = result->line;
+    }
+    if (column != NULL) {
+      *column = result->column;
     }
   }
+  g_mutex_unlock(&synctex->lock);
 
   return ret;
 }
@@ -134,24 +485,10 @@ void synctex_edit(zathura_t* zathura, const char* editor, zathura_page_t* page,
   }
 }
 
-girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char* filename, const char* input_file,
-                                                int line, int column, unsigned int* page,
-                                                girara_list_t** secondary_rects) {
-  if (filename == NULL || input_file == NULL || page == NULL) {
-    return NULL;
-  }
-
-  /* We use indexes starting at 0 but SyncTeX uses 1 */
-  ++line;
-  ++column;
-
-  synctex_scanner_p scanner = synctex_make_scanner(zathura, filename);
-  if (!scanner) {
-    return NULL;
-  }
-
-  g_autoptr(girara_list_t) hitlist     = girara_list_new_with_free(g_free);
-  g_autoptr(girara_list_t) other_rects = girara_list_new_with_free(g_free);
+static void synctex_display_query_result(synctex_scanner_p scanner, const char* input_file, int line, int column,
+                                         synctex_result_t* result) {
+  g_autoptr(girara_list_t) hitlist = girara_list_new_with_free(g_free);
+  girara_list_t* other_rects       = girara_list_new_with_free(g_free);
 
   if (synctex_display_query(scanner, input_file, line, column, -1) > 0) {
     synctex_node_p node = NULL;
@@ -160,8 +497,8 @@ girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char*
     while ((node = synctex_scanner_next_result(scanner)) != NULL) {
       const unsigned int current_page = synctex_node_page(node) - 1;
       if (got_page == false) {
-        got_page = true;
-        *page    = current_page;
+        got_page     = true;
+        result->page = current_page;
       }
 
       zathura_rectangle_t rect = {0, 0, 0, 0};
@@ -170,7 +507,7 @@ girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char*
       rect.x2                  = rect.x1 + synctex_node_box_visible_width(node);
       rect.y2                  = synctex_node_box_visible_depth(node) + synctex_node_box_visible_height(node) + rect.y1;
 
-      if (*page == current_page) {
+      if (result->page == current_page) {
         zathura_rectangle_t* real_rect = g_try_malloc(sizeof(zathura_rectangle_t));
         if (real_rect == NULL) {
           continue;
@@ -192,12 +529,73 @@ girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char*
     }
   }
 
-  if (secondary_rects != NULL) {
-    *secondary_rects = other_rects;
-    other_rects      = NULL;
+  result->rectangles      = flatten_rectangles(hitlist);
+  result->secondary_rects = other_rects;
+}
+
+static girara_list_t* synctex_lookup_rectangles(zathura_synctex_t* synctex, const char* filename,
+                                                const char* input_file, int line, int column, unsigned int* page,
+                                                girara_list_t** secondary_rects, GCancellable* cancellable) {
+  /* We use indexes starting at 0 but SyncTeX uses 1 */
+  ++line;
+  ++column;
+
+  /* wake up the wait for the loader when cancelled; connected without the
+   * lock held since the handler runs right away if already cancelled */
+  const gulong handler =
+      cancellable != NULL ? g_cancellable_connect(cancellable, G_CALLBACK(synctex_cancel_wait), synctex, NULL) : 0;
+
+  g_mutex_lock(&synctex->lock);
+  synctex_scanner_p scanner = synctex_get_scanner(synctex, filename, cancellable);
+  if (!scanner) {
+    g_mutex_unlock(&synctex->lock);
+    g_cancellable_disconnect(cancellable, handler);
+    return NULL;
+  }
+
+  g_autofree char* key     = g_strdup_printf("view:%d:%d:%s", line, column, input_file);
+  synctex_result_t* result = synctex_cache_lookup(synctex, key);
+  if (result == NULL) {
+    result      = g_new0(synctex_result_t, 1);
+    result->key = g_steal_pointer(&key);
+    synctex_display_query_result(scanner, input_file, line, column, result);
+    synctex_cache_insert(synctex, result);
+  }
+
+  /* without hits there is nothing to show */
+  girara_list_t* rectangles = NULL;
+  if (girara_list_size(result->rectangles) > 0) {
+    *page      = result->page;
+    rectangles = synctex_copy_list(result->rectangles, sizeof(zathura_rectangle_t));
+    if (secondary_rects != NULL) {
+      *secondary_rects = synctex_copy_list(result->secondary_rects, sizeof(synctex_page_rect_t));
+    }
   }
+  g_mutex_unlock(&synctex->lock);
+  g_cancellable_disconnect(cancellable, handler);
 
-  return flatten_rectangles(hitlist);
+  return rectangles;
+}
+
+girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char* filename, const char* input_file,
+                                                int line, int column, unsigned int* page,
+                                                girara_list_t** secondary_rects) {
+  if (filename == NULL || input_file == NULL || page == NULL) {
+    return NULL;
+  }
+
+  return synctex_lookup_rectangles(synctex_get_context(zathura, filename), filename, input_file, line, column, page,
+                                   secondary_rects, NULL);
+}
+
+girara_list_t* synctex_context_rectangles_from_position(zathura_synctex_t* synctex, const char* input_file, int line,
+                                                        int column, unsigned int* page, girara_list_t** secondary_rects,
+                                                        GCancellable* cancellable) {
+  if (synctex == NULL || input_file == NULL || page == NULL) {
+    return NULL;
+  }
+
+  return synctex_lookup_rectangles(synctex, NULL, input_file, line, column, page, secondary_rects, cancellable);
 }
 #else
 bool synctex_get_input_line_column(zathura_t* UNUSED(zathura), const char* UNUSED(filename), unsigned int UNUSED(page),
@@ -214,6 +612,24 @@ girara_list_t* synctex_rectangles_from_position(zathura_t* UNUSED(zathura), cons
                                                 unsigned int* UNUSED(page), girara_list_t** UNUSED(secondary_rects)) {
   return NULL;
 }
+
+void synctex_preload(zathura_t* UNUSED(zathura)) {}
+
+void synctex_free(zathura_t* UNUSED(zathura)) {}
+
+zathura_synctex_t* synctex_context_ref(zathura_t* UNUSED(zathura)) {
+  return NULL;
+}
+
+void synctex_context_unref(zathura_synctex_t* UNUSED(synctex)) {}
+
+girara_list_t* synctex_context_rectangles_from_position(zathura_synctex_t* UNUSED(synctex),
+                                                        const char* UNUSED(input_file), int UNUSED(line),
+                                                        int UNUSED(column), unsigned int* UNUSED(page),
+                                                        girara_list_t** UNUSED(secondary_rects),
+                                                        GCancellable* UNUSED(cancellable)) {
+  return NULL;
+}
 #endif
 
 bool synctex_parse_input(const char* synctex, char** input_file, int* line, int* column) {
@@ -324,20 +740,12 @@ static void dup_and_append_rect(void* data, void* userdata) {
   }
 }
 
-bool synctex_view(zathura_t* zathura, const char* input_file, unsigned int line, unsigned int column) {
-  if (zathura == NULL || input_file == NULL) {
-    return false;
-  }
-
+bool synctex_show_rectangles(zathura_t* zathura, unsigned int page, girara_list_t* rectangles,
+                             girara_list_t* secondary_rects) {
   zathura_document_t* document       = zathura_get_document(zathura);
   const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
-
-  unsigned int page                        = 0;
-  g_autoptr(girara_list_t) secondary_rects = NULL;
-  girara_list_t* rectangles = synctex_rectangles_from_position(zathura, zathura_document_get_path(document), input_file,
-                                                               line, column, &page, &secondary_rects);
-
-  if (rectangles == NULL) {
+  if (page >= number_of_pages) {
+    girara_list_free(rectangles);
     return false;
   }
 
@@ -363,3 +771,22 @@ bool synctex_view(zathura_t* zathura, const char* input_file, unsigned int line,
 
   return true;
 }
+
+bool synctex_view(zathura_t* zathura, const char* input_file, unsigned int line, unsigned int column) {
+  if (zathura == NULL || input_file == NULL) {
+    return false;
+  }
+
+  zathura_document_t* document = zathura_get_document(zathura);
+
+  unsigned int page                        = 0;
+  g_autoptr(girara_list_t) secondary_rects = NULL;
+  girara_list_t* rectangles = synctex_rectangles_from_position(zathura, zathura_document_get_path(document), input_file,
+                                                               line, column, &page, &secondary_rects);
+
+  if (rectangles == NULL) {
+    return false;
+  }
+
+  return synctex_show_rectangles(zathura, page, rectangles, secondary_rects);
+}
@@ -3,8 +3,15 @@
 #ifndef SYNCTEX_H
 #define SYNCTEX_H
 
+#include <gio/gio.h>
+
 #include "types.h"
 
+/**
+ * SyncTeX context of a document: the parsed SyncTeX file and recent lookups.
+ */
+typedef struct zathura_synctex_s zathura_synctex_t;
+
 typedef struct synctex_page_rect_s {
   int page;
   zathura_rectangle_t rect;
@@ -13,6 +20,60 @@ typedef struct synctex_page_rect_s {
 bool synctex_get_input_line_column(zathura_t* zathura, const char* filename, unsigned int page, int x, int y, char** input_file,
                                    unsigned int* line, unsigned int* column);
 
+/**
+ * Parse the SyncTeX file of the open document on a background thread, unless
+ * SyncTeX support is disabled. Lookups wait for the parser instead of parsing
+ * the file again.
+ *
+ * @param zathura The zathura session
+ */
+void synctex_preload(zathura_t* zathura);
+
+/**
+ * Release the SyncTeX context of the document and stop watching the SyncTeX
+ * file. Does not wait for a running parser; it releases the context once it
+ * is done.
+ *
+ * @param zathura The zathura session
+ */
+void synctex_free(zathura_t* zathura);
+
+/**
+ * Get a reference to the SyncTeX context of the open document, i.e. the
+ * parsed SyncTeX file and the cached lookups. The context stays valid after
+ * the document is closed; lookups with it are thread safe.
+ *
+ * @param zathura The zathura session
+ * @return the context, or NULL if no document is open
+ */
+zathura_synctex_t* synctex_context_ref(zathura_t* zathura);
+
+/**
+ * Release a reference to a SyncTeX context.
+ *
+ * @param synctex The context
+ */
+void synctex_context_unref(zathura_synctex_t* synctex);
+
+/**
+ * Forward search with a SyncTeX context, see
+ * synctex_rectangles_from_position. Can be called from any thread.
+ *
+ * @param synctex The context
+ * @param input_file The input file
+ * @param line Line in the input file (starts at 0)
+ * @param column Column in the input file (starts at 0)
+ * @param page Set to the page of the rectangles
+ * @param secondary_rects Set to the rectangles on other pages, can be NULL
+ * @param cancellable Stops waiting for the SyncTeX file to be parsed, can be
+ *   NULL
+ * @return the rectangles on the page, or NULL if there are no hits, on error
+ *   or if cancelled
+ */
+girara_list_t* synctex_context_rectangles_from_position(zathura_synctex_t* synctex, const char* input_file, int line,
+                                                        int column, unsigned int* page, girara_list_t** secondary_rects,
+                                                        GCancellable* cancellable);
+
 void synctex_edit(zathura_t* zathura, const char* editor, zathura_page_t* page, int x, int y);
 
 bool synctex_parse_input(const char* synctex, char** input_file, int* line, int* column);
@@ -22,6 +83,18 @@ girara_list_t* synctex_rectangles_from_position(zathura_t* zathura, const char*
 
 void synctex_highlight_rects(zathura_t* zathura, unsigned int page, girara_list_t** rectangles);
 
+/**
+ * Highlight the rectangles of a forward search and move to the first one.
+ *
+ * @param zathura The zathura session
+ * @param page The page of the rectangles
+ * @param rectangles The rectangles on the page; ownership is taken
+ * @param secondary_rects The rectangles on other pages, can be NULL
+ * @return false if the page does not exist
+ */
+bool synctex_show_rectangles(zathura_t* zathura, unsigned int page, girara_list_t* rectangles,
+                             girara_list_t* secondary_rects);
+
 bool synctex_view(zathura_t* zathura, const char* input_file, unsigned int line, unsigned int column);
 
 #endif
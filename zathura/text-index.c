@@ -0,0 +1,467 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <girara/datastructures.h>
+#include <girara/utils.h>
+#include <sys/stat.h>
+
+#include "text-index.h"
+#include "content-type.h"
+#include "document.h"
+#include "macros.h"
+#include "page.h"
+
+/* number of matches handed over to the main thread at once */
+#define TEXT_INDEX_SEARCH_BATCH 16
+
+struct zathura_text_index_s {
+  ZathuraDatabase* database;
+  zathura_plugin_manager_t* plugin_manager;
+  GCancellable* cancellable;        /**< Cancelled when the index is freed */
+  GCancellable* search_cancellable; /**< Cancellable of the running search */
+  GPtrArray* pending_files;         /**< Files of the next update */
+  zathura_text_index_progress_t progress_callback;
+  void* progress_data;
+  unsigned int checked; /**< Documents of the running update that are up to date */
+  unsigned int total;   /**< Documents of the running update */
+  unsigned int serial;  /**< Incremented for every update */
+
+  GMutex lock;
+  GCond cond;
+  bool updating; /**< An update is running; protected by lock */
+};
+
+typedef struct text_index_update_s {
+  zathura_text_index_t* index; /**< Only used on the main thread and to signal completion */
+  ZathuraDatabase* database;
+  GCancellable* cancellable;
+  GMainContext* context;
+  const zathura_plugin_manager_t* plugin_manager;
+  GPtrArray* files;
+  GHashTable* known;   /**< path -> indexed entry, removed once seen */
+  unsigned int serial; /**< Serial of the update */
+} text_index_update_t;
+
+typedef struct text_index_progress_s {
+  zathura_text_index_t* index;
+  GCancellable* cancellable;
+  unsigned int serial;
+  unsigned int checked;
+} text_index_progress_t;
+
+typedef struct text_index_search_s {
+  ZathuraDatabase* database;
+  GCancellable* cancellable;
+  GMainContext* context;
+  char* query;
+  unsigned int max;
+  zathura_text_index_results_t callback;
+  void* data;
+  GPtrArray* matches; /**< Matches not yet handed over to the main thread */
+  unsigned int found; /**< Number of matches found so far */
+} text_index_search_t;
+
+typedef struct text_index_results_s {
+  GCancellable* cancellable;
+  zathura_text_index_results_t callback;
+  void* data;
+  GPtrArray* matches;
+  bool finished;
+} text_index_results_t;
+
+static void catalog_entry_free(void* p) {
+  zathura_catalog_entry_t* entry = p;
+  zathura_catalog_entry_free(entry);
+}
+
+static void text_index_match_free(void* p) {
+  zathura_text_index_match_t* match = p;
+  g_free(match->file);
+  g_free(match->snippet);
+  g_free(match);
+}
+
+zathura_text_index_t* zathura_text_index_new(ZathuraDatabase* database, zathura_plugin_manager_t* plugin_manager) {
+  g_return_val_if_fail(database != NULL && plugin_manager != NULL, NULL);
+
+  /* the database has no text index if it cannot list the indexed documents */
+  g_autoptr(girara_list_t) indexed = zathura_db_load_text_index(database);
+  if (indexed == NULL) {
+    return NULL;
+  }
+
+  zathura_text_index_t* index = g_try_malloc0(sizeof(zathura_text_index_t));
+  if (index == NULL) {
+    return NULL;
+  }
+
+  index->database       = g_object_ref(database);
+  index->plugin_manager = plugin_manager;
+  index->cancellable    = g_cancellable_new();
+  g_mutex_init(&index->lock);
+  g_cond_init(&index->cond);
+
+  return index;
+}
+
+void zathura_text_index_free(zathura_text_index_t* index) {
+  if (index == NULL) {
+    return;
+  }
+
+  zathura_text_index_cancel_search(index);
+  g_cancellable_cancel(index->cancellable);
+
+  /* the update thread uses the plugins; wait until it stopped */
+  g_mutex_lock(&index->lock);
+  while (index->updating == true) {
+    g_cond_wait(&index->cond, &index->lock);
+  }
+  g_mutex_unlock(&index->lock);
+
+  g_mutex_clear(&index->lock);
+  g_cond_clear(&index->cond);
+  g_object_unref(index->cancellable);
+  if (index->pending_files != NULL) {
+    g_ptr_array_unref(index->pending_files);
+  }
+  g_object_unref(index->database);
+  g_free(index);
+}
+
+void zathura_text_index_set_progress_callback(zathura_text_index_t* index, zathura_text_index_progress_t callback,
+                                              void* data) {
+  g_return_if_fail(index != NULL);
+
+  index->progress_callback = callback;
+  index->progress_data     = data;
+}
+
+bool zathura_text_index_get_progress(zathura_text_index_t* index, unsigned int* checked, unsigned int* total) {
+  g_return_val_if_fail(index != NULL, false);
+
+  if (checked != NULL) {
+    *checked = index->checked;
+  }
+  if (total != NULL) {
+    *total = index->total;
+  }
+
+  return index->checked < index->total;
+}
+
+static void text_index_progress_free(void* data) {
+  text_index_progress_t* progress = data;
+  g_object_unref(progress->cancellable);
+  g_free(progress);
+}
+
+static gboolean text_index_progress_apply(void* data) {
+  text_index_progress_t* progress = data;
+  /* progress of a previous update may arrive after the next one started */
+  if (g_cancellable_is_cancelled(progress->cancellable) == FALSE && progress->serial == progress->index->serial) {
+    zathura_text_index_t* index = progress->index;
+    index->checked              = progress->checked;
+    if (index->progress_callback != NULL) {
+      index->progress_callback(index->checked, index->total, index->progress_data);
+    }
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Tell the main thread how many documents are up to date. Runs on the update
+ * thread; the text itself is written to the database there. */
+static void text_index_post_progress(text_index_update_t* update, unsigned int checked) {
+  text_index_progress_t* progress = g_new0(text_index_progress_t, 1);
+  progress->index                 = update->index;
+  progress->cancellable           = g_object_ref(update->cancellable);
+  progress->serial                = update->serial;
+  progress->checked               = checked;
+
+  g_main_context_invoke_full(update->context, G_PRIORITY_DEFAULT_IDLE, text_index_progress_apply, progress,
+                             text_index_progress_free);
+}
+
+static void text_index_write(text_index_update_t* update, const zathura_catalog_entry_t* entry,
+                             girara_list_t* pages) {
+  if (zathura_db_update_text_index(update->database, entry, pages) == false) {
+    girara_debug("Failed to update the text index of '%s'.", entry->path);
+  }
+}
+
+/* Extract the text of every page. Documents that cannot be opened are
+ * indexed without pages so that they are not tried again until they
+ * change. */
+static girara_list_t* text_index_extract(const zathura_plugin_manager_t* plugin_manager,
+                                         zathura_content_type_context_t* context, const char* path,
+                                         GCancellable* cancellable) {
+  girara_list_t* pages = girara_list_new_with_free(g_free);
+
+  g_autofree char* content_type =
+      zathura_content_type_guess(context, path, zathura_plugin_manager_get_content_types(plugin_manager));
+  const zathura_plugin_t* plugin =
+      content_type != NULL ? zathura_plugin_manager_get_plugin(plugin_manager, content_type) : NULL;
+  if (plugin == NULL) {
+    return pages;
+  }
+
+  zathura_document_t* document = zathura_document_open_with_plugin(plugin, path, NULL, NULL, NULL);
+  if (document == NULL) {
+    return pages;
+  }
+
+  const unsigned int number_of_pages = zathura_document_get_number_of_pages(document);
+  for (unsigned int page_id = 0; page_id < number_of_pages; ++page_id) {
+    if (g_cancellable_is_cancelled(cancellable) == TRUE) {
+      break;
+    }
+
+    zathura_page_t* page                = zathura_document_get_page(document, page_id);
+    const zathura_rectangle_t rectangle = {
+        .x1 = 0,
+        .y1 = 0,
+        .x2 = zathura_page_get_width(page),
+        .y2 = zathura_page_get_height(page),
+    };
+    char* text = zathura_page_get_text(page, rectangle, NULL);
+    girara_list_append(pages, text != NULL ? text : g_strdup(""));
+  }
+
+  zathura_document_free(document);
+  return pages;
+}
+
+static void text_index_update_thread(GTask* task, gpointer UNUSED(source), gpointer data,
+                                     GCancellable* cancellable) {
+  text_index_update_t* update             = data;
+  zathura_content_type_context_t* context = zathura_content_type_new();
+
+  for (guint idx = 0; idx != update->files->len && g_cancellable_is_cancelled(cancellable) == FALSE; ++idx) {
+    const char* path = g_ptr_array_index(update->files, idx);
+    GStatBuf st;
+    if (g_stat(path, &st) != 0 || S_ISREG(st.st_mode) == 0) {
+      continue;
+    }
+
+    const zathura_catalog_entry_t* known = g_hash_table_lookup(update->known, path);
+    const bool unchanged = known != NULL && known->size == (guint64)st.st_size && known->mtime == st.st_mtime;
+    g_hash_table_remove(update->known, path);
+    if (unchanged == true) {
+      continue;
+    }
+
+    girara_list_t* pages = text_index_extract(update->plugin_manager, context, path, cancellable);
+    if (g_cancellable_is_cancelled(cancellable) == TRUE) {
+      girara_list_free(pages);
+      break;
+    }
+
+    const zathura_catalog_entry_t entry = {
+        .path  = (char*)path,
+        .size  = st.st_size,
+        .mtime = st.st_mtime,
+        .pages = girara_list_size(pages),
+    };
+    text_index_write(update, &entry, pages);
+    girara_list_free(pages);
+    text_index_post_progress(update, idx + 1);
+  }
+
+  zathura_content_type_free(context);
+
+  /* documents that are gone or were not asked for are removed */
+  if (g_cancellable_is_cancelled(cancellable) == FALSE) {
+    GHashTableIter iter;
+    gpointer path = NULL;
+    g_hash_table_iter_init(&iter, update->known);
+    while (g_hash_table_iter_next(&iter, &path, NULL) == TRUE &&
+           g_cancellable_is_cancelled(cancellable) == FALSE) {
+      const zathura_catalog_entry_t entry = {.path = path};
+      text_index_write(update, &entry, NULL);
+    }
+    text_index_post_progress(update, update->files->len);
+  }
+
+  zathura_text_index_t* index = update->index;
+  g_mutex_lock(&index->lock);
+  index->updating = false;
+  g_cond_signal(&index->cond);
+  g_mutex_unlock(&index->lock);
+
+  g_task_return_boolean(task, TRUE);
+}
+
+static void text_index_update_free(void* data) {
+  text_index_update_t* update = data;
+  g_object_unref(update->database);
+  g_object_unref(update->cancellable);
+  g_main_context_unref(update->context);
+  g_ptr_array_unref(update->files);
+  g_hash_table_unref(update->known);
+  g_free(update);
+}
+
+static void text_index_update_done(GObject* UNUSED(source), GAsyncResult* result, gpointer data) {
+  /* fails if the index has been freed in the meantime */
+  if (g_task_propagate_boolean(G_TASK(result), NULL) == FALSE) {
+    return;
+  }
+
+  zathura_text_index_t* index = data;
+  if (index->pending_files != NULL) {
+    g_autoptr(GPtrArray) files = g_steal_pointer(&index->pending_files);
+    zathura_text_index_update(index, files);
+  }
+}
+
+void zathura_text_index_update(zathura_text_index_t* index, GPtrArray* files) {
+  g_return_if_fail(index != NULL && files != NULL);
+
+  g_mutex_lock(&index->lock);
+  const bool updating = index->updating;
+  index->updating     = true;
+  g_mutex_unlock(&index->lock);
+
+  if (updating == true) {
+    if (index->pending_files != NULL) {
+      g_ptr_array_unref(index->pending_files);
+    }
+    index->pending_files = g_ptr_array_ref(files);
+    return;
+  }
+
+  text_index_update_t* update = g_new0(text_index_update_t, 1);
+  update->index               = index;
+  update->database            = g_object_ref(index->database);
+  update->cancellable         = g_object_ref(index->cancellable);
+  update->context             = g_main_context_ref_thread_default();
+  update->plugin_manager      = index->plugin_manager;
+  update->files               = g_ptr_array_ref(files);
+  update->known               = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, catalog_entry_free);
+
+  girara_list_t* indexed = zathura_db_load_text_index(index->database);
+  for (size_t idx = 0; indexed != NULL && idx != girara_list_size(indexed); ++idx) {
+    zathura_catalog_entry_t* entry = girara_list_nth(indexed, idx);
+    zathura_catalog_entry_t* copy  = g_new0(zathura_catalog_entry_t, 1);
+    *copy                          = *entry;
+    copy->path                     = g_strdup(entry->path);
+    g_hash_table_replace(update->known, copy->path, copy);
+  }
+  if (indexed != NULL) {
+    girara_list_free(indexed);
+  }
+
+  index->checked = 0;
+  index->total   = files->len;
+  update->serial = ++index->serial;
+
+  g_autoptr(GTask) task = g_task_new(NULL, update->cancellable, text_index_update_done, index);
+  g_task_set_task_data(task, update, text_index_update_free);
+  g_task_run_in_thread(task, text_index_update_thread);
+}
+
+static void text_index_results_free(void* data) {
+  text_index_results_t* results = data;
+  g_object_unref(results->cancellable);
+  g_ptr_array_unref(results->matches);
+  g_free(results);
+}
+
+static gboolean text_index_results_apply(void* data) {
+  text_index_results_t* results = data;
+  if (g_cancellable_is_cancelled(results->cancellable) == FALSE) {
+    results->callback(results->matches, results->finished, results->data);
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Hand the collected matches over to the main thread. Runs on the search
+ * thread. */
+static void text_index_search_flush(text_index_search_t* search, bool finished) {
+  text_index_results_t* results = g_new0(text_index_results_t, 1);
+  results->cancellable          = g_object_ref(search->cancellable);
+  results->callback             = search->callback;
+  results->data                 = search->data;
+  results->matches              = search->matches;
+  results->finished             = finished;
+  search->matches               = g_ptr_array_new_with_free_func(text_index_match_free);
+
+  g_main_context_invoke_full(search->context, G_PRIORITY_DEFAULT, text_index_results_apply, results,
+                             text_index_results_free);
+}
+
+static bool text_index_search_match(const char* file, unsigned int page, const char* snippet, void* data) {
+  text_index_search_t* search = data;
+  if (g_cancellable_is_cancelled(search->cancellable) == TRUE) {
+    return false;
+  }
+
+  zathura_text_index_match_t* match = g_new0(zathura_text_index_match_t, 1);
+  match->file                       = g_strdup(file);
+  match->page                       = page;
+  match->snippet                    = g_strdup(snippet);
+  g_ptr_array_add(search->matches, match);
+  ++search->found;
+
+  /* show the best match as early as possible */
+  if (search->matches->len >= TEXT_INDEX_SEARCH_BATCH || search->found == 1) {
+    text_index_search_flush(search, false);
+  }
+
+  return true;
+}
+
+static void text_index_search_thread(GTask* UNUSED(task), gpointer UNUSED(source), gpointer data,
+                                     GCancellable* UNUSED(cancellable)) {
+  text_index_search_t* search = data;
+
+  if (zathura_db_search_text(search->database, search->query, search->max, text_index_search_match, search) ==
+      false) {
+    girara_debug("Text search for '%s' failed.", search->query);
+  }
+  text_index_search_flush(search, true);
+}
+
+static void text_index_search_free(void* data) {
+  text_index_search_t* search = data;
+  g_object_unref(search->database);
+  g_object_unref(search->cancellable);
+  g_main_context_unref(search->context);
+  g_free(search->query);
+  g_ptr_array_unref(search->matches);
+  g_free(search);
+}
+
+void zathura_text_index_search(zathura_text_index_t* index, const char* query, unsigned int max,
+                               zathura_text_index_results_t callback, void* data) {
+  g_return_if_fail(index != NULL && query != NULL && callback != NULL);
+
+  zathura_text_index_cancel_search(index);
+  index->search_cancellable = g_cancellable_new();
+
+  text_index_search_t* search = g_new0(text_index_search_t, 1);
+  search->database            = g_object_ref(index->database);
+  search->cancellable         = g_object_ref(index->search_cancellable);
+  search->context             = g_main_context_ref_thread_default();
+  search->query               = g_strdup(query);
+  search->max                 = MIN(max, G_MAXINT);
+  search->callback            = callback;
+  search->data                = data;
+  search->matches             = g_ptr_array_new_with_free_func(text_index_match_free);
+
+  g_autoptr(GTask) task = g_task_new(NULL, search->cancellable, NULL, NULL);
+  g_task_set_task_data(task, search, text_index_search_free);
+  g_task_run_in_thread(task, text_index_search_thread);
+}
+
+void zathura_text_index_cancel_search(zathura_text_index_t* index) {
+  g_return_if_fail(index != NULL);
+
+  if (index->search_cancellable != NULL) {
+    g_cancellable_cancel(index->search_cancellable);
+    g_clear_object(&index->search_cancellable);
+  }
+}
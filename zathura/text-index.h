@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_TEXT_INDEX_H
+#define ZATHURA_TEXT_INDEX_H
+
+#include <stdbool.h>
+#include <glib.h>
+
+#include "database.h"
+#include "plugin.h"
+
+/**
+ * Persistent full-text index of the pages of many documents. The text is
+ * extracted with the plugins and stored in the database by a background
+ * thread; searches run in a background thread as well. All functions have
+ * to be called from the main thread.
+ */
+typedef struct zathura_text_index_s zathura_text_index_t;
+
+/**
+ * A match of a text search
+ */
+typedef struct zathura_text_index_match_s {
+  char* file;        /**< Path of the document */
+  unsigned int page; /**< Page number (starting at 0) */
+  char* snippet;     /**< Text around the match */
+} zathura_text_index_match_t;
+
+/**
+ * Called on the main thread with the next matches of a search, ordered by
+ * relevance. It is not called anymore once the search was cancelled.
+ *
+ * @param matches Array of zathura_text_index_match_t*, owned by the index
+ * @param finished true if these are the last matches of the search
+ * @param data User data
+ */
+typedef void (*zathura_text_index_results_t)(GPtrArray* matches, bool finished, void* data);
+
+/**
+ * Called on the main thread while an update is running.
+ *
+ * @param checked Number of documents that are up to date
+ * @param total Number of documents of the update
+ * @param data User data
+ */
+typedef void (*zathura_text_index_progress_t)(unsigned int checked, unsigned int total, void* data);
+
+/**
+ * Create a new text index.
+ *
+ * @param database The database holding the index
+ * @param plugin_manager The plugin manager used to open documents
+ * @return new index or NULL if the database does not support a text index
+ */
+zathura_text_index_t* zathura_text_index_new(ZathuraDatabase* database, zathura_plugin_manager_t* plugin_manager);
+
+/**
+ * Free the index and cancel running updates and searches.
+ *
+ * @param index The index
+ */
+void zathura_text_index_free(zathura_text_index_t* index);
+
+/**
+ * Bring the index up to date with the given documents in the background.
+ * Documents whose size and modification time did not change are not
+ * extracted again; documents not in the list are removed from the index. If
+ * an update is already running, the new one starts after it finished.
+ *
+ * @param index The index
+ * @param files Array of paths of the documents to index
+ */
+void zathura_text_index_update(zathura_text_index_t* index, GPtrArray* files);
+
+/**
+ * Set the function that is told about the progress of updates.
+ *
+ * @param index The index
+ * @param callback Function called with the progress or NULL
+ * @param data User data passed to callback
+ */
+void zathura_text_index_set_progress_callback(zathura_text_index_t* index, zathura_text_index_progress_t callback,
+                                              void* data);
+
+/**
+ * Get the progress of the running update. Searches only find documents that
+ * are up to date.
+ *
+ * @param index The index
+ * @param checked Set to the number of documents that are up to date
+ * @param total Set to the number of documents of the update
+ * @return true if an update is running
+ */
+bool zathura_text_index_get_progress(zathura_text_index_t* index, unsigned int* checked, unsigned int* total);
+
+/**
+ * Search the index in the background. A running search is cancelled.
+ *
+ * @param index The index
+ * @param query The search query
+ * @param max Maximal number of matches
+ * @param callback Function called with the matches
+ * @param data User data passed to callback
+ */
+void zathura_text_index_search(zathura_text_index_t* index, const char* query, unsigned int max,
+                               zathura_text_index_results_t callback, void* data);
+
+/**
+ * Cancel the running search.
+ *
+ * @param index The index
+ */
+void zathura_text_index_cancel_search(zathura_text_index_t* index);
+
+#endif
@@ -0,0 +1,486 @@
+/* SPDX-License-Identifier: Zlib */
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <girara/log.h>
+#include <girara/utils.h>
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+
+#include "thumbnail-cache.h"
+#include "document.h"
+#include "macros.h"
+#include "page.h"
+#include "utils.h"
+
+/* directory of the thumbnail files in the cache directory */
+#define THUMBNAIL_CACHE_DIR "thumbnails"
+/* identifies the file format; bumped whenever the layout changes */
+#define THUMBNAIL_CACHE_MAGIC "ZTHUMB01"
+/* thumbnail files are removed once the directory grows beyond this size ... */
+#define THUMBNAIL_CACHE_MAX_SIZE (256 * 1024 * 1024)
+/* ... or if the document was not opened for this many seconds */
+#define THUMBNAIL_CACHE_MAX_AGE (90 * 24 * 60 * 60)
+
+/**
+ * Header of a thumbnail file. It is followed by an entry for every page and the
+ * pixel data. All values are stored in host byte order.
+ */
+typedef struct thumbnail_header_s {
+  char magic[8];           /**< THUMBNAIL_CACHE_MAGIC */
+  guint32 number_of_pages; /**< Number of entries */
+  guint32 size;            /**< ZATHURA_THUMBNAIL_SIZE when the file was written */
+} thumbnail_header_t;
+
+/**
+ * Entry of a page in a thumbnail file.
+ */
+typedef struct thumbnail_entry_s {
+  guint64 offset; /**< Offset of the RGB16_565 pixel data, 0 if the page has no thumbnail */
+  guint32 width;  /**< Width of the thumbnail */
+  guint32 height; /**< Height of the thumbnail */
+} thumbnail_entry_t;
+
+struct zathura_thumbnail_cache_s {
+  zathura_document_t* document;
+  ZathuraRenderer* renderer;
+  char* path; /**< Path of the thumbnail file, NULL if thumbnails are not stored */
+  zathura_thumbnail_cache_updated_t callback;
+  void* data;
+  unsigned int number_of_pages;
+
+  GMappedFile* file;                /**< Thumbnail file of an earlier session, NULL if there is none */
+  const thumbnail_entry_t* entries; /**< Entries of the mapped file */
+
+  GThread* thread;
+  gint cancelled;
+  GMutex lock;
+  cairo_surface_t** thumbnails; /**< Thumbnails generated by the worker thread */
+  unsigned int missing;         /**< Number of pages without a thumbnail */
+  unsigned int next;            /**< Page the worker thread continues with */
+  bool dirty;                   /**< Thumbnails were generated since the file was written */
+  guint idle;                   /**< Source notifying the main loop about new thumbnails */
+};
+
+static const cairo_user_data_key_t thumbnail_file_key;
+
+void zathura_thumbnail_size(zathura_page_t* page, unsigned int* width, unsigned int* height) {
+  const double page_width  = zathura_page_get_width(page);
+  const double page_height = zathura_page_get_height(page);
+  const double longer_side = fmax(page_width, page_height);
+  const double scale       = longer_side > 0 ? ZATHURA_THUMBNAIL_SIZE / longer_side : 0;
+
+  *width  = CLAMP((unsigned int)round(page_width * scale), 1, ZATHURA_THUMBNAIL_SIZE);
+  *height = CLAMP((unsigned int)round(page_height * scale), 1, ZATHURA_THUMBNAIL_SIZE);
+}
+
+static unsigned int thumbnail_stride(unsigned int width) {
+  return cairo_format_stride_for_width(CAIRO_FORMAT_RGB16_565, width);
+}
+
+static bool thumbnail_cache_has(zathura_thumbnail_cache_t* cache, unsigned int page) {
+  return cache->thumbnails[page] != NULL || (cache->entries != NULL && cache->entries[page].offset != 0);
+}
+
+/* Map the thumbnail file and check that every entry lies within the file. An
+ * invalid file is ignored and replaced once new thumbnails are written. */
+static void thumbnail_cache_map(zathura_thumbnail_cache_t* cache) {
+  g_autoptr(GError) error = NULL;
+  GMappedFile* file       = g_mapped_file_new(cache->path, FALSE, &error);
+  if (file == NULL) {
+    if (g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT) == FALSE) {
+      girara_debug("Failed to map thumbnail file '%s': %s", cache->path, error->message);
+    }
+    return;
+  }
+
+  const char* contents             = g_mapped_file_get_contents(file);
+  const gsize length               = g_mapped_file_get_length(file);
+  const gsize entries_end          = sizeof(thumbnail_header_t) + cache->number_of_pages * sizeof(thumbnail_entry_t);
+  const thumbnail_header_t* header = (const thumbnail_header_t*)contents;
+  if (length < entries_end || memcmp(header->magic, THUMBNAIL_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->number_of_pages != cache->number_of_pages || header->size != ZATHURA_THUMBNAIL_SIZE) {
+    girara_debug("Ignoring outdated thumbnail file '%s'", cache->path);
+    g_mapped_file_unref(file);
+    return;
+  }
+
+  const thumbnail_entry_t* entries = (const thumbnail_entry_t*)(contents + sizeof(thumbnail_header_t));
+  unsigned int available           = 0;
+  for (unsigned int page = 0; page < cache->number_of_pages; ++page) {
+    const thumbnail_entry_t* entry = &entries[page];
+    if (entry->offset == 0) {
+      continue;
+    }
+
+    if (entry->width == 0 || entry->width > ZATHURA_THUMBNAIL_SIZE || entry->height == 0 ||
+        entry->height > ZATHURA_THUMBNAIL_SIZE || entry->offset % 4 != 0 || entry->offset < entries_end ||
+        entry->offset > length || (gsize)thumbnail_stride(entry->width) * entry->height > length - entry->offset) {
+      girara_debug("Ignoring corrupted thumbnail file '%s'", cache->path);
+      g_mapped_file_unref(file);
+      return;
+    }
+    ++available;
+  }
+
+  cache->file    = file;
+  cache->entries = entries;
+
+  /* recently used files are kept when the directory is trimmed */
+  g_utime(cache->path, NULL);
+
+  cache->missing -= available;
+  girara_debug("Mapped %u thumbnails from '%s'", available, cache->path);
+}
+
+/**
+ * Thumbnails to be written to a new file. The job does not refer to the
+ * document, so it can outlive the cache.
+ */
+typedef struct thumbnail_write_s {
+  char* path;
+  unsigned int number_of_pages;
+  cairo_surface_t** generated;      /**< Generated thumbnails */
+  GMappedFile* file;                /**< Mapped thumbnail file, NULL if there is none */
+  const thumbnail_entry_t* entries; /**< Entries of the mapped file */
+} thumbnail_write_t;
+
+static void thumbnail_write_free(void* data) {
+  thumbnail_write_t* job = data;
+  for (unsigned int page = 0; page < job->number_of_pages; ++page) {
+    if (job->generated[page] != NULL) {
+      cairo_surface_destroy(job->generated[page]);
+    }
+  }
+  g_free(job->generated);
+  if (job->file != NULL) {
+    g_mapped_file_unref(job->file);
+  }
+  g_free(job->path);
+  g_free(job);
+}
+
+/* Collect the thumbnails that have to be written, or return NULL if the file
+ * is up to date. */
+static thumbnail_write_t* thumbnail_cache_take_write(zathura_thumbnail_cache_t* cache) {
+  if (cache->path == NULL) {
+    return NULL;
+  }
+
+  /* generated thumbnails are not modified once they are stored, so only the
+   * references need to be taken under the lock */
+  g_mutex_lock(&cache->lock);
+  if (cache->dirty == false) {
+    g_mutex_unlock(&cache->lock);
+    return NULL;
+  }
+  cache->dirty = false;
+
+  thumbnail_write_t* job = g_new0(thumbnail_write_t, 1);
+  job->path              = g_strdup(cache->path);
+  job->number_of_pages   = cache->number_of_pages;
+  job->generated         = g_new0(cairo_surface_t*, cache->number_of_pages);
+  for (unsigned int page = 0; page < cache->number_of_pages; ++page) {
+    if (cache->thumbnails[page] != NULL) {
+      job->generated[page] = cairo_surface_reference(cache->thumbnails[page]);
+    }
+  }
+  g_mutex_unlock(&cache->lock);
+
+  if (cache->file != NULL) {
+    job->file    = g_mapped_file_ref(cache->file);
+    job->entries = cache->entries;
+  }
+
+  return job;
+}
+
+/* Write the mapped and the generated thumbnails to a new file and trim the
+ * thumbnail directory. The file is replaced atomically, so mappings of the
+ * old file stay valid. Runs on a worker thread. */
+static void thumbnail_write_run(thumbnail_write_t* job) {
+  thumbnail_header_t header = {
+      .number_of_pages = job->number_of_pages,
+      .size            = ZATHURA_THUMBNAIL_SIZE,
+  };
+  memcpy(header.magic, THUMBNAIL_CACHE_MAGIC, sizeof(header.magic));
+
+  GByteArray* bytes = g_byte_array_new();
+  g_byte_array_append(bytes, (const guint8*)&header, sizeof(header));
+  g_byte_array_set_size(bytes, sizeof(header) + job->number_of_pages * sizeof(thumbnail_entry_t));
+  memset(bytes->data + sizeof(header), 0, job->number_of_pages * sizeof(thumbnail_entry_t));
+
+  static const guint8 padding[4] = {0};
+  for (unsigned int page = 0; page < job->number_of_pages; ++page) {
+    thumbnail_entry_t entry     = {0};
+    const unsigned char* pixels = NULL;
+    unsigned int source_stride  = 0;
+    if (job->generated[page] != NULL) {
+      entry.width   = cairo_image_surface_get_width(job->generated[page]);
+      entry.height  = cairo_image_surface_get_height(job->generated[page]);
+      pixels        = cairo_image_surface_get_data(job->generated[page]);
+      source_stride = cairo_image_surface_get_stride(job->generated[page]);
+    } else if (job->entries != NULL && job->entries[page].offset != 0) {
+      entry.width   = job->entries[page].width;
+      entry.height  = job->entries[page].height;
+      pixels        = (const unsigned char*)g_mapped_file_get_contents(job->file) + job->entries[page].offset;
+      source_stride = thumbnail_stride(entry.width);
+    } else {
+      continue;
+    }
+
+    g_byte_array_append(bytes, padding, (4 - bytes->len % 4) % 4);
+    entry.offset              = bytes->len;
+    const unsigned int stride = thumbnail_stride(entry.width);
+    for (unsigned int row = 0; row < entry.height; ++row) {
+      g_byte_array_append(bytes, pixels + row * source_stride, stride);
+    }
+    memcpy(bytes->data + sizeof(header) + page * sizeof(thumbnail_entry_t), &entry, sizeof(entry));
+  }
+
+  g_autofree char* dir    = g_path_get_dirname(job->path);
+  g_autoptr(GError) error = NULL;
+  if (g_mkdir_with_parents(dir, 0700) != 0 ||
+      g_file_set_contents(job->path, (const char*)bytes->data, bytes->len, &error) == FALSE) {
+    girara_debug("Failed to write thumbnail file '%s': %s", job->path,
+                 error != NULL ? error->message : g_strerror(errno));
+  }
+  g_byte_array_unref(bytes);
+
+  cache_dir_trim(dir, THUMBNAIL_CACHE_MAX_SIZE, THUMBNAIL_CACHE_MAX_AGE);
+}
+
+static void thumbnail_write_thread(GTask* UNUSED(task), gpointer UNUSED(source), gpointer data,
+                                   GCancellable* UNUSED(cancellable)) {
+  thumbnail_write_run(data);
+}
+
+/* Render a thumbnail. Plugins only support RGB24 and ARGB32 surfaces, so the
+ * page is rendered into an RGB24 surface and converted afterwards. */
+static cairo_surface_t* thumbnail_render(zathura_page_t* page, ZathuraRenderer* renderer) {
+  unsigned int width  = 0;
+  unsigned int height = 0;
+  zathura_thumbnail_size(page, &width, &height);
+
+  cairo_surface_t* rendered = cairo_image_surface_create(CAIRO_FORMAT_RGB24, width, height);
+  if (cairo_surface_status(rendered) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(rendered);
+    return NULL;
+  }
+
+  cairo_t* cairo = cairo_create(rendered);
+  cairo_set_source_rgb(cairo, 1, 1, 1);
+  cairo_paint(cairo);
+  cairo_scale(cairo, width / zathura_page_get_width(page), height / zathura_page_get_height(page));
+
+  if (renderer != NULL) {
+    zathura_renderer_lock(renderer);
+  }
+  const zathura_error_t error = zathura_page_render(page, cairo, false);
+  if (renderer != NULL) {
+    zathura_renderer_unlock(renderer);
+  }
+  cairo_destroy(cairo);
+
+  if (error != ZATHURA_ERROR_OK) {
+    /* keep the blank thumbnail, the page would fail again */
+    girara_debug("Failed to render thumbnail of page %u", zathura_page_get_index(page));
+  }
+
+  cairo_surface_t* thumbnail = cairo_image_surface_create(CAIRO_FORMAT_RGB16_565, width, height);
+  cairo                      = cairo_create(thumbnail);
+  cairo_set_source_surface(cairo, rendered, 0, 0);
+  cairo_paint(cairo);
+  cairo_destroy(cairo);
+  cairo_surface_destroy(rendered);
+  cairo_surface_flush(thumbnail);
+
+  if (cairo_surface_status(thumbnail) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(thumbnail);
+    return NULL;
+  }
+
+  return thumbnail;
+}
+
+static gboolean thumbnail_cache_updated(gpointer data) {
+  zathura_thumbnail_cache_t* cache = data;
+
+  g_mutex_lock(&cache->lock);
+  cache->idle = 0;
+  g_mutex_unlock(&cache->lock);
+
+  cache->callback(cache, cache->data);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Find the next page without a thumbnail, starting with the prioritized page */
+static bool thumbnail_cache_next(zathura_thumbnail_cache_t* cache, unsigned int* page) {
+  if (cache->missing == 0) {
+    return false;
+  }
+
+  for (unsigned int idx = 0; idx < cache->number_of_pages; ++idx) {
+    const unsigned int candidate = (cache->next + idx) % cache->number_of_pages;
+    if (thumbnail_cache_has(cache, candidate) == false) {
+      *page = candidate;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static gpointer thumbnail_cache_thread(gpointer data) {
+  zathura_thumbnail_cache_t* cache = data;
+
+  while (g_atomic_int_get(&cache->cancelled) == 0) {
+    unsigned int page = 0;
+
+    g_mutex_lock(&cache->lock);
+    const bool found = thumbnail_cache_next(cache, &page);
+    cache->next      = page + 1;
+    g_mutex_unlock(&cache->lock);
+
+    if (found == false) {
+      break;
+    }
+
+    /* the renderer is only locked while a single page is rendered, so requests
+     * for visible pages are served between two thumbnails */
+    cairo_surface_t* thumbnail = thumbnail_render(zathura_document_get_page(cache->document, page), cache->renderer);
+    if (thumbnail == NULL) {
+      break;
+    }
+
+    g_mutex_lock(&cache->lock);
+    cache->thumbnails[page] = thumbnail;
+    cache->dirty            = true;
+    --cache->missing;
+    if (cache->callback != NULL && cache->idle == 0) {
+      cache->idle = g_idle_add(thumbnail_cache_updated, cache);
+    }
+    g_mutex_unlock(&cache->lock);
+  }
+
+  if (g_atomic_int_get(&cache->cancelled) == 0) {
+    thumbnail_write_t* job = thumbnail_cache_take_write(cache);
+    if (job != NULL) {
+      thumbnail_write_run(job);
+      thumbnail_write_free(job);
+    }
+  }
+
+  return NULL;
+}
+
+zathura_thumbnail_cache_t* zathura_thumbnail_cache_new(zathura_document_t* document, ZathuraRenderer* renderer,
+                                                       const char* cache_dir, zathura_thumbnail_cache_updated_t callback,
+                                                       void* data) {
+  g_return_val_if_fail(document != NULL, NULL);
+
+  zathura_thumbnail_cache_t* cache = g_new0(zathura_thumbnail_cache_t, 1);
+  cache->document                  = document;
+  cache->renderer                  = renderer != NULL ? g_object_ref(renderer) : NULL;
+  cache->callback                  = callback;
+  cache->data                      = data;
+  cache->number_of_pages           = zathura_document_get_number_of_pages(document);
+  cache->thumbnails                = g_new0(cairo_surface_t*, cache->number_of_pages);
+  cache->missing                   = cache->number_of_pages;
+  g_mutex_init(&cache->lock);
+
+  if (cache_dir != NULL && cache->number_of_pages > 0) {
+    g_autofree char* name = document_cache_name(document);
+    cache->path           = g_build_filename(cache_dir, THUMBNAIL_CACHE_DIR, name, NULL);
+
+    thumbnail_cache_map(cache);
+  }
+
+  return cache;
+}
+
+void zathura_thumbnail_cache_free(zathura_thumbnail_cache_t* cache) {
+  if (cache == NULL) {
+    return;
+  }
+
+  g_atomic_int_set(&cache->cancelled, 1);
+  if (cache->thread != NULL) {
+    g_thread_join(cache->thread);
+  }
+  if (cache->idle != 0) {
+    g_source_remove(cache->idle);
+  }
+
+  /* keep what was generated so far; the file is written in the background */
+  thumbnail_write_t* job = thumbnail_cache_take_write(cache);
+  if (job != NULL) {
+    g_autoptr(GTask) task = g_task_new(NULL, NULL, NULL, NULL);
+    g_task_set_task_data(task, job, thumbnail_write_free);
+    g_task_run_in_thread(task, thumbnail_write_thread);
+  }
+
+  for (unsigned int page = 0; page < cache->number_of_pages; ++page) {
+    if (cache->thumbnails[page] != NULL) {
+      cairo_surface_destroy(cache->thumbnails[page]);
+    }
+  }
+  g_free(cache->thumbnails);
+  if (cache->file != NULL) {
+    g_mapped_file_unref(cache->file);
+  }
+  g_clear_object(&cache->renderer);
+  g_free(cache->path);
+  g_mutex_clear(&cache->lock);
+  g_free(cache);
+}
+
+void zathura_thumbnail_cache_start(zathura_thumbnail_cache_t* cache) {
+  g_return_if_fail(cache != NULL);
+
+  g_mutex_lock(&cache->lock);
+  const bool complete = cache->missing == 0;
+  g_mutex_unlock(&cache->lock);
+
+  if (cache->thread != NULL || complete == true) {
+    return;
+  }
+
+  cache->thread = g_thread_new("thumbnails", thumbnail_cache_thread, cache);
+}
+
+void zathura_thumbnail_cache_prioritize(zathura_thumbnail_cache_t* cache, unsigned int page) {
+  g_return_if_fail(cache != NULL);
+
+  g_mutex_lock(&cache->lock);
+  cache->next = page;
+  g_mutex_unlock(&cache->lock);
+}
+
+cairo_surface_t* zathura_thumbnail_cache_get(zathura_thumbnail_cache_t* cache, unsigned int page) {
+  g_return_val_if_fail(cache != NULL && page < cache->number_of_pages, NULL);
+
+  g_mutex_lock(&cache->lock);
+  cairo_surface_t* thumbnail = cache->thumbnails[page];
+  if (thumbnail != NULL) {
+    cairo_surface_reference(thumbnail);
+  }
+  g_mutex_unlock(&cache->lock);
+
+  if (thumbnail != NULL || cache->entries == NULL || cache->entries[page].offset == 0) {
+    return thumbnail;
+  }
+
+  /* draw straight from the mapping; the surface keeps the mapping alive */
+  const thumbnail_entry_t* entry = &cache->entries[page];
+  unsigned char* pixels          = (unsigned char*)g_mapped_file_get_contents(cache->file) + entry->offset;
+  thumbnail = cairo_image_surface_create_for_data(pixels, CAIRO_FORMAT_RGB16_565, entry->width, entry->height,
+                                                  thumbnail_stride(entry->width));
+  cairo_surface_set_user_data(thumbnail, &thumbnail_file_key, g_mapped_file_ref(cache->file),
+                              (cairo_destroy_func_t)g_mapped_file_unref);
+
+  return thumbnail;
+}
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: Zlib */
+
+#ifndef ZATHURA_THUMBNAIL_CACHE_H
+#define ZATHURA_THUMBNAIL_CACHE_H
+
+#include <stdbool.h>
+#include <cairo.h>
+
+#include "types.h"
+#include "render.h"
+
+/**
+ * Length of the longer side of a thumbnail in pixels
+ */
+#define ZATHURA_THUMBNAIL_SIZE 128
+
+/**
+ * Thumbnails of all pages of a document. Thumbnails are stored in one file
+ * per document in the cache directory, named after the SHA-256 of the
+ * document: a header, a table with the offset and size of every page, and the
+ * pixel data of the thumbnails in RGB16_565. The file is mapped when the cache
+ * is created, so thumbnails generated during an earlier session are available
+ * immediately and are drawn straight from the mapping. Missing thumbnails are
+ * rendered by a worker thread, which also writes the file. Files that were not
+ * used for a long time or do not fit into the size limit of the thumbnail
+ * directory are removed.
+ */
+typedef struct zathura_thumbnail_cache_s zathura_thumbnail_cache_t;
+
+/**
+ * Callback of the thumbnail cache, invoked from the main loop after the worker
+ * thread generated new thumbnails.
+ *
+ * @param cache The thumbnail cache
+ * @param data Custom data
+ */
+typedef void (*zathura_thumbnail_cache_updated_t)(zathura_thumbnail_cache_t* cache, void* data);
+
+/**
+ * Create the thumbnail cache of a document and map the thumbnails stored on
+ * disk. No thumbnails are generated until zathura_thumbnail_cache_start is
+ * called.
+ *
+ * @param document The document; it has to outlive the cache
+ * @param renderer The renderer; locked while a thumbnail is rendered, can be NULL
+ * @param cache_dir The cache directory, or NULL to keep the thumbnails in memory
+ * @param callback Invoked when new thumbnails are available, can be NULL
+ * @param data Custom data passed to the callback
+ * @return the thumbnail cache
+ */
+zathura_thumbnail_cache_t* zathura_thumbnail_cache_new(zathura_document_t* document, ZathuraRenderer* renderer,
+                                                       const char* cache_dir, zathura_thumbnail_cache_updated_t callback,
+                                                       void* data);
+
+/**
+ * Free the thumbnail cache. Stops the worker thread; the generated thumbnails
+ * are written to disk in the background. Has to be called before the document
+ * is freed.
+ *
+ * @param cache The thumbnail cache
+ */
+void zathura_thumbnail_cache_free(zathura_thumbnail_cache_t* cache);
+
+/**
+ * Start generating the missing thumbnails in a worker thread. Pages are
+ * rendered one at a time and the renderer is released in between, so visible
+ * pages are not held up. Does nothing if the worker is already running or all
+ * thumbnails are available.
+ *
+ * @param cache The thumbnail cache
+ */
+void zathura_thumbnail_cache_start(zathura_thumbnail_cache_t* cache);
+
+/**
+ * Let the worker thread continue with the given page, e.g. the first page
+ * visible in the overview.
+ *
+ * @param cache The thumbnail cache
+ * @param page The page number
+ */
+void zathura_thumbnail_cache_prioritize(zathura_thumbnail_cache_t* cache, unsigned int page);
+
+/**
+ * Get the thumbnail of a page.
+ *
+ * @param cache The thumbnail cache
+ * @param page The page number
+ * @return a new reference to the thumbnail, or NULL if it was not generated yet
+ */
+cairo_surface_t* zathura_thumbnail_cache_get(zathura_thumbnail_cache_t* cache, unsigned int page);
+
+/**
+ * Compute the size of the thumbnail of a page.
+ *
+ * @param page The page
+ * @param width Set to the width of the thumbnail
+ * @param height Set to the height of the thumbnail
+ */
+void zathura_thumbnail_size(zathura_page_t* page, unsigned int* width, unsigned int* height);
+
+#endif
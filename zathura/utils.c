@@ -4,14 +4,17 @@
 #include <stdarg.h>
 #include <string.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <math.h>
 #include <gtk/gtk.h>
 #include <girara/datastructures.h>
 #include <girara/session.h>
 #include <girara/settings.h>
 #include <girara/utils.h>
+#include <glib/gstdio.h>
 
 #include "girara-compat.h"
+#include "index-model.h"
 #include "links.h"
 #include "utils.h"
 #include "zathura.h"
@@ -57,69 +60,6 @@ bool file_valid_extension(zathura_t* zathura, const char* path) {
   return zathura_plugin_manager_get_plugin(zathura->plugins.manager, content_type) != NULL;
 }
 
-static void index_element_free(void* data, GObject* UNUSED(object)) {
-  zathura_index_element_t* element = data;
-  zathura_index_element_free(element);
-}
-
-void document_index_build(girara_session_t* session, GtkTreeModel* model, GtkTreeIter* parent,
-                          girara_tree_node_t* tree) {
-  girara_list_t* list = girara_node_get_children(tree);
-
-  for (size_t idx = 0; idx != girara_list_size(list); ++idx) {
-    girara_tree_node_t* node               = girara_list_nth(list, idx);
-    zathura_index_element_t* index_element = girara_node_get_data(node);
-    const zathura_link_type_t type         = zathura_link_get_type(index_element->link);
-    const zathura_link_target_t target     = zathura_link_get_target(index_element->link);
-
-    g_autofree gchar* description  = NULL;
-    g_autofree gchar* description2 = NULL;
-
-    if (type == ZATHURA_LINK_GOTO_DEST) {
-      zathura_t* zathura   = session->global.data;
-      zathura_page_t* page = zathura_document_get_page(zathura_get_document(zathura), target.page_number);
-      const char* label    = zathura_page_get_label(page, NULL);
-
-      if (label != NULL) {
-        description  = g_strdup_printf("Page %s", label);
-        description2 = g_strdup_printf("(%d)", target.page_number + 1);
-      } else {
-        description = g_strdup_printf("Page %d", target.page_number + 1);
-      }
-    } else {
-      description = g_strdup(target.value);
-    }
-
-    GtkTreeIter tree_iter;
-    gtk_tree_store_append(GTK_TREE_STORE(model), &tree_iter, parent);
-    g_autofree gchar* markup = g_markup_escape_text(index_element->title, -1);
-    gtk_tree_store_set(GTK_TREE_STORE(model), &tree_iter, 0, markup, 1, description, 2, description2, 3, index_element,
-                       -1);
-    g_object_weak_ref(G_OBJECT(model), index_element_free, index_element);
-
-    if (girara_node_get_num_children(node) > 0) {
-      document_index_build(session, model, &tree_iter, node);
-    }
-  }
-}
-
-typedef struct {
-  GtkTreeIter current_iter;
-  unsigned int current_page;
-} SearchData;
-
-static gboolean search_current_index(GtkTreeModel* model, GtkTreePath* UNUSED(path), GtkTreeIter* iter, gpointer data) {
-  SearchData* search_data = (SearchData*)data;
-  zathura_index_element_t* index_element;
-  gtk_tree_model_get(model, iter, 3, &index_element, -1);
-  zathura_link_target_t target = zathura_link_get_target(index_element->link);
-  if (target.page_number > search_data->current_page) {
-    return TRUE; // terminate foreach loop
-  }
-  search_data->current_iter = *iter;
-  return FALSE;
-}
-
 static bool find_substring(const char* source_str, const char* search_str) {
   g_autofree gchar* normalized_source_str = g_utf8_normalize(source_str, -1, G_NORMALIZE_ALL);
   g_autofree gchar* normalized_search_str = g_utf8_normalize(search_str, -1, G_NORMALIZE_ALL);
@@ -198,12 +138,13 @@ void index_scroll_to_current_page(zathura_t* zathura) {
   GtkTreeView* tree_view = get_tree_view(zathura);
   GtkTreeModel* model    = gtk_tree_view_get_model(tree_view);
 
-  SearchData search_data;
-  gtk_tree_model_get_iter_first(model, &search_data.current_iter);
-  search_data.current_page = zathura_document_get_current_page_number(zathura_get_document(zathura));
-  gtk_tree_model_foreach(model, search_current_index, &search_data);
+  GtkTreeIter iter;
+  const unsigned int current_page = zathura_document_get_current_page_number(zathura_get_document(zathura));
+  if (zathura_index_model_find_page(ZATHURA_INDEX_MODEL(model), current_page, &iter) == false) {
+    return;
+  }
 
-  g_autoptr(GtkTreePath) current_path = gtk_tree_model_get_path(model, &search_data.current_iter);
+  g_autoptr(GtkTreePath) current_path = gtk_tree_model_get_path(model, &iter);
   if (zathura->global.current_index_path != NULL) {
     gtk_tree_path_free(zathura->global.current_index_path);
   }
@@ -590,3 +531,80 @@ girara_list_t* flatten_rectangles(girara_list_t* rectangles) {
   }
   return new_rectangles;
 }
+
+char* document_cache_name(zathura_document_t* document) {
+  const uint8_t* hash = zathura_document_get_hash(document);
+  GString* name       = g_string_sized_new(2 * 32);
+  for (size_t idx = 0; idx < 32; ++idx) {
+    g_string_append_printf(name, "%02x", hash[idx]);
+  }
+
+  return g_string_free(name, FALSE);
+}
+
+typedef struct cache_file_s {
+  char* path;
+  guint64 size;
+  gint64 mtime;
+} cache_file_t;
+
+static void cache_file_free(void* data) {
+  cache_file_t* file = data;
+  g_free(file->path);
+  g_free(file);
+}
+
+static gint cache_file_compare_age(gconstpointer lhs, gconstpointer rhs) {
+  const cache_file_t* lhs_file = *(cache_file_t* const*)lhs;
+  const cache_file_t* rhs_file = *(cache_file_t* const*)rhs;
+  return lhs_file->mtime < rhs_file->mtime ? -1 : (lhs_file->mtime > rhs_file->mtime ? 1 : 0);
+}
+
+void cache_dir_trim(const char* path, guint64 max_size, gint64 max_age) {
+  g_return_if_fail(path != NULL);
+
+  GDir* dir = g_dir_open(path, 0, NULL);
+  if (dir == NULL) {
+    return;
+  }
+
+  const gint64 now           = g_get_real_time() / G_USEC_PER_SEC;
+  g_autoptr(GPtrArray) files = g_ptr_array_new_with_free_func(cache_file_free);
+  guint64 total              = 0;
+
+  const char* name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    char* file_path = g_build_filename(path, name, NULL);
+    GStatBuf st;
+    if (g_stat(file_path, &st) != 0 || S_ISREG(st.st_mode) == 0) {
+      g_free(file_path);
+      continue;
+    }
+
+    if (now - st.st_mtime > max_age) {
+      girara_debug("Removing stale cache file '%s'", file_path);
+      g_remove(file_path);
+      g_free(file_path);
+      continue;
+    }
+
+    cache_file_t* file = g_new0(cache_file_t, 1);
+    file->path         = file_path;
+    file->size         = st.st_size;
+    file->mtime        = st.st_mtime;
+    g_ptr_array_add(files, file);
+    total += file->size;
+  }
+  g_dir_close(dir);
+
+  /* least recently modified first */
+  g_ptr_array_sort(files, cache_file_compare_age);
+  for (guint idx = 0; idx < files->len && total > max_size; ++idx) {
+    const cache_file_t* file = g_ptr_array_index(files, idx);
+    girara_debug("Removing cache file '%s' to keep the cache below %" G_GUINT64_FORMAT " bytes", file->path,
+                 max_size);
+    if (g_remove(file->path) == 0) {
+      total -= file->size;
+    }
+  }
+}
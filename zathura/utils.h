@@ -26,18 +26,6 @@ typedef struct page_offset_s {
  */
 bool file_valid_extension(zathura_t* zathura, const char* path);
 
-/**
- * Generates the document index based upon the list retrieved from the document
- * object.
- *
- * @param session The session
- * @param model The tree model
- * @param parent The tree iterator parent
- * @param tree The Tree iterator
- */
-void document_index_build(girara_session_t* session, GtkTreeModel* model, GtkTreeIter* parent,
-                          girara_tree_node_t* tree);
-
 /**
  * A custom search equal function for the index tree view, so that
  * when interactively searching, the string will be recursively compared
@@ -181,4 +169,25 @@ bool parse_color(GdkRGBA* color, const char* str);
  */
 girara_list_t* flatten_rectangles(girara_list_t* rectangles);
 
+/**
+ * Get the name of the files caching data of a document in the cache
+ * directory, i.e. the SHA-256 hash of the document as hexadecimal string.
+ *
+ * @param document The document
+ * @return the name, free with g_free
+ */
+char* document_cache_name(zathura_document_t* document);
+
+/**
+ * Remove files from a directory in the cache directory. Files that were not
+ * modified within max_age are removed, and then the least recently modified
+ * files until the remaining ones take up at most max_size bytes. Only uses
+ * the file system, so it can be called from a worker thread.
+ *
+ * @param path The directory
+ * @param max_size Maximal size of all files in bytes
+ * @param max_age Maximal age of a file in seconds
+ */
+void cache_dir_trim(const char* path, guint64 max_size, gint64 max_age);
+
 #endif // UTILS_H
@@ -39,7 +39,11 @@
 #include "database-sqlite.h"
 #endif
 #include "document.h"
+#include "dir-cache.h"
 #include "document-widget.h"
+#include "export.h"
+#include "file-catalog.h"
+#include "index-model.h"
 #include "shortcuts.h"
 #include "zathura.h"
 #include "utils.h"
@@ -48,12 +52,17 @@
 #include "page.h"
 #include "page-widget.h"
 #include "plugin.h"
+#include "print.h"
 #include "adjustment.h"
 #include "dbus-interface.h"
 #include "resources.h"
 #include "synctex.h"
+#include "text-index.h"
+#include "thumbnail-cache.h"
 #include "content-type.h"
 #include "note-popup.h"
+#include "snapshot.h"
+#include "startup-trace.h"
 
 typedef struct zathura_document_info_s {
   zathura_t* zathura;
@@ -426,28 +435,39 @@ bool zathura_init(zathura_t* zathura) {
   init_css(zathura);
 
   /* load plugins */
+  zathura_startup_trace_begin("plugins");
+  zathura_plugin_manager_set_cache_dir(zathura->plugins.manager, zathura->config.cache_dir);
   if (zathura_plugin_manager_load(zathura->plugins.manager) == false) {
     girara_warning("Found no plugins. Please install at least one plugin.");
   }
+  zathura_startup_trace_end("plugins");
 
   /* configuration */
+  zathura_startup_trace_begin("config");
   config_load_default(zathura);
   config_load_files(zathura);
+  zathura_startup_trace_end("config");
 
   /* UI */
+  zathura_startup_trace_begin("init_ui");
   if (init_ui(zathura) == false) {
     girara_error("Failed to initialize UI.");
+    zathura_startup_trace_end("init_ui");
     goto error_free;
   }
+  zathura_startup_trace_end("init_ui");
 
   /* Note popup widget */
   zathura->ui.note_popup = zathura_note_popup_new(zathura);
 
   /* database */
+  zathura_startup_trace_begin("init_database");
   if (init_database(zathura) == false) {
     girara_error("Failed to initialize database.");
+    zathura_startup_trace_end("init_database");
     goto error_free;
   }
+  zathura_startup_trace_end("init_database");
 
   /* bookmarks */
   zathura->bookmarks.bookmarks = girara_sorted_list_new_with_free((girara_compare_function_t)zathura_bookmarks_compare,
@@ -472,7 +492,9 @@ bool zathura_init(zathura_t* zathura) {
   girara_setting_get(zathura->ui.session, "dbus-service", &dbus);
   if (dbus == true) {
     /* Start D-Bus service */
+    zathura_startup_trace_begin("dbus");
     zathura->dbus = zathura_dbus_new(zathura);
+    zathura_startup_trace_end("dbus");
   }
 #endif
 
@@ -494,6 +516,9 @@ void zathura_free(zathura_t* zathura) {
 
   document_close(zathura, false);
 
+  /* write the startup trace if no page was painted */
+  zathura_startup_trace_finish();
+
   /* MIME type detection */
   zathura_content_type_free(zathura->content_type_context);
 
@@ -525,6 +550,19 @@ void zathura_free(zathura_t* zathura) {
   /* bookmarks */
   girara_list_free(zathura->bookmarks.bookmarks);
 
+  /* file catalog and text index */
+  zathura_text_index_free(zathura->text_index);
+  zathura_file_catalog_free(zathura->file_catalog);
+  if (zathura->catalog_pages != NULL) {
+    g_hash_table_unref(zathura->catalog_pages);
+  }
+
+  /* completion caches */
+  zathura_dir_cache_free(zathura->completion.directories);
+  if (zathura->completion.recent_files != NULL) {
+    girara_list_free(zathura->completion.recent_files);
+  }
+
   /* database */
   g_clear_object(&zathura->database);
 
@@ -921,6 +959,39 @@ static void document_open_page_max_size(zathura_document_t* document, unsigned i
   }
 }
 
+static void document_index_loaded(ZathuraIndexModel* model, void* data) {
+  zathura_t* zathura = data;
+
+  zathura_index_model_loader_free(zathura->index.loader);
+  zathura->index.loader = NULL;
+  zathura->index.model  = model;
+  zathura->index.loaded = true;
+
+  /* the index was requested while it was still being generated */
+  if (zathura->index.show_pending == true) {
+    zathura->index.show_pending = false;
+    if (girara_mode_get(zathura->ui.session) == zathura->modes.normal) {
+      sc_toggle_index(zathura->ui.session, NULL, NULL, 0);
+    }
+  }
+}
+
+void document_load_index(zathura_t* zathura) {
+  g_return_if_fail(zathura != NULL && zathura->document != NULL);
+
+  zathura->index.show_pending = true;
+  if (zathura->index.loader == NULL) {
+    zathura->index.loader = zathura_index_model_load(zathura->document, document_index_loaded, zathura);
+  }
+}
+
+static void document_thumbnails_updated(zathura_thumbnail_cache_t* UNUSED(thumbnails), void* data) {
+  zathura_t* zathura = data;
+  if (zathura->overview.grid != NULL) {
+    gtk_widget_queue_draw(zathura->overview.grid);
+  }
+}
+
 bool document_open(zathura_t* zathura, const char* path, const char* uri, const char* password, int page_number,
                    zathura_fileinfo_t* file_info_p) {
   if (zathura == NULL || zathura->plugins.manager == NULL || path == NULL) {
@@ -929,6 +1000,8 @@ bool document_open(zathura_t* zathura, const char* path, const char* uri, const
 
   g_return_val_if_fail(zathura->document == NULL, false);
 
+  zathura_startup_trace_begin("document_open");
+
   /* FIXME: since there are many call chains leading here, check again if we need to expand ~ or
    * ~user. We should fix all call sites instead */
   g_autofree char* tmp_path = *path == '~' ? girara_fix_path(path) : NULL;
@@ -1235,6 +1308,16 @@ bool document_open(zathura_t* zathura, const char* path, const char* uri, const
     gtk_widget_show(zathura->pages[page_id]);
   }
 
+  if (zathura->file_catalog != NULL) {
+    zathura_file_catalog_set_pages(zathura->file_catalog, file_path, number_of_pages);
+  } else {
+    /* handed to the catalog once the file picker creates it */
+    if (zathura->catalog_pages == NULL) {
+      zathura->catalog_pages = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    }
+    g_hash_table_replace(zathura->catalog_pages, g_strdup(file_path), GUINT_TO_POINTER(number_of_pages));
+  }
+
   /* Load persistent highlights from database */
   if (zathura->database != NULL) {
     girara_list_t* all_highlights = zathura_db_load_highlights(zathura->database, file_path);
@@ -1331,6 +1414,26 @@ bool document_open(zathura_t* zathura, const char* path, const char* uri, const
   /* call screen-changed callback to connect monitors-changed signal on initial screen */
   cb_widget_screen_changed(zathura->ui.session->gtk.view, NULL, zathura);
 
+  /* show the first screen of the last session while the visible pages are rendered */
+  zathura_snapshot_load(zathura);
+
+  /* map the thumbnails of earlier sessions; the missing ones are generated once the overview is shown */
+  bool thumbnail_cache = true;
+  girara_setting_get(zathura->ui.session, "thumbnail-cache", &thumbnail_cache);
+  zathura->overview.thumbnails =
+      zathura_thumbnail_cache_new(document, zathura->sync.render_thread,
+                                  thumbnail_cache == true ? zathura->config.cache_dir : NULL,
+                                  document_thumbnails_updated, zathura);
+
+  /* parse the SyncTeX file in the background before the first forward or backward search */
+  synctex_preload(zathura);
+
+  /* let forward searches find this instance by the path of the document */
+  if (zathura->dbus != NULL) {
+    zathura_dbus_set_document(zathura, zathura_document_get_path(document));
+  }
+
+  zathura_startup_trace_end("document_open");
   return true;
 
 error_free:
@@ -1338,6 +1441,7 @@ error_free:
   zathura->document = NULL;
 
 error_out:
+  zathura_startup_trace_end("document_open");
   return false;
 }
 
@@ -1461,6 +1565,8 @@ static void save_fileinfo_to_db(zathura_t* zathura) {
 
   /* save file info */
   zathura_db_set_fileinfo(zathura->database, path, file_hash, &file_info);
+  /* the order of the recent files changed */
+  g_clear_pointer(&zathura->completion.recent_files, girara_list_free);
   /* save jumplist */
   zathura_db_save_jumplist(zathura->database, path, zathura->jumplist.list);
   /* save quickmarks */
@@ -1508,6 +1614,21 @@ bool document_close(zathura_t* zathura, bool keep_monitor) {
   zathura_renderer_stop(zathura->sync.render_thread);
   g_clear_object(&zathura->window_icon_render_request);
 
+  /* stop generating the index; the worker has to finish before the document is freed */
+  g_clear_pointer(&zathura->index.loader, zathura_index_model_loader_free);
+  g_clear_object(&zathura->index.model);
+  zathura->index.loaded       = false;
+  zathura->index.show_pending = false;
+
+  /* stop exporting pages */
+  g_clear_pointer(&zathura->export.pages, zathura_export_free);
+
+  /* stop pre-rendering pages of a running print operation */
+  print_cancel(zathura);
+
+  /* stop generating thumbnails and store them */
+  g_clear_pointer(&zathura->overview.thumbnails, zathura_thumbnail_cache_free);
+
   /* remove monitor */
   if (keep_monitor == false) {
     g_clear_object(&zathura->file_monitor.monitor);
@@ -1521,6 +1642,13 @@ bool document_close(zathura_t* zathura, bool keep_monitor) {
   /* store file information */
   save_fileinfo_to_db(zathura);
 
+  /* store the first screen for the next time the document is opened; on reload
+   * the old pages are shown anyway */
+  zathura_snapshot_cancel(zathura);
+  if (keep_monitor == false) {
+    zathura_snapshot_save(zathura);
+  }
+
   /* remove marks */
   if (zathura->global.marks != NULL) {
     girara_list_free(zathura->global.marks);
@@ -1616,13 +1744,13 @@ bool document_close(zathura_t* zathura, bool keep_monitor) {
     document_predecessor_free(zathura);
   }
 
-#ifdef WITH_SYNCTEX
   /* invalidate synctex scanner */
-  if (zathura->synctex.scanner != NULL) {
-    synctex_scanner_free(zathura->synctex.scanner);
-    zathura->synctex.scanner = NULL;
+  synctex_free(zathura);
+
+  /* a reload keeps the bus name of the document */
+  if (zathura->dbus != NULL && keep_monitor == false) {
+    zathura_dbus_set_document(zathura, NULL);
   }
-#endif
 
   /* remove widgets */
   zathura_document_widget_clear_pages(zathura->ui.document_widget);
@@ -1651,6 +1779,13 @@ bool document_close(zathura_t* zathura, bool keep_monitor) {
     zathura->ui.index = NULL;
   }
 
+  /* remove overview */
+  if (zathura->ui.overview != NULL) {
+    g_object_ref_sink(zathura->ui.overview);
+    zathura->ui.overview   = NULL;
+    zathura->overview.grid = NULL;
+  }
+
   /* free current index path */
   if (zathura->global.current_index_path != NULL) {
     gtk_tree_path_free(zathura->global.current_index_path);
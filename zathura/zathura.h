@@ -7,9 +7,6 @@
 #include <girara/types.h>
 #include <girara/session.h>
 #include <gtk/gtk.h>
-#ifdef WITH_SYNCTEX
-#include <synctex/synctex_parser.h>
-#endif
 #ifdef GDK_WINDOWING_X11
 #include <gtk/gtkx.h>
 #endif
@@ -94,6 +91,23 @@ typedef struct _ZathuraDatabase zathura_database_t;
 typedef struct zathura_fileinfo_s zathura_fileinfo_t;
 /* forward declaration for types from content-type.h */
 typedef struct zathura_content_type_context_s zathura_content_type_context_t;
+/* forward declaration for types from file-catalog.h */
+typedef struct zathura_file_catalog_s zathura_file_catalog_t;
+/* forward declaration for types from text-index.h */
+typedef struct zathura_text_index_s zathura_text_index_t;
+/* forward declaration for types from dir-cache.h */
+typedef struct zathura_dir_cache_s zathura_dir_cache_t;
+/* forward declaration for types from index-model.h */
+typedef struct zathura_index_model_s ZathuraIndexModel;
+typedef struct zathura_index_model_loader_s zathura_index_model_loader_t;
+/* forward declaration for types from thumbnail-cache.h */
+typedef struct zathura_thumbnail_cache_s zathura_thumbnail_cache_t;
+/* forward declaration for types from export.h */
+typedef struct zathura_export_s zathura_export_t;
+/* forward declaration for types from print.h */
+typedef struct zathura_print_job_s zathura_print_job_t;
+/* forward declaration for types from synctex.h */
+typedef struct zathura_synctex_s zathura_synctex_t;
 
 struct zathura_s {
   struct {
@@ -119,6 +133,7 @@ struct zathura_s {
     GtkWidget* view;            /**< Scrolled Window */
     GtkWidget* document_widget; /**< Widget that contains all rendered pages */
     GtkWidget* index;             /**< Widget to show the index of the document */
+    GtkWidget* overview;          /**< Widget to show the thumbnails of the document */
     GtkWidget* highlights;        /**< Widget to show highlights list */
     GtkWidget* highlights_search; /**< Search entry for highlight filter */
     GtkWidget* highlights_paned;  /**< Paned container for document + highlights */
@@ -148,6 +163,7 @@ struct zathura_s {
   struct {
     GtkPrintSettings* settings; /**< Print settings */
     GtkPageSetup* page_setup;   /**< Saved page setup */
+    zathura_print_job_t* job;   /**< Running print operation */
   } print;
 
   struct {
@@ -175,6 +191,7 @@ struct zathura_s {
     girara_mode_t insert;       /**< Insert mode */
     girara_mode_t presentation; /**< Presentation mode */
     girara_mode_t highlights;   /**< Highlights list mode */
+    girara_mode_t overview;     /**< Thumbnail overview mode */
   } modes;
 
   struct {
@@ -202,8 +219,49 @@ struct zathura_s {
   GtkWidget** predecessor_pages;                    /**< The page widgets from before a reload */
   zathura_database_t* database;                     /**< The database */
   ZathuraDbus* dbus;                                /**< D-Bus service */
+  zathura_file_catalog_t* file_catalog;             /**< Documents shown in the file picker */
+  GHashTable* catalog_pages;                        /**< Page counts of documents opened before the catalog existed */
+  zathura_text_index_t* text_index;                 /**< Text of the documents shown in the file picker */
   ZathuraRenderRequest* window_icon_render_request; /**< Render request for window icon */
 
+  struct {
+    zathura_dir_cache_t* directories; /**< Directory listings for file completion */
+    girara_list_t* recent_files;      /**< Recent files, NULL if not loaded yet */
+  } completion;
+
+  /**
+   * Outline of the current document
+   */
+  struct {
+    zathura_index_model_loader_t* loader; /**< Generates the outline, NULL once it is loaded */
+    ZathuraIndexModel* model;             /**< The outline, NULL if the document has none */
+    bool loaded;                          /**< The outline has been generated */
+    bool show_pending;                    /**< Show the outline once it is loaded */
+  } index;
+
+  /**
+   * Thumbnail overview of the current document
+   */
+  struct {
+    zathura_thumbnail_cache_t* thumbnails; /**< Thumbnails of the pages */
+    GtkWidget* grid;                       /**< Grid of the overview, NULL if it was not shown yet */
+    unsigned int selected;                 /**< Page selected in the overview */
+  } overview;
+
+  /**
+   * Snapshot of the first screen of the last session
+   */
+  struct {
+    GCancellable* load; /**< Cancels decoding the snapshot, NULL once it is shown */
+  } snapshot;
+
+  /**
+   * Export of rendered pages
+   */
+  struct {
+    zathura_export_t* pages; /**< Running export, NULL if there is none */
+  } export;
+
   /**
    * File monitor
    */
@@ -255,11 +313,10 @@ struct zathura_s {
 
 #ifdef WITH_SYNCTEX
   /**
-   * SyncTeX context. The scanner object is cached for better performance.
+   * SyncTeX context. The scanner object is parsed in the background when the
+   * document is opened and cached together with recent lookups.
    */
-  struct {
-    synctex_scanner_p scanner;
-  } synctex;
+  zathura_synctex_t* synctex;
 #endif
 };
 
@@ -396,6 +453,14 @@ bool document_open_synctex(zathura_t* zathura, const char* path, const char* uri
 void document_open_idle(zathura_t* zathura, const char* path, const char* password, int page_number, const char* mode,
                         const char* synctex, const char* bookmark_name, const char* search_string);
 
+/**
+ * Generate the index of the current document in the background. The index is
+ * shown once it is loaded.
+ *
+ * @param zathura The zathura session
+ */
+void document_load_index(zathura_t* zathura);
+
 /**
  * Save a open file
  *